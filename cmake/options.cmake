@@ -1,3 +1,4 @@
 option(VULQIAN_BUILD_EXAMPLE "Build the VulQIan example" ON)
 option(ENABLE_SHADER_COMPILATION "Build Shaders" ON)
 option(VULQIAN_BUILD_TESTS "Build unit tests for VulQIan" ON)
+option(VULQIAN_BUILD_BENCHMARKS "Build the VulQIan benchmarks" OFF)
@@ -1,3 +1,9 @@
+# Set the destination folder for the copied files
+set(destination_folder "${CMAKE_CURRENT_BINARY_DIR}/Shaders")
+
+# Set the source folder containing the .spv files
+set(source_folder "${CMAKE_CURRENT_SOURCE_DIR}/source/VulQIan/Shaders")
+
 if (ENABLE_SHADER_COMPILATION)
     if (UNIX)
         add_custom_target(ShaderCompilation ALL
@@ -12,13 +18,47 @@ if (ENABLE_SHADER_COMPILATION)
             COMMENT "Running compile.bat for shaders"
         )
     endif()
+else()
+    # Shaders without a committed .spv are still compiled, straight into the destination folder
+    file(GLOB shader_sources ${source_folder}/*.vert ${source_folder}/*.frag ${source_folder}/*.comp)
+    set(uncompiled_shaders)
+    foreach(shader ${shader_sources})
+        if (NOT EXISTS ${shader}.spv)
+            list(APPEND uncompiled_shaders ${shader})
+        endif()
+    endforeach()
 
-    # Set the destination folder for the copied files
-    set(destination_folder "${CMAKE_CURRENT_BINARY_DIR}/Shaders")
+    if (uncompiled_shaders)
+        find_program(GLSLC_EXECUTABLE glslc HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin)
+        find_program(GLSLANG_VALIDATOR_EXECUTABLE glslangValidator HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin)
+        if (NOT GLSLC_EXECUTABLE AND NOT GLSLANG_VALIDATOR_EXECUTABLE)
+            message(FATAL_ERROR "Neither glslc nor glslangValidator found to compile ${uncompiled_shaders}")
+        endif()
 
-    # Set the source folder containing the .spv files
-    set(source_folder "${CMAKE_CURRENT_SOURCE_DIR}/source/VulQIan/Shaders")
+        file(MAKE_DIRECTORY ${destination_folder})
+        set(compiled_shaders)
+        foreach(shader ${uncompiled_shaders})
+            get_filename_component(shader_name ${shader} NAME)
+            set(output ${destination_folder}/${shader_name}.spv)
+            if (GLSLC_EXECUTABLE)
+                set(compile_command ${GLSLC_EXECUTABLE} ${shader} -o ${output})
+            else()
+                set(compile_command ${GLSLANG_VALIDATOR_EXECUTABLE} -V ${shader} -o ${output})
+            endif()
+            add_custom_command(
+                OUTPUT ${output}
+                COMMAND ${compile_command}
+                DEPENDS ${shader}
+                COMMENT "Compiling ${shader_name}"
+                VERBATIM
+            )
+            list(APPEND compiled_shaders ${output})
+        endforeach()
 
-    # Copy .spv files to the destination folder
-    file(COPY ${source_folder}/. DESTINATION ${destination_folder} FILES_MATCHING PATTERN "*.spv")
+        add_custom_target(ShaderCompilation ALL DEPENDS ${compiled_shaders})
+        message(STATUS "Compiling shaders without a committed .spv: " "${uncompiled_shaders}")
+    endif()
 endif()
+
+# Copy .spv files to the destination folder
+file(COPY ${source_folder}/. DESTINATION ${destination_folder} FILES_MATCHING PATTERN "*.spv")
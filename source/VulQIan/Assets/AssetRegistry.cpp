@@ -0,0 +1,70 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "AssetRegistry.hpp"
+
+#include "../Exception/Exception.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+
+namespace Vulqian::Engine::Assets {
+
+std::string normalize_path(std::string const& path) {
+    // weakly_canonical also resolves symbolic links of the part of the path that exists
+    std::error_code       error{};
+    std::filesystem::path normalized = std::filesystem::weakly_canonical(path, error);
+    if (error) {
+        normalized = std::filesystem::absolute(path).lexically_normal();
+    }
+    return normalized.generic_string();
+}
+
+std::uint64_t hash_file(std::string const& normalized_path) {
+    std::ifstream file{normalized_path, std::ios::binary};
+    if (!file) {
+        throw Vulqian::Exception::failed_to_open(normalized_path);
+    }
+
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    std::uint64_t           hash = FNV_OFFSET;
+    std::array<char, 65536> chunk{};
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+        for (std::streamsize i = 0; i < file.gcount(); ++i) {
+            hash = (hash ^ static_cast<unsigned char>(chunk[static_cast<std::size_t>(i)])) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+bool same_contents(std::string const& normalized_path, std::string const& other_normalized_path) {
+    std::error_code error{};
+    const auto      size = std::filesystem::file_size(normalized_path, error);
+    if (error || std::filesystem::file_size(other_normalized_path, error) != size || error) {
+        return false;
+    }
+
+    std::ifstream file{normalized_path, std::ios::binary};
+    std::ifstream other{other_normalized_path, std::ios::binary};
+    if (!file || !other) {
+        return false;
+    }
+
+    std::array<char, 65536> chunk{};
+    std::array<char, 65536> other_chunk{};
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+        const std::streamsize count = file.gcount();
+        if (!other.read(other_chunk.data(), count) || !std::equal(chunk.begin(), chunk.begin() + count, other_chunk.begin())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Vulqian::Engine::Assets
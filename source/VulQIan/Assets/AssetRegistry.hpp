@@ -0,0 +1,120 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace Vulqian::Engine::Assets {
+
+// Same file however it is written: absolute, with '.' and '..' resolved and '/' separators
+std::string normalize_path(std::string const& path);
+
+// 64-bit FNV-1a of the file's bytes, throws Vulqian::Exception::failed_to_open when it cannot be read
+std::uint64_t hash_file(std::string const& normalized_path);
+
+// Whether both files can be read and hold the same bytes, sizes compared first
+bool same_contents(std::string const& normalized_path, std::string const& other_normalized_path);
+
+// Loads each asset once and hands out shared handles to it.
+// Paths are normalized first, so "./models/cube.obj" and "models/../models/cube.obj" are one entry, and
+// files with identical contents share one asset too: a matching content hash is confirmed byte for byte
+// against the file the asset was loaded from, so a collision only costs a separate entry. The registry
+// keeps its own reference, the asset (and the GPU buffers it owns) is freed by evict_unused() once no
+// handle outside the registry remains.
+// Safe to call from several threads, loads of different files are serialized.
+template <typename Asset>
+class AssetRegistry {
+  public:
+    using Loader = std::function<std::shared_ptr<Asset>(std::string const& path)>;
+    using Hasher = std::function<std::uint64_t(std::string const& normalized_path)>;
+
+    explicit AssetRegistry(Loader loader, Hasher hasher = hash_file) : loader{std::move(loader)}, hasher{std::move(hasher)} {}
+
+    AssetRegistry(const AssetRegistry&) = delete;
+    AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+    std::shared_ptr<Asset> load(std::string const& path) {
+        const std::string           normalized = normalize_path(path);
+        std::lock_guard<std::mutex> lock{this->mutex};
+
+        if (const auto known = this->paths.find(normalized); known != this->paths.end()) {
+            return this->assets.at(known->second).asset;
+        }
+
+        // A new path, still the same asset when another path already brought identical contents
+        const std::uint64_t content = this->hasher(normalized);
+        const auto [first, last] = this->by_content.equal_range(content);
+        for (auto candidate = first; candidate != last; ++candidate) {
+            Entry const& entry = this->assets.at(candidate->second);
+            if (same_contents(normalized, entry.source)) {
+                this->paths.emplace(normalized, candidate->second);
+                return entry.asset;
+            }
+        }
+
+        const std::uint64_t id = this->next_id++;
+        auto                asset = this->loader(normalized);
+        this->assets.emplace(id, Entry{normalized, asset});
+        this->by_content.emplace(content, id);
+        this->paths.emplace(normalized, id);
+        ++this->load_count;
+        return asset;
+    }
+
+    // Frees the assets only the registry still holds, returns how many
+    std::size_t evict_unused() {
+        std::lock_guard<std::mutex> lock{this->mutex};
+
+        std::size_t evicted = 0;
+        for (auto asset = this->assets.begin(); asset != this->assets.end();) {
+            if (asset->second.asset.use_count() == 1) {
+                asset = this->assets.erase(asset);
+                ++evicted;
+            } else {
+                ++asset;
+            }
+        }
+        std::erase_if(this->by_content, [this](auto const& content) { return !this->assets.contains(content.second); });
+        std::erase_if(this->paths, [this](auto const& path) { return !this->assets.contains(path.second); });
+        return evicted;
+    }
+
+    std::size_t get_asset_count() const {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        return this->assets.size();
+    }
+
+    // Assets the loader was called for since creation
+    std::size_t get_load_count() const {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        return this->load_count;
+    }
+
+  private:
+    // One loaded asset and the file it was loaded from, the reference for later files with the same hash
+    struct Entry {
+        std::string            source{};
+        std::shared_ptr<Asset> asset{};
+    };
+
+    Loader loader;
+    Hasher hasher;
+
+    mutable std::mutex                                    mutex{};
+    std::unordered_map<std::uint64_t, Entry>              assets{};      // by id
+    std::unordered_multimap<std::uint64_t, std::uint64_t> by_content{};  // content hash to ids, several on a collision
+    std::unordered_map<std::string, std::uint64_t>        paths{};       // normalized path to id
+    std::uint64_t                                         next_id{};
+    std::size_t                                           load_count{};
+};
+
+} // namespace Vulqian::Engine::Assets
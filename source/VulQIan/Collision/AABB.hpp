@@ -0,0 +1,85 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+namespace Vulqian::Engine::Collision {
+
+// Axis-aligned bounding box, boxes touching on a face overlap
+struct AABB {
+    glm::vec3 min{};
+    glm::vec3 max{};
+
+    glm::vec3 center() const noexcept {
+        return (this->min + this->max) * .5f;
+    }
+
+    float surface_area() const noexcept {
+        const glm::vec3 size = this->max - this->min;
+        return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool overlaps(AABB const& other) const noexcept {
+        return this->min.x <= other.max.x && other.min.x <= this->max.x && this->min.y <= other.max.y && other.min.y <= this->max.y &&
+               this->min.z <= other.max.z && other.min.z <= this->max.z;
+    }
+
+    bool contains(AABB const& other) const noexcept {
+        return this->min.x <= other.min.x && this->min.y <= other.min.y && this->min.z <= other.min.z && other.max.x <= this->max.x &&
+               other.max.y <= this->max.y && other.max.z <= this->max.z;
+    }
+
+    AABB fattened(float margin) const noexcept {
+        return {this->min - margin, this->max + margin};
+    }
+
+    static AABB merge(AABB const& a, AABB const& b) noexcept {
+        return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+    }
+};
+
+// Half-line from origin along a unit direction, up to max_distance
+struct Ray {
+    glm::vec3 origin{};
+    glm::vec3 direction{0.f, 0.f, 1.f};
+    float     max_distance{std::numeric_limits<float>::max()};
+};
+
+// Closest object hit by a ray cast, user_data is the value given when the object was added
+struct RayHit {
+    std::uint32_t user_data{};
+    float         distance{};
+};
+
+// Slab test, `inverse_direction` is 1 / ray.direction (infinite on axes the ray does not move along).
+// Returns the distance at which the ray enters the box, 0 if it starts inside, or a negative value on a miss.
+inline float ray_entry(AABB const& box, glm::vec3 origin, glm::vec3 inverse_direction, float max_distance) noexcept {
+    float entry = 0.f;
+    float exit = max_distance;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        float near = (box.min[axis] - origin[axis]) * inverse_direction[axis];
+        float far = (box.max[axis] - origin[axis]) * inverse_direction[axis];
+        if (near > far) {
+            std::swap(near, far);
+        }
+
+        // NaN from 0 * inf (origin on a slab plane of a parallel ray) leaves the bounds unchanged
+        entry = near > entry ? near : entry;
+        exit = far < exit ? far : exit;
+        if (entry > exit) {
+            return -1.f;
+        }
+    }
+    return entry;
+}
+
+} // namespace Vulqian::Engine::Collision
@@ -0,0 +1,195 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "BroadPhase.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Vulqian::Engine::Collision {
+
+namespace {
+
+// Proxies whose pairs are looked up per job
+constexpr std::size_t QUERY_GRAIN = 1024;
+
+// Never overlaps anything, marks free proxies for the spatial hash
+const AABB FREE_BOX{glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+
+} // namespace
+
+BroadPhase::ProxyId BroadPhase::add(AABB const& box, std::uint32_t user_data) {
+    ProxyId proxy;
+    if (!this->free_proxies.empty()) {
+        proxy = this->free_proxies.back();
+        this->free_proxies.pop_back();
+    } else {
+        proxy = static_cast<ProxyId>(this->boxes.size());
+        this->boxes.emplace_back();
+        this->user_data.emplace_back();
+        this->leaves.emplace_back(DynamicAABBTree::NULL_NODE);
+        this->moved.emplace_back();
+    }
+
+    this->boxes[proxy] = box;
+    this->user_data[proxy] = user_data;
+    if (this->mode == BroadPhaseMode::AABBTree) {
+        this->leaves[proxy] = this->tree.create_proxy(box, proxy);
+        this->mark_moved(proxy);
+        ++this->added_count;
+    }
+    return proxy;
+}
+
+void BroadPhase::remove(ProxyId proxy) {
+    assert(proxy < this->boxes.size() && this->boxes[proxy].min.x <= this->boxes[proxy].max.x && "removing a free proxy");
+
+    if (this->mode == BroadPhaseMode::AABBTree) {
+        this->tree.destroy_proxy(this->leaves[proxy]);
+        this->leaves[proxy] = DynamicAABBTree::NULL_NODE;
+        this->mark_moved(proxy);
+    }
+    this->boxes[proxy] = FREE_BOX;
+    this->free_proxies.push_back(proxy);
+}
+
+void BroadPhase::move(ProxyId proxy, AABB const& box, glm::vec3 displacement) {
+    assert(proxy < this->boxes.size() && "moving an unknown proxy");
+
+    this->boxes[proxy] = box;
+    if (this->mode == BroadPhaseMode::AABBTree) {
+        this->tree.move_proxy(this->leaves[proxy], box, displacement);
+        this->mark_moved(proxy);
+    }
+}
+
+void BroadPhase::mark_moved(ProxyId proxy) {
+    if (!this->moved[proxy]) {
+        this->moved[proxy] = 1;
+        this->move_buffer.push_back(proxy);
+    }
+}
+
+void BroadPhase::update_pairs(Jobs::ThreadPool* pool) {
+    if (this->mode == BroadPhaseMode::AABBTree) {
+        this->update_tree_pairs(pool);
+        return;
+    }
+
+    std::vector<SpatialHash::Pair> found{};
+    this->hash.build(this->boxes, pool);
+    this->hash.find_pairs(found, pool);
+
+    this->pairs.clear();
+    this->pairs.reserve(found.size());
+    for (auto [a, b] : found) {
+        this->pairs.emplace_back(std::minmax(this->user_data[a], this->user_data[b]));
+    }
+
+    // Same order whatever the traversal or the amount of threads
+    std::sort(this->pairs.begin(), this->pairs.end());
+}
+
+void BroadPhase::update_tree_pairs(Jobs::ThreadPool* pool) {
+    if ((this->tree.get_enlarged_count() + this->added_count) * REBUILD_RATIO > this->tree.get_proxy_count()) {
+        this->tree.rebuild(pool);
+        this->added_count = 0;
+        ++this->rebuild_count;
+    }
+
+    // Pairs of two proxies that did not move still overlap, the others are found again below
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < this->pairs.size(); ++i) {
+        auto [a, b] = this->proxy_pairs[i];
+        if (!this->moved[a] && !this->moved[b]) {
+            this->pairs[kept] = this->pairs[i];
+            this->proxy_pairs[kept] = this->proxy_pairs[i];
+            ++kept;
+        }
+    }
+    this->pairs.resize(kept);
+    this->proxy_pairs.resize(kept);
+
+    // Each moved proxy looks up the proxies overlapping its tight box, a pair of two moved ones is kept by the lower
+    struct Found {
+        Pair pair;
+        Pair proxies;
+
+        bool operator<(Found const& other) const noexcept {
+            return this->pair < other.pair || (this->pair == other.pair && this->proxies < other.proxies);
+        }
+    };
+
+    const std::size_t               count = this->move_buffer.size();
+    std::vector<std::vector<Found>> found((count + QUERY_GRAIN - 1) / QUERY_GRAIN);
+    Jobs::run_jobs(pool, found.size(), [&](std::size_t job) {
+        for (std::size_t i = job * QUERY_GRAIN; i < std::min(count, (job + 1) * QUERY_GRAIN); ++i) {
+            const ProxyId proxy = this->move_buffer[i];
+            if (this->leaves[proxy] == DynamicAABBTree::NULL_NODE) {
+                continue;
+            }
+
+            AABB const& box = this->boxes[proxy];
+            this->tree.query(box, [&](DynamicAABBTree::ProxyId leaf) {
+                const ProxyId other = this->tree.get_user_data(leaf);
+                if (other != proxy && (!this->moved[other] || other > proxy) && this->boxes[other].overlaps(box)) {
+                    found[job].push_back({std::minmax(this->user_data[proxy], this->user_data[other]), std::minmax(proxy, other)});
+                }
+                return true;
+            });
+        }
+    });
+
+    std::vector<Found> added{};
+    for (auto const& local : found) {
+        added.insert(added.end(), local.begin(), local.end());
+    }
+    std::sort(added.begin(), added.end());
+
+    // Both lists are sorted, merged back into one, so the order never depends on the traversal or the amount of threads
+    std::vector<Pair> pairs(kept + added.size());
+    std::vector<Pair> proxy_pairs(kept + added.size());
+    for (std::size_t i = 0, j = 0, out = 0; out < pairs.size(); ++out) {
+        if (j == added.size() || (i < kept && Found{this->pairs[i], this->proxy_pairs[i]} < added[j])) {
+            pairs[out] = this->pairs[i];
+            proxy_pairs[out] = this->proxy_pairs[i++];
+        } else {
+            pairs[out] = added[j].pair;
+            proxy_pairs[out] = added[j++].proxies;
+        }
+    }
+    this->pairs = std::move(pairs);
+    this->proxy_pairs = std::move(proxy_pairs);
+
+    for (ProxyId proxy : this->move_buffer) {
+        this->moved[proxy] = 0;
+    }
+    this->move_buffer.clear();
+}
+
+std::optional<RayHit> BroadPhase::ray_cast(Ray const& ray) const {
+    const glm::vec3       inverse_direction = 1.f / ray.direction;
+    std::optional<RayHit> hit{};
+    float                 closest = ray.max_distance;
+
+    // Candidates are clipped against the tight box, the ray then only goes as far as the closest hit
+    auto test = [&](std::uint32_t proxy) {
+        const float distance = ray_entry(this->boxes[proxy], ray.origin, inverse_direction, closest);
+        if (distance >= 0.f && (!hit || distance < closest)) {
+            closest = distance;
+            hit = RayHit{this->user_data[proxy], distance};
+        }
+        return closest;
+    };
+
+    if (this->mode == BroadPhaseMode::AABBTree) {
+        this->tree.ray_cast(ray, [&](DynamicAABBTree::ProxyId leaf, float) { return test(this->tree.get_user_data(leaf)); });
+    } else {
+        this->hash.ray_cast(ray, [&](std::uint32_t proxy, float) { return test(proxy); });
+    }
+    return hit;
+}
+
+} // namespace Vulqian::Engine::Collision
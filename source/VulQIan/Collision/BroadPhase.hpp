@@ -0,0 +1,129 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../Jobs/ThreadPool.hpp"
+#include "AABB.hpp"
+#include "DynamicAABBTree.hpp"
+#include "SpatialHash.hpp"
+
+namespace Vulqian::Engine::Collision {
+
+enum class BroadPhaseMode : std::uint8_t {
+    AABBTree,    // few objects moving at a time, large size differences
+    SpatialHash  // dense scenes of similar objects, most of them moving every frame
+};
+
+// Finds the pairs of objects whose boxes overlap, with either structure behind the same interface.
+// Objects are referred to by the proxy returned by add() and reported by the user data given to it.
+// Pairs are always tested on the tight boxes, fat boxes only save tree updates, so both modes report the same pairs.
+// The tree keeps the pairs of the objects that did not move and only queries the ones added or moved since the
+// previous update, the hash finds every pair again each time.
+class BroadPhase {
+  public:
+    using ProxyId = std::uint32_t;
+
+    // Overlapping objects by user data, first < second
+    using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+    explicit BroadPhase(BroadPhaseMode mode = BroadPhaseMode::AABBTree, float margin = .1f, float cell_size = 2.f)
+        : mode{mode}, tree{margin}, hash{cell_size} {}
+
+    ProxyId add(AABB const& box, std::uint32_t user_data);
+    void    remove(ProxyId proxy);
+
+    // `displacement` is the expected motion until the next move, the tree stretches the fat box along it
+    void move(ProxyId proxy, AABB const& box, glm::vec3 displacement = {});
+
+    // Updates the pair list, sorted and without duplicates. The tree is rebuilt first once more than
+    // 1 / REBUILD_RATIO of its proxies were added or enlarged in place since the last rebuild.
+    // Incremental inserts keep the tree balanced but loose, after a bulk add the rebuild tightens it.
+    void update_pairs(Jobs::ThreadPool* pool = nullptr);
+
+    AABB const& get_box(ProxyId proxy) const noexcept {
+        assert(proxy < this->boxes.size() && "unknown proxy");
+        return this->boxes[proxy];
+    }
+
+    std::span<const Pair> get_pairs() const noexcept {
+        return this->pairs;
+    }
+
+    // Calls callback(user_data) for every object overlapping `box`.
+    // In SpatialHash mode queries see the boxes as of the last update_pairs().
+    template <typename Callback>
+    void query(AABB const& box, Callback&& callback) const {
+        auto report = [&](ProxyId proxy) {
+            if (this->boxes[proxy].overlaps(box)) {
+                callback(this->user_data[proxy]);
+            }
+        };
+
+        if (this->mode == BroadPhaseMode::AABBTree) {
+            this->tree.query(box, [&](DynamicAABBTree::ProxyId node) {
+                report(this->tree.get_user_data(node));
+                return true;
+            });
+        } else {
+            this->hash.query(box, report);
+        }
+    }
+
+    // Closest object hit by the ray, if any
+    std::optional<RayHit> ray_cast(Ray const& ray) const;
+
+    BroadPhaseMode get_mode() const noexcept {
+        return this->mode;
+    }
+
+    std::size_t get_proxy_count() const noexcept {
+        return this->boxes.size() - this->free_proxies.size();
+    }
+
+    // Tree rebuilds since creation
+    std::size_t get_rebuild_count() const noexcept {
+        return this->rebuild_count;
+    }
+
+    DynamicAABBTree const& get_tree() const noexcept {
+        return this->tree;
+    }
+
+    static constexpr std::size_t REBUILD_RATIO = 8;
+
+  private:
+    void mark_moved(ProxyId proxy);
+    void update_tree_pairs(Jobs::ThreadPool* pool);
+
+    BroadPhaseMode  mode;
+    DynamicAABBTree tree;
+    SpatialHash     hash;
+
+    // Per proxy: tight box (inverted while free), user data and tree leaf
+    std::vector<AABB>                     boxes{};
+    std::vector<std::uint32_t>            user_data{};
+    std::vector<DynamicAABBTree::ProxyId> leaves{};
+    std::vector<ProxyId>                  free_proxies{};
+
+    // Tree mode: proxies added, moved or removed since the last update, flagged and listed
+    std::vector<std::uint8_t> moved{};
+    std::vector<ProxyId>      move_buffer{};
+
+    // Pairs by user data, and in tree mode the same pairs by proxy at the same positions
+    std::vector<Pair> pairs{};
+    std::vector<Pair> proxy_pairs{};
+    std::size_t       added_count{};  // since the last rebuild
+    std::size_t       rebuild_count{};
+};
+
+} // namespace Vulqian::Engine::Collision
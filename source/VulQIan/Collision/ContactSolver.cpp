@@ -0,0 +1,136 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "ContactSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Vulqian::Engine::Collision {
+
+namespace {
+
+// One direction of one contact point, with the lever arms and their inertia terms computed once per step
+// so each iteration is only dot products and scaled adds
+struct Row {
+    glm::vec3 arm_a{};  // offset from each center of mass to the point, crossed with the direction
+    glm::vec3 arm_b{};
+    glm::vec3 angular_a{};  // world inverse inertia * arm, the spin one unit of impulse gives
+    glm::vec3 angular_b{};
+    float     mass{};
+};
+
+// Rows of each point: the normal then the two tangents
+struct PointState {
+    std::array<Row, 3> rows{};
+    float              velocity_bias{};
+};
+
+struct ConstraintState {
+    std::array<glm::vec3, 3>                     directions{};
+    std::array<PointState, Manifold::MAX_POINTS> points{};
+};
+
+// Any unit vector orthogonal to `normal`, always the same for the same normal so warm starting keeps its meaning
+glm::vec3 tangent_of(glm::vec3 normal) noexcept {
+    // sqrt(1/3): one axis is always at least that large
+    if (std::abs(normal.x) >= .57735f) {
+        return glm::normalize(glm::vec3{normal.y, -normal.x, 0.f});
+    }
+    return glm::normalize(glm::vec3{0.f, normal.z, -normal.y});
+}
+
+Row make_row(SolverBody const& a, SolverBody const& b, glm::vec3 offset_a, glm::vec3 offset_b, glm::vec3 direction) noexcept {
+    Row row{};
+    row.arm_a = glm::cross(offset_a, direction);
+    row.arm_b = glm::cross(offset_b, direction);
+    row.angular_a = a.inverse_inertia * row.arm_a;
+    row.angular_b = b.inverse_inertia * row.arm_b;
+
+    const float mass = a.inverse_mass + b.inverse_mass + glm::dot(row.arm_a, row.angular_a) + glm::dot(row.arm_b, row.angular_b);
+    row.mass = mass > 0.f ? 1.f / mass : 0.f;
+    return row;
+}
+
+// Relative velocity of the point along the row's direction, b against a
+float speed(SolverBody const& a, SolverBody const& b, Row const& row, glm::vec3 direction) noexcept {
+    return glm::dot(b.linear - a.linear, direction) + glm::dot(b.angular, row.arm_b) - glm::dot(a.angular, row.arm_a);
+}
+
+void apply(SolverBody& a, SolverBody& b, Row const& row, glm::vec3 direction, float impulse) noexcept {
+    a.linear -= direction * (impulse * a.inverse_mass);
+    a.angular -= row.angular_a * impulse;
+    b.linear += direction * (impulse * b.inverse_mass);
+    b.angular += row.angular_b * impulse;
+}
+
+} // namespace
+
+void solve_contacts(std::span<SolverBody> bodies, std::span<ContactConstraint> constraints, SolverSettings const& settings, float dt) {
+    std::vector<ConstraintState> states(constraints.size());
+
+    // Rows and target velocities, then the impulses of the previous step are applied again
+    for (std::size_t c = 0; c < constraints.size(); ++c) {
+        ContactConstraint& constraint = constraints[c];
+        ConstraintState&   state = states[c];
+        SolverBody&        a = bodies[constraint.body_a];
+        SolverBody&        b = bodies[constraint.body_b];
+
+        state.directions[0] = constraint.manifold.normal;
+        state.directions[1] = tangent_of(constraint.manifold.normal);
+        state.directions[2] = glm::cross(constraint.manifold.normal, state.directions[1]);
+
+        for (std::uint32_t p = 0; p < constraint.manifold.count; ++p) {
+            ContactPoint const& contact = constraint.manifold.points[p];
+            PointState&         point = state.points[p];
+
+            const glm::vec3 offset_a = contact.position - a.position;
+            const glm::vec3 offset_b = contact.position - b.position;
+            for (int row = 0; row < 3; ++row) {
+                point.rows[row] = make_row(a, b, offset_a, offset_b, state.directions[row]);
+            }
+
+            // Pushed apart by whichever is larger: the bounce or the penetration correction
+            const float closing = speed(a, b, point.rows[0], state.directions[0]);
+            const float bounce = closing < -settings.restitution_threshold ? -constraint.restitution * closing : 0.f;
+            const float correction = settings.baumgarte / dt * std::max(contact.penetration - settings.linear_slop, 0.f);
+            point.velocity_bias = std::max(bounce, correction);
+
+            for (int row = 0; row < 3; ++row) {
+                apply(a, b, point.rows[row], state.directions[row], constraint.impulses[p][row]);
+            }
+        }
+    }
+
+    for (std::uint32_t iteration = 0; iteration < settings.velocity_iterations; ++iteration) {
+        for (std::size_t c = 0; c < constraints.size(); ++c) {
+            ContactConstraint&     constraint = constraints[c];
+            ConstraintState const& state = states[c];
+            SolverBody&            a = bodies[constraint.body_a];
+            SolverBody&            b = bodies[constraint.body_b];
+
+            for (std::uint32_t p = 0; p < constraint.manifold.count; ++p) {
+                PointState const& point = state.points[p];
+                glm::vec3&        accumulated = constraint.impulses[p];
+
+                // Friction first, bounded by the current normal impulse (a box instead of the friction cone)
+                const float limit = constraint.friction * accumulated.x;
+                for (int row = 1; row < 3; ++row) {
+                    const float previous = accumulated[row];
+                    accumulated[row] = std::clamp(previous - point.rows[row].mass * speed(a, b, point.rows[row], state.directions[row]), -limit, limit);
+                    apply(a, b, point.rows[row], state.directions[row], accumulated[row] - previous);
+                }
+
+                // Then non-penetration, the accumulated impulse may only push
+                const float previous = accumulated.x;
+                accumulated.x = std::max(previous - point.rows[0].mass * (speed(a, b, point.rows[0], state.directions[0]) - point.velocity_bias), 0.f);
+                apply(a, b, point.rows[0], state.directions[0], accumulated.x - previous);
+            }
+        }
+    }
+}
+
+} // namespace Vulqian::Engine::Collision
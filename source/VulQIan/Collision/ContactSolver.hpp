@@ -0,0 +1,56 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include <glm/glm.hpp>
+
+#include "NarrowPhase.hpp"
+
+namespace Vulqian::Engine::Collision {
+
+// Velocity state of a body while its island is solved, a static body has no inverse mass nor inertia
+struct SolverBody {
+    glm::vec3 position{};  // center of mass
+    glm::vec3 linear{};
+    glm::vec3 angular{};
+    glm::mat3 inverse_inertia{0.f};  // world space
+    float     inverse_mass{};
+};
+
+// Contact between two bodies of the same island
+struct ContactConstraint {
+    std::uint32_t body_a{};
+    std::uint32_t body_b{};
+    Manifold      manifold{};
+    float         friction{.5f};
+    float         restitution{};
+
+    // Accumulated impulse of every point along the normal and the two tangents.
+    // Read as the starting guess (warm starting), written back with the solution.
+    std::array<glm::vec3, Manifold::MAX_POINTS> impulses{};
+};
+
+struct SolverSettings {
+    std::uint32_t velocity_iterations{8};
+
+    // Fraction of the penetration beyond linear_slop removed per step, as extra separating velocity
+    float baumgarte{.2f};
+    float linear_slop{.005f};
+
+    // Closing speeds below this do not bounce, so resting contacts stay at rest
+    float restitution_threshold{1.f};
+};
+
+// Sequential impulses over one island: every contact point is solved in turn for friction then
+// non-penetration, `velocity_iterations` times, starting from the impulses stored in the constraints.
+// Only touches the given bodies and constraints, so separate islands can be solved at the same time.
+void solve_contacts(std::span<SolverBody> bodies, std::span<ContactConstraint> constraints, SolverSettings const& settings, float dt);
+
+} // namespace Vulqian::Engine::Collision
@@ -0,0 +1,362 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "DynamicAABBTree.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace Vulqian::Engine::Collision {
+
+namespace {
+
+// Fat box of a tight box moving by `displacement`, stretched only in the direction of motion
+AABB predicted_box(AABB const& aabb, float margin, glm::vec3 displacement) {
+    AABB fat = aabb.fattened(margin);
+    for (int axis = 0; axis < 3; ++axis) {
+        if (displacement[axis] < 0.f) {
+            fat.min[axis] += displacement[axis];
+        } else {
+            fat.max[axis] += displacement[axis];
+        }
+    }
+    return fat;
+}
+
+} // namespace
+
+DynamicAABBTree::ProxyId DynamicAABBTree::allocate_node() {
+    if (this->free_list == NULL_NODE) {
+        this->nodes.emplace_back();
+        return static_cast<ProxyId>(this->nodes.size() - 1);
+    }
+
+    const ProxyId node = this->free_list;
+    this->free_list = this->nodes[node].parent;
+    this->nodes[node] = Node{};
+    return node;
+}
+
+void DynamicAABBTree::free_node(ProxyId node) {
+    this->nodes[node].parent = this->free_list;
+    this->nodes[node].height = -1;
+    this->free_list = node;
+}
+
+DynamicAABBTree::ProxyId DynamicAABBTree::create_proxy(AABB const& aabb, std::uint32_t user_data) {
+    const ProxyId proxy = this->allocate_node();
+
+    Node& node = this->nodes[proxy];
+    node.aabb = aabb.fattened(this->margin);
+    node.user_data = user_data;
+    node.height = 0;
+
+    this->insert_leaf(proxy);
+    ++this->proxy_count;
+    return proxy;
+}
+
+void DynamicAABBTree::destroy_proxy(ProxyId proxy) {
+    assert(this->nodes[proxy].is_leaf() && this->nodes[proxy].height == 0 && "not a proxy");
+
+    this->remove_leaf(proxy);
+    this->free_node(proxy);
+    --this->proxy_count;
+}
+
+bool DynamicAABBTree::move_proxy(ProxyId proxy, AABB const& aabb, glm::vec3 displacement) {
+    assert(this->nodes[proxy].is_leaf() && this->nodes[proxy].height == 0 && "not a proxy");
+
+    const AABB fat = predicted_box(aabb, this->margin, displacement);
+
+    // Still inside, unless the fat box became much larger than needed (the proxy slowed down)
+    AABB const& current = this->nodes[proxy].aabb;
+    if (current.contains(aabb) && fat.fattened(4.f * this->margin).contains(current)) {
+        return false;
+    }
+
+    this->nodes[proxy].aabb = fat;
+    ++this->enlarged_count;
+
+    // Ancestors only need to grow until one of them already covers the new box
+    for (ProxyId node = this->nodes[proxy].parent; node != NULL_NODE && !this->nodes[node].aabb.contains(fat); node = this->nodes[node].parent) {
+        this->nodes[node].aabb = AABB::merge(this->nodes[node].aabb, fat);
+    }
+    return true;
+}
+
+void DynamicAABBTree::insert_leaf(ProxyId leaf) {
+    if (this->root == NULL_NODE) {
+        this->root = leaf;
+        this->nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling that grows the total surface area the least
+    const AABB leaf_box = this->nodes[leaf].aabb;
+    ProxyId    index = this->root;
+    while (!this->nodes[index].is_leaf()) {
+        Node const& node = this->nodes[index];
+
+        const float area = node.aabb.surface_area();
+        const float combined_area = AABB::merge(node.aabb, leaf_box).surface_area();
+
+        // Pairing with this node creates a parent covering both
+        const float cost = 2.f * combined_area;
+
+        // Going further down, every ancestor still grows by this much
+        const float inheritance_cost = 2.f * (combined_area - area);
+
+        auto descend_cost = [this, &leaf_box, inheritance_cost](ProxyId child) {
+            AABB const& box = this->nodes[child].aabb;
+            const float merged = AABB::merge(box, leaf_box).surface_area();
+            return (this->nodes[child].is_leaf() ? merged : merged - box.surface_area()) + inheritance_cost;
+        };
+        const float cost1 = descend_cost(node.child1);
+        const float cost2 = descend_cost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const ProxyId sibling = index;
+    const ProxyId old_parent = this->nodes[sibling].parent;
+    const ProxyId new_parent = this->allocate_node();
+
+    Node& parent = this->nodes[new_parent];
+    parent.parent = old_parent;
+    parent.aabb = AABB::merge(leaf_box, this->nodes[sibling].aabb);
+    parent.height = this->nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+
+    if (old_parent == NULL_NODE) {
+        this->root = new_parent;
+    } else if (this->nodes[old_parent].child1 == sibling) {
+        this->nodes[old_parent].child1 = new_parent;
+    } else {
+        this->nodes[old_parent].child2 = new_parent;
+    }
+    this->nodes[sibling].parent = new_parent;
+    this->nodes[leaf].parent = new_parent;
+
+    this->fix_upwards(new_parent);
+}
+
+void DynamicAABBTree::remove_leaf(ProxyId leaf) {
+    if (leaf == this->root) {
+        this->root = NULL_NODE;
+        return;
+    }
+
+    const ProxyId parent = this->nodes[leaf].parent;
+    const ProxyId grand_parent = this->nodes[parent].parent;
+    const ProxyId sibling = this->nodes[parent].child1 == leaf ? this->nodes[parent].child2 : this->nodes[parent].child1;
+
+    // The sibling takes the place of the parent
+    this->nodes[sibling].parent = grand_parent;
+    this->free_node(parent);
+
+    if (grand_parent == NULL_NODE) {
+        this->root = sibling;
+        return;
+    }
+
+    if (this->nodes[grand_parent].child1 == parent) {
+        this->nodes[grand_parent].child1 = sibling;
+    } else {
+        this->nodes[grand_parent].child2 = sibling;
+    }
+    this->fix_upwards(grand_parent);
+}
+
+void DynamicAABBTree::fix_upwards(ProxyId index) {
+    while (index != NULL_NODE) {
+        index = this->balance(index);
+
+        Node&       node = this->nodes[index];
+        Node const& child1 = this->nodes[node.child1];
+        Node const& child2 = this->nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.aabb = AABB::merge(child1.aabb, child2.aabb);
+
+        index = node.parent;
+    }
+}
+
+// Rotates the taller child of `a` up when the heights of its children differ by more than one,
+// returns the node now at a's place
+DynamicAABBTree::ProxyId DynamicAABBTree::balance(ProxyId a) {
+    Node& node_a = this->nodes[a];
+    if (node_a.is_leaf() || node_a.height < 2) {
+        return a;
+    }
+
+    const ProxyId b = node_a.child1;
+    const ProxyId c = node_a.child2;
+    const int     difference = this->nodes[c].height - this->nodes[b].height;
+    if (difference >= -1 && difference <= 1) {
+        return a;
+    }
+
+    // `up` replaces a, a keeps `stay` and takes the shorter child of `up`, `up` keeps the taller one
+    const bool    rotate_c = difference > 1;
+    const ProxyId up = rotate_c ? c : b;
+    const ProxyId stay = rotate_c ? b : c;
+    Node&         node_up = this->nodes[up];
+
+    const ProxyId f = node_up.child1;
+    const ProxyId g = node_up.child2;
+
+    node_up.child1 = a;
+    node_up.parent = node_a.parent;
+    node_a.parent = up;
+
+    if (node_up.parent == NULL_NODE) {
+        this->root = up;
+    } else if (this->nodes[node_up.parent].child1 == a) {
+        this->nodes[node_up.parent].child1 = up;
+    } else {
+        this->nodes[node_up.parent].child2 = up;
+    }
+
+    const bool    f_taller = this->nodes[f].height > this->nodes[g].height;
+    const ProxyId kept = f_taller ? f : g;
+    const ProxyId moved = f_taller ? g : f;
+
+    node_up.child2 = kept;
+    if (rotate_c) {
+        node_a.child2 = moved;
+    } else {
+        node_a.child1 = moved;
+    }
+    this->nodes[moved].parent = a;
+
+    node_a.aabb = AABB::merge(this->nodes[stay].aabb, this->nodes[moved].aabb);
+    node_a.height = 1 + std::max(this->nodes[stay].height, this->nodes[moved].height);
+    node_up.aabb = AABB::merge(node_a.aabb, this->nodes[kept].aabb);
+    node_up.height = 1 + std::max(node_a.height, this->nodes[kept].height);
+
+    return up;
+}
+
+void DynamicAABBTree::rebuild(Jobs::ThreadPool* pool) {
+    std::vector<BuildLeaf> leaves{};
+    leaves.reserve(this->proxy_count);
+
+    // Internal nodes go back to the free list, then get handed out again as fixed slots
+    for (std::size_t i = 0; i < this->nodes.size(); ++i) {
+        Node const& node = this->nodes[i];
+        if (node.height < 0) {
+            continue;
+        }
+        if (node.is_leaf()) {
+            leaves.push_back({node.aabb.center(), static_cast<ProxyId>(i)});
+        } else {
+            this->free_node(static_cast<ProxyId>(i));
+        }
+    }
+
+    this->enlarged_count = 0;
+    this->root = NULL_NODE;
+    if (leaves.empty()) {
+        return;
+    }
+
+    // Allocated up front so the nodes never move while the subtrees are built concurrently
+    std::vector<ProxyId> slots(leaves.size() - 1);
+    for (auto& slot : slots) {
+        slot = this->allocate_node();
+    }
+
+    this->root = this->build_range({leaves, slots, pool}, 0, leaves.size(), 0);
+    this->nodes[this->root].parent = NULL_NODE;
+}
+
+// A subtree over n leaves uses the n - 1 slots from `slot`: its root takes the first one,
+// the left half the next ones and the right half the rest, so the two halves never share a slot
+// and the tree only depends on the leaves, never on how the halves were scheduled.
+DynamicAABBTree::ProxyId DynamicAABBTree::build_range(BuildContext const& context, std::size_t first, std::size_t last, std::size_t slot) {
+    if (last - first == 1) {
+        return context.leaves[first].leaf;
+    }
+
+    // Median split along the axis the box centers spread the most on
+    AABB centers{context.leaves[first].center, context.leaves[first].center};
+    for (std::size_t i = first + 1; i < last; ++i) {
+        centers.min = glm::min(centers.min, context.leaves[i].center);
+        centers.max = glm::max(centers.max, context.leaves[i].center);
+    }
+
+    const glm::vec3 spread = centers.max - centers.min;
+    const int       axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+
+    const std::size_t mid = first + (last - first) / 2;
+    std::nth_element(context.leaves.begin() + first, context.leaves.begin() + mid, context.leaves.begin() + last, [axis](BuildLeaf const& a, BuildLeaf const& b) {
+        return a.center[axis] < b.center[axis];
+    });
+
+    std::array<ProxyId, 2> children{};
+    auto                   build_half = [&](std::size_t half) {
+        children[half] = half == 0 ? this->build_range(context, first, mid, slot + 1) : this->build_range(context, mid, last, slot + (mid - first));
+    };
+
+    if (context.pool != nullptr && last - first > PARALLEL_BUILD_SIZE) {
+        Jobs::run_jobs(context.pool, 2, build_half);
+    } else {
+        build_half(0);
+        build_half(1);
+    }
+
+    const ProxyId index = context.slots[slot];
+    Node&         node = this->nodes[index];
+    node.child1 = children[0];
+    node.child2 = children[1];
+    node.aabb = AABB::merge(this->nodes[children[0]].aabb, this->nodes[children[1]].aabb);
+    node.height = 1 + std::max(this->nodes[children[0]].height, this->nodes[children[1]].height);
+    this->nodes[children[0]].parent = index;
+    this->nodes[children[1]].parent = index;
+    return index;
+}
+
+float DynamicAABBTree::get_area_ratio() const {
+    if (this->root == NULL_NODE) {
+        return 0.f;
+    }
+
+    float total = 0.f;
+    for (Node const& node : this->nodes) {
+        if (node.height >= 0) {
+            total += node.aabb.surface_area();
+        }
+    }
+    return total / this->nodes[this->root].aabb.surface_area();
+}
+
+bool DynamicAABBTree::validate() const {
+    std::size_t leaves = 0;
+
+    std::function<bool(ProxyId, ProxyId)> check = [&](ProxyId index, ProxyId parent) {
+        Node const& node = this->nodes[index];
+        if (node.parent != parent) {
+            return false;
+        }
+        if (node.is_leaf()) {
+            ++leaves;
+            return node.height == 0;
+        }
+
+        Node const& child1 = this->nodes[node.child1];
+        Node const& child2 = this->nodes[node.child2];
+        return node.height == 1 + std::max(child1.height, child2.height) && node.aabb.contains(child1.aabb) && node.aabb.contains(child2.aabb) &&
+               check(node.child1, index) && check(node.child2, index);
+    };
+
+    return (this->root == NULL_NODE || check(this->root, NULL_NODE)) && leaves == this->proxy_count;
+}
+
+} // namespace Vulqian::Engine::Collision
@@ -0,0 +1,184 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../Jobs/ThreadPool.hpp"
+#include "AABB.hpp"
+
+namespace Vulqian::Engine::Collision {
+
+// Bounding volume hierarchy over boxes that move every frame.
+// Each proxy is a leaf holding a fat box: its tight box grown by a margin and stretched along its
+// last displacement, so a proxy moving a little stays inside and costs nothing. A proxy leaving its
+// fat box gets a new one and its ancestors are grown on the way up (an O(depth) refit) instead of
+// being re-inserted. Internal boxes only grow that way, so once enough proxies were enlarged the
+// owner calls rebuild(), a top-down median split whose subtrees are built in parallel.
+// Created and destroyed proxies are inserted / removed with the surface area heuristic and AVL rotations.
+class DynamicAABBTree {
+  public:
+    using ProxyId = std::int32_t;
+
+    static constexpr ProxyId NULL_NODE = -1;
+
+    explicit DynamicAABBTree(float margin = .1f) : margin{margin} {}
+
+    ProxyId create_proxy(AABB const& aabb, std::uint32_t user_data);
+    void    destroy_proxy(ProxyId proxy);
+
+    // Returns false when `aabb` still fits in the proxy's fat box, true when the fat box was replaced
+    bool move_proxy(ProxyId proxy, AABB const& aabb, glm::vec3 displacement = {});
+
+    // Rebuilds the whole hierarchy from its leaves, proxy ids are kept
+    void rebuild(Jobs::ThreadPool* pool = nullptr);
+
+    AABB const& get_fat_aabb(ProxyId proxy) const noexcept {
+        assert(this->nodes[proxy].is_leaf() && "not a proxy");
+        return this->nodes[proxy].aabb;
+    }
+
+    std::uint32_t get_user_data(ProxyId proxy) const noexcept {
+        assert(this->nodes[proxy].is_leaf() && "not a proxy");
+        return this->nodes[proxy].user_data;
+    }
+
+    std::size_t get_proxy_count() const noexcept {
+        return this->proxy_count;
+    }
+
+    // Proxies enlarged in place since the last rebuild
+    std::size_t get_enlarged_count() const noexcept {
+        return this->enlarged_count;
+    }
+
+    std::int32_t get_height() const noexcept {
+        return this->root == NULL_NODE ? 0 : this->nodes[this->root].height;
+    }
+
+    // Sum of the surface areas of every node over the root's, the query cost grows with it
+    float get_area_ratio() const;
+
+    // Checks parent links, heights and bounds of the whole tree, for tests
+    bool validate() const;
+
+    // Calls callback(proxy) for every proxy whose fat box overlaps `box`, until the callback returns false
+    template <typename Callback>
+    void query(AABB const& box, Callback&& callback) const {
+        std::array<ProxyId, MAX_STACK> stack;
+        std::size_t                    size = 0;
+        if (this->root != NULL_NODE) {
+            stack[size++] = this->root;
+        }
+
+        while (size > 0) {
+            Node const& node = this->nodes[stack[--size]];
+            if (!node.aabb.overlaps(box)) {
+                continue;
+            }
+
+            if (node.is_leaf()) {
+                if (!callback(stack[size])) {
+                    return;
+                }
+            } else {
+                assert(size + 2 <= MAX_STACK && "tree too deep");
+                stack[size++] = node.child1;
+                stack[size++] = node.child2;
+            }
+        }
+    }
+
+    // Calls callback(proxy, entry) for every proxy whose fat box the ray enters at `entry` within its current
+    // range. The callback returns the new range: `entry` or less to clip the ray, 0 to stop, the old one to go on.
+    template <typename Callback>
+    void ray_cast(Ray const& ray, Callback&& callback) const {
+        const glm::vec3 inverse_direction = 1.f / ray.direction;
+        float           max_distance = ray.max_distance;
+
+        std::array<ProxyId, MAX_STACK> stack;
+        std::size_t                    size = 0;
+        if (this->root != NULL_NODE) {
+            stack[size++] = this->root;
+        }
+
+        while (size > 0 && max_distance > 0.f) {
+            const ProxyId index = stack[--size];
+            Node const&   node = this->nodes[index];
+
+            const float entry = ray_entry(node.aabb, ray.origin, inverse_direction, max_distance);
+            if (entry < 0.f) {
+                continue;
+            }
+
+            if (node.is_leaf()) {
+                max_distance = callback(index, entry);
+            } else {
+                assert(size + 2 <= MAX_STACK && "tree too deep");
+                stack[size++] = node.child1;
+                stack[size++] = node.child2;
+            }
+        }
+    }
+
+  private:
+    // Enough for any tree the rotations and the median rebuild produce
+    static constexpr std::size_t MAX_STACK = 256;
+
+    struct Node {
+        AABB          aabb{};
+        ProxyId       parent{NULL_NODE};  // next free node while on the free list
+        ProxyId       child1{NULL_NODE};
+        ProxyId       child2{NULL_NODE};
+        std::int32_t  height{-1};  // 0 for leaves, -1 for free nodes
+        std::uint32_t user_data{};
+
+        bool is_leaf() const noexcept {
+            return this->child1 == NULL_NODE;
+        }
+    };
+
+    ProxyId allocate_node();
+    void    free_node(ProxyId node);
+
+    void    insert_leaf(ProxyId leaf);
+    void    remove_leaf(ProxyId leaf);
+    ProxyId balance(ProxyId node);
+
+    // Walks from `node` to the root, rebalancing and refreshing boxes and heights
+    void fix_upwards(ProxyId node);
+
+    // Leaves are sorted by center during a rebuild, kept packed so the splits never chase node indices
+    struct BuildLeaf {
+        glm::vec3 center;
+        ProxyId   leaf;
+    };
+
+    struct BuildContext {
+        std::vector<BuildLeaf>&     leaves;
+        std::vector<ProxyId> const& slots;
+        Jobs::ThreadPool*           pool;
+    };
+
+    // Halves with more leaves than this are built by two jobs
+    static constexpr std::size_t PARALLEL_BUILD_SIZE = 4096;
+
+    // Builds leaves[first, last) into the internal node slots starting at `slot`, returns the subtree root
+    ProxyId build_range(BuildContext const& context, std::size_t first, std::size_t last, std::size_t slot);
+
+    float margin;
+
+    std::vector<Node> nodes{};
+    ProxyId           root{NULL_NODE};
+    ProxyId           free_list{NULL_NODE};
+    std::size_t       proxy_count{};
+    std::size_t       enlarged_count{};
+};
+
+} // namespace Vulqian::Engine::Collision
@@ -0,0 +1,314 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "NarrowPhase.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Vulqian::Engine::Collision {
+
+namespace {
+
+constexpr float EPSILON = 1e-6f;
+
+// A quad clipped by four planes has at most eight vertices
+constexpr std::size_t MAX_CLIPPED = 8;
+
+// The separating axis test prefers face axes over edge axes, and the first box's faces over the second's,
+// unless the other axis is clearly shallower. It keeps the reference face from flickering between frames.
+constexpr float RELATIVE_TOLERANCE = .95f;
+constexpr float ABSOLUTE_TOLERANCE = .01f;
+
+// The engine's +Y points down, concentric shapes are pushed apart upwards
+const glm::vec3 FALLBACK_NORMAL{0.f, -1.f, 0.f};
+
+float projected_radius(Shape const& box, glm::vec3 axis) noexcept {
+    return box.half_extents.x * std::abs(glm::dot(box.axes[0], axis)) + box.half_extents.y * std::abs(glm::dot(box.axes[1], axis)) +
+           box.half_extents.z * std::abs(glm::dot(box.axes[2], axis));
+}
+
+bool sphere_sphere(Shape const& a, Shape const& b, Manifold& manifold) {
+    const glm::vec3 offset = b.center - a.center;
+    const float     distance_squared = glm::dot(offset, offset);
+    const float     radii = a.radius + b.radius;
+    if (distance_squared > radii * radii) {
+        return false;
+    }
+
+    const float distance = std::sqrt(distance_squared);
+    const float penetration = radii - distance;
+
+    manifold.normal = distance > EPSILON ? offset / distance : FALLBACK_NORMAL;
+    manifold.points[0] = {a.center + manifold.normal * (a.radius - penetration * .5f), penetration};
+    manifold.count = 1;
+    return true;
+}
+
+// Normal from the box towards the sphere
+bool box_sphere(Shape const& box, Shape const& sphere, Manifold& manifold) {
+    const glm::vec3 local = glm::transpose(box.axes) * (sphere.center - box.center);
+    glm::vec3       surface = glm::clamp(local, -box.half_extents, box.half_extents);
+    const glm::vec3 outside = local - surface;
+    const float     distance_squared = glm::dot(outside, outside);
+    if (distance_squared > sphere.radius * sphere.radius) {
+        return false;
+    }
+
+    glm::vec3 local_normal{};
+    float     penetration;
+    if (distance_squared > EPSILON * EPSILON) {
+        const float distance = std::sqrt(distance_squared);
+        local_normal = outside / distance;
+        penetration = sphere.radius - distance;
+    } else {
+        // Center inside the box, pushed out through the closest face
+        int   axis = 0;
+        float depth = std::numeric_limits<float>::max();
+        for (int i = 0; i < 3; ++i) {
+            const float face_distance = box.half_extents[i] - std::abs(local[i]);
+            if (face_distance < depth) {
+                depth = face_distance;
+                axis = i;
+            }
+        }
+        local_normal[axis] = local[axis] < 0.f ? -1.f : 1.f;
+        surface[axis] = local_normal[axis] * box.half_extents[axis];
+        penetration = sphere.radius + depth;
+    }
+
+    manifold.normal = box.axes * local_normal;
+    const glm::vec3 box_point = box.center + box.axes * surface;
+    const glm::vec3 sphere_point = sphere.center - manifold.normal * sphere.radius;
+    manifold.points[0] = {(box_point + sphere_point) * .5f, penetration};
+    manifold.count = 1;
+    return true;
+}
+
+// Keeps the four points spanning the largest area, starting from the deepest one
+std::uint32_t reduce(std::array<ContactPoint, MAX_CLIPPED> const& points, std::uint32_t count, glm::vec3 normal, Manifold& manifold) {
+    if (count <= Manifold::MAX_POINTS) {
+        std::copy_n(points.begin(), count, manifold.points.begin());
+        return count;
+    }
+
+    // Each point picked is the best scoring one among those not picked yet
+    std::array<std::uint32_t, Manifold::MAX_POINTS> chosen{};
+    auto                                             pick = [&](std::uint32_t picked, auto&& score) {
+        std::uint32_t best = 0;
+        float         best_score = std::numeric_limits<float>::lowest();
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const float value = score(points[i]);
+            if (value > best_score && std::find(chosen.begin(), chosen.begin() + picked, i) == chosen.begin() + picked) {
+                best_score = value;
+                best = i;
+            }
+        }
+        chosen[picked] = best;
+    };
+
+    pick(0, [](ContactPoint const& point) { return point.penetration; });
+    const glm::vec3 first = points[chosen[0]].position;
+    pick(1, [&](ContactPoint const& point) { return glm::dot(point.position - first, point.position - first); });
+
+    // Largest triangles on each side of the first edge
+    const glm::vec3 edge = points[chosen[1]].position - first;
+    pick(2, [&](ContactPoint const& point) { return glm::dot(glm::cross(edge, point.position - first), normal); });
+    pick(3, [&](ContactPoint const& point) { return -glm::dot(glm::cross(edge, point.position - first), normal); });
+
+    for (std::uint32_t i = 0; i < Manifold::MAX_POINTS; ++i) {
+        manifold.points[i] = points[chosen[i]];
+    }
+    return Manifold::MAX_POINTS;
+}
+
+// Incident face of `incident` clipped against the side planes of `reference`'s face along `axis`.
+// `flip` tells the reference box is the second shape, the normal then points the other way.
+bool face_contact(Shape const& reference, Shape const& incident, int axis, bool flip, Manifold& manifold) {
+    glm::vec3 normal = reference.axes[axis];
+    if (glm::dot(incident.center - reference.center, normal) < 0.f) {
+        normal = -normal;
+    }
+
+    // The incident face is the one facing the most against the normal
+    int   incident_axis = 0;
+    float alignment = -1.f;
+    for (int i = 0; i < 3; ++i) {
+        const float value = std::abs(glm::dot(incident.axes[i], normal));
+        if (value > alignment) {
+            alignment = value;
+            incident_axis = i;
+        }
+    }
+
+    const float     side = glm::dot(incident.axes[incident_axis], normal) > 0.f ? -1.f : 1.f;
+    const glm::vec3 face = incident.center + incident.axes[incident_axis] * (side * incident.half_extents[incident_axis]);
+    const glm::vec3 u = incident.axes[(incident_axis + 1) % 3] * incident.half_extents[(incident_axis + 1) % 3];
+    const glm::vec3 v = incident.axes[(incident_axis + 2) % 3] * incident.half_extents[(incident_axis + 2) % 3];
+
+    std::array<glm::vec3, MAX_CLIPPED> polygon{face + u + v, face - u + v, face - u - v, face + u - v};
+    std::array<glm::vec3, MAX_CLIPPED> clipped{};
+    std::uint32_t                      count = 4;
+
+    // Sutherland-Hodgman against the four planes bounding the reference face
+    for (int plane = 0; plane < 4 && count > 0; ++plane) {
+        const int       side_axis = (axis + 1 + plane / 2) % 3;
+        const glm::vec3 plane_normal = reference.axes[side_axis] * (plane % 2 == 0 ? 1.f : -1.f);
+        const float     offset = glm::dot(plane_normal, reference.center) + reference.half_extents[side_axis];
+
+        std::uint32_t kept = 0;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const glm::vec3 start = polygon[i];
+            const glm::vec3 end = polygon[(i + 1) % count];
+            const float     start_distance = glm::dot(plane_normal, start) - offset;
+            const float     end_distance = glm::dot(plane_normal, end) - offset;
+
+            if (start_distance <= 0.f) {
+                clipped[kept++] = start;
+            }
+            if ((start_distance <= 0.f) != (end_distance <= 0.f) && kept < MAX_CLIPPED) {
+                clipped[kept++] = start + (end - start) * (start_distance / (start_distance - end_distance));
+            }
+        }
+        std::swap(polygon, clipped);
+        count = kept;
+    }
+
+    // Points below the reference face, moved halfway up to it
+    const float                           face_offset = glm::dot(normal, reference.center) + reference.half_extents[axis];
+    std::array<ContactPoint, MAX_CLIPPED> points{};
+    std::uint32_t                         touching = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const float separation = glm::dot(normal, polygon[i]) - face_offset;
+        if (separation <= 0.f) {
+            points[touching++] = {polygon[i] - normal * (separation * .5f), -separation};
+        }
+    }
+    if (touching == 0) {
+        return false;
+    }
+
+    manifold.normal = flip ? -normal : normal;
+    manifold.count = reduce(points, touching, normal, manifold);
+    return true;
+}
+
+// Single point halfway between the closest points of two crossing edges
+bool edge_contact(Shape const& a, Shape const& b, int edge_a, int edge_b, float separation, Manifold& manifold) {
+    glm::vec3 normal = glm::normalize(glm::cross(a.axes[edge_a], b.axes[edge_b]));
+    if (glm::dot(b.center - a.center, normal) < 0.f) {
+        normal = -normal;
+    }
+
+    // The edge of a furthest along the normal, the edge of b furthest against it
+    glm::vec3 point_a = a.center;
+    glm::vec3 point_b = b.center;
+    for (int i = 0; i < 3; ++i) {
+        if (i != edge_a) {
+            point_a += a.axes[i] * (glm::dot(a.axes[i], normal) > 0.f ? a.half_extents[i] : -a.half_extents[i]);
+        }
+        if (i != edge_b) {
+            point_b += b.axes[i] * (glm::dot(b.axes[i], normal) > 0.f ? -b.half_extents[i] : b.half_extents[i]);
+        }
+    }
+
+    // Closest points of the two lines, both directions being unit length
+    const glm::vec3 direction_a = a.axes[edge_a];
+    const glm::vec3 direction_b = b.axes[edge_b];
+    const glm::vec3 offset = point_a - point_b;
+    const float     cosine = glm::dot(direction_a, direction_b);
+    const float     denominator = std::max(1.f - cosine * cosine, EPSILON);
+    const float     along_a = glm::dot(direction_a, offset);
+    const float     along_b = glm::dot(direction_b, offset);
+
+    const float s = std::clamp((cosine * along_b - along_a) / denominator, -a.half_extents[edge_a], a.half_extents[edge_a]);
+    const float t = std::clamp((along_b - cosine * along_a) / denominator, -b.half_extents[edge_b], b.half_extents[edge_b]);
+
+    manifold.normal = normal;
+    manifold.points[0] = {(point_a + direction_a * s + point_b + direction_b * t) * .5f, -separation};
+    manifold.count = 1;
+    return true;
+}
+
+bool box_box(Shape const& a, Shape const& b, Manifold& manifold) {
+    const glm::vec3 offset = b.center - a.center;
+
+    // Separation along each candidate axis, any positive one means the boxes are apart
+    struct Axis {
+        float separation{std::numeric_limits<float>::lowest()};
+        int   first{};
+        int   second{};
+    };
+    Axis face_a{};
+    Axis face_b{};
+    Axis edge{};
+
+    for (int i = 0; i < 3; ++i) {
+        const float separation_a = std::abs(glm::dot(offset, a.axes[i])) - a.half_extents[i] - projected_radius(b, a.axes[i]);
+        const float separation_b = std::abs(glm::dot(offset, b.axes[i])) - b.half_extents[i] - projected_radius(a, b.axes[i]);
+        if (separation_a > 0.f || separation_b > 0.f) {
+            return false;
+        }
+        if (separation_a > face_a.separation) {
+            face_a = {separation_a, i, 0};
+        }
+        if (separation_b > face_b.separation) {
+            face_b = {separation_b, i, 0};
+        }
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            // Parallel edges are covered by the face axes
+            const glm::vec3 cross = glm::cross(a.axes[i], b.axes[j]);
+            const float     length = glm::length(cross);
+            if (length < 1e-3f) {
+                continue;
+            }
+
+            const glm::vec3 axis = cross / length;
+            const float     separation = std::abs(glm::dot(offset, axis)) - projected_radius(a, axis) - projected_radius(b, axis);
+            if (separation > 0.f) {
+                return false;
+            }
+            if (separation > edge.separation) {
+                edge = {separation, i, j};
+            }
+        }
+    }
+
+    const bool  use_b = face_b.separation > RELATIVE_TOLERANCE * face_a.separation + ABSOLUTE_TOLERANCE;
+    const float face_separation = use_b ? face_b.separation : face_a.separation;
+    if (edge.separation > RELATIVE_TOLERANCE * face_separation + ABSOLUTE_TOLERANCE) {
+        return edge_contact(a, b, edge.first, edge.second, edge.separation, manifold);
+    }
+    return use_b ? face_contact(b, a, face_b.first, true, manifold) : face_contact(a, b, face_a.first, false, manifold);
+}
+
+} // namespace
+
+bool collide(Shape const& a, Shape const& b, Manifold& manifold) {
+    manifold.count = 0;
+
+    if (a.type == ShapeType::Sphere && b.type == ShapeType::Sphere) {
+        return sphere_sphere(a, b, manifold);
+    }
+    if (a.type == ShapeType::Box && b.type == ShapeType::Box) {
+        return box_box(a, b, manifold);
+    }
+    if (a.type == ShapeType::Box) {
+        return box_sphere(a, b, manifold);
+    }
+
+    if (!box_sphere(b, a, manifold)) {
+        return false;
+    }
+    manifold.normal = -manifold.normal;
+    return true;
+}
+
+} // namespace Vulqian::Engine::Collision
@@ -0,0 +1,56 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "AABB.hpp"
+
+namespace Vulqian::Engine::Collision {
+
+enum class ShapeType : std::uint8_t { Sphere, Box };
+
+// Collision shape placed in the world
+struct Shape {
+    ShapeType type{ShapeType::Box};
+    glm::vec3 center{};
+    glm::mat3 axes{1.f};  // orthonormal, the box's local axes as columns
+    glm::vec3 half_extents{.5f, .5f, .5f};
+    float     radius{.5f};
+
+    AABB bounds() const noexcept {
+        const glm::vec3 extent = this->type == ShapeType::Sphere
+                                     ? glm::vec3{this->radius}
+                                     : glm::abs(this->axes[0]) * this->half_extents.x + glm::abs(this->axes[1]) * this->half_extents.y +
+                                           glm::abs(this->axes[2]) * this->half_extents.z;
+        return {this->center - extent, this->center + extent};
+    }
+};
+
+// Point halfway between the two surfaces, and how deep they overlap there
+struct ContactPoint {
+    glm::vec3 position{};
+    float     penetration{};
+};
+
+// Up to four points sharing one normal, pointing from the first shape towards the second
+struct Manifold {
+    static constexpr std::uint32_t MAX_POINTS = 4;
+
+    glm::vec3                            normal{};
+    std::array<ContactPoint, MAX_POINTS> points{};
+    std::uint32_t                        count{};
+};
+
+// Fills `manifold` and returns true when the shapes overlap.
+// Spheres give one point, boxes the incident face clipped against the reference face (reduced to
+// four points) or a single point between two crossing edges, picked by the separating axis test.
+bool collide(Shape const& a, Shape const& b, Manifold& manifold);
+
+} // namespace Vulqian::Engine::Collision
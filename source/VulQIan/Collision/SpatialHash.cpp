@@ -0,0 +1,172 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "SpatialHash.hpp"
+
+#include <bit>
+
+namespace Vulqian::Engine::Collision {
+
+namespace {
+
+// Boxes, entries and cells handled per job
+constexpr std::size_t BOX_GRAIN = 4096;
+constexpr std::size_t SORT_GRAIN = 16384;
+constexpr std::size_t CELL_GRAIN = 1024;
+
+} // namespace
+
+void SpatialHash::build(std::span<const AABB> boxes, Jobs::ThreadPool* pool) {
+    this->boxes.assign(boxes.begin(), boxes.end());
+    this->oversized.clear();
+
+    const std::size_t count = boxes.size();
+    auto              covered_cells = [this](AABB const& box) -> std::size_t {
+        if (!is_valid(box)) {
+            return 0;
+        }
+
+        const CellRange range = this->cells_of(box);
+        for (int axis = 0; axis < 3; ++axis) {
+            if (range.max[axis] - range.min[axis] >= MAX_CELLS_PER_AXIS) {
+                return 0;
+            }
+        }
+        return range.count();
+    };
+
+    // Entries of every box, then their offsets
+    std::vector<std::uint32_t> offsets(count + 1);
+    Jobs::run_jobs(pool, (count + BOX_GRAIN - 1) / BOX_GRAIN, [&](std::size_t job) {
+        for (std::size_t i = job * BOX_GRAIN; i < std::min(count, (job + 1) * BOX_GRAIN); ++i) {
+            offsets[i + 1] = static_cast<std::uint32_t>(covered_cells(boxes[i]));
+        }
+    });
+
+    this->bounds = {glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+    for (std::size_t i = 0; i < count; ++i) {
+        if (is_valid(boxes[i])) {
+            this->bounds = AABB::merge(this->bounds, boxes[i]);
+            if (offsets[i + 1] == 0) {
+                this->oversized.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        offsets[i + 1] += offsets[i];
+    }
+
+    this->entries.resize(offsets[count]);
+    Jobs::run_jobs(pool, (count + BOX_GRAIN - 1) / BOX_GRAIN, [&](std::size_t job) {
+        for (std::size_t i = job * BOX_GRAIN; i < std::min(count, (job + 1) * BOX_GRAIN); ++i) {
+            if (offsets[i] == offsets[i + 1]) {
+                continue;
+            }
+
+            const CellRange range = this->cells_of(boxes[i]);
+            std::size_t     entry = offsets[i];
+            for (std::int32_t z = range.min[2]; z <= range.max[2]; ++z) {
+                for (std::int32_t y = range.min[1]; y <= range.max[1]; ++y) {
+                    for (std::int32_t x = range.min[0]; x <= range.max[0]; ++x) {
+                        this->entries[entry++] = {pack(x, y, z), static_cast<std::uint32_t>(i)};
+                    }
+                }
+            }
+        }
+    });
+
+    // Sorted by cell then item: chunks are sorted by separate jobs and merged pairwise, level by level
+    const std::size_t entry_count = this->entries.size();
+    const std::size_t sort_jobs = std::max<std::size_t>(1, (entry_count + SORT_GRAIN - 1) / SORT_GRAIN);
+    auto              boundary = [entry_count, sort_jobs](std::size_t chunk) -> std::ptrdiff_t {
+        return static_cast<std::ptrdiff_t>(chunk * entry_count / sort_jobs);
+    };
+
+    Jobs::run_jobs(pool, sort_jobs, [&](std::size_t chunk) {
+        std::sort(this->entries.begin() + boundary(chunk), this->entries.begin() + boundary(chunk + 1));
+    });
+    for (std::size_t width = 1; width < sort_jobs; width *= 2) {
+        Jobs::run_jobs(pool, (sort_jobs + 2 * width - 1) / (2 * width), [&](std::size_t merge) {
+            const std::size_t first = 2 * merge * width;
+            const std::size_t middle = std::min(first + width, sort_jobs);
+            const std::size_t last = std::min(first + 2 * width, sort_jobs);
+            std::inplace_merge(this->entries.begin() + boundary(first), this->entries.begin() + boundary(middle), this->entries.begin() + boundary(last));
+        });
+    }
+
+    // Occupied cells, then the table finding them
+    this->cell_items.resize(entry_count);
+    this->cell_starts.clear();
+    for (std::size_t i = 0; i < entry_count; ++i) {
+        this->cell_items[i] = this->entries[i].item;
+        if (i == 0 || this->entries[i].key != this->entries[i - 1].key) {
+            this->cell_starts.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    this->cell_starts.push_back(static_cast<std::uint32_t>(entry_count));
+
+    const std::size_t cell_count = this->cell_starts.size() - 1;
+    this->table.assign(std::bit_ceil(std::max<std::size_t>(16, 2 * cell_count)), Slot{});
+
+    const std::size_t mask = this->table.size() - 1;
+    for (std::size_t cell = 0; cell < cell_count; ++cell) {
+        const std::uint64_t key = this->entries[this->cell_starts[cell]].key;
+
+        std::size_t index = hash(key) & mask;
+        while (this->table[index].key != EMPTY_KEY) {
+            index = (index + 1) & mask;
+        }
+        this->table[index] = {key, this->cell_starts[cell], this->cell_starts[cell + 1]};
+    }
+}
+
+void SpatialHash::find_pairs(std::vector<Pair>& pairs, Jobs::ThreadPool* pool) const {
+    const std::size_t cell_count = this->cell_starts.empty() ? 0 : this->cell_starts.size() - 1;
+    const std::size_t cell_jobs = (cell_count + CELL_GRAIN - 1) / CELL_GRAIN;
+
+    // One list per job, concatenated in job order so the result never depends on scheduling
+    std::vector<std::vector<Pair>> found(cell_jobs + this->oversized.size());
+
+    Jobs::run_jobs(pool, found.size(), [&](std::size_t job) {
+        std::vector<Pair>& local = found[job];
+
+        if (job >= cell_jobs) {
+            // Oversized boxes against everything, pairs between two of them are found by the lower one
+            const std::uint32_t big = this->oversized[job - cell_jobs];
+            for (std::uint32_t item = 0; item < this->boxes.size(); ++item) {
+                if (item == big || !is_valid(this->boxes[item]) || !this->boxes[item].overlaps(this->boxes[big])) {
+                    continue;
+                }
+
+                const bool item_oversized = std::binary_search(this->oversized.begin(), this->oversized.end(), item);
+                if (!item_oversized || big < item) {
+                    local.emplace_back(std::min(big, item), std::max(big, item));
+                }
+            }
+            return;
+        }
+
+        for (std::size_t cell = job * CELL_GRAIN; cell < std::min(cell_count, (job + 1) * CELL_GRAIN); ++cell) {
+            const std::uint32_t first = this->cell_starts[cell];
+            const std::uint32_t last = this->cell_starts[cell + 1];
+            const std::uint64_t key = this->entries[first].key;
+
+            // Items are sorted within the cell, so a < b
+            for (std::uint32_t i = first; i < last; ++i) {
+                AABB const& a = this->boxes[this->cell_items[i]];
+                for (std::uint32_t j = i + 1; j < last; ++j) {
+                    AABB const& b = this->boxes[this->cell_items[j]];
+                    if (a.overlaps(b) && this->cell_key(glm::max(a.min, b.min)) == key) {
+                        local.emplace_back(this->cell_items[i], this->cell_items[j]);
+                    }
+                }
+            }
+        }
+    });
+
+    for (auto const& local : found) {
+        pairs.insert(pairs.end(), local.begin(), local.end());
+    }
+}
+
+} // namespace Vulqian::Engine::Collision
@@ -0,0 +1,243 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../Jobs/ThreadPool.hpp"
+#include "AABB.hpp"
+
+namespace Vulqian::Engine::Collision {
+
+// Uniform grid over boxes of similar size, rebuilt from scratch every time.
+// Better than the tree for dense scenes where most objects move every frame: a build is a parallel
+// pass writing (cell, box) entries, a parallel chunked sort and a hash table of the occupied cells.
+// A box is listed in every cell it covers, boxes covering more than MAX_CELLS_PER_AXIS cells along
+// an axis are kept aside and tested against everything.
+// Pairs are reported by one cell only, the one holding the min corner of the two boxes' intersection,
+// so they come out deduplicated without any sorting.
+class SpatialHash {
+  public:
+    using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+    static constexpr int MAX_CELLS_PER_AXIS = 4;
+
+    explicit SpatialHash(float cell_size = 2.f) : cell_size{cell_size}, inverse_cell_size{1.f / cell_size} {
+        assert(cell_size > 0.f && "cells need a size");
+    }
+
+    // Indexes boxes[i] as item i, boxes with min > max are skipped (free slots of the owner)
+    void build(std::span<const AABB> boxes, Jobs::ThreadPool* pool = nullptr);
+
+    // Appends every overlapping pair (i, j) with i < j once
+    void find_pairs(std::vector<Pair>& pairs, Jobs::ThreadPool* pool = nullptr) const;
+
+    // Calls callback(item) once for every item overlapping `box`
+    template <typename Callback>
+    void query(AABB const& box, Callback&& callback) const {
+        const CellRange range = this->cells_of(box);
+
+        // A box spanning more cells than there are items is cheaper to test against everything
+        if (range.count() > this->boxes.size()) {
+            for (std::uint32_t item = 0; item < this->boxes.size(); ++item) {
+                if (is_valid(this->boxes[item]) && this->boxes[item].overlaps(box)) {
+                    callback(item);
+                }
+            }
+            return;
+        }
+
+        for (std::uint32_t item : this->oversized) {
+            if (this->boxes[item].overlaps(box)) {
+                callback(item);
+            }
+        }
+
+        for (std::int32_t z = range.min[2]; z <= range.max[2]; ++z) {
+            for (std::int32_t y = range.min[1]; y <= range.max[1]; ++y) {
+                for (std::int32_t x = range.min[0]; x <= range.max[0]; ++x) {
+                    const std::uint64_t key = pack(x, y, z);
+                    for (std::uint32_t item : this->items_in(key)) {
+                        // Reported by the cell holding the min corner of the overlap only
+                        AABB const& item_box = this->boxes[item];
+                        if (item_box.overlaps(box) && this->cell_key(glm::max(item_box.min, box.min)) == key) {
+                            callback(item);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Walks the cells along the ray and calls callback(item, entry) for the items it enters within its current
+    // range, once each. The callback returns the new range like DynamicAABBTree::ray_cast.
+    template <typename Callback>
+    void ray_cast(Ray const& ray, Callback&& callback) const {
+        const glm::vec3 inverse_direction = 1.f / ray.direction;
+        float           max_distance = ray.max_distance;
+
+        std::vector<std::uint32_t> visited{};
+        auto                       test = [&](std::uint32_t item) {
+            if (std::find(visited.begin(), visited.end(), item) != visited.end()) {
+                return;
+            }
+            visited.push_back(item);
+
+            const float entry = ray_entry(this->boxes[item], ray.origin, inverse_direction, max_distance);
+            if (entry >= 0.f) {
+                max_distance = callback(item, entry);
+            }
+        };
+
+        for (std::uint32_t item : this->oversized) {
+            test(item);
+        }
+
+        // Only the part of the ray inside the occupied area is walked
+        float entry = ray_entry(this->bounds, ray.origin, inverse_direction, max_distance);
+        if (entry < 0.f || this->entries.empty()) {
+            return;
+        }
+
+        // Amanatides & Woo traversal
+        const glm::vec3 start = ray.origin + ray.direction * entry;
+        std::int32_t    cell[3];
+        std::int32_t    step[3];
+        float           next[3];
+        float           delta[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            cell[axis] = this->cell_coordinate(start[axis]);
+            step[axis] = ray.direction[axis] < 0.f ? -1 : 1;
+            delta[axis] = std::abs(inverse_direction[axis]) * this->cell_size;
+
+            const float boundary = static_cast<float>(cell[axis] + (step[axis] > 0 ? 1 : 0)) * this->cell_size;
+            next[axis] = ray.direction[axis] == 0.f ? std::numeric_limits<float>::infinity() : entry + (boundary - start[axis]) * inverse_direction[axis];
+        }
+
+        // Distance at which the ray leaves the occupied area
+        float exit = max_distance;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float far = std::max((this->bounds.min[axis] - ray.origin[axis]) * inverse_direction[axis],
+                                       (this->bounds.max[axis] - ray.origin[axis]) * inverse_direction[axis]);
+            exit = far < exit ? far : exit;
+        }
+
+        while (entry <= std::min(exit, max_distance)) {
+            for (std::uint32_t item : this->items_in(pack(cell[0], cell[1], cell[2]))) {
+                test(item);
+            }
+
+            const int axis = next[0] < next[1] ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+            entry = next[axis];
+            next[axis] += delta[axis];
+            cell[axis] += step[axis];
+        }
+    }
+
+  private:
+    struct CellRange {
+        std::int32_t min[3];
+        std::int32_t max[3];
+
+        std::size_t count() const noexcept {
+            return static_cast<std::size_t>(this->max[0] - this->min[0] + 1) * static_cast<std::size_t>(this->max[1] - this->min[1] + 1) *
+                   static_cast<std::size_t>(this->max[2] - this->min[2] + 1);
+        }
+    };
+
+    struct Entry {
+        std::uint64_t key;
+        std::uint32_t item;
+
+        bool operator<(Entry const& other) const noexcept {
+            return this->key < other.key || (this->key == other.key && this->item < other.item);
+        }
+    };
+
+    // Occupied cell of the open addressing table, its items are entries[first, last)
+    struct Slot {
+        std::uint64_t key{EMPTY_KEY};
+        std::uint32_t first{};
+        std::uint32_t last{};
+    };
+
+    static constexpr std::uint64_t EMPTY_KEY = ~std::uint64_t{0};
+
+    // Cell coordinates are kept in 21 bits each, so keys are exact and never collide
+    static constexpr std::int32_t COORDINATE_LIMIT = (1 << 20) - 1;
+
+    static bool is_valid(AABB const& box) noexcept {
+        return box.min.x <= box.max.x;
+    }
+
+    static std::uint64_t pack(std::int32_t x, std::int32_t y, std::int32_t z) noexcept {
+        constexpr std::uint64_t mask = (1u << 21) - 1;
+        return ((static_cast<std::uint64_t>(x + COORDINATE_LIMIT + 1) & mask) << 42) | ((static_cast<std::uint64_t>(y + COORDINATE_LIMIT + 1) & mask) << 21) |
+               (static_cast<std::uint64_t>(z + COORDINATE_LIMIT + 1) & mask);
+    }
+
+    static std::uint64_t hash(std::uint64_t key) noexcept {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        return key;
+    }
+
+    std::int32_t cell_coordinate(float value) const noexcept {
+        const float cell = std::floor(value * this->inverse_cell_size);
+        return static_cast<std::int32_t>(std::clamp(cell, static_cast<float>(-COORDINATE_LIMIT), static_cast<float>(COORDINATE_LIMIT)));
+    }
+
+    std::uint64_t cell_key(glm::vec3 point) const noexcept {
+        return pack(this->cell_coordinate(point.x), this->cell_coordinate(point.y), this->cell_coordinate(point.z));
+    }
+
+    CellRange cells_of(AABB const& box) const noexcept {
+        CellRange range{};
+        for (int axis = 0; axis < 3; ++axis) {
+            range.min[axis] = this->cell_coordinate(box.min[axis]);
+            range.max[axis] = this->cell_coordinate(box.max[axis]);
+        }
+        return range;
+    }
+
+    std::span<const std::uint32_t> items_in(std::uint64_t key) const noexcept {
+        if (this->table.empty()) {
+            return {};
+        }
+
+        const std::size_t mask = this->table.size() - 1;
+        for (std::size_t index = hash(key) & mask;; index = (index + 1) & mask) {
+            Slot const& slot = this->table[index];
+            if (slot.key == key) {
+                return std::span<const std::uint32_t>{this->cell_items}.subspan(slot.first, slot.last - slot.first);
+            }
+            if (slot.key == EMPTY_KEY) {
+                return {};
+            }
+        }
+    }
+
+    float cell_size;
+    float inverse_cell_size;
+
+    std::vector<AABB>          boxes{};
+    AABB                       bounds{};
+    std::vector<std::uint32_t> oversized{};
+    std::vector<Entry>         entries{};
+    std::vector<std::uint32_t> cell_items{};  // item of every entry, in entry order
+    std::vector<std::uint32_t> cell_starts{}; // first entry of every occupied cell, plus the end
+    std::vector<Slot>          table{};
+};
+
+} // namespace Vulqian::Engine::Collision
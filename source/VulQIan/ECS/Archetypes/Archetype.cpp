@@ -0,0 +1,171 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Archetype.hpp"
+
+#include <algorithm>
+
+namespace Vulqian::Engine::ECS {
+
+namespace {
+std::size_t align_up(std::size_t offset, std::size_t alignment) noexcept {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+Archetype::Archetype(Signature signature, std::array<ComponentInfo, MAX_COMPONENTS> const& infos) : signature{signature} {
+    this->column_slots.fill(NO_COLUMN);
+
+    std::size_t row_size = sizeof(Entity);
+    for (ComponentType type = 0; type < MAX_COMPONENTS; ++type) {
+        if (signature.test(type)) {
+            assert(infos[type].size != 0 && "component not registered in the archetype storage");
+            assert(infos[type].alignment <= alignof(Chunk) && "component is over-aligned for a chunk");
+
+            this->column_slots[type] = static_cast<std::uint8_t>(this->columns.size());
+            this->columns.push_back(Column{type, infos[type], 0});
+            this->tick_columns.emplace_back();
+            row_size += infos[type].size;
+        }
+    }
+
+    // Entities first then one column per component, shrink the row count until the padding fits
+    for (this->capacity = CHUNK_SIZE / row_size; this->capacity > 0; --this->capacity) {
+        std::size_t offset = this->capacity * sizeof(Entity);
+        for (auto& column : this->columns) {
+            column.offset = align_up(offset, column.info.alignment);
+            offset = column.offset + this->capacity * column.info.size;
+        }
+
+        if (offset <= CHUNK_SIZE) {
+            break;
+        }
+    }
+
+    assert(this->capacity > 0 && "components are too large to fit a single row in a chunk");
+}
+
+Archetype::~Archetype() {
+    for (std::size_t chunk = 0; chunk < this->chunk_count(); ++chunk) {
+        for (auto const& column : this->columns) {
+            column.info.destroy(this->column(chunk, column.type), this->chunk_size(chunk));
+        }
+    }
+}
+
+std::size_t Archetype::allocate(Entity entity, Tick tick) {
+    if (this->count == this->chunks.size() * this->capacity) {
+        this->chunks.push_back(std::make_unique<Chunk>());
+    }
+
+    const std::size_t row = this->count++;
+    this->entities(row / this->capacity)[row % this->capacity] = entity;
+
+    for (auto& ticks : this->tick_columns) {
+        ticks.push_back(ComponentTicks{tick, tick});
+    }
+
+    return row;
+}
+
+void Archetype::destroy_components(std::size_t row, Signature const& keep) {
+    for (auto const& column : this->columns) {
+        if (!keep.test(column.type)) {
+            column.info.destroy(this->component(row, column.type), 1);
+        }
+    }
+}
+
+Entity Archetype::remove_row(std::size_t row) {
+    assert(row < this->count && "removing a row out of range");
+
+    const std::size_t last = this->count - 1;
+
+    if (row != last) {
+        // Move every column of the last row into the hole
+        for (auto const& column : this->columns) {
+            column.info.relocate(this->component(row, column.type), this->component(last, column.type), 1);
+        }
+        this->entities(row / this->capacity)[row % this->capacity] = this->entity(last);
+    }
+
+    for (auto& ticks : this->tick_columns) {
+        ticks[row] = ticks.back();
+        ticks.pop_back();
+    }
+
+    const Entity moved = this->entity(row);
+    --this->count;
+
+    // Keep a single spare chunk around so an entity bouncing on a chunk boundary does not reallocate
+    if (this->chunks.size() > this->chunk_count() + 1) {
+        this->chunks.pop_back();
+    }
+
+    return moved;
+}
+
+void Archetype::remove_rows(std::span<const std::size_t> rows) {
+    assert(std::is_sorted(rows.begin(), rows.end()) && "rows to remove must be sorted");
+    assert(rows.size() <= this->count && "removing more rows than stored");
+
+    const std::size_t remaining = this->count - rows.size();
+
+    // Rows below the new end are holes to fill, the removed rows past it are skipped
+    const std::size_t holes = static_cast<std::size_t>(std::lower_bound(rows.begin(), rows.end(), remaining) - rows.begin());
+    std::size_t       hole = 0;
+    std::size_t       skipped = holes;
+
+    for (std::size_t last = remaining; last < this->count; ++last) {
+        if (skipped < rows.size() && rows[skipped] == last) {
+            ++skipped;
+            continue;
+        }
+
+        const std::size_t row = rows[hole++];
+        for (auto const& column : this->columns) {
+            column.info.relocate(this->component(row, column.type), this->component(last, column.type), 1);
+        }
+        this->entities(row / this->capacity)[row % this->capacity] = this->entity(last);
+
+        for (auto& ticks : this->tick_columns) {
+            ticks[row] = ticks[last];
+        }
+    }
+    assert(hole == holes && "every hole below the new end is filled");
+
+    for (auto& ticks : this->tick_columns) {
+        ticks.resize(remaining);
+    }
+    this->count = remaining;
+
+    while (this->chunks.size() > this->chunk_count() + 1) {
+        this->chunks.pop_back();
+    }
+}
+
+void Archetype::relocate_from(Archetype& source, std::size_t source_row, std::size_t row, std::size_t count) {
+    for (std::size_t done = 0; done < count;) {
+        // Largest span staying inside one chunk of the source and one chunk of this archetype
+        const std::size_t span = std::min({count - done,
+                                           source.capacity - (source_row + done) % source.capacity,
+                                           this->capacity - (row + done) % this->capacity});
+
+        for (auto const& column : this->columns) {
+            if (source.has(column.type)) {
+                column.info.relocate(this->component(row + done, column.type), source.component(source_row + done, column.type), span);
+            }
+        }
+        done += span;
+    }
+
+    for (auto const& column : this->columns) {
+        if (source.has(column.type)) {
+            std::copy_n(&source.ticks(source_row, column.type), count, &this->ticks(row, column.type));
+        }
+    }
+}
+
+} // namespace Vulqian::Engine::ECS
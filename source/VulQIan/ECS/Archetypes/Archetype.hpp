@@ -0,0 +1,176 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Types.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+// Type-erased description of a component, enough to move columns around without knowing T
+struct ComponentInfo {
+    std::size_t size{};
+    std::size_t alignment{};
+
+    // Move-constructs `count` components from `source` into uninitialized `destination` and ends the lifetime of the sources
+    void (*relocate)(void* destination, void* source, std::size_t count){};
+
+    // Ends the lifetime of `count` components
+    void (*destroy)(void* components, std::size_t count){};
+
+    template <typename T>
+    static ComponentInfo of() noexcept {
+        ComponentInfo info{};
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // Plain data moves as a single block copy
+            info.relocate = [](void* destination, void* source, std::size_t count) {
+                std::memcpy(destination, source, count * sizeof(T));
+            };
+            info.destroy = [](void*, std::size_t) {};
+        } else {
+            info.relocate = [](void* destination, void* source, std::size_t count) {
+                auto* to = static_cast<T*>(destination);
+                auto* from = static_cast<T*>(source);
+                for (std::size_t i = 0; i < count; ++i) {
+                    ::new (static_cast<void*>(to + i)) T(std::move(from[i]));
+                    from[i].~T();
+                }
+            };
+            info.destroy = [](void* components, std::size_t count) {
+                auto* typed = static_cast<T*>(components);
+                for (std::size_t i = 0; i < count; ++i) {
+                    typed[i].~T();
+                }
+            };
+        }
+
+        return info;
+    }
+};
+
+// Every entity sharing a Signature lives in the same archetype.
+// Rows are packed into fixed-size chunks, and inside a chunk each component is stored
+// as its own contiguous column, so systems touching several components read linear memory.
+class Archetype {
+  public:
+    static constexpr std::size_t CHUNK_SIZE = 16 * 1024;
+
+    struct alignas(64) Chunk {
+        std::array<std::byte, CHUNK_SIZE> data;
+    };
+
+    Archetype(Signature signature, std::array<ComponentInfo, MAX_COMPONENTS> const& infos);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    Signature   get_signature() const noexcept { return this->signature; }
+    std::size_t size() const noexcept { return this->count; }
+    std::size_t chunk_capacity() const noexcept { return this->capacity; }
+    std::size_t chunk_count() const noexcept { return (this->count + this->capacity - 1) / this->capacity; }
+
+    // Rows stored in a chunk, every chunk but the last one is full
+    std::size_t chunk_size(std::size_t chunk) const noexcept {
+        return chunk + 1 < this->chunk_count() ? this->capacity : this->count - chunk * this->capacity;
+    }
+
+    bool has(ComponentType type) const noexcept { return this->signature.test(type); }
+
+    Entity* entities(std::size_t chunk) noexcept {
+        return std::launder(reinterpret_cast<Entity*>(this->chunks[chunk]->data.data()));
+    }
+
+    // Start of the column of `type` in a chunk
+    void* column(std::size_t chunk, ComponentType type) noexcept {
+        assert(this->has(type) && "archetype does not store this component");
+        return this->chunks[chunk]->data.data() + this->columns[this->column_slots[type]].offset;
+    }
+
+    template <typename T>
+    T* column(std::size_t chunk, ComponentType type) noexcept {
+        return std::launder(static_cast<T*>(this->column(chunk, type)));
+    }
+
+    // Address of one component of a row
+    void* component(std::size_t row, ComponentType type) noexcept {
+        auto const& column = this->columns[this->column_slots[type]];
+        return static_cast<std::byte*>(this->column(row / this->capacity, type)) + (row % this->capacity) * column.info.size;
+    }
+
+    // Added / changed ticks of one component of a row
+    ComponentTicks& ticks(std::size_t row, ComponentType type) noexcept {
+        assert(this->has(type) && "archetype does not store this component");
+        return this->tick_columns[this->column_slots[type]][row];
+    }
+
+    // Ticks of the rows of a chunk for one component, parallel to column(chunk, type)
+    ComponentTicks* column_ticks(std::size_t chunk, ComponentType type) noexcept {
+        assert(this->has(type) && "archetype does not store this component");
+        return this->tick_columns[this->column_slots[type]].data() + chunk * this->capacity;
+    }
+
+    Entity entity(std::size_t row) const noexcept {
+        return std::launder(reinterpret_cast<Entity const*>(this->chunks[row / this->capacity]->data.data()))[row % this->capacity];
+    }
+
+    // Appends a row whose components are left uninitialized and returns its index.
+    // Every component of the row starts as added and changed at `tick`.
+    std::size_t allocate(Entity entity, Tick tick);
+
+    // Ends the lifetime of the components of a row, except the ones listed in `keep`
+    void destroy_components(std::size_t row, Signature const& keep);
+
+    // Fills the hole left at `row` with the last row to keep the rows packed.
+    // The components of `row` must already have been destroyed or moved out.
+    // Returns the entity moved into `row`, or `row`'s own entity if it was the last one.
+    Entity remove_row(std::size_t row);
+
+    // remove_row() for several rows, sorted in increasing order. Rows past the new end fill the holes below it,
+    // so the entity found at a removed row still in range afterwards is one that was moved there.
+    void remove_rows(std::span<const std::size_t> rows);
+
+    // Moves the shared components of `count` consecutive rows of `source`, and their ticks, into uninitialized
+    // rows of this archetype. Each column moves with one relocate per span of rows sharing a chunk on both sides.
+    void relocate_from(Archetype& source, std::size_t source_row, std::size_t row, std::size_t count = 1);
+
+    // Cached archetype reached by adding / removing one component, filled lazily by the storage
+    std::array<Archetype*, MAX_COMPONENTS> add_edges{};
+    std::array<Archetype*, MAX_COMPONENTS> remove_edges{};
+
+  private:
+    struct Column {
+        ComponentType type{};
+        ComponentInfo info{};
+        std::size_t   offset{};  // byte offset of the column inside a chunk
+    };
+
+    static constexpr std::uint8_t NO_COLUMN = 0xFF;
+
+    Signature                                signature;
+    std::vector<Column>                      columns{};
+    std::array<std::uint8_t, MAX_COMPONENTS> column_slots{};  // index in `columns` per component type
+    std::vector<std::unique_ptr<Chunk>>      chunks{};
+    std::vector<std::vector<ComponentTicks>> tick_columns{};  // per column, indexed by row
+    std::size_t                              capacity{};      // rows per chunk
+    std::size_t                              count{};         // rows over all chunks
+};
+
+} // namespace Vulqian::Engine::ECS
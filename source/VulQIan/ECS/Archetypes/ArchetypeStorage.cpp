@@ -0,0 +1,192 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "ArchetypeStorage.hpp"
+
+#include <algorithm>
+
+namespace Vulqian::Engine::ECS {
+
+void ArchetypeStorage::remove_component(Entity entity, ComponentType type) {
+    assert(this->has_component(entity, type) && "removing non-existent component");
+    Location& location = this->location_of(entity);
+
+    Archetype& source = *location.archetype;
+    source.destroy_components(location.row, source.get_signature().reset(type));
+
+    if (Archetype* target = this->remove_edge(source, type); target != nullptr) {
+        this->move_entity(entity, *target);
+    } else {
+        // That was the last component, the entity no longer needs a row
+        this->release_row(location);
+    }
+}
+
+void ArchetypeStorage::entity_destroyed(Entity entity) {
+    if (!this->owns_row(entity)) {
+        return;
+    }
+
+    Location& location = this->locations[entity_index(entity)];
+    location.archetype->destroy_components(location.row, Signature{});
+    this->release_row(location);
+}
+
+void ArchetypeStorage::collect_changed(ComponentType type, Tick since, std::vector<Entity>& changed) {
+    for (auto const& archetype : this->archetypes) {
+        if (!archetype->has(type)) {
+            continue;
+        }
+
+        for (std::size_t chunk = 0; chunk < archetype->chunk_count(); ++chunk) {
+            ComponentTicks const* ticks = archetype->column_ticks(chunk, type);
+            Entity const*         entities = archetype->entities(chunk);
+
+            for (std::size_t row = 0; row < archetype->chunk_size(chunk); ++row) {
+                if (ticks[row].changed > since && ticks[row].added <= since) {
+                    changed.push_back(entities[row]);
+                }
+            }
+        }
+    }
+}
+
+Archetype& ArchetypeStorage::add_edge(Archetype* source, ComponentType type) {
+    if (source == nullptr) {
+        return this->archetype_for(Signature{}.set(type));
+    }
+
+    if (source->add_edges[type] == nullptr) {
+        Archetype& target = this->archetype_for(source->get_signature().set(type));
+        source->add_edges[type] = &target;
+        target.remove_edges[type] = source;
+    }
+
+    return *source->add_edges[type];
+}
+
+Archetype* ArchetypeStorage::remove_edge(Archetype& source, ComponentType type) {
+    const Signature signature = source.get_signature().reset(type);
+
+    if (signature.none()) {
+        return nullptr;
+    }
+
+    if (source.remove_edges[type] == nullptr) {
+        Archetype& target = this->archetype_for(signature);
+        source.remove_edges[type] = &target;
+        target.add_edges[type] = &source;
+    }
+
+    return source.remove_edges[type];
+}
+
+Archetype& ArchetypeStorage::archetype_for(Signature signature) {
+    if (auto found = this->archetype_lookup.find(signature); found != this->archetype_lookup.end()) {
+        return *found->second;
+    }
+
+    auto& archetype = this->archetypes.emplace_back(std::make_unique<Archetype>(signature, this->component_infos));
+    this->archetype_lookup.emplace(signature, archetype.get());
+
+    return *archetype;
+}
+
+std::size_t ArchetypeStorage::move_entity(Entity entity, Archetype& target, Tick tick) {
+    Location&         location = this->location_of(entity);
+    const std::size_t row = target.allocate(entity, tick);
+
+    if (location.archetype != nullptr) {
+        target.relocate_from(*location.archetype, location.row, row);
+        this->release_row(location);
+    }
+
+    location.archetype = &target;
+    location.row = row;
+
+    return row;
+}
+
+std::vector<ArchetypeStorage::Batch> ArchetypeStorage::group_by_archetype(std::span<const Entity> entities) {
+    std::vector<Batch>                          batches{};
+    std::unordered_map<Archetype*, std::size_t> batch_of{};
+
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        Archetype* source = this->location_of(entities[i]).archetype;
+
+        auto [found, inserted] = batch_of.try_emplace(source, batches.size());
+        if (inserted) {
+            batches.push_back(Batch{source, {}});
+        }
+        batches[found->second].members.push_back(i);
+    }
+
+    // Consecutive source rows then form runs that relocate together
+    for (Batch& batch : batches) {
+        if (batch.source != nullptr) {
+            std::sort(batch.members.begin(), batch.members.end(), [&](std::size_t a, std::size_t b) {
+                return this->locations[entity_index(entities[a])].row < this->locations[entity_index(entities[b])].row;
+            });
+        }
+    }
+
+    return batches;
+}
+
+std::size_t ArchetypeStorage::move_entities(std::span<const Entity> entities, Batch const& batch, Archetype& target, Tick tick) {
+    const std::size_t first = target.size();
+    for (std::size_t member : batch.members) {
+        target.allocate(entities[member], tick);
+    }
+
+    if (batch.source != nullptr) {
+        std::vector<std::size_t> rows{};
+        rows.reserve(batch.members.size());
+        for (std::size_t member : batch.members) {
+            rows.push_back(this->locations[entity_index(entities[member])].row);
+        }
+
+        for (std::size_t begin = 0; begin < rows.size();) {
+            std::size_t end = begin + 1;
+            while (end < rows.size() && rows[end] == rows[end - 1] + 1) {
+                ++end;
+            }
+
+            target.relocate_from(*batch.source, rows[begin], first + begin, end - begin);
+            begin = end;
+        }
+
+        // Rows of the source that were moved into the holes
+        batch.source->remove_rows(rows);
+        for (std::size_t row : rows) {
+            if (row >= batch.source->size()) {
+                break;
+            }
+            this->locations[entity_index(batch.source->entity(row))].row = row;
+        }
+    }
+
+    for (std::size_t i = 0; i < batch.members.size(); ++i) {
+        Location& location = this->locations[entity_index(entities[batch.members[i]])];
+        location.archetype = &target;
+        location.row = first + i;
+    }
+
+    return first;
+}
+
+void ArchetypeStorage::release_row(Location& location) {
+    const Entity moved = location.archetype->remove_row(location.row);
+
+    // The last row of the archetype was moved into the hole
+    if (Location& moved_location = this->locations[entity_index(moved)]; &moved_location != &location) {
+        moved_location.row = location.row;
+    }
+
+    location.archetype = nullptr;
+    location.row = 0;
+}
+
+} // namespace Vulqian::Engine::ECS
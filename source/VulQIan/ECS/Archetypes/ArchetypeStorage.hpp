@@ -0,0 +1,266 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../Types.hpp"
+#include "Archetype.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+// Component storage grouping entities by archetype, used instead of the per-type
+// component arrays when the Coordinator is initialized with StorageMode::Archetype.
+// Components are addressed by their signature bit, the Coordinator resolves it from T.
+class ArchetypeStorage {
+  public:
+    ArchetypeStorage() = default;
+
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+    template <typename T>
+    void register_component(ComponentType type) {
+        this->component_infos[type] = ComponentInfo::of<T>();
+    }
+
+    template <typename T>
+    void add_component(Entity entity, ComponentType type, T component, Tick tick = 0) {
+        Location& location = this->location_of(entity);
+        assert((location.archetype == nullptr || !location.archetype->has(type)) && "component added to same entity more than once");
+
+        Archetype&        target = this->add_edge(location.archetype, type);
+        const std::size_t row = this->move_entity(entity, target, tick);
+
+        ::new (target.component(row, type)) T(std::move(component));
+        target.ticks(row, type) = ComponentTicks{tick, tick};
+    }
+
+    // Entities sharing an archetype move together through its add edge, one relocate per column
+    template <typename T>
+    void add_components(std::span<const Entity> entities, ComponentType type, std::span<const T> components, Tick tick = 0) {
+        assert(entities.size() == components.size() && "one component is needed per entity");
+
+        for (Batch const& batch : this->group_by_archetype(entities)) {
+            assert((batch.source == nullptr || !batch.source->has(type)) && "component added to same entity more than once");
+
+            Archetype&        target = this->add_edge(batch.source, type);
+            const std::size_t first = this->move_entities(entities, batch, target, tick);
+
+            for (std::size_t i = 0; i < batch.members.size(); ++i) {
+                ::new (target.component(first + i, type)) T(components[batch.members[i]]);
+            }
+        }
+    }
+
+    // Rows for entities owning no component yet, all placed in the archetype of `types`
+    // and filled with copies of the prototypes
+    template <typename... Ts>
+    void spawn(std::span<const Entity> entities, Tick tick, std::array<ComponentType, sizeof...(Ts)> const& types, Ts const&... prototypes) {
+        Signature signature{};
+        for (ComponentType type : types) {
+            signature.set(type);
+        }
+        Archetype& archetype = this->archetype_for(signature);
+
+        for (Entity entity : entities) {
+            Location& location = this->location_of(entity);
+            assert(location.archetype == nullptr && "spawning an entity that already owns components");
+
+            location.archetype = &archetype;
+            location.row = archetype.allocate(entity, tick);
+            this->construct_row(archetype, location.row, types, std::index_sequence_for<Ts...>{}, prototypes...);
+        }
+    }
+
+    void remove_component(Entity entity, ComponentType type);
+
+    template <typename T>
+    T& get_component(Entity entity, ComponentType type) {
+        Location const& location = this->locations[entity_index(entity)];
+        assert(this->has_component(entity, type) && "retrieving non-existent component");
+
+        return *std::launder(static_cast<T*>(location.archetype->component(location.row, type)));
+    }
+
+    ComponentTicks& get_ticks(Entity entity, ComponentType type) {
+        Location const& location = this->locations[entity_index(entity)];
+        assert(this->has_component(entity, type) && "retrieving ticks of a non-existent component");
+
+        return location.archetype->ticks(location.row, type);
+    }
+
+    bool has_component(Entity entity, ComponentType type) const noexcept {
+        return this->owns_row(entity) && this->locations[entity_index(entity)].archetype->has(type);
+    }
+
+    void entity_destroyed(Entity entity);
+
+    // Calls fn(entity, components...) or fn(components...) for every entity whose archetype
+    // holds all of `types` and none of `excluded`. Chunks are walked column by column.
+    // The mutable components of Ts are stamped as changed at `tick`.
+    template <typename... Ts, typename Function>
+    void each(Function&& fn, std::array<ComponentType, sizeof...(Ts)> const& types, Signature const& excluded, Tick tick = 0) {
+        const Signature required = signature_of(types);
+
+        for (auto const& archetype : this->archetypes) {
+            if (!matches(archetype->get_signature(), required, excluded)) {
+                continue;
+            }
+
+            for (std::size_t chunk = 0; chunk < archetype->chunk_count(); ++chunk) {
+                each_in_chunk<Ts...>(fn, *archetype, chunk, types, tick, std::index_sequence_for<Ts...>{});
+            }
+        }
+    }
+
+    struct ChunkRef {
+        Archetype*  archetype{nullptr};
+        std::size_t chunk{};
+    };
+
+    // Every non-empty chunk an each() with the same arguments would visit, in the same order
+    template <std::size_t N>
+    std::vector<ChunkRef> matching_chunks(std::array<ComponentType, N> const& types, Signature const& excluded) const {
+        const Signature required = signature_of(types);
+
+        std::vector<ChunkRef> chunks{};
+        for (auto const& archetype : this->archetypes) {
+            if (matches(archetype->get_signature(), required, excluded)) {
+                for (std::size_t chunk = 0; chunk < archetype->chunk_count(); ++chunk) {
+                    chunks.push_back(ChunkRef{archetype.get(), chunk});
+                }
+            }
+        }
+
+        return chunks;
+    }
+
+    // each() restricted to a single chunk, used to split the work between threads
+    template <typename... Ts, typename Function>
+    static void each_in(Function& fn, ChunkRef const& chunk, std::array<ComponentType, sizeof...(Ts)> const& types, Tick tick = 0) {
+        each_in_chunk<Ts...>(fn, *chunk.archetype, chunk.chunk, types, tick, std::index_sequence_for<Ts...>{});
+    }
+
+    // Appends every entity whose `type` component changed after `since` but was added at or before it
+    void collect_changed(ComponentType type, Tick since, std::vector<Entity>& changed);
+
+    // Archetypes in creation order
+    std::vector<std::unique_ptr<Archetype>> const& get_archetypes() const noexcept { return this->archetypes; }
+
+  private:
+    struct Location {
+        Archetype*  archetype{nullptr};  // null while the entity owns no component
+        std::size_t row{};
+    };
+
+    template <std::size_t N>
+    static Signature signature_of(std::array<ComponentType, N> const& types) noexcept {
+        Signature signature{};
+        for (ComponentType type : types) {
+            signature.set(type);
+        }
+        return signature;
+    }
+
+    static bool matches(Signature const& signature, Signature const& required, Signature const& excluded) noexcept {
+        return (signature & required) == required && (signature & excluded).none();
+    }
+
+    template <typename... Ts, typename Function, std::size_t... Is>
+    static void each_in_chunk(Function& fn, Archetype& archetype, std::size_t chunk, std::array<ComponentType, sizeof...(Ts)> const& types, Tick tick, std::index_sequence<Is...> /*indices*/) {
+        const std::size_t rows = archetype.chunk_size(chunk);
+        Entity const*     entities = archetype.entities(chunk);
+        const auto        columns = std::tuple{archetype.column<std::remove_const_t<Ts>>(chunk, types[Is])...};
+
+        // Every row of the chunk hands out its mutable components, stamp them column by column
+        ([&] {
+            if constexpr (!std::is_const_v<Ts>) {
+                ComponentTicks* ticks = archetype.column_ticks(chunk, types[Is]);
+                for (std::size_t row = 0; row < rows; ++row) {
+                    ticks[row].changed = tick;
+                }
+            }
+        }(),
+         ...);
+
+        for (std::size_t row = 0; row < rows; ++row) {
+            if constexpr (std::is_invocable_v<Function&, Entity, Ts&...>) {
+                fn(entities[row], static_cast<Ts&>(std::get<Is>(columns)[row])...);
+            } else {
+                fn(static_cast<Ts&>(std::get<Is>(columns)[row])...);
+            }
+        }
+    }
+
+    template <typename... Ts, std::size_t... Is>
+    static void construct_row(Archetype& archetype, std::size_t row, std::array<ComponentType, sizeof...(Ts)> const& types, std::index_sequence<Is...> /*indices*/, Ts const&... prototypes) {
+        (::new (archetype.component(row, types[Is])) Ts(prototypes), ...);
+    }
+
+    Location& location_of(Entity entity) {
+        const std::uint32_t index = entity_index(entity);
+        if (index >= this->locations.size()) {
+            this->locations.resize(static_cast<std::size_t>(index) + 1);
+        }
+        return this->locations[index];
+    }
+
+    // The row stores the full handle, a stale handle sharing its index does not own it
+    bool owns_row(Entity entity) const noexcept {
+        const std::uint32_t index = entity_index(entity);
+        return index < this->locations.size() && this->locations[index].archetype != nullptr &&
+               this->locations[index].archetype->entity(this->locations[index].row) == entity;
+    }
+
+    // Archetype of `source` plus / minus one component, cached on the source archetype
+    Archetype& add_edge(Archetype* source, ComponentType type);
+    Archetype* remove_edge(Archetype& source, ComponentType type);
+
+    Archetype& archetype_for(Signature signature);
+
+    // Moves an entity's shared components to a new row of `target` and returns that row.
+    // Components `target` does not hold must have been destroyed beforehand.
+    std::size_t move_entity(Entity entity, Archetype& target, Tick tick = 0);
+
+    // Entities of a bulk operation currently in the same archetype
+    struct Batch {
+        Archetype*               source{nullptr};
+        std::vector<std::size_t> members{};  // positions in the entity span, sorted by row in `source`
+    };
+
+    // Batches in order of first appearance, so the resulting rows only depend on the input
+    std::vector<Batch> group_by_archetype(std::span<const Entity> entities);
+
+    // move_entity() for a whole batch, whose entities land in consecutive rows of `target` in member order.
+    // Returns the first of these rows.
+    std::size_t move_entities(std::span<const Entity> entities, Batch const& batch, Archetype& target, Tick tick);
+
+    // Removes the entity's row from its archetype and patches the entity moved into it
+    void release_row(Location& location);
+
+    // Type-erased operations of each component, indexed by signature bit
+    std::array<ComponentInfo, MAX_COMPONENTS> component_infos{};
+
+    std::vector<std::unique_ptr<Archetype>>   archetypes{};
+    std::unordered_map<Signature, Archetype*> archetype_lookup{};
+
+    // Where each entity's row lives, indexed by entity index
+    std::vector<Location> locations{};
+};
+
+} // namespace Vulqian::Engine::ECS
@@ -0,0 +1,90 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "CommandBuffer.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+CommandBuffer::CommandBuffer(CommandBuffer&& other) noexcept
+    : commands{std::exchange(other.commands, {})},
+      destroyed{std::exchange(other.destroyed, {})},
+      created{std::exchange(other.created, {})},
+      blocks{std::exchange(other.blocks, {})},
+      current_block{std::exchange(other.current_block, 0)},
+      block_offset{std::exchange(other.block_offset, 0)},
+      large_payloads{std::exchange(other.large_payloads, {})} {}
+
+CommandBuffer& CommandBuffer::operator=(CommandBuffer&& other) noexcept {
+    if (this != &other) {
+        this->clear();
+
+        this->commands = std::exchange(other.commands, {});
+        this->destroyed = std::exchange(other.destroyed, {});
+        this->created = std::exchange(other.created, {});
+        this->blocks = std::exchange(other.blocks, {});
+        this->current_block = std::exchange(other.current_block, 0);
+        this->block_offset = std::exchange(other.block_offset, 0);
+        this->large_payloads = std::exchange(other.large_payloads, {});
+    }
+    return *this;
+}
+
+CommandBuffer::~CommandBuffer() {
+    this->clear();
+}
+
+Entity CommandBuffer::create_entity() {
+    assert(this->created.size() < ENTITY_INDEX_MASK && "too many entities created in one command buffer");
+
+    const auto index = static_cast<std::uint32_t>(this->created.size());
+    this->created.push_back(NULL_ENTITY);
+
+    return make_entity(index, PENDING_ENTITY_VERSION);
+}
+
+void CommandBuffer::destroy_entity(Entity entity) {
+    this->destroyed.push_back(entity);
+}
+
+void CommandBuffer::clear() {
+    for (auto const& command : this->commands) {
+        if (command.destroy != nullptr) {
+            command.destroy(command.payload);
+        }
+    }
+
+    this->commands.clear();
+    this->destroyed.clear();
+    this->created.clear();
+    this->large_payloads.clear();
+    this->current_block = 0;
+    this->block_offset = 0;
+}
+
+void* CommandBuffer::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && "over-aligned components can not be recorded");
+
+    if (size > BLOCK_SIZE) {
+        return this->large_payloads.emplace_back(std::make_unique<std::byte[]>(size)).get();
+    }
+
+    std::size_t offset = (this->block_offset + alignment - 1) / alignment * alignment;
+
+    if (this->current_block == this->blocks.size() || offset + size > BLOCK_SIZE) {
+        // Move on to the next block, reusing the ones allocated by previous frames
+        if (this->current_block < this->blocks.size()) {
+            ++this->current_block;
+        }
+        if (this->current_block == this->blocks.size()) {
+            this->blocks.push_back(std::make_unique<std::byte[]>(BLOCK_SIZE));
+        }
+        offset = 0;
+    }
+
+    this->block_offset = offset + size;
+    return this->blocks[this->current_block].get() + offset;
+}
+
+} // namespace Vulqian::Engine::ECS
@@ -0,0 +1,134 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "../TypeIndex.hpp"
+#include "../Types.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+class Coordinator;
+
+// Records structural changes (create / destroy / add / remove) to apply later with Coordinator::flush.
+// A buffer is meant to be owned by a single thread: recording never touches shared state and takes no lock,
+// so workers can each fill their own buffer while systems iterate the world.
+// Entities created through a buffer get a pending handle, only valid inside that same buffer until the flush.
+class CommandBuffer {
+  public:
+    CommandBuffer() = default;
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    CommandBuffer(CommandBuffer&& other) noexcept;
+    // Destroys the components still recorded here before taking over the other buffer's
+    CommandBuffer& operator=(CommandBuffer&& other) noexcept;
+
+    // Pending handle, resolved to the real entity when the buffer is flushed
+    Entity create_entity();
+
+    // Applied after every component command of the flush, an entity destroyed in a flush ignores its other commands
+    void destroy_entity(Entity entity);
+
+    // Adds the component, or replaces it if the entity already owns one when the command is applied
+    template <typename T>
+    void add_component(Entity entity, T component) {
+        void* payload = this->allocate(sizeof(T), alignof(T));
+        ::new (payload) T(std::move(component));
+
+        this->commands.push_back(Command{
+            TypeIndex<ComponentFamily>::of<T>(),
+            entity,
+            payload,
+            &CommandBuffer::apply_add<Coordinator, T>,
+            [](void* component) { static_cast<T*>(component)->~T(); }});
+    }
+
+    // Ignored if the entity does not own the component when the command is applied
+    template <typename T>
+    void remove_component(Entity entity) {
+        this->commands.push_back(Command{
+            TypeIndex<ComponentFamily>::of<T>(),
+            entity,
+            nullptr,
+            &CommandBuffer::apply_remove<Coordinator, T>,
+            nullptr});
+    }
+
+    bool empty() const noexcept { return this->commands.empty() && this->destroyed.empty() && this->created.empty(); }
+
+    // Drops every recorded command, done by the Coordinator once the buffer was flushed
+    void clear();
+
+  private:
+    friend class Coordinator;
+
+    struct Command {
+        std::size_t type_index{};  // static type index of the component, commands are applied grouped by it
+        Entity      entity{};
+        void*       payload{nullptr};
+
+        void (*apply)(Coordinator& coordinator, Entity entity, void* payload){};
+        void (*destroy)(void* payload){};
+    };
+
+    static constexpr std::size_t BLOCK_SIZE = 16 * 1024;
+
+    // Templated on the coordinator type so the body is only compiled where Coordinator is complete
+    template <typename World, typename T>
+    static void apply_add(World& world, Entity entity, void* payload) {
+        auto& component = *std::launder(static_cast<T*>(payload));
+
+        if (world.template has_component<T>(entity)) {
+            world.template get_component<T>(entity) = std::move(component);
+        } else {
+            world.template store_component<T>(entity, std::move(component));
+        }
+    }
+
+    template <typename World, typename T>
+    static void apply_remove(World& world, Entity entity, void* /*payload*/) {
+        if (world.template has_component<T>(entity)) {
+            world.template erase_component<T>(entity);
+        }
+    }
+
+    // Real handle of a pending entity of this buffer, other handles are returned as is
+    Entity resolve(Entity entity) const noexcept {
+        if (entity_version(entity) != PENDING_ENTITY_VERSION) {
+            return entity;
+        }
+
+        assert(entity_index(entity) < this->created.size() && "pending entity recorded by another command buffer");
+        return this->created[entity_index(entity)];
+    }
+
+    // Storage for the recorded components, blocks are kept between flushes and never move
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    std::vector<Command> commands{};
+    std::vector<Entity>  destroyed{};
+
+    // Real handles of the entities created through this buffer, filled during the flush
+    std::vector<Entity> created{};
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks{};
+    std::size_t                               current_block{};
+    std::size_t                               block_offset{};
+
+    // Components too large for a block get their own allocation
+    std::vector<std::unique_ptr<std::byte[]>> large_payloads{};
+};
+
+} // namespace Vulqian::Engine::ECS
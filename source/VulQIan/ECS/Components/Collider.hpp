@@ -0,0 +1,40 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace Vulqian::Engine::ECS::Components {
+
+enum class ColliderShape : std::uint8_t { Sphere, Box };
+
+// Collision shape of an entity, in its local space: centered on its Transform_TB_YXZ translation,
+// rotated and scaled with it. A sphere under a non-uniform scale is bounded by its largest axis.
+struct Collider {
+    ColliderShape shape{ColliderShape::Box};
+    glm::vec3     half_extents{.5f, .5f, .5f};  // Box
+    float         radius{.5f};                  // Sphere
+
+    // Surface material for Systems::Physics contacts, combined as sqrt(a * b) and max(a, b)
+    float friction{.5f};
+    float restitution{0.f};
+
+    // Half size of the world aligned box around the shape, `basis` being the transform's rotation * scale
+    glm::vec3 world_half_extents(glm::mat3 const& basis) const noexcept {
+        if (this->shape == ColliderShape::Sphere) {
+            const float scale = std::max({glm::length(basis[0]), glm::length(basis[1]), glm::length(basis[2])});
+            return glm::vec3{this->radius * scale};
+        }
+
+        // Each world axis takes the absolute projection of the three box axes
+        return glm::abs(basis[0]) * this->half_extents.x + glm::abs(basis[1]) * this->half_extents.y + glm::abs(basis[2]) * this->half_extents.z;
+    }
+};
+
+} // namespace Vulqian::Engine::ECS::Components
@@ -5,10 +5,12 @@
 
 #pragma once
 
-#include <array>
 #include <cassert>
-#include <unordered_map>
+#include <span>
+#include <utility>
+#include <vector>
 
+#include "../Entities/SparseSet.hpp"
 #include "../Types.hpp"
 
 namespace Vulqian::Engine::ECS {
@@ -17,70 +19,111 @@ class IComponentArray {
   public:
     virtual ~IComponentArray() = default;
     virtual void entity_destroyed(Entity entity) = 0;
+
+    // Membership does not depend on the component type, so it can be tested without a virtual call
+    bool                    contains(Entity entity) const noexcept { return this->entity_set.contains(entity); }
+    std::size_t             size() const noexcept { return this->entity_set.size(); }
+    std::span<const Entity> entities() const noexcept { return this->entity_set.entities(); }
+
+    // Position of the entity's component in the packed arrays
+    std::size_t index_of(Entity entity) const noexcept { return this->entity_set.index_of(entity); }
+
+    // index_of() for an entity that may not own the component, SparseSet::NOT_FOUND if it does not
+    std::size_t find(Entity entity) const noexcept { return this->entity_set.find(entity); }
+
+    ComponentTicks&       ticks_at(std::size_t index) noexcept { return this->tick_array[index]; }
+    ComponentTicks const& ticks_at(std::size_t index) const noexcept { return this->tick_array[index]; }
+    ComponentTicks const& ticks(Entity entity) const noexcept { return this->tick_array[this->entity_set.index_of(entity)]; }
+
+    // Ticks of every component, index i belongs to entities()[i]
+    std::span<const ComponentTicks> component_ticks() const noexcept { return this->tick_array; }
+
+  protected:
+    // Dense entity array and paged sparse index, kept parallel to the packed components
+    SparseSet entity_set{};
+
+    // Added / changed ticks, parallel to the packed components
+    std::vector<ComponentTicks> tick_array{};
 };
 
 template <typename T>
 class ComponentArray : public IComponentArray {
   public:
-    void insert_data(Entity entity, T component) {
-        assert(this->entity_to_index_map.find(entity) == this->entity_to_index_map.end() && "component added to same entity more than once");
-
-        // Put new entry at end and update the maps
-        size_t newIndex = this->size;
-        this->entity_to_index_map[entity] = newIndex;
-        this->index_to_entity_map[newIndex] = entity;
-        this->component_array[newIndex] = component;
-        ++this->size;
+    // `tick` is recorded as both the added and the changed tick of the new components
+    void insert_data(Entity entity, T component, Tick tick = 0) {
+        assert(!this->entity_set.contains(entity) && "component added to same entity more than once");
+
+        // Put new entry at end, the sparse set records where it went
+        this->entity_set.insert(entity);
+        this->component_array.push_back(std::move(component));
+        this->tick_array.push_back(ComponentTicks{tick, tick});
     }
 
-    void remove_data(Entity entity) {
-        assert(this->entity_to_index_map.find(entity) != this->entity_to_index_map.end() && "removing non-existent component");
+    // Appends one component per entity, the components are copied as one contiguous block
+    void insert_data(std::span<const Entity> entities, std::span<const T> components, Tick tick = 0) {
+        assert(entities.size() == components.size() && "one component is needed per entity");
 
-        // Copy element at end into deleted element's place to maintain density
-        size_t indexOfRemovedEntity = this->entity_to_index_map[entity];
-        size_t indexOfLastElement = this->size - 1;
-        this->component_array[indexOfRemovedEntity] = this->component_array[indexOfLastElement];
+        this->insert_entities(entities, tick);
+        this->component_array.insert(this->component_array.end(), components.begin(), components.end());
+    }
 
-        // Update map to point to moved spot
-        Entity entityOfLastElement = this->index_to_entity_map[indexOfLastElement];
-        this->entity_to_index_map[entityOfLastElement] = indexOfRemovedEntity;
-        this->index_to_entity_map[indexOfRemovedEntity] = entityOfLastElement;
+    // Appends a copy of the prototype for every entity
+    void insert_copies(std::span<const Entity> entities, T const& prototype, Tick tick = 0) {
+        this->insert_entities(entities, tick);
+        this->component_array.insert(this->component_array.end(), entities.size(), prototype);
+    }
 
-        this->entity_to_index_map.erase(entity);
-        this->index_to_entity_map.erase(indexOfLastElement);
+    void remove_data(Entity entity) {
+        assert(this->entity_set.contains(entity) && "removing non-existent component");
 
-        --this->size;
+        // Move element at end into deleted element's place to maintain density
+        const std::size_t index_of_removed_entity = this->entity_set.erase(entity);
+
+        if (index_of_removed_entity != this->component_array.size() - 1) {
+            this->component_array[index_of_removed_entity] = std::move(this->component_array.back());
+            this->tick_array[index_of_removed_entity] = this->tick_array.back();
+        }
+        this->component_array.pop_back();
+        this->tick_array.pop_back();
     }
 
     void entity_destroyed(Entity entity) override {
-        if (this->entity_to_index_map.find(entity) != this->entity_to_index_map.end()) {
+        if (this->entity_set.contains(entity)) {
             // Remove the entity's component if it existed
             this->remove_data(entity);
         }
     }
 
     T& get_data(Entity entity) {
-        assert(this->entity_to_index_map.find(entity) != this->entity_to_index_map.end() && "Retrieving non-existent component.");
-
         // Return a reference to the entity's component
-        return this->component_array[this->entity_to_index_map[entity]];
+        return this->component_array[this->entity_set.index_of(entity)];
     }
 
-  private:
-    // The packed array of components (of generic type T),
-    // set to a specified maximum amount, matching the maximum number
-    // of entities allowed to exist simultaneously, so that each entity
-    // has a unique spot.
-    std::array<T, MAX_ENTITIES> component_array;
+    T& data_at(std::size_t index) noexcept { return this->component_array[index]; }
+
+    void reserve(std::size_t capacity) {
+        this->entity_set.reserve(capacity);
+        this->component_array.reserve(capacity);
+        this->tick_array.reserve(capacity);
+    }
+
+    // Packed components, index i belongs to entities()[i]
+    std::span<T>       components() noexcept { return this->component_array; }
+    std::span<const T> components() const noexcept { return this->component_array; }
 
-    // Map from an entity ID to an array index.
-    std::unordered_map<Entity, size_t> entity_to_index_map;
+  private:
+    void insert_entities(std::span<const Entity> entities, Tick tick) {
+        this->reserve(this->component_array.size() + entities.size());
 
-    // Map from an array index to an entity ID.
-    std::unordered_map<size_t, Entity> index_to_entity_map;
+        for (Entity entity : entities) {
+            this->entity_set.insert(entity);
+        }
+        this->tick_array.insert(this->tick_array.end(), entities.size(), ComponentTicks{tick, tick});
+    }
 
-    // Total size of valid entries in the array.
-    size_t size;
+    // The packed array of components (of generic type T), grown on demand
+    // so the amount of entities is no longer capped at compile time.
+    std::vector<T> component_array{};
 };
 
 } // namespace Vulqian::Engine::ECS
@@ -5,15 +5,21 @@
 
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <memory>
-#include <unordered_map>
+#include <span>
+#include <vector>
 
+#include "../TypeIndex.hpp"
 #include "../Types.hpp"
 #include "ComponentArray.hpp"
+#include "Collider.hpp"
+#include "Hierarchy.hpp"
 #include "Transform.hpp"
 #include "Mesh.hpp"
 #include "PointLight.hpp"
+#include "RigidBody.hpp"
 #include "Transparency.hpp"
 
 namespace Vulqian::Engine::ECS {
@@ -22,75 +28,110 @@ class ComponentManager {
   public:
     template <typename T>
     void register_component() {
-        const char* type_name = typeid(T).name();
+        const std::size_t type_index = TypeIndex<ComponentFamily>::of<T>();
 
-        assert(component_types.find(type_name) == component_types.end() && "Registering component type more than once.");
+        assert(!this->is_registered(type_index) && "Registering component type more than once.");
+        assert(this->next_component_type < MAX_COMPONENTS && "Too many component types registered.");
 
-        // Add this component type to the component type map
-        component_types.insert({type_name, this->next_component_type});
+        if (type_index >= this->component_types.size()) {
+            this->component_types.resize(type_index + 1, INVALID_COMPONENT_TYPE);
+            this->component_arrays.resize(type_index + 1);
+        }
+
+        // Add this component type to the component type table
+        this->component_types[type_index] = this->next_component_type;
 
-        // Create a ComponentArray pointer and add it to the component arrays map
-        this->component_arrays.insert({type_name, std::make_shared<ComponentArray<T>>()});
+        // Create a ComponentArray and store it at the index of its type
+        this->component_arrays[type_index] = std::make_unique<ComponentArray<T>>();
+        this->arrays_by_type[this->next_component_type] = this->component_arrays[type_index].get();
 
         // Increment the value so that the next component registered will be different
         ++this->next_component_type;
     }
 
     template <typename T>
-    ComponentType get_component_type() {
-        const char* type_name = typeid(T).name();
+    ComponentType get_component_type() const {
+        const std::size_t type_index = TypeIndex<ComponentFamily>::of<T>();
 
-        assert(component_types.find(type_name) != component_types.end() && "Component not registered before use.");
+        assert(this->is_registered(type_index) && "Component not registered before use.");
 
         // Return this component's type - used for creating signatures
-        return component_types[type_name];
+        return this->component_types[type_index];
     }
 
     template <typename T>
-    void add_component(Entity entity, T component) {
+    void add_component(Entity entity, T component, Tick tick = 0) {
         // Add a component to the array for an entity
-        this->get_component_array<T>()->insert_data(entity, component);
+        this->get_component_array<T>().insert_data(entity, std::move(component), tick);
+    }
+
+    template <typename T>
+    void add_components(std::span<const Entity> entities, std::span<const T> components, Tick tick = 0) {
+        this->get_component_array<T>().insert_data(entities, components, tick);
+    }
+
+    template <typename T>
+    void add_components(std::span<const Entity> entities, T const& prototype, Tick tick = 0) {
+        this->get_component_array<T>().insert_copies(entities, prototype, tick);
     }
 
     template <typename T>
     void remove_component(Entity entity) {
         // Remove a component from the array for an entity
-        this->get_component_array<T>()->remove_data(entity);
+        this->get_component_array<T>().remove_data(entity);
     }
 
     template <typename T>
     T& get_component(Entity entity) {
         // Get a reference to a component from the array for an entity
-        return this->get_component_array<T>()->get_data(entity);
+        return this->get_component_array<T>().get_data(entity);
     }
 
     void entity_destroyed(Entity entity) const {
         // Notify each component array that an entity has been destroyed
         // If it has a component for that entity, it will remove it
-        for (auto const& [type, component] : this->component_arrays) {
-            component->entity_destroyed(entity);
+        for (auto const& component : this->component_arrays) {
+            if (component) {
+                component->entity_destroyed(entity);
+            }
         }
     }
 
-  private:
-    // Map from type string pointer to a component type
-    std::unordered_map<const char*, ComponentType> component_types{};
+    // The ComponentArray of type T, reached by indexing with its static type index
+    template <typename T>
+    ComponentArray<T>& get_component_array() const {
+        const std::size_t type_index = TypeIndex<ComponentFamily>::of<T>();
 
-    // Map from type string pointer to a component array
-    std::unordered_map<const char*, std::shared_ptr<IComponentArray>> component_arrays{};
+        assert(this->is_registered(type_index) && "Component not registered before use.");
 
-    // The component type to be assigned to the next registered component - starting at 0
-    ComponentType next_component_type{};
+        return *static_cast<ComponentArray<T>*>(this->component_arrays[type_index].get());
+    }
 
-    // Convenience function to get the statically casted pointer to the ComponentArray of type T.
-    template <typename T>
-    std::shared_ptr<ComponentArray<T>> get_component_array() {
-        const char* type_name = typeid(T).name();
+    // Type-erased array of a component, reached by its signature bit
+    IComponentArray const& get_component_array(ComponentType type) const {
+        assert(this->arrays_by_type[type] != nullptr && "Component not registered before use.");
+
+        return *this->arrays_by_type[type];
+    }
 
-        assert(component_types.find(type_name) != component_types.end() && "Component not registered before use.");
+  private:
+    static constexpr ComponentType INVALID_COMPONENT_TYPE = MAX_COMPONENTS;
 
-        return std::static_pointer_cast<ComponentArray<T>>(this->component_arrays[type_name]);
+    bool is_registered(std::size_t type_index) const noexcept {
+        return type_index < this->component_types.size() && this->component_types[type_index] != INVALID_COMPONENT_TYPE;
     }
+
+    // Signature bit of each component, indexed by its static type index
+    std::vector<ComponentType> component_types{};
+
+    // Component arrays, indexed by the static type index of their component
+    std::vector<std::unique_ptr<IComponentArray>> component_arrays{};
+
+    // The same arrays indexed by signature bit
+    std::array<IComponentArray*, MAX_COMPONENTS> arrays_by_type{};
+
+    // The component type to be assigned to the next registered component - starting at 0
+    ComponentType next_component_type{};
 };
 
 } // namespace Vulqian::Engine::ECS
@@ -0,0 +1,24 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <vector>
+
+#include "../Types.hpp"
+
+namespace Vulqian::Engine::ECS::Components {
+
+// Entity whose world matrix this entity's transform is relative to.
+// Both sides are kept in sync by Systems::TransformHierarchy::set_parent.
+struct Parent {
+    Entity entity{NULL_ENTITY};
+};
+
+struct Children {
+    std::vector<Entity> entities{};
+};
+
+}  // namespace Vulqian::Engine::ECS::Components
@@ -14,6 +14,8 @@ namespace Vulqian::Engine::ECS::Components {
 struct Mesh {
     std::shared_ptr<Vulqian::Engine::Graphics::Model> model{};
     glm::vec3                                         color{};
+    // Rasterized by the CPU occlusion culling to hide what is behind it: large, simple and usually in front
+    bool                                              occluder{false};
 };
 
 } // namespace Vulqian::Engine::ECS::Components
@@ -0,0 +1,37 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Vulqian::Engine::ECS::Components {
+
+// Mass properties of an entity simulated by Systems::Physics, which moves its Transform_TB_YXZ.
+// Inverse values are stored so a static body is simply inverse_mass = 0.
+struct RigidBody {
+    float     inverse_mass{1.f};
+    glm::vec3 inverse_inertia{1.f, 1.f, 1.f};  // diagonal of the inverse inertia tensor, body axes
+
+    float linear_damping{0.01f};   // fraction of the velocity lost per second
+    float angular_damping{0.05f};
+    float gravity_scale{1.f};
+
+    // Accumulated by gameplay code, applied over the next physics update then cleared
+    glm::vec3 force{};
+    glm::vec3 torque{};
+
+    // Set by Systems::Physics when it solves contacts: a sleeping body is neither integrated nor solved until
+    // something touches it, a force is applied or its transform or velocity is changed. Clearing it wakes it up too.
+    bool  sleeping{false};
+    float sleep_time{};  // seconds spent below the sleep tolerances
+};
+
+struct Velocity {
+    glm::vec3 linear{};   // units per second
+    glm::vec3 angular{};  // radians per second around world axes, integrated as a rotation then written back as Transform_TB_YXZ::rotation
+};
+
+}  // namespace Vulqian::Engine::ECS::Components
@@ -90,4 +90,11 @@ struct Transform_TB_YXZ {
     }
 };
 
+// World-space matrices of an entity, written by the TransformHierarchy system from its
+// Transform_TB_YXZ and the chain of its parents, and read by the renderer
+struct WorldTransform {
+    glm::mat4 world_matrix{1.f};
+    glm::mat4 normal_matrix{1.f};  // only the upper 3x3 is used, padded for the push constants
+};
+
 } // namespace Vulqian::Engine::ECS::Components
@@ -0,0 +1,130 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <algorithm>
+#include <vector>
+
+#include "Coordinator.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+void Coordinator::flush(std::span<CommandBuffer> buffers) {
+    // Give every pending entity its real handle
+    for (auto& buffer : buffers) {
+        for (auto& created : buffer.created) {
+            created = this->entity_manager->create_entity();
+        }
+    }
+
+    std::vector<Entity> destroyed{};
+    for (auto const& buffer : buffers) {
+        for (Entity entity : buffer.destroyed) {
+            if (Entity resolved = buffer.resolve(entity); this->is_alive(resolved)) {
+                destroyed.push_back(resolved);
+            }
+        }
+    }
+    std::ranges::sort(destroyed);
+    destroyed.erase(std::unique(destroyed.begin(), destroyed.end()), destroyed.end());
+
+    // Group the component commands by type so each storage is visited in a single run,
+    // the stable sort keeps the recording order between commands of the same type
+    std::vector<CommandBuffer::Command*> commands{};
+    for (auto& buffer : buffers) {
+        for (auto& command : buffer.commands) {
+            command.entity = buffer.resolve(command.entity);
+            commands.push_back(&command);
+        }
+    }
+    std::ranges::stable_sort(commands, {}, &CommandBuffer::Command::type_index);
+    std::erase_if(commands, [this, &destroyed](CommandBuffer::Command const* command) {
+        return !this->is_alive(command->entity) || std::ranges::binary_search(destroyed, command->entity);
+    });
+
+    // Signatures before any command ran, systems only look at the components that changed
+    std::vector<Entity> touched{};
+    touched.reserve(commands.size());
+    for (auto const* command : commands) {
+        touched.push_back(command->entity);
+    }
+    std::ranges::sort(touched);
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+    std::vector<Signature> previous{};
+    previous.reserve(touched.size());
+    for (Entity entity : touched) {
+        previous.push_back(this->entity_manager->get_signature(entity));
+    }
+
+    for (auto* command : commands) {
+        command->apply(*this, command->entity, command->payload);
+    }
+
+    // Every system updates its entity set once for the whole batch
+    std::vector<Signature> signatures{};
+    signatures.reserve(touched.size());
+    for (Entity entity : touched) {
+        signatures.push_back(this->entity_manager->get_signature(entity));
+    }
+    this->system_manager->entities_signature_changed(touched, previous, signatures);
+
+    std::vector<Signature> destroyed_signatures{};
+    destroyed_signatures.reserve(destroyed.size());
+    for (Entity entity : destroyed) {
+        destroyed_signatures.push_back(this->entity_manager->get_signature(entity));
+        this->observers.notify(ComponentEvent::Remove, destroyed_signatures.back(), entity);
+    }
+
+    for (Entity entity : destroyed) {
+        this->entity_manager->destroy_entity(entity);
+        this->release_components(entity);
+    }
+    this->system_manager->entities_destroyed(destroyed, destroyed_signatures);
+
+    for (auto& buffer : buffers) {
+        buffer.clear();
+    }
+}
+
+void Coordinator::dispatch_changes() {
+    const Tick since = this->last_dispatch;
+    this->last_dispatch = this->advance_tick();
+
+    const Signature watched = this->observers.watched_types(ComponentEvent::Change);
+    if (watched.none()) {
+        return;
+    }
+
+    // Collected before any observer runs, an observer changing components cannot disturb the walk
+    std::vector<Entity> changed{};
+    for (ComponentType type = 0; type < MAX_COMPONENTS; ++type) {
+        if (!watched.test(type)) {
+            continue;
+        }
+
+        changed.clear();
+        if (this->storage_mode == StorageMode::Archetype) {
+            this->archetype_storage->collect_changed(type, since, changed);
+        } else {
+            IComponentArray const& array = this->component_manager->get_component_array(type);
+            const auto             ticks = array.component_ticks();
+            const auto             entities = array.entities();
+
+            for (std::size_t i = 0; i < ticks.size(); ++i) {
+                if (ticks[i].changed > since && ticks[i].added <= since) {
+                    changed.push_back(entities[i]);
+                }
+            }
+        }
+
+        this->observers.notify(ComponentEvent::Change, type, changed);
+    }
+}
+
+void Coordinator::run_jobs(std::size_t count, std::function<void(std::size_t)> const& job) {
+    Jobs::run_jobs(this->thread_pool, count, job);
+}
+
+} // namespace Vulqian::Engine::ECS
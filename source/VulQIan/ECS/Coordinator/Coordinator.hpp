@@ -5,21 +5,45 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <functional>
 #include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "../../Jobs/ThreadPool.hpp"
+#include "../Archetypes/ArchetypeStorage.hpp"
+#include "../Commands/CommandBuffer.hpp"
 #include "../Components/ComponentManager.hpp"
 #include "../Entities/EntityManager.hpp"
+#include "../Observers/ObserverRegistry.hpp"
 #include "../Systems/SystemManager.hpp"
+#include "../Views/View.hpp"
 
 namespace Vulqian::Engine::ECS {
 
 class Coordinator {
   public:
-    void init() {
+    void init(StorageMode mode = StorageMode::SparseSet) {
         // Create pointers to each manager
         this->component_manager = std::make_unique<ComponentManager>();
         this->entity_manager = std::make_unique<EntityManager>();
         this->system_manager = std::make_unique<SystemManager>();
+
+        // The component manager keeps assigning signature bits, only the storage itself changes
+        this->storage_mode = mode;
+        if (mode == StorageMode::Archetype) {
+            this->archetype_storage = std::make_unique<ArchetypeStorage>();
+        }
+    }
+
+    StorageMode get_storage_mode() const noexcept {
+        return this->storage_mode;
     }
 
     // Entity methods
@@ -27,43 +51,140 @@ class Coordinator {
         return this->entity_manager->create_entity();
     }
 
+    // Creates `count` entities each owning a copy of every prototype, e.g. create_entities(400, transform, mesh).
+    // Storage is filled with contiguous copies and system membership is computed once for the batch.
+    template <typename... Ts>
+    std::vector<Entity> create_entities(std::size_t count, Ts const&... prototypes) {
+        std::vector<Entity> entities(count);
+        this->entity_manager->create_entities(entities);
+
+        if constexpr (sizeof...(Ts) > 0) {
+            if (this->storage_mode == StorageMode::Archetype) {
+                this->archetype_storage->spawn<Ts...>(
+                    entities, this->get_tick(), std::array<ComponentType, sizeof...(Ts)>{this->component_manager->get_component_type<Ts>()...}, prototypes...);
+            } else {
+                (this->component_manager->add_components<Ts>(entities, prototypes, this->get_tick()), ...);
+            }
+
+            const Signature signature = this->signature_of<Ts...>();
+            for (Entity entity : entities) {
+                this->entity_manager->set_signature(entity, signature);
+            }
+            this->system_manager->entities_signature_changed(entities, std::vector<Signature>(count), std::vector<Signature>(count, signature));
+
+            (this->observers.notify(ComponentEvent::Add, this->component_manager->get_component_type<Ts>(), entities), ...);
+        }
+
+        return entities;
+    }
+
+    // False for handles of destroyed entities, even once their index was handed out again
+    bool is_alive(Entity entity) const noexcept {
+        return this->entity_manager->is_alive(entity);
+    }
+
+    // on_remove observers run first, while the entity and its components are still there
     void destroy_entity(Entity entity) {
+        const Signature signature = this->entity_manager->get_signature(entity);
+        this->observers.notify(ComponentEvent::Remove, signature, entity);
+
         this->entity_manager->destroy_entity(entity);
-        this->component_manager->entity_destroyed(entity);
-        this->system_manager->entity_destroyed(entity);
+        this->release_components(entity);
+        this->system_manager->entity_destroyed(entity, signature);
     }
 
     // Component methods
     template <typename T>
     void register_component() {
         this->component_manager->register_component<T>();
+
+        if (this->storage_mode == StorageMode::Archetype) {
+            this->archetype_storage->register_component<T>(this->component_manager->get_component_type<T>());
+        }
     }
 
     template <typename T>
     void add_component(Entity entity, T component) {
-        this->component_manager->add_component<T>(entity, component);
+        const Signature previous = this->entity_manager->get_signature(entity);
+        this->store_component<T>(entity, std::move(component));
+        this->system_manager->entity_signature_changed(entity, previous, this->entity_manager->get_signature(entity));
+    }
 
-        auto signature = entity_manager->get_signature(entity);
-        signature.set(this->component_manager->get_component_type<T>(), true);
-        this->entity_manager->set_signature(entity, signature);
+    // Adds components[i] to entities[i], system membership is computed once for the batch
+    template <typename T>
+    void add_components(std::span<const Entity> entities, std::span<const T> components) {
+        const ComponentType type = this->component_manager->get_component_type<T>();
 
-        this->system_manager->entity_signature_changed(entity, signature);
+        if (this->storage_mode == StorageMode::Archetype) {
+            this->archetype_storage->add_components<T>(entities, type, components, this->get_tick());
+        } else {
+            this->component_manager->add_components<T>(entities, components, this->get_tick());
+        }
+
+        std::vector<Signature> previous{};
+        std::vector<Signature> signatures{};
+        previous.reserve(entities.size());
+        signatures.reserve(entities.size());
+        for (Entity entity : entities) {
+            auto signature = this->entity_manager->get_signature(entity);
+            previous.push_back(signature);
+            signature.set(type, true);
+            this->entity_manager->set_signature(entity, signature);
+            signatures.push_back(signature);
+        }
+        this->system_manager->entities_signature_changed(entities, previous, signatures);
+        this->observers.notify(ComponentEvent::Add, type, entities);
     }
 
     template <typename T>
     void remove_component(Entity entity) {
-        this->component_manager->remove_component<T>(entity);
+        const Signature previous = this->entity_manager->get_signature(entity);
+        this->erase_component<T>(entity);
+        this->system_manager->entity_signature_changed(entity, previous, this->entity_manager->get_signature(entity));
+    }
 
-        auto signature = entity_manager->get_signature(entity);
-        signature.set(this->component_manager->get_component_type<T>(), false);
-        this->entity_manager->set_signature(entity, signature);
+    // get_component<T> marks the component as changed, get_component<const T> only reads it
+    template <typename T>
+    T& get_component(Entity entity) {
+        using Component = std::remove_const_t<T>;
+
+        if constexpr (!std::is_const_v<T>) {
+            this->mark_changed<Component>(entity);
+        }
+
+        if (this->storage_mode == StorageMode::Archetype) {
+            return this->archetype_storage->get_component<Component>(entity, this->component_manager->get_component_type<Component>());
+        }
+        return this->component_manager->get_component<Component>(entity);
+    }
 
-        this->system_manager->entity_signature_changed(entity, signature);
+    // Change tracking
+    // Components record the tick they were added at and the tick a mutable reference to them was last
+    // handed out at, through get_component<T>, a query over a mutable T or mark_changed<T>.
+    // A system keeps the tick advance_tick() returned when it last ran and passes it to the
+    // changed<T>(since) / added<T>(since) query filters to only visit what happened in between:
+    //     const Tick since = this->last_run;
+    //     this->last_run = coordinator.advance_tick();
+    //     coordinator.each<const Transform_TB_YXZ, Bounds>(fn, changed<Transform_TB_YXZ>(since));
+    // Writes the system makes during its run are stamped after last_run, so its next run sees them too.
+    Tick get_tick() const noexcept {
+        return this->current_tick.load(std::memory_order_relaxed);
     }
 
+    // Closes the current tick and returns it, changes made from now on are stamped with a later one
+    Tick advance_tick() noexcept {
+        return this->current_tick.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // For changes made through a pointer or reference kept from an earlier read
     template <typename T>
-    T& get_component(Entity entity) {
-        return this->component_manager->get_component<T>(entity);
+    void mark_changed(Entity entity) {
+        this->ticks_of<std::remove_const_t<T>>(entity).changed = this->get_tick();
+    }
+
+    template <typename T>
+    ComponentTicks get_ticks(Entity entity) {
+        return this->ticks_of<std::remove_const_t<T>>(entity);
     }
 
     template <typename T>
@@ -71,6 +192,40 @@ class Coordinator {
         return this->component_manager->get_component_type<T>();
     }
 
+    // Signature with the bit of each of Ts set, e.g. to declare a system's access
+    template <typename... Ts>
+    Signature signature_of() {
+        Signature signature{};
+        (signature.set(this->component_manager->get_component_type<std::remove_const_t<Ts>>()), ...);
+        return signature;
+    }
+
+    // Observers
+    // Called with fn(entity) or fn(entity, component const&) for every component of type T that is
+    // added (right after it is stored), removed (right before it goes away, entity destruction included)
+    // or changed. Change observers are batched: dispatch_changes() calls them once per component changed
+    // since its previous call, so a component mutated many times in a frame is reported once.
+    // Observers may add components, removals and destructions belong in a CommandBuffer, and they must
+    // not register other observers.
+    template <typename T, typename Function>
+    void on_add(Function&& fn) {
+        this->observe<T>(ComponentEvent::Add, std::forward<Function>(fn));
+    }
+
+    template <typename T, typename Function>
+    void on_remove(Function&& fn) {
+        this->observe<T>(ComponentEvent::Remove, std::forward<Function>(fn));
+    }
+
+    template <typename T, typename Function>
+    void on_change(Function&& fn) {
+        this->observe<T>(ComponentEvent::Change, std::forward<Function>(fn));
+    }
+
+    // Runs the on_change observers, components added since the previous call are only reported to on_add.
+    // Meant to be called once per frame outside of any iteration.
+    void dispatch_changes();
+
     // System methods
     template <typename T>
     std::shared_ptr<T> register_system() {
@@ -84,14 +239,285 @@ class Coordinator {
 
     template <typename T>
     bool has_component(Entity entity) {
-        auto signature = entity_manager->get_signature(entity);
-        return signature.test(component_manager->get_component_type<T>());
+        using Component = std::remove_const_t<T>;
+
+        if (this->storage_mode == StorageMode::Archetype) {
+            return this->archetype_storage->has_component(entity, this->component_manager->get_component_type<Component>());
+        }
+        return this->component_manager->get_component_array<Component>().contains(entity);
     }
 
+    // Query methods
+    // e.g. view<Transform_TB_YXZ, Mesh>(exclude<Transparency>)
+    // Views walk the per-type arrays and are only available with StorageMode::SparseSet, use each() otherwise
+    template <typename... Ts, typename... Excluded>
+    View<Ts...> view(Exclude<Excluded...> /*excluded*/ = {}) {
+        assert(this->storage_mode == StorageMode::SparseSet && "views require the sparse set storage");
+
+        return View<Ts...>{
+            std::tuple{&this->component_manager->get_component_array<std::remove_const_t<Ts>>()...},
+            std::array<IComponentArray const*, sizeof...(Excluded)>{&this->component_manager->get_component_array<Excluded>()...},
+            this->get_tick()};
+    }
+
+    // Calls fn(entity, components...) or fn(components...) on every entity matching the view
+    template <typename... Ts, typename Function, typename... Excluded>
+    void each(Function&& fn, Exclude<Excluded...> excluded = {}) {
+        if (this->storage_mode == StorageMode::Archetype) {
+            this->archetype_storage->each<Ts...>(std::forward<Function>(fn), this->component_types_of<Ts...>(), this->signature_of<Excluded...>(), this->get_tick());
+            return;
+        }
+
+        this->view<Ts...>(excluded).each(std::forward<Function>(fn));
+    }
+
+    // each() restricted to entities where any of Watched changed after filter.since,
+    // e.g. each<Transform_TB_YXZ>(fn, changed<Transform_TB_YXZ>(last_run)).
+    // Only the entities passing the filter get their mutable components stamped.
+    template <typename... Ts, typename Function, typename... Watched, typename... Excluded>
+    void each(Function&& fn, Changed<Watched...> filter, Exclude<Excluded...> excluded = {}) {
+        this->each_filtered<Ts...>(
+            fn, [this, since = filter.since](Entity entity) { return ((this->has_component<Watched>(entity) && this->get_ticks<Watched>(entity).changed > since) || ...); },
+            excluded);
+    }
+
+    // each() restricted to entities that gained any of Watched after filter.since
+    template <typename... Ts, typename Function, typename... Watched, typename... Excluded>
+    void each(Function&& fn, Added<Watched...> filter, Exclude<Excluded...> excluded = {}) {
+        this->each_filtered<Ts...>(
+            fn, [this, since = filter.since](Entity entity) { return ((this->has_component<Watched>(entity) && this->get_ticks<Watched>(entity).added > since) || ...); },
+            excluded);
+    }
+
+    // Parallel queries, run on the pool given to set_thread_pool or inline without one.
+    // Matching entities are split in chunks of about `grain` entities (whole storage chunks in archetype mode),
+    // the split only depends on the world so results never depend on the amount of threads.
+    static constexpr std::size_t DEFAULT_GRAIN = 4096;
+
+    void set_thread_pool(Jobs::ThreadPool* pool) noexcept {
+        this->thread_pool = pool;
+    }
+
+    Jobs::ThreadPool* get_thread_pool() const noexcept {
+        return this->thread_pool;
+    }
+
+    // each() spread over the thread pool, fn is called concurrently and must only touch the entity it is given
+    template <typename... Ts, typename Function, typename... Excluded>
+    void parallel_each(Function&& fn, std::size_t grain = DEFAULT_GRAIN, Exclude<Excluded...> excluded = {}) {
+        this->for_each_chunk<Ts...>(
+            grain, excluded, [](std::size_t /*chunk_count*/) {}, [&fn](std::size_t /*chunk*/, auto const& visit) { visit(fn); });
+    }
+
+    // Folds the matching entities with accumulate(partial, [entity,] components...) into one partial per chunk,
+    // then merges the partials with combine(result, partial) in chunk order, so floating point results are reproducible.
+    // e.g. the bounds of every transform: accumulate grows a box, combine merges two boxes
+    template <typename... Ts, typename Result, typename Accumulate, typename Combine, typename... Excluded>
+    Result parallel_reduce(Result identity, Accumulate&& accumulate, Combine&& combine, std::size_t grain = DEFAULT_GRAIN, Exclude<Excluded...> excluded = {}) {
+        std::vector<Result> partials{};
+
+        this->for_each_chunk<Ts...>(
+            grain, excluded, [&partials, &identity](std::size_t chunk_count) { partials.assign(chunk_count, identity); },
+            [&partials, &accumulate](std::size_t chunk, auto const& visit) {
+                Result& partial = partials[chunk];
+                visit([&partial, &accumulate](Entity entity, Ts&... components) {
+                    if constexpr (std::is_invocable_v<Accumulate&, Result&, Entity, Ts&...>) {
+                        accumulate(partial, entity, components...);
+                    } else {
+                        accumulate(partial, components...);
+                    }
+                });
+            });
+
+        Result result = std::move(identity);
+        for (auto const& partial : partials) {
+            combine(result, partial);
+        }
+        return result;
+    }
+
+    // Runs job(first, last) over [0, count) in ranges of `grain`, for systems keeping their own arrays next to the storages
+    void parallel_for(std::size_t count, std::size_t grain, std::function<void(std::size_t, std::size_t)> const& job) {
+        assert(grain > 0 && "ranges need at least one element");
+
+        this->run_jobs((count + grain - 1) / grain, [&job, count, grain](std::size_t range) {
+            job(range * grain, std::min(count, (range + 1) * grain));
+        });
+    }
+
+    // Deferred changes
+    // Applies the recorded commands in one pass then clears the buffers: entities are created first,
+    // component commands are applied grouped by component type, system membership is recomputed
+    // once per touched entity and destroys come last. Must not run while the world is iterated.
+    void flush(CommandBuffer& buffer) {
+        this->flush(std::span<CommandBuffer>{&buffer, 1});
+    }
+
+    void flush(std::span<CommandBuffer> buffers);
+
   private:
+    friend class CommandBuffer;
+
+    template <typename... Ts>
+    std::array<ComponentType, sizeof...(Ts)> component_types_of() {
+        return {this->component_manager->get_component_type<std::remove_const_t<Ts>>()...};
+    }
+
+    // Splits the entities matching the query in chunks, calls prepare(chunk_count) once then
+    // run(chunk, visit) from the pool for every chunk, where visit(fn) calls fn on the chunk's entities
+    template <typename... Ts, typename... Excluded, typename Prepare, typename Run>
+    void for_each_chunk(std::size_t grain, Exclude<Excluded...> excluded, Prepare&& prepare, Run&& run) {
+        assert(grain > 0 && "chunks need at least one entity");
+
+        if (this->storage_mode == StorageMode::Archetype) {
+            const auto types = this->component_types_of<Ts...>();
+            const auto chunks = this->archetype_storage->matching_chunks(types, this->signature_of<Excluded...>());
+
+            // Storage chunks are grouped until they hold `grain` rows
+            std::vector<std::size_t> job_starts{};
+            std::size_t              rows{grain};
+            for (std::size_t i = 0; i < chunks.size(); ++i) {
+                if (rows >= grain) {
+                    job_starts.push_back(i);
+                    rows = 0;
+                }
+                rows += chunks[i].archetype->chunk_size(chunks[i].chunk);
+            }
+            job_starts.push_back(chunks.size());
+
+            const std::size_t job_count = job_starts.size() - 1;
+            prepare(job_count);
+            this->run_jobs(job_count, [&](std::size_t job) {
+                for (std::size_t i = job_starts[job]; i < job_starts[job + 1]; ++i) {
+                    run(job, [&chunks, &types, i, tick = this->get_tick()](auto&& fn) { ArchetypeStorage::each_in<Ts...>(fn, chunks[i], types, tick); });
+                }
+            });
+            return;
+        }
+
+        auto              view = this->view<Ts...>(excluded);
+        const std::size_t candidates = view.candidates().size();
+        const std::size_t job_count = (candidates + grain - 1) / grain;
+
+        prepare(job_count);
+        this->run_jobs(job_count, [&](std::size_t job) {
+            const std::size_t first = job * grain;
+            run(job, [&view, first, last = std::min(candidates, first + grain)](auto&& fn) { view.each_in(first, last, fn); });
+        });
+    }
+
+    // Walks the query read-only and hands out mutable references only for the entities `passes` accepts,
+    // so rejected entities keep their change tick
+    template <typename... Ts, typename Function, typename Predicate, typename... Excluded>
+    void each_filtered(Function& fn, Predicate const& passes, Exclude<Excluded...> excluded) {
+        this->each<std::add_const_t<Ts>...>(
+            [this, &fn, &passes](Entity entity, std::add_const_t<Ts>&... components) {
+                if (!passes(entity)) {
+                    return;
+                }
+
+                ([&] {
+                    if constexpr (!std::is_const_v<Ts>) {
+                        this->mark_changed<Ts>(entity);
+                    }
+                }(),
+                 ...);
+
+                // The storage itself is mutable, only the iteration was read-only
+                if constexpr (std::is_invocable_v<Function&, Entity, Ts&...>) {
+                    fn(entity, const_cast<Ts&>(components)...);
+                } else {
+                    fn(const_cast<Ts&>(components)...);
+                }
+            },
+            excluded);
+    }
+
+    template <typename T, typename Function>
+    void observe(ComponentEvent event, Function&& fn) {
+        const ComponentType type = this->component_manager->get_component_type<T>();
+
+        if constexpr (std::is_invocable_v<Function&, Entity, T const&>) {
+            this->observers.add(event, type, [this, fn = std::forward<Function>(fn)](Entity entity) mutable {
+                fn(entity, this->get_component<const T>(entity));
+            });
+        } else {
+            this->observers.add(event, type, Observer{std::forward<Function>(fn)});
+        }
+    }
+
+    template <typename T>
+    ComponentTicks& ticks_of(Entity entity) {
+        if (this->storage_mode == StorageMode::Archetype) {
+            return this->archetype_storage->get_ticks(entity, this->component_manager->get_component_type<T>());
+        }
+
+        auto& array = this->component_manager->get_component_array<T>();
+        return array.ticks_at(array.index_of(entity));
+    }
+
+    // Runs job(0) ... job(count - 1) on the thread pool and waits for them
+    void run_jobs(std::size_t count, std::function<void(std::size_t)> const& job);
+
+    // Storage side of add / remove, updates the entity signature and runs the observers
+    // but leaves system membership alone
+    template <typename T>
+    void store_component(Entity entity, T component) {
+        const ComponentType type = this->component_manager->get_component_type<T>();
+
+        if (this->storage_mode == StorageMode::Archetype) {
+            this->archetype_storage->add_component<T>(entity, type, std::move(component), this->get_tick());
+        } else {
+            this->component_manager->add_component<T>(entity, std::move(component), this->get_tick());
+        }
+
+        auto signature = entity_manager->get_signature(entity);
+        signature.set(type, true);
+        this->entity_manager->set_signature(entity, signature);
+
+        this->observers.notify(ComponentEvent::Add, type, entity);
+    }
+
+    template <typename T>
+    void erase_component(Entity entity) {
+        const ComponentType type = this->component_manager->get_component_type<T>();
+        this->observers.notify(ComponentEvent::Remove, type, entity);
+
+        if (this->storage_mode == StorageMode::Archetype) {
+            this->archetype_storage->remove_component(entity, type);
+        } else {
+            this->component_manager->remove_component<T>(entity);
+        }
+
+        auto signature = entity_manager->get_signature(entity);
+        signature.set(type, false);
+        this->entity_manager->set_signature(entity, signature);
+    }
+
+    void release_components(Entity entity) {
+        if (this->storage_mode == StorageMode::Archetype) {
+            this->archetype_storage->entity_destroyed(entity);
+        } else {
+            this->component_manager->entity_destroyed(entity);
+        }
+    }
+
     std::unique_ptr<Vulqian::Engine::ECS::ComponentManager> component_manager;
     std::unique_ptr<Vulqian::Engine::ECS::EntityManager>    entity_manager;
     std::unique_ptr<Vulqian::Engine::ECS::SystemManager>    system_manager;
+
+    // Only created with StorageMode::Archetype, the component arrays stay empty in that mode
+    std::unique_ptr<Vulqian::Engine::ECS::ArchetypeStorage> archetype_storage;
+    StorageMode                                             storage_mode{StorageMode::SparseSet};
+
+    // Starts above zero so changed<T>(0) / added<T>(0) match every component
+    std::atomic<Tick> current_tick{1};
+
+    ObserverRegistry observers{};
+    Tick             last_dispatch{};
+
+    // Shared with the rest of the engine, not owned
+    Vulqian::Engine::Jobs::ThreadPool* thread_pool{nullptr};
 };
 
 } // namespace Vulqian::Engine::ECS
@@ -5,16 +5,28 @@
 
 #pragma once
 
+#include "Commands/CommandBuffer.hpp"
+
+#include "Components/Collider.hpp"
 #include "Components/ComponentArray.hpp"
+#include "Components/Hierarchy.hpp"
+#include "Components/RigidBody.hpp"
 #include "Components/Transform.hpp"
 
 #include "Coordinator/Coordinator.hpp"
 
 #include "Entities/EntityManager.hpp"
 
+#include "Observers/ObserverRegistry.hpp"
+
+#include "Systems/Collisions.hpp"
 #include "Systems/Physics.hpp"
 #include "Systems/PointLights.hpp"
+#include "Systems/Scheduler.hpp"
 #include "Systems/System.hpp"
 #include "Systems/SystemManager.hpp"
+#include "Systems/TransformHierarchy.hpp"
 
 #include "Types.hpp"
+
+#include "Views/View.hpp"
@@ -8,47 +8,71 @@
 #include "EntityManager.hpp"
 
 namespace Vulqian::Engine::ECS {
-EntityManager::EntityManager() {
-    // Initialize the queue with all possible entity IDs
-    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
-        this->available_entities.push(entity);
-    }
-}
+EntityManager::EntityManager() = default;
 
 Entity EntityManager::create_entity() {
-    assert(this->living_entity_count < MAX_ENTITIES && "too many entities in existence");
+    Entity entity{};
+
+    if (this->free_head != NO_FREE_SLOT) {
+        // Reuse the last freed index, its slot already holds the bumped version
+        const std::uint32_t index = this->free_head;
+        this->free_head = entity_index(this->slots[index]);
 
-    // Take an ID from the front of the queue
-    Entity id = this->available_entities.front();
-    this->available_entities.pop();
+        entity = make_entity(index, entity_version(this->slots[index]));
+        this->slots[index] = entity;
+    } else {
+        // No index to recycle, hand out a new one and grow the signatures with it
+        assert(this->slots.size() < NO_FREE_SLOT && "too many entities in existence");
+
+        entity = make_entity(static_cast<std::uint32_t>(this->slots.size()), 0);
+        this->slots.push_back(entity);
+        this->signatures.emplace_back();
+    }
     ++this->living_entity_count;
 
-    return id;
+    return entity;
+}
+
+void EntityManager::create_entities(std::span<Entity> entities) {
+    // Grow the tables once for the indices the free-list can not provide
+    this->slots.reserve(this->slots.size() + entities.size());
+    this->signatures.reserve(this->signatures.size() + entities.size());
+
+    for (Entity& entity : entities) {
+        entity = this->create_entity();
+    }
 }
 
 void EntityManager::destroy_entity(Entity entity) {
-    assert(entity < MAX_ENTITIES && "entity out of range");
+    assert(this->is_alive(entity) && "destroying a dead entity");
+
+    const std::uint32_t index = entity_index(entity);
 
     // Invalidate the destroyed entity's signature
-    this->signatures[entity].reset();
+    this->signatures[index].reset();
 
-    // Put the destroyed ID at the back of the queue
-    this->available_entities.push(entity);
+    // Push the index on the free-list, bumping the version invalidates every handle still around
+    std::uint32_t version = entity_version(entity) + 1;
+    if (version == PENDING_ENTITY_VERSION) {
+        version = 0;
+    }
+    this->slots[index] = make_entity(this->free_head, version);
+    this->free_head = index;
     --this->living_entity_count;
 }
 
 void EntityManager::set_signature(Entity entity, Signature const& signature) {
-    assert(entity < MAX_ENTITIES && "entity out of range");
+    assert(this->is_alive(entity) && "entity is not alive");
 
     // Put this entity's signature into the array
-    this->signatures[entity] = signature;
+    this->signatures[entity_index(entity)] = signature;
 }
 
 Signature EntityManager::get_signature(Entity entity) {
-    assert(entity < MAX_ENTITIES && "entity out of range");
+    assert(this->is_alive(entity) && "entity is not alive");
 
     // Get this entity's signature from the array
-    return this->signatures[entity];
+    return this->signatures[entity_index(entity)];
 }
 
 } // namespace Vulqian::Engine::ECS
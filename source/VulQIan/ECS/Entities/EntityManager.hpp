@@ -5,8 +5,9 @@
 
 #pragma once
 
-#include <array>
-#include <queue>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 #include "../Types.hpp"
 
@@ -16,16 +17,30 @@ class EntityManager {
     EntityManager();
 
     Entity    create_entity();
+    void      create_entities(std::span<Entity> entities);
     void      destroy_entity(Entity entity);
     void      set_signature(Entity entity, Signature const& signature);
     Signature get_signature(Entity entity);
 
+    // False once the entity was destroyed, even if its index has been recycled since
+    bool is_alive(Entity entity) const noexcept {
+        const std::uint32_t index = entity_index(entity);
+        return index < this->slots.size() && this->slots[index] == entity;
+    }
+
   private:
-    // Queue of unused entity IDs
-    std::queue<Entity> available_entities{};
+    // Marks the end of the free-list
+    static constexpr std::uint32_t NO_FREE_SLOT = ENTITY_INDEX_MASK;
+
+    // One entry per entity index: the live handle, or for a destroyed entity the next free
+    // index packed with the version its slot will be handed out with (an implicit free-list)
+    std::vector<Entity> slots{};
+
+    // Array of signatures where the position corresponds to the entity index, grown as indices are handed out
+    std::vector<Signature> signatures{};
 
-    // Array of signatures where the index corresponds to the entity ID
-    std::array<Signature, MAX_ENTITIES> signatures{};
+    // Most recently freed index, reused first
+    std::uint32_t free_head{NO_FREE_SLOT};
 
     // Total living entities - used to keep limits on how many exist
     uint32_t living_entity_count{};
@@ -0,0 +1,129 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "../Types.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+// Set of entities stored as a packed (dense) array, plus a sparse index paged by entity index.
+// The dense array keeps the full handle, so a stale handle sharing the index of a member is not found.
+// Membership tests, inserts and removals are O(1) and iteration walks contiguous memory.
+// Pages are only allocated for the ID ranges that are actually used, so the set grows at runtime.
+class SparseSet {
+  public:
+    static constexpr std::size_t   PAGE_SIZE = 4096;
+    static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t   NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+    bool contains(Entity entity) const noexcept { return this->find(entity) != NOT_FOUND; }
+
+    // Dense index of the entity, or NOT_FOUND when it is not part of the set
+    std::size_t find(Entity entity) const noexcept {
+        const std::size_t page = entity_index(entity) / PAGE_SIZE;
+
+        if (page >= this->sparse_pages.size() || !this->sparse_pages[page]) {
+            return NOT_FOUND;
+        }
+
+        const std::uint32_t index = (*this->sparse_pages[page])[entity_index(entity) % PAGE_SIZE];
+        return index != INVALID_INDEX && this->dense_entities[index] == entity ? index : NOT_FOUND;
+    }
+
+    // Dense index of an entity already in the set
+    std::size_t index_of(Entity entity) const noexcept {
+        assert(this->contains(entity) && "entity is not part of the set");
+
+        return this->slot(entity);
+    }
+
+    // Appends the entity at the end of the dense array and returns its dense index
+    std::size_t insert(Entity entity) {
+        assert(!this->contains(entity) && "entity added to the set more than once");
+
+        const auto index = static_cast<std::uint32_t>(this->dense_entities.size());
+        this->page_for(entity)[entity_index(entity) % PAGE_SIZE] = index;
+        this->dense_entities.push_back(entity);
+
+        return index;
+    }
+
+    // Removes the entity by moving the last element into its slot to keep the array packed.
+    // Returns the dense index that was filled so owners of parallel arrays can do the same move.
+    std::size_t erase(Entity entity) {
+        assert(this->contains(entity) && "removing entity that is not part of the set");
+
+        const std::size_t index = this->index_of(entity);
+        const Entity      last = this->dense_entities.back();
+
+        this->dense_entities[index] = last;
+        this->slot(last) = static_cast<std::uint32_t>(index);
+        this->slot(entity) = INVALID_INDEX;
+        this->dense_entities.pop_back();
+
+        return index;
+    }
+
+    void clear() noexcept {
+        for (Entity entity : this->dense_entities) {
+            this->slot(entity) = INVALID_INDEX;
+        }
+        this->dense_entities.clear();
+    }
+
+    void reserve(std::size_t capacity) { this->dense_entities.reserve(capacity); }
+
+    std::size_t             size() const noexcept { return this->dense_entities.size(); }
+    bool                    empty() const noexcept { return this->dense_entities.empty(); }
+    std::span<const Entity> entities() const noexcept { return this->dense_entities; }
+
+    auto begin() const noexcept { return this->dense_entities.cbegin(); }
+    auto end() const noexcept { return this->dense_entities.cend(); }
+
+  private:
+    using Page = std::array<std::uint32_t, PAGE_SIZE>;
+
+    // Sparse entry of an entity whose page is allocated
+    std::uint32_t& slot(Entity entity) noexcept {
+        return (*this->sparse_pages[entity_index(entity) / PAGE_SIZE])[entity_index(entity) % PAGE_SIZE];
+    }
+
+    std::uint32_t slot(Entity entity) const noexcept {
+        return (*this->sparse_pages[entity_index(entity) / PAGE_SIZE])[entity_index(entity) % PAGE_SIZE];
+    }
+
+    Page& page_for(Entity entity) {
+        const std::size_t page = entity_index(entity) / PAGE_SIZE;
+
+        if (page >= this->sparse_pages.size()) {
+            this->sparse_pages.resize(page + 1);
+        }
+
+        if (!this->sparse_pages[page]) {
+            this->sparse_pages[page] = std::make_unique<Page>();
+            this->sparse_pages[page]->fill(INVALID_INDEX);
+        }
+
+        return *this->sparse_pages[page];
+    }
+
+    // Packed array of the entities in the set
+    std::vector<Entity> dense_entities{};
+
+    // Sparse index from an entity index to its position in the dense array, allocated page by page
+    std::vector<std::unique_ptr<Page>> sparse_pages{};
+};
+
+} // namespace Vulqian::Engine::ECS
@@ -0,0 +1,81 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../Types.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+enum class ComponentEvent : std::uint8_t {
+    Add,     // the component was stored on the entity
+    Remove,  // the component is about to be removed, or its entity destroyed
+    Change   // the component was changed since the previous Coordinator::dispatch_changes
+};
+
+using Observer = std::function<void(Entity)>;
+
+// Callbacks registered per event and per component type, indexed by signature bit so a
+// structural change only reaches the observers of the components it touched
+class ObserverRegistry {
+  public:
+    static constexpr std::size_t EVENT_COUNT = 3;
+
+    void add(ComponentEvent event, ComponentType type, Observer observer) {
+        this->observers[index_of(event)][type].push_back(std::move(observer));
+        this->watched[index_of(event)].set(type);
+    }
+
+    // Component types with at least one observer for the event
+    Signature const& watched_types(ComponentEvent event) const noexcept {
+        return this->watched[index_of(event)];
+    }
+
+    bool is_watched(ComponentEvent event, ComponentType type) const noexcept {
+        return this->watched[index_of(event)].test(type);
+    }
+
+    // Observers must not register other observers while they run
+    void notify(ComponentEvent event, ComponentType type, Entity entity) const {
+        for (auto const& observer : this->observers[index_of(event)][type]) {
+            observer(entity);
+        }
+    }
+
+    void notify(ComponentEvent event, ComponentType type, std::span<const Entity> entities) const {
+        for (auto const& observer : this->observers[index_of(event)][type]) {
+            for (Entity entity : entities) {
+                observer(entity);
+            }
+        }
+    }
+
+    // One call per component of `components` that has observers for the event
+    void notify(ComponentEvent event, Signature const& components, Entity entity) const {
+        const Signature notified = components & this->watched[index_of(event)];
+        for (ComponentType type = 0; notified.any() && type < MAX_COMPONENTS; ++type) {
+            if (notified.test(type)) {
+                this->notify(event, type, entity);
+            }
+        }
+    }
+
+  private:
+    static constexpr std::size_t index_of(ComponentEvent event) noexcept {
+        return static_cast<std::size_t>(event);
+    }
+
+    std::array<std::array<std::vector<Observer>, MAX_COMPONENTS>, EVENT_COUNT> observers{};
+    std::array<Signature, EVENT_COUNT>                                         watched{};
+};
+
+} // namespace Vulqian::Engine::ECS
@@ -0,0 +1,58 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Collisions.hpp"
+
+#include <cassert>
+
+namespace Vulqian::Engine::ECS::Systems {
+
+using Vulqian::Engine::ECS::Components::Collider;
+using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+
+void Collisions::init(Vulqian::Engine::ECS::Coordinator& coordinator, Collision::BroadPhaseMode mode, float margin, float cell_size) {
+    this->proxies = EntityProxies{mode, margin, cell_size};
+
+    // Losing either component, or being destroyed, takes the entity out of the broad phase
+    auto drop = [this](Entity entity) { this->proxies.remove(entity); };
+    coordinator.on_remove<Collider>(drop);
+    coordinator.on_remove<Transform_TB_YXZ>(drop);
+}
+
+void Collisions::update(Vulqian::Engine::ECS::Coordinator& coordinator) {
+    const Tick since = this->last_run;
+    this->last_run = coordinator.advance_tick();
+
+    const auto entities = this->entities();
+    this->boxes.resize(entities.size());
+    this->dirty.resize(entities.size());
+
+    // World boxes of the new members and of the ones whose transform or collider changed, in parallel
+    coordinator.parallel_for(entities.size(), this->grain, [this, &coordinator, entities, since](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const Entity entity = entities[i];
+            this->dirty[i] = !this->proxies.contains(entity) || coordinator.get_ticks<Transform_TB_YXZ>(entity).changed > since || coordinator.get_ticks<Collider>(entity).changed > since;
+            if (!this->dirty[i]) {
+                continue;
+            }
+
+            auto const&     transform = coordinator.get_component<const Transform_TB_YXZ>(entity);
+            auto const&     collider = coordinator.get_component<const Collider>(entity);
+            const glm::vec3 half_extents = collider.world_half_extents(glm::mat3{transform.mat4()});
+            this->boxes[i] = {transform.translation - half_extents, transform.translation + half_extents};
+        }
+    });
+
+    // The broad phase itself is updated on this thread
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        if (this->dirty[i]) {
+            this->proxies.update(entities[i], this->boxes[i]);
+        }
+    }
+
+    this->proxies.update_pairs(coordinator.get_thread_pool());
+}
+
+} // namespace Vulqian::Engine::ECS::Systems
@@ -0,0 +1,69 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include "../Components/Collider.hpp"
+#include "../Components/Transform.hpp"
+#include "../Coordinator/Coordinator.hpp"
+#include "Collision/BroadPhase.hpp"
+#include "EntityProxies.hpp"
+#include "System.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Vulqian::Engine::ECS::Systems {
+
+// Broad phase of the entities owning Transform_TB_YXZ + Collider.
+// update() keeps one proxy per entity in a Collision::BroadPhase, only moving the ones whose
+// transform or collider changed since its previous run, then recomputes the overlapping pairs.
+// World boxes come from the local Transform_TB_YXZ, so colliders belong on root entities.
+class Collisions : public System {
+  public:
+    // Pairs of entities whose boxes overlap, first < second
+    using Pair = EntityProxies::Pair;
+
+    // Picks the broad phase and registers the observers dropping proxies, the components must be registered first
+    void init(Vulqian::Engine::ECS::Coordinator& coordinator, Collision::BroadPhaseMode mode = Collision::BroadPhaseMode::AABBTree, float margin = .1f,
+              float cell_size = 2.f);
+
+    void update(Vulqian::Engine::ECS::Coordinator& coordinator);
+
+    // Found by the last update, sorted
+    std::span<const Pair> get_pairs() const noexcept {
+        return this->proxies.get_pairs();
+    }
+
+    // Calls callback(entity) for every entity whose box overlaps `box`
+    template <typename Callback>
+    void query(Collision::AABB const& box, Callback&& callback) const {
+        this->proxies.get_broad_phase().query(box, [&](std::uint32_t user_data) { callback(static_cast<Entity>(user_data)); });
+    }
+
+    // Closest entity whose box the ray hits, its user_data being the entity
+    std::optional<Collision::RayHit> ray_cast(Collision::Ray const& ray) const {
+        return this->proxies.get_broad_phase().ray_cast(ray);
+    }
+
+    Collision::BroadPhase const& get_broad_phase() const noexcept {
+        return this->proxies.get_broad_phase();
+    }
+
+    // Entities per job when computing world boxes
+    std::size_t grain{4096};
+
+  private:
+    EntityProxies proxies{};
+
+    // Scratch of the update: world box of every member and whether its proxy has to be created or moved
+    std::vector<Collision::AABB> boxes{};
+    std::vector<std::uint8_t>    dirty{};
+
+    Tick last_run{};
+};
+
+} // namespace Vulqian::Engine::ECS::Systems
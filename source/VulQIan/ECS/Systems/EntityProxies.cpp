@@ -0,0 +1,43 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "EntityProxies.hpp"
+
+namespace Vulqian::Engine::ECS::Systems {
+
+void EntityProxies::insert(Entity entity, Collision::AABB const& box) {
+    const std::uint32_t index = entity_index(entity);
+    if (index >= this->proxies.size()) {
+        this->proxies.resize(index + 1, NO_PROXY);
+        this->owners.resize(index + 1, NULL_ENTITY);
+    }
+
+    // A previous entity with this index was destroyed without its proxy being removed
+    if (this->proxies[index] != NO_PROXY) {
+        this->broad_phase.remove(this->proxies[index]);
+    }
+    this->proxies[index] = this->broad_phase.add(box, entity);
+    this->owners[index] = entity;
+}
+
+void EntityProxies::update(Entity entity, Collision::AABB const& box) {
+    if (!this->contains(entity)) {
+        this->insert(entity, box);
+        return;
+    }
+
+    const Collision::BroadPhase::ProxyId proxy = this->proxies[entity_index(entity)];
+    this->broad_phase.move(proxy, box, box.center() - this->broad_phase.get_box(proxy).center());
+}
+
+void EntityProxies::remove(Entity entity) {
+    if (this->contains(entity)) {
+        const std::uint32_t index = entity_index(entity);
+        this->broad_phase.remove(this->proxies[index]);
+        this->proxies[index] = NO_PROXY;
+    }
+}
+
+} // namespace Vulqian::Engine::ECS::Systems
@@ -0,0 +1,79 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include "../Types.hpp"
+#include "Collision/BroadPhase.hpp"
+
+#include <cassert>
+#include <span>
+#include <vector>
+
+namespace Vulqian::Engine::ECS::Systems {
+
+// A broad phase holding at most one proxy per entity, shared by the Collisions and Physics systems.
+// Proxies are kept by entity index with the entity they were created for, so a recycled index is not
+// mistaken for the entity that had it before. Every proxy reports its entity as user data.
+class EntityProxies {
+  public:
+    using Pair = Collision::BroadPhase::Pair;
+
+    explicit EntityProxies(Collision::BroadPhaseMode mode = Collision::BroadPhaseMode::AABBTree, float margin = .1f, float cell_size = 2.f)
+        : broad_phase{mode, margin, cell_size} {}
+
+    bool contains(Entity entity) const noexcept {
+        const std::uint32_t index = entity_index(entity);
+        return index < this->proxies.size() && this->owners[index] == entity && this->proxies[index] != NO_PROXY;
+    }
+
+    // Adds the entity's proxy, replacing the one left by a previous entity with the same index
+    void insert(Entity entity, Collision::AABB const& box);
+
+    // `displacement` is the expected motion until the next move, the entity must have a proxy
+    void move(Entity entity, Collision::AABB const& box, glm::vec3 displacement) {
+        assert(this->contains(entity) && "entity without a proxy");
+        this->broad_phase.move(this->proxies[entity_index(entity)], box, displacement);
+    }
+
+    // Moves the entity's proxy, by as much again until the next update as far as can be guessed, or adds it
+    void update(Entity entity, Collision::AABB const& box);
+
+    // Nothing happens if the entity has no proxy
+    void remove(Entity entity);
+
+    // Removes the proxy of every entity for which remove(entity) returns true
+    template <typename Predicate>
+    void remove_if(Predicate&& remove) {
+        for (std::size_t index = 0; index < this->proxies.size(); ++index) {
+            if (this->proxies[index] != NO_PROXY && remove(this->owners[index])) {
+                this->broad_phase.remove(this->proxies[index]);
+                this->proxies[index] = NO_PROXY;
+            }
+        }
+    }
+
+    void update_pairs(Jobs::ThreadPool* pool = nullptr) {
+        this->broad_phase.update_pairs(pool);
+    }
+
+    // Overlapping entities as of the last update_pairs(), sorted
+    std::span<const Pair> get_pairs() const noexcept {
+        return this->broad_phase.get_pairs();
+    }
+
+    Collision::BroadPhase const& get_broad_phase() const noexcept {
+        return this->broad_phase;
+    }
+
+  private:
+    static constexpr Collision::BroadPhase::ProxyId NO_PROXY = ~Collision::BroadPhase::ProxyId{0};
+
+    Collision::BroadPhase                       broad_phase;
+    std::vector<Collision::BroadPhase::ProxyId> proxies{};
+    std::vector<Entity>                         owners{};
+};
+
+} // namespace Vulqian::Engine::ECS::Systems
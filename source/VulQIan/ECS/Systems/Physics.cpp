@@ -0,0 +1,692 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Physics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+#include <glm/gtc/quaternion.hpp>
+
+namespace Vulqian::Engine::ECS::Systems {
+
+using Vulqian::Engine::ECS::Components::Collider;
+using Vulqian::Engine::ECS::Components::ColliderShape;
+using Vulqian::Engine::ECS::Components::RigidBody;
+using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+using Vulqian::Engine::ECS::Components::Velocity;
+
+namespace {
+
+// Pairs closer than this keep the impulses of the point they were matched with
+constexpr float WARM_START_DISTANCE = .1f;
+
+// Contact pairs per narrow phase job, bodies per island solving job
+constexpr std::size_t PAIR_GRAIN = 256;
+constexpr std::size_t ISLAND_GRAIN = 128;
+
+glm::mat3 rotation_matrix(glm::vec3 angles) {
+    return glm::mat3{Transform_TB_YXZ{glm::vec3{0.f}, glm::vec3{1.f}, angles}.mat4()};
+}
+
+// Ry * Rx * Rz, the rotation of Transform_TB_YXZ
+glm::quat orientation_of(glm::vec3 angles) {
+    return glm::angleAxis(angles.y, glm::vec3{0.f, 1.f, 0.f}) * glm::angleAxis(angles.x, glm::vec3{1.f, 0.f, 0.f}) *
+           glm::angleAxis(angles.z, glm::vec3{0.f, 0.f, 1.f});
+}
+
+// Back to Y, X, Z angles from the third column (c2 s1, -s2, c1 c2) and second row (c2 s3, c2 c3) of the matrix.
+// At x = +-pi/2 only y - z or y + z is defined, all of it goes to y.
+glm::vec3 tait_bryan_yxz(glm::quat orientation) {
+    const glm::mat3 m = glm::mat3_cast(orientation);
+    const float     c2 = std::sqrt(m[2][0] * m[2][0] + m[2][2] * m[2][2]);
+    const float     x = std::atan2(-m[2][1], c2);
+    if (c2 > 1e-6f) {
+        return {x, std::atan2(m[2][0], m[2][2]), std::atan2(m[0][1], m[1][1])};
+    }
+    return {x, std::atan2(-m[0][2], m[0][0]), 0.f};
+}
+
+glm::quat orientation_at(std::array<std::vector<float>, 4> const& orientation, std::size_t i) {
+    return glm::quat{orientation[3][i], orientation[0][i], orientation[1][i], orientation[2][i]};
+}
+
+std::uint64_t pair_key(Entity a, Entity b) noexcept {
+    return (static_cast<std::uint64_t>(a) << 32) | b;
+}
+
+} // namespace
+
+void Physics::Bodies::resize(std::size_t count, bool contacts) {
+    for (auto* field : {&this->position, &this->linear, &this->angular, &this->linear_acceleration, &this->angular_acceleration}) {
+        for (auto& axis : *field) {
+            axis.resize(count);
+        }
+    }
+    for (auto& axis : this->orientation) {
+        axis.resize(count);
+    }
+    this->linear_damping.resize(count);
+    this->angular_damping.resize(count);
+
+    if (contacts) {
+        this->entity.resize(count);
+        this->inverse_mass.resize(count);
+        this->inverse_inertia.resize(count);
+        this->shape.resize(count);
+        this->friction.resize(count);
+        this->restitution.resize(count);
+        this->has_collider.resize(count);
+        this->active.resize(count);
+        this->stayed_asleep.resize(count);
+        this->sleep_time.resize(count);
+    }
+}
+
+void Physics::update(Vulqian::Engine::ECS::Coordinator& coordinator, float frame_time) {
+    assert(this->fixed_timestep > 0.f && "the physics step must last some time");
+
+    this->accumulator += frame_time;
+
+    std::uint32_t steps = 0;
+    while (this->accumulator >= this->fixed_timestep && steps < this->max_steps_per_update) {
+        this->accumulator -= this->fixed_timestep;
+        ++steps;
+    }
+
+    // Behind by more than the step budget, the simulation slows down instead of catching up
+    if (this->accumulator >= this->fixed_timestep) {
+        this->accumulator = 0.f;
+    }
+
+    this->simulate(coordinator, steps);
+}
+
+void Physics::step(Vulqian::Engine::ECS::Coordinator& coordinator) {
+    this->simulate(coordinator, 1);
+}
+
+void Physics::simulate(Vulqian::Engine::ECS::Coordinator& coordinator, std::uint32_t steps) {
+    this->step_count = steps;
+    if (steps == 0 || this->entities().empty()) {
+        return;
+    }
+
+    if (this->solve_contacts) {
+        this->simulate_contacts(coordinator, steps);
+        return;
+    }
+
+    this->stats = {};
+    this->stats.awake_bodies = static_cast<std::uint32_t>(this->entities().size());
+    this->stats.islands = this->stats.awake_bodies;
+    this->bodies.resize(this->entities().size(), false);
+
+    // Bodies do not interact, so each job takes its chunk through every step while it stays in cache
+    coordinator.parallel_for(this->entities().size(), this->grain, [this, &coordinator, steps](std::size_t first, std::size_t last) {
+        this->gather(coordinator, first, last);
+        for (std::uint32_t step = 0; step < steps; ++step) {
+            this->integrate(first, last, this->fixed_timestep);
+        }
+        this->scatter(coordinator, first, last);
+    });
+}
+
+void Physics::gather(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last) {
+    const auto entities = this->entities();
+
+    // Damping as a per-step factor, the implicit form 1 / (1 + c dt) never flips the velocity
+    const float dt = this->fixed_timestep;
+
+    for (std::size_t i = first; i < last; ++i) {
+        auto const& transform = coordinator.get_component<const Transform_TB_YXZ>(entities[i]);
+        auto const& body = coordinator.get_component<const RigidBody>(entities[i]);
+        auto const& velocity = coordinator.get_component<const Velocity>(entities[i]);
+
+        // A static body ignores gravity like any other force
+        const glm::vec3 linear_acceleration =
+            body.inverse_mass > 0.f ? this->gravity * body.gravity_scale + body.force * body.inverse_mass : glm::vec3{0.f};
+        const glm::vec3 angular_acceleration = body.torque * body.inverse_inertia;
+
+        const glm::quat orientation = orientation_of(transform.rotation);
+        for (int axis = 0; axis < 4; ++axis) {
+            this->bodies.orientation[axis][i] = orientation[axis];
+        }
+
+        for (int axis = 0; axis < 3; ++axis) {
+            this->bodies.position[axis][i] = transform.translation[axis];
+            this->bodies.linear[axis][i] = velocity.linear[axis];
+            this->bodies.angular[axis][i] = velocity.angular[axis];
+            this->bodies.linear_acceleration[axis][i] = linear_acceleration[axis];
+            this->bodies.angular_acceleration[axis][i] = angular_acceleration[axis];
+        }
+        this->bodies.linear_damping[i] = 1.f / (1.f + body.linear_damping * dt);
+        this->bodies.angular_damping[i] = 1.f / (1.f + body.angular_damping * dt);
+    }
+}
+
+void Physics::integrate(std::size_t first, std::size_t last, float dt) {
+    // One straight loop per axis and field over restrict pointers, so the compiler vectorizes each of them
+    auto integrate_axis = [first, last, dt](float* __restrict value, float* __restrict velocity, float const* __restrict acceleration,
+                                            float const* __restrict damping) {
+        for (std::size_t i = first; i < last; ++i) {
+            velocity[i] = (velocity[i] + acceleration[i] * dt) * damping[i];
+            value[i] += velocity[i] * dt;
+        }
+    };
+    auto integrate_velocity = [first, last, dt](float* __restrict velocity, float const* __restrict acceleration, float const* __restrict damping) {
+        for (std::size_t i = first; i < last; ++i) {
+            velocity[i] = (velocity[i] + acceleration[i] * dt) * damping[i];
+        }
+    };
+
+    for (int axis = 0; axis < 3; ++axis) {
+        integrate_axis(this->bodies.position[axis].data(), this->bodies.linear[axis].data(), this->bodies.linear_acceleration[axis].data(),
+                       this->bodies.linear_damping.data());
+        integrate_velocity(this->bodies.angular[axis].data(), this->bodies.angular_acceleration[axis].data(), this->bodies.angular_damping.data());
+    }
+    this->integrate_orientations(first, last, dt);
+}
+
+void Physics::integrate_orientations(std::size_t first, std::size_t last, float dt) {
+    float* __restrict       qx = this->bodies.orientation[0].data();
+    float* __restrict       qy = this->bodies.orientation[1].data();
+    float* __restrict       qz = this->bodies.orientation[2].data();
+    float* __restrict       qw = this->bodies.orientation[3].data();
+    float const* __restrict wx = this->bodies.angular[0].data();
+    float const* __restrict wy = this->bodies.angular[1].data();
+    float const* __restrict wz = this->bodies.angular[2].data();
+
+    // q += dt / 2 * (0, w) * q, renormalized, still one straight loop the compiler can vectorize.
+    // Bodies that do not turn keep their quaternion bit for bit, so their angles are not rewritten.
+    const float half_dt = .5f * dt;
+    for (std::size_t i = first; i < last; ++i) {
+        const bool turning = (wx[i] != 0.f) | (wy[i] != 0.f) | (wz[i] != 0.f);
+
+        const float x = qx[i] + half_dt * (wx[i] * qw[i] + wy[i] * qz[i] - wz[i] * qy[i]);
+        const float y = qy[i] + half_dt * (wy[i] * qw[i] + wz[i] * qx[i] - wx[i] * qz[i]);
+        const float z = qz[i] + half_dt * (wz[i] * qw[i] + wx[i] * qy[i] - wy[i] * qx[i]);
+        const float w = qw[i] - half_dt * (wx[i] * qx[i] + wy[i] * qy[i] + wz[i] * qz[i]);
+
+        const float inverse_length = 1.f / std::sqrt(x * x + y * y + z * z + w * w);
+        qx[i] = turning ? x * inverse_length : qx[i];
+        qy[i] = turning ? y * inverse_length : qy[i];
+        qz[i] = turning ? z * inverse_length : qz[i];
+        qw[i] = turning ? w * inverse_length : qw[i];
+    }
+}
+
+void Physics::scatter(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last) {
+    const auto entities = this->entities();
+
+    for (std::size_t i = first; i < last; ++i) {
+        auto& transform = coordinator.get_component<Transform_TB_YXZ>(entities[i]);
+        auto& velocity = coordinator.get_component<Velocity>(entities[i]);
+
+        // Angles come back in [-pi, pi], a body that did not turn keeps the ones it had
+        const glm::quat orientation = orientation_at(this->bodies.orientation, i);
+        if (orientation != orientation_of(transform.rotation)) {
+            transform.rotation = tait_bryan_yxz(orientation);
+        }
+
+        for (int axis = 0; axis < 3; ++axis) {
+            transform.translation[axis] = this->bodies.position[axis][i];
+            velocity.linear[axis] = this->bodies.linear[axis][i];
+            velocity.angular[axis] = this->bodies.angular[axis][i];
+        }
+
+        // Forces only last one update, cleared without marking untouched bodies as changed
+        auto const& body = coordinator.get_component<const RigidBody>(entities[i]);
+        if (body.force != glm::vec3{0.f} || body.torque != glm::vec3{0.f}) {
+            auto& cleared = coordinator.get_component<RigidBody>(entities[i]);
+            cleared.force = glm::vec3{0.f};
+            cleared.torque = glm::vec3{0.f};
+        }
+    }
+}
+
+void Physics::simulate_contacts(Vulqian::Engine::ECS::Coordinator& coordinator, std::uint32_t steps) {
+    const auto entities = this->entities();
+    this->bodies.resize(entities.size(), true);
+
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        const std::uint32_t index = entity_index(entities[i]);
+        if (index >= this->body_of.size()) {
+            this->body_of.resize(index + 1, NO_BODY);
+        }
+        this->body_of[index] = static_cast<std::uint32_t>(i);
+    }
+
+    const Tick since = this->last_run;
+    coordinator.parallel_for(entities.size(), this->grain, [this, &coordinator, since](std::size_t first, std::size_t last) {
+        this->gather_contacts(coordinator, first, last, since);
+    });
+    this->sync_proxies();
+
+    for (std::uint32_t step = 0; step < steps; ++step) {
+        this->contact_step(coordinator);
+    }
+
+    coordinator.parallel_for(entities.size(), this->grain, [this, &coordinator](std::size_t first, std::size_t last) {
+        this->scatter_contacts(coordinator, first, last);
+    });
+
+    // Taken after the write back, so the next update only wakes bodies someone else moved in between
+    this->last_run = coordinator.advance_tick();
+}
+
+void Physics::gather_contacts(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last, Tick since) {
+    this->gather(coordinator, first, last);
+
+    const auto entities = this->entities();
+    for (std::size_t i = first; i < last; ++i) {
+        const Entity entity = entities[i];
+        auto const&  transform = coordinator.get_component<const Transform_TB_YXZ>(entity);
+        auto const&  body = coordinator.get_component<const RigidBody>(entity);
+        auto const&  velocity = coordinator.get_component<const Velocity>(entity);
+
+        this->bodies.entity[i] = entity;
+        this->bodies.inverse_mass[i] = body.inverse_mass;
+        this->bodies.inverse_inertia[i] = body.inverse_mass > 0.f ? body.inverse_inertia : glm::vec3{0.f};
+        this->bodies.sleep_time[i] = body.sleep_time;
+
+        Collision::Shape& shape = this->bodies.shape[i];
+        shape.center = transform.translation;
+        shape.axes = rotation_matrix(transform.rotation);
+
+        this->bodies.has_collider[i] = coordinator.has_component<Collider>(entity);
+        if (this->bodies.has_collider[i]) {
+            auto const& collider = coordinator.get_component<const Collider>(entity);
+            shape.type = collider.shape == ColliderShape::Sphere ? Collision::ShapeType::Sphere : Collision::ShapeType::Box;
+            shape.half_extents = collider.half_extents * glm::abs(transform.scale);
+            shape.radius = collider.radius * std::max({std::abs(transform.scale.x), std::abs(transform.scale.y), std::abs(transform.scale.z)});
+            this->bodies.friction[i] = collider.friction;
+            this->bodies.restitution[i] = collider.restitution;
+        }
+
+        // Static bodies never sleep, they only take part while something moves them
+        const bool moving = velocity.linear != glm::vec3{0.f} || velocity.angular != glm::vec3{0.f};
+        bool       awake = moving;
+        if (body.inverse_mass > 0.f) {
+            awake = awake || !body.sleeping || body.force != glm::vec3{0.f} || body.torque != glm::vec3{0.f} ||
+                    coordinator.get_ticks<Transform_TB_YXZ>(entity).changed > since || coordinator.get_ticks<RigidBody>(entity).changed > since;
+        }
+
+        this->bodies.active[i] = awake ? 1.f : 0.f;
+        this->bodies.stayed_asleep[i] = !awake;
+        if (awake && body.sleeping) {
+            this->bodies.sleep_time[i] = 0.f;
+        }
+    }
+}
+
+void Physics::sync_proxies() {
+    // Entities that are no longer colliding bodies of this update leave the broad phase, new colliders enter it
+    const std::size_t count = this->bodies.entity.size();
+    this->proxies.remove_if([this, count](Entity entity) {
+        const std::uint32_t index = entity_index(entity);
+        const std::uint32_t body = index < this->body_of.size() ? this->body_of[index] : NO_BODY;
+        return body >= count || this->bodies.entity[body] != entity || !this->bodies.has_collider[body];
+    });
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (this->bodies.has_collider[i] && !this->proxies.contains(this->bodies.entity[i])) {
+            this->proxies.insert(this->bodies.entity[i], this->bodies.shape[i].bounds());
+        }
+    }
+}
+
+void Physics::contact_step(Vulqian::Engine::ECS::Coordinator& coordinator) {
+    const std::size_t count = this->bodies.entity.size();
+    const float       dt = this->fixed_timestep;
+
+    // Awake bodies moved since the last step, the broad phase follows them on this thread
+    coordinator.parallel_for(count, this->grain, [this](std::size_t first, std::size_t last) { this->refresh_shapes(first, last); });
+    for (std::size_t i = 0; i < count; ++i) {
+        if (this->bodies.has_collider[i] && this->bodies.active[i] > 0.f) {
+            const glm::vec3 displacement{this->bodies.linear[0][i] * dt, this->bodies.linear[1][i] * dt, this->bodies.linear[2][i] * dt};
+            this->proxies.move(this->bodies.entity[i], this->bodies.shape[i].bounds(), displacement);
+        }
+    }
+    this->proxies.update_pairs(coordinator.get_thread_pool());
+
+    this->find_contacts(coordinator.get_thread_pool());
+    this->build_islands();
+
+    coordinator.parallel_for(count, this->grain, [this, dt](std::size_t first, std::size_t last) { this->integrate_velocities(first, last, dt); });
+    this->solve_islands(coordinator.get_thread_pool());
+    coordinator.parallel_for(count, this->grain, [this, dt](std::size_t first, std::size_t last) { this->integrate_positions(first, last, dt); });
+
+    // The next step starts from this step's impulses
+    this->contact_cache.clear();
+    for (std::size_t c = 0; c < this->constraints.size(); ++c) {
+        this->contact_cache[this->constraint_keys[c]] = {this->constraints[c].manifold, this->constraints[c].impulses};
+    }
+
+    this->stats = {};
+    for (std::size_t i = 0; i < count; ++i) {
+        if (this->bodies.inverse_mass[i] > 0.f) {
+            ++(this->bodies.active[i] > 0.f ? this->stats.awake_bodies : this->stats.sleeping_bodies);
+        }
+    }
+    this->stats.islands = static_cast<std::uint32_t>(this->island_body_starts.size() - 1);
+    this->stats.contacts = static_cast<std::uint32_t>(this->constraints.size());
+    for (auto const& constraint : this->constraints) {
+        this->stats.contact_points += constraint.manifold.count;
+    }
+    for (std::size_t island = 0; island + 1 < this->island_constraint_starts.size(); ++island) {
+        if (this->island_constraint_starts[island + 1] > this->island_constraint_starts[island]) {
+            this->stats.solver_iterations += this->solver.velocity_iterations;
+        }
+    }
+}
+
+void Physics::refresh_shapes(std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+        if (this->bodies.active[i] > 0.f) {
+            Collision::Shape& shape = this->bodies.shape[i];
+            shape.center = {this->bodies.position[0][i], this->bodies.position[1][i], this->bodies.position[2][i]};
+            shape.axes = glm::mat3_cast(orientation_at(this->bodies.orientation, i));
+        }
+    }
+}
+
+void Physics::find_contacts(Jobs::ThreadPool* pool) {
+    const auto        pairs = this->proxies.get_pairs();
+    const std::size_t job_count = (pairs.size() + PAIR_GRAIN - 1) / PAIR_GRAIN;
+
+    // Each job fills its own lists, joined in job order so the constraint order does not depend on the threads
+    std::vector<std::vector<Collision::ContactConstraint>> found(job_count);
+    std::vector<std::vector<std::uint64_t>>                found_keys(job_count);
+
+    Jobs::run_jobs(pool, job_count, [&](std::size_t job) {
+        const std::size_t last = std::min(pairs.size(), (job + 1) * PAIR_GRAIN);
+        for (std::size_t p = job * PAIR_GRAIN; p < last; ++p) {
+            const std::uint32_t a = this->body_of[entity_index(pairs[p].first)];
+            const std::uint32_t b = this->body_of[entity_index(pairs[p].second)];
+
+            // Two sleeping bodies stay as they are, nothing pushes static bodies
+            if ((this->bodies.active[a] == 0.f && this->bodies.active[b] == 0.f) ||
+                (this->bodies.inverse_mass[a] == 0.f && this->bodies.inverse_mass[b] == 0.f)) {
+                continue;
+            }
+
+            Collision::ContactConstraint constraint{};
+            if (!Collision::collide(this->bodies.shape[a], this->bodies.shape[b], constraint.manifold)) {
+                continue;
+            }
+            constraint.body_a = a;
+            constraint.body_b = b;
+            constraint.friction = std::sqrt(this->bodies.friction[a] * this->bodies.friction[b]);
+            constraint.restitution = std::max(this->bodies.restitution[a], this->bodies.restitution[b]);
+
+            // Each point starts from the impulses of the nearest point the pair had last step
+            const std::uint64_t key = pair_key(this->bodies.entity[a], this->bodies.entity[b]);
+            if (const auto cached = this->contact_cache.find(key); cached != this->contact_cache.end()) {
+                for (std::uint32_t i = 0; i < constraint.manifold.count; ++i) {
+                    float nearest = WARM_START_DISTANCE * WARM_START_DISTANCE;
+                    for (std::uint32_t j = 0; j < cached->second.manifold.count; ++j) {
+                        const glm::vec3 offset = constraint.manifold.points[i].position - cached->second.manifold.points[j].position;
+                        const float     distance = glm::dot(offset, offset);
+                        if (distance < nearest) {
+                            nearest = distance;
+                            constraint.impulses[i] = cached->second.impulses[j];
+                        }
+                    }
+                }
+            }
+
+            found[job].push_back(constraint);
+            found_keys[job].push_back(key);
+        }
+    });
+
+    this->constraints.clear();
+    this->constraint_keys.clear();
+    for (std::size_t job = 0; job < job_count; ++job) {
+        this->constraints.insert(this->constraints.end(), found[job].begin(), found[job].end());
+        this->constraint_keys.insert(this->constraint_keys.end(), found_keys[job].begin(), found_keys[job].end());
+    }
+}
+
+void Physics::build_islands() {
+    const std::size_t count = this->bodies.entity.size();
+    auto&             parents = this->island_parents;
+
+    parents.resize(count);
+    std::iota(parents.begin(), parents.end(), 0u);
+    auto find = [&parents](std::uint32_t body) {
+        while (parents[body] != body) {
+            parents[body] = parents[parents[body]];
+            body = parents[body];
+        }
+        return body;
+    };
+
+    // Only dynamic bodies join islands, a static floor would otherwise tie everything on it together
+    auto dynamic = [this](std::uint32_t body) { return this->bodies.inverse_mass[body] > 0.f; };
+    for (auto const& constraint : this->constraints) {
+        if (dynamic(constraint.body_a) && dynamic(constraint.body_b)) {
+            const std::uint32_t a = find(constraint.body_a);
+            const std::uint32_t b = find(constraint.body_b);
+            parents[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    // Islands with an awake body or a contact are simulated, their sleeping bodies wake up
+    auto& island_of = this->island_ids;
+    island_of.assign(count, NO_BODY);
+    for (auto const& constraint : this->constraints) {
+        island_of[find(dynamic(constraint.body_a) ? constraint.body_a : constraint.body_b)] = 0;
+    }
+    for (std::uint32_t body = 0; body < count; ++body) {
+        if (dynamic(body) && this->bodies.active[body] > 0.f) {
+            island_of[find(body)] = 0;
+        }
+    }
+
+    // Numbered by their root, which is their lowest body, then laid out by counting
+    this->island_body_starts.assign(1, 0);
+    for (std::uint32_t body = 0; body < count; ++body) {
+        if (parents[body] == body && island_of[body] != NO_BODY) {
+            island_of[body] = static_cast<std::uint32_t>(this->island_body_starts.size() - 1);
+            this->island_body_starts.push_back(0);
+        }
+    }
+    const std::size_t island_count = this->island_body_starts.size() - 1;
+    this->island_constraint_starts.assign(island_count + 1, 0);
+
+    for (std::uint32_t body = 0; body < count; ++body) {
+        if (dynamic(body) && island_of[find(body)] != NO_BODY) {
+            ++this->island_body_starts[island_of[find(body)] + 1];
+        }
+    }
+    for (auto const& constraint : this->constraints) {
+        ++this->island_constraint_starts[island_of[find(dynamic(constraint.body_a) ? constraint.body_a : constraint.body_b)] + 1];
+    }
+    std::partial_sum(this->island_body_starts.begin(), this->island_body_starts.end(), this->island_body_starts.begin());
+    std::partial_sum(this->island_constraint_starts.begin(), this->island_constraint_starts.end(), this->island_constraint_starts.begin());
+
+    std::vector<std::uint32_t> body_cursor(this->island_body_starts.begin(), this->island_body_starts.end() - 1);
+    std::vector<std::uint32_t> constraint_cursor(this->island_constraint_starts.begin(), this->island_constraint_starts.end() - 1);
+    this->island_bodies.resize(this->island_body_starts.back());
+    this->island_constraints.resize(this->island_constraint_starts.back());
+
+    for (std::uint32_t body = 0; body < count; ++body) {
+        if (dynamic(body) && island_of[find(body)] != NO_BODY) {
+            this->island_bodies[body_cursor[island_of[find(body)]]++] = body;
+            this->wake(body);
+        }
+    }
+    for (std::uint32_t c = 0; c < this->constraints.size(); ++c) {
+        auto const& constraint = this->constraints[c];
+        this->island_constraints[constraint_cursor[island_of[find(dynamic(constraint.body_a) ? constraint.body_a : constraint.body_b)]]++] = c;
+    }
+}
+
+void Physics::wake(std::size_t body) noexcept {
+    if (this->bodies.active[body] == 0.f) {
+        this->bodies.active[body] = 1.f;
+        this->bodies.sleep_time[body] = 0.f;
+    }
+    this->bodies.stayed_asleep[body] = false;
+}
+
+void Physics::solve_islands(Jobs::ThreadPool* pool) {
+    const std::size_t island_count = this->island_body_starts.size() - 1;
+    const float       dt = this->fixed_timestep;
+
+    // Whole islands per job, small ones grouped until the job has enough bodies
+    std::vector<std::size_t> groups{0};
+    for (std::size_t island = 0; island < island_count; ++island) {
+        if (this->island_body_starts[island + 1] - this->island_body_starts[groups.back()] >= ISLAND_GRAIN || island + 1 == island_count) {
+            groups.push_back(island + 1);
+        }
+    }
+
+    this->local_index.resize(this->bodies.entity.size());
+    Jobs::run_jobs(pool, groups.size() - 1, [&, this](std::size_t group) {
+        std::vector<Collision::SolverBody>        solver_bodies{};
+        std::vector<Collision::ContactConstraint> solver_constraints{};
+
+        for (std::size_t island = groups[group]; island < groups[group + 1]; ++island) {
+            const std::span<const std::uint32_t> members{this->island_bodies.data() + this->island_body_starts[island],
+                                                         this->island_bodies.data() + this->island_body_starts[island + 1]};
+            const std::span<const std::uint32_t> contacts{this->island_constraints.data() + this->island_constraint_starts[island],
+                                                          this->island_constraints.data() + this->island_constraint_starts[island + 1]};
+
+            if (!contacts.empty()) {
+                auto solver_body = [this](std::uint32_t body) {
+                    const glm::mat3 axes = this->bodies.shape[body].axes;
+                    glm::mat3       diagonal{0.f};
+                    diagonal[0][0] = this->bodies.inverse_inertia[body].x;
+                    diagonal[1][1] = this->bodies.inverse_inertia[body].y;
+                    diagonal[2][2] = this->bodies.inverse_inertia[body].z;
+
+                    Collision::SolverBody solver_body{};
+                    solver_body.position = this->bodies.shape[body].center;
+                    solver_body.linear = {this->bodies.linear[0][body], this->bodies.linear[1][body], this->bodies.linear[2][body]};
+                    solver_body.angular = {this->bodies.angular[0][body], this->bodies.angular[1][body], this->bodies.angular[2][body]};
+                    solver_body.inverse_inertia = axes * diagonal * glm::transpose(axes);
+                    solver_body.inverse_mass = this->bodies.inverse_mass[body];
+                    return solver_body;
+                };
+
+                solver_bodies.clear();
+                for (const std::uint32_t body : members) {
+                    this->local_index[body] = static_cast<std::uint32_t>(solver_bodies.size());
+                    solver_bodies.push_back(solver_body(body));
+                }
+
+                // A static body is copied for each of its contacts, the solver cannot change it anyway
+                auto local = [&, this](std::uint32_t body) {
+                    if (this->bodies.inverse_mass[body] > 0.f) {
+                        return this->local_index[body];
+                    }
+                    solver_bodies.push_back(solver_body(body));
+                    return static_cast<std::uint32_t>(solver_bodies.size() - 1);
+                };
+
+                solver_constraints.clear();
+                for (const std::uint32_t c : contacts) {
+                    Collision::ContactConstraint constraint = this->constraints[c];
+                    constraint.body_a = local(constraint.body_a);
+                    constraint.body_b = local(constraint.body_b);
+                    solver_constraints.push_back(constraint);
+                }
+
+                Collision::solve_contacts(solver_bodies, solver_constraints, this->solver, dt);
+
+                for (const std::uint32_t body : members) {
+                    Collision::SolverBody const& solved = solver_bodies[this->local_index[body]];
+                    for (int axis = 0; axis < 3; ++axis) {
+                        this->bodies.linear[axis][body] = solved.linear[axis];
+                        this->bodies.angular[axis][body] = solved.angular[axis];
+                    }
+                }
+                for (std::size_t c = 0; c < contacts.size(); ++c) {
+                    this->constraints[contacts[c]].impulses = solver_constraints[c].impulses;
+                }
+            }
+
+            // The island sleeps once its slowest-to-settle body was slow long enough
+            float settled = this->time_to_sleep;
+            for (const std::uint32_t body : members) {
+                const glm::vec3 linear{this->bodies.linear[0][body], this->bodies.linear[1][body], this->bodies.linear[2][body]};
+                const glm::vec3 angular{this->bodies.angular[0][body], this->bodies.angular[1][body], this->bodies.angular[2][body]};
+                const bool      slow = glm::dot(linear, linear) < this->linear_sleep_tolerance * this->linear_sleep_tolerance &&
+                                  glm::dot(angular, angular) < this->angular_sleep_tolerance * this->angular_sleep_tolerance;
+
+                this->bodies.sleep_time[body] = slow ? this->bodies.sleep_time[body] + dt : 0.f;
+                settled = std::min(settled, this->bodies.sleep_time[body]);
+            }
+
+            if (settled >= this->time_to_sleep) {
+                for (const std::uint32_t body : members) {
+                    this->bodies.active[body] = 0.f;
+                    for (int axis = 0; axis < 3; ++axis) {
+                        this->bodies.linear[axis][body] = 0.f;
+                        this->bodies.angular[axis][body] = 0.f;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void Physics::integrate_velocities(std::size_t first, std::size_t last, float dt) {
+    // Same loops as integrate(), the accelerations of sleeping bodies masked out
+    auto integrate_axis = [first, last, dt](float* __restrict velocity, float const* __restrict acceleration, float const* __restrict damping,
+                                            float const* __restrict active) {
+        for (std::size_t i = first; i < last; ++i) {
+            velocity[i] = (velocity[i] + acceleration[i] * active[i] * dt) * damping[i];
+        }
+    };
+
+    for (int axis = 0; axis < 3; ++axis) {
+        integrate_axis(this->bodies.linear[axis].data(), this->bodies.linear_acceleration[axis].data(), this->bodies.linear_damping.data(),
+                       this->bodies.active.data());
+        integrate_axis(this->bodies.angular[axis].data(), this->bodies.angular_acceleration[axis].data(), this->bodies.angular_damping.data(),
+                       this->bodies.active.data());
+    }
+}
+
+void Physics::integrate_positions(std::size_t first, std::size_t last, float dt) {
+    auto integrate_axis = [first, last, dt](float* __restrict value, float const* __restrict velocity) {
+        for (std::size_t i = first; i < last; ++i) {
+            value[i] += velocity[i] * dt;
+        }
+    };
+
+    for (int axis = 0; axis < 3; ++axis) {
+        integrate_axis(this->bodies.position[axis].data(), this->bodies.linear[axis].data());
+    }
+    this->integrate_orientations(first, last, dt);
+}
+
+void Physics::scatter_contacts(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last) {
+    const auto entities = this->entities();
+
+    for (std::size_t i = first; i < last; ++i) {
+        // Untouched since the gather, the components are left alone and not marked as changed
+        if (this->bodies.stayed_asleep[i]) {
+            continue;
+        }
+
+        this->scatter(coordinator, i, i + 1);
+
+        auto const& body = coordinator.get_component<const RigidBody>(entities[i]);
+        const bool  sleeping = body.inverse_mass > 0.f && this->bodies.active[i] == 0.f;
+        if (body.sleeping != sleeping || body.sleep_time != this->bodies.sleep_time[i]) {
+            auto& written = coordinator.get_component<RigidBody>(entities[i]);
+            written.sleeping = sleeping;
+            written.sleep_time = this->bodies.sleep_time[i];
+        }
+    }
+}
+
+} // namespace Vulqian::Engine::ECS::Systems
@@ -5,19 +5,168 @@
 
 #pragma once
 
+#include "../Components/Collider.hpp"
+#include "../Components/RigidBody.hpp"
 #include "../Components/Transform.hpp"
 #include "../Coordinator/Coordinator.hpp"
+#include "Collision/BroadPhase.hpp"
+#include "Collision/ContactSolver.hpp"
+#include "Collision/NarrowPhase.hpp"
+#include "EntityProxies.hpp"
 #include "System.hpp"
 
-#include <iostream>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace Vulqian::Engine::ECS::Systems {
 
+// Counters of the last fixed step, to tune the solver and the sleep tolerances
+struct PhysicsStats {
+    std::uint32_t awake_bodies{};
+    std::uint32_t sleeping_bodies{};
+    std::uint32_t islands{};            // awake islands, bodies without contacts count as their own
+    std::uint32_t contacts{};           // touching pairs
+    std::uint32_t contact_points{};
+    std::uint32_t solver_iterations{};  // summed over the islands that had contacts
+};
+
+// Rigid-body dynamics of the entities owning Transform_TB_YXZ + RigidBody + Velocity.
+// update() advances the simulation in fixed steps of semi-implicit Euler: velocities first take
+// gravity, forces and damping, then positions and orientations move by the new velocities. The world
+// space angular velocity turns a quaternion per body, written back as Transform_TB_YXZ angles.
+// Bodies are split in chunks over the thread pool. A job gathers its chunk into structure-of-arrays
+// state, runs every step as branch-free loops over plain float arrays (auto-vectorized), then writes
+// the result back to the components, so the chunk's data stays in cache for the whole update.
+//
+// With solve_contacts, bodies also owning a Collider collide. Each step then finds pairs with a broad
+// phase, contacts with the narrow phase, groups the bodies touching each other into islands and solves
+// the islands in parallel with sequential impulses, warm started from the previous step. An island
+// whose bodies all stayed slow for time_to_sleep falls asleep and costs nothing until something wakes it.
 class Physics : public System {
   public:
-    void update() {
+    // Runs as many fixed steps as fit in the accumulated time, leftover time carries to the next update
+    void update(Vulqian::Engine::ECS::Coordinator& coordinator, float frame_time);
+
+    // One fixed step regardless of the accumulated time
+    void step(Vulqian::Engine::ECS::Coordinator& coordinator);
+
+    // Steps taken by the last update
+    std::uint32_t get_step_count() const noexcept {
+        return this->step_count;
+    }
+
+    // How far the simulation is between its last step and the next one, to interpolate rendering
+    float get_interpolation_alpha() const noexcept {
+        return this->accumulator / this->fixed_timestep;
+    }
 
+    PhysicsStats const& get_stats() const noexcept {
+        return this->stats;
     }
+
+    // The engine's +Y points down
+    glm::vec3 gravity{0.f, 9.81f, 0.f};
+
+    float fixed_timestep{1.f / 60.f};
+
+    // Above this many steps in one update the remaining time is dropped, so a slow frame cannot snowball
+    std::uint32_t max_steps_per_update{8};
+
+    // Bodies per job of a step
+    std::size_t grain{4096};
+
+    // Contacts between bodies owning a Collider, the Collider component must then be registered
+    bool                      solve_contacts{false};
+    Collision::SolverSettings solver{};
+
+    // A body slower than these for time_to_sleep may sleep, once every body of its island can
+    float linear_sleep_tolerance{.05f};   // units per second
+    float angular_sleep_tolerance{.05f};  // radians per second
+    float time_to_sleep{.5f};
+
+  private:
+    // Copy bodies [first, last) between the components and the arrays
+    void gather(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last);
+    void scatter(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last);
+    void integrate(std::size_t first, std::size_t last, float dt);
+    void simulate(Vulqian::Engine::ECS::Coordinator& coordinator, std::uint32_t steps);
+
+    // Contact path: every step runs over all the bodies, as contacts tie any of them together
+    void simulate_contacts(Vulqian::Engine::ECS::Coordinator& coordinator, std::uint32_t steps);
+    void gather_contacts(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last, Tick since);
+    void scatter_contacts(Vulqian::Engine::ECS::Coordinator& coordinator, std::size_t first, std::size_t last);
+    void sync_proxies();
+    void contact_step(Vulqian::Engine::ECS::Coordinator& coordinator);
+    void refresh_shapes(std::size_t first, std::size_t last);
+    void find_contacts(Jobs::ThreadPool* pool);
+    void build_islands();
+    void solve_islands(Jobs::ThreadPool* pool);
+    void integrate_velocities(std::size_t first, std::size_t last, float dt);
+    void integrate_positions(std::size_t first, std::size_t last, float dt);
+    // Turns the orientations by their world space angular velocities
+    void integrate_orientations(std::size_t first, std::size_t last, float dt);
+    void wake(std::size_t body) noexcept;
+
+    // Structure of arrays, one float per body for each axis of each field.
+    // Gravity and forces are folded into per-body accelerations, damping into per-step factors.
+    // Orientations are integrated as unit quaternions and only turned back into Tait-Bryan angles on the write back.
+    struct Bodies {
+        std::array<std::vector<float>, 3> position{};
+        std::array<std::vector<float>, 4> orientation{};  // x, y, z, w
+        std::array<std::vector<float>, 3> linear{};
+        std::array<std::vector<float>, 3> angular{};
+        std::array<std::vector<float>, 3> linear_acceleration{};
+        std::array<std::vector<float>, 3> angular_acceleration{};
+        std::vector<float>                linear_damping{};
+        std::vector<float>                angular_damping{};
+
+        // Contact path only
+        std::vector<Entity>           entity{};
+        std::vector<float>            inverse_mass{};
+        std::vector<glm::vec3>        inverse_inertia{};  // body axes
+        std::vector<Collision::Shape> shape{};
+        std::vector<float>            friction{};
+        std::vector<float>            restitution{};
+        std::vector<std::uint8_t>     has_collider{};
+        std::vector<float>            active{};         // 1 while awake, 0 while asleep, scales the accelerations
+        std::vector<std::uint8_t>     stayed_asleep{};  // asleep for the whole update, nothing to write back
+        std::vector<float>            sleep_time{};
+
+        void resize(std::size_t count, bool contacts);
+    };
+
+    // Impulses of a touching pair, kept from one step to the next to warm start the solver
+    struct CachedContact {
+        Collision::Manifold                                    manifold{};
+        std::array<glm::vec3, Collision::Manifold::MAX_POINTS> impulses{};
+    };
+
+    static constexpr std::uint32_t NO_BODY = ~std::uint32_t{0};
+
+    Bodies        bodies{};
+    float         accumulator{};
+    std::uint32_t step_count{};
+    PhysicsStats  stats{};
+    Tick          last_run{};
+
+    EntityProxies proxies{};  // of the bodies owning a Collider
+
+    std::vector<std::uint32_t>                        body_of{};  // body of each entity index in this update
+    std::vector<Collision::ContactConstraint>         constraints{};
+    std::vector<std::uint64_t>                        constraint_keys{};
+    std::unordered_map<std::uint64_t, CachedContact> contact_cache{};
+
+    // Islands as ranges of island_bodies / island_constraints, and the position of each body in its island.
+    // Built with a union-find over the bodies, numbered by their lowest body so the order is deterministic.
+    std::vector<std::uint32_t> island_parents{};
+    std::vector<std::uint32_t> island_ids{};
+    std::vector<std::uint32_t> island_bodies{};
+    std::vector<std::uint32_t> island_body_starts{};
+    std::vector<std::uint32_t> island_constraints{};
+    std::vector<std::uint32_t> island_constraint_starts{};
+    std::vector<std::uint32_t> local_index{};
 };
 
 } // namespace Vulqian::Engine::ECS::Systems
@@ -68,22 +68,18 @@ void PointLights::createPipeline(VkRenderPass renderPass) {
         pipelineConfig);
 }
 
-void PointLights::render(Vulqian::Engine::Graphics::Frames::Info&         frameInfo,
-                         Vulqian::Engine::ECS::Coordinator&               coordinator,
-                         const std::vector<Vulqian::Engine::ECS::Entity>& entities) {
+void PointLights::render(Vulqian::Engine::Graphics::Frames::Info& frameInfo,
+                         Vulqian::Engine::ECS::Coordinator&       coordinator) {
     // Sort lights by distance from camera
     std::map<float, Vulqian::Engine::ECS::Entity> sorted;
 
-    for (const auto& entity : entities) {
-        if (coordinator.has_component<Vulqian::Engine::ECS::Components::PointLight>(entity)) {
-            auto const& transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-
+    coordinator.each<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ, const Vulqian::Engine::ECS::Components::PointLight>(
+        [&frameInfo, &sorted](Vulqian::Engine::ECS::Entity entity, auto const& transform, auto const&) {
             // Calculate distance from camera to light
             auto  offset = frameInfo.camera.get_position() - transform.translation;
             float disSquared = glm::dot(offset, offset);
             sorted[disSquared] = entity;
-        }
-    }
+        });
 
     this->pipeline->bind(frameInfo.command_buffer);
 
@@ -101,8 +97,8 @@ void PointLights::render(Vulqian::Engine::Graphics::Frames::Info&         frameI
     for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
         const auto& entity = it->second;
 
-        auto const& transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-        auto const& pointLight = coordinator.get_component<Vulqian::Engine::ECS::Components::PointLight>(entity);
+        auto const& transform = coordinator.get_component<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
+        auto const& pointLight = coordinator.get_component<const Vulqian::Engine::ECS::Components::PointLight>(entity);
 
         LightsPushConstants push{};
         push.position = glm::vec4(transform.translation, 1.f);
@@ -121,10 +117,9 @@ void PointLights::render(Vulqian::Engine::Graphics::Frames::Info&         frameI
     }
 }
 
-void PointLights::update(Vulqian::Engine::Graphics::Frames::Info const&   frameInfo,
-                         Vulqian::Engine::Graphics::Frames::GlobalUbo&    ubo,
-                         Vulqian::Engine::ECS::Coordinator&               coordinator,
-                         const std::vector<Vulqian::Engine::ECS::Entity>& entities) const {
+void PointLights::update(Vulqian::Engine::Graphics::Frames::Info const& frameInfo,
+                         Vulqian::Engine::Graphics::Frames::GlobalUbo&  ubo,
+                         Vulqian::Engine::ECS::Coordinator&             coordinator) const {
     // Gentle rotation around the center point
     auto rotateLight = glm::rotate(
         glm::mat4(1.f),
@@ -134,21 +129,18 @@ void PointLights::update(Vulqian::Engine::Graphics::Frames::Info const&   frameI
 
     int lightIndex{0};
 
-    for (const auto& entity : entities) {
-        if (coordinator.has_component<Vulqian::Engine::ECS::Components::PointLight>(entity)) {
+    coordinator.each<Vulqian::Engine::ECS::Components::Transform_TB_YXZ, const Vulqian::Engine::ECS::Components::PointLight>(
+        [&rotateLight, &ubo, &lightIndex](Vulqian::Engine::ECS::Components::Transform_TB_YXZ& transform,
+                                          Vulqian::Engine::ECS::Components::PointLight const& pointLight) {
             assert(lightIndex < Vulqian::Engine::Graphics::Frames::MAX_LIGHTS && "Point lights exceed maximum specified");
 
-            auto&       transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-            auto const& pointLight = coordinator.get_component<Vulqian::Engine::ECS::Components::PointLight>(entity);
-
             transform.translation = glm::vec3(rotateLight * glm::vec4(transform.translation, 1.f));
 
             ubo.pointLights[lightIndex].position = glm::vec4(transform.translation, 1.f);
             ubo.pointLights[lightIndex].color = glm::vec4(pointLight.color, pointLight.lightIntensity);
 
             ++lightIndex;
-        }
-    }
+        });
 
     ubo.numLights = lightIndex;
 }
@@ -165,8 +157,8 @@ void PointLights::render_single_light(Vulqian::Engine::Graphics::Frames::Info& f
         &frameInfo.global_descriptor_set,
         0, nullptr);
 
-    auto const& transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-    auto const& pointLight = coordinator.get_component<Vulqian::Engine::ECS::Components::PointLight>(entity);
+    auto const& transform = coordinator.get_component<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
+    auto const& pointLight = coordinator.get_component<const Vulqian::Engine::ECS::Components::PointLight>(entity);
 
     LightsPushConstants push{};
     push.position = glm::vec4(transform.translation, 1.f);
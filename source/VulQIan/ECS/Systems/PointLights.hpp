@@ -31,14 +31,12 @@ class PointLights {
     PointLights(const PointLights&) = delete;
     PointLights& operator=(const PointLights&) = delete;
 
-    void update(Vulqian::Engine::Graphics::Frames::Info const&   frameInfo,
-                Vulqian::Engine::Graphics::Frames::GlobalUbo&    ubo,
-                Vulqian::Engine::ECS::Coordinator&               coordinator,
-                const std::vector<Vulqian::Engine::ECS::Entity>& entities) const;
-
-    void render(Vulqian::Engine::Graphics::Frames::Info&         frameInfo,
-                Vulqian::Engine::ECS::Coordinator&               coordinator,
-                const std::vector<Vulqian::Engine::ECS::Entity>& entities);
+    void update(Vulqian::Engine::Graphics::Frames::Info const& frameInfo,
+                Vulqian::Engine::Graphics::Frames::GlobalUbo&  ubo,
+                Vulqian::Engine::ECS::Coordinator&             coordinator) const;
+
+    void render(Vulqian::Engine::Graphics::Frames::Info& frameInfo,
+                Vulqian::Engine::ECS::Coordinator&       coordinator);
     void render_single_light(Vulqian::Engine::Graphics::Frames::Info& frameInfo,
                              Vulqian::Engine::ECS::Entity             entity,
                              Vulqian::Engine::ECS::Coordinator&       coordinator);
@@ -0,0 +1,86 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Scheduler.hpp"
+
+#include <chrono>
+#include <utility>
+
+namespace Vulqian::Engine::ECS {
+
+namespace {
+double milliseconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+Scheduler::Scheduler(Jobs::ThreadPool& pool) : pool{pool} {}
+
+void Scheduler::add(std::string name, SystemAccess const& access, std::function<void()> update) {
+    this->nodes.push_back(Node{std::move(name), access, std::move(update)});
+}
+
+void Scheduler::clear() {
+    this->nodes.clear();
+    this->timings.clear();
+}
+
+void Scheduler::run() {
+    const auto start = std::chrono::steady_clock::now();
+
+    this->build_graph();
+
+    Jobs::WaitGroup group{};
+    for (std::size_t i = 0; i < this->nodes.size(); ++i) {
+        if (this->nodes[i].dependency_count == 0) {
+            this->launch(i, group);
+        }
+    }
+    this->pool.wait(group);
+
+    this->frame_milliseconds = milliseconds_since(start);
+}
+
+void Scheduler::build_graph() {
+    this->remaining = std::vector<std::atomic<std::size_t>>(this->nodes.size());
+    this->timings.assign(this->nodes.size(), Timing{});
+
+    for (std::size_t later = 0; later < this->nodes.size(); ++later) {
+        auto& node = this->nodes[later];
+        node.dependents.clear();
+        node.dependency_count = 0;
+        this->timings[later].name = &node.name;
+
+        for (std::size_t earlier = 0; earlier < later; ++earlier) {
+            if (this->nodes[earlier].access.conflicts_with(node.access)) {
+                this->nodes[earlier].dependents.push_back(later);
+                ++node.dependency_count;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < this->nodes.size(); ++i) {
+        this->remaining[i].store(this->nodes[i].dependency_count, std::memory_order_relaxed);
+    }
+}
+
+void Scheduler::launch(std::size_t node, Jobs::WaitGroup& group) {
+    auto job = [this, node, &group] {
+        const auto start = std::chrono::steady_clock::now();
+        this->nodes[node].update();
+        this->timings[node].milliseconds = milliseconds_since(start);
+
+        // Dependents are submitted before this job completes, so the group cannot drain early
+        for (std::size_t dependent : this->nodes[node].dependents) {
+            if (this->remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                this->launch(dependent, group);
+            }
+        }
+    };
+
+    this->pool.submit(std::move(job), group);
+}
+
+} // namespace Vulqian::Engine::ECS
@@ -0,0 +1,68 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include "../../Jobs/ThreadPool.hpp"
+#include "System.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Vulqian::Engine::ECS {
+
+// Runs a frame's systems on the thread pool.
+// Each run builds a dependency graph from the declared accesses: a system waits for every system
+// added before it that it conflicts with, so the result matches running them in insertion order,
+// while systems touching disjoint components run concurrently.
+class Scheduler {
+  public:
+    struct Timing {
+        std::string const* name{nullptr};
+        double             milliseconds{};
+    };
+
+    explicit Scheduler(Jobs::ThreadPool& pool);
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    void add(std::string name, SystemAccess const& access, std::function<void()> update);
+    void clear();
+
+    // Blocks until every system ran, the calling thread takes part in the work
+    void run();
+
+    // Time spent in each system during the last run, in insertion order
+    std::span<const Timing> get_timings() const noexcept { return this->timings; }
+
+    // Wall time of the last run, including scheduling overhead
+    double get_frame_milliseconds() const noexcept { return this->frame_milliseconds; }
+
+  private:
+    struct Node {
+        std::string              name;
+        SystemAccess             access;
+        std::function<void()>    update;
+        std::vector<std::size_t> dependents{};        // nodes waiting on this one
+        std::size_t              dependency_count{};  // nodes this one waits on
+    };
+
+    void build_graph();
+    void launch(std::size_t node, Jobs::WaitGroup& group);
+
+    Jobs::ThreadPool& pool;
+
+    std::vector<Node>                     nodes{};
+    std::vector<std::atomic<std::size_t>> remaining{};
+    std::vector<Timing>                   timings{};
+    double                                frame_milliseconds{};
+};
+
+} // namespace Vulqian::Engine::ECS
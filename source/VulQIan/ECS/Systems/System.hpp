@@ -5,16 +5,41 @@
 
 #pragma once
 
+#include "../Entities/SparseSet.hpp"
 #include "../Types.hpp"
-#include "../Coordinator/Coordinator.hpp"
 
-#include <set>
+#include <cstddef>
+#include <span>
 
 namespace Vulqian::Engine::ECS {
 
+// Components a system reads and writes, as signature bits
+struct SystemAccess {
+    Signature reads{};
+    Signature writes{};
+
+    // Two systems can run at the same time unless one writes a component the other one uses
+    bool conflicts_with(SystemAccess const& other) const noexcept {
+        return (this->writes & (other.reads | other.writes)).any() || (other.writes & this->reads).any();
+    }
+};
+
 class System {
     public:
-        std::set<Entity> entities;
+        // Members as one packed array, so updates walk contiguous memory and can split it in chunks.
+        // The order only depends on the sequence of membership changes, it is the same from run to run.
+        std::span<const Entity> entities() const noexcept { return this->members.entities(); }
+
+        bool contains(Entity entity) const noexcept { return this->members.contains(entity); }
+
+        // Declared by the owner of the system so the Scheduler can order it against the others
+        SystemAccess access{};
+
+    private:
+        friend class SystemManager;
+
+        // O(1) membership changes, removal moves the last member into the hole
+        SparseSet members{};
 };
 
 } // namespace Vulqian::Engine::ECS
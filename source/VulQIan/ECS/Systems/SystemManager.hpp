@@ -5,13 +5,18 @@
 
 #pragma once
 
+#include "../TypeIndex.hpp"
 #include "../Types.hpp"
 #include "Physics.hpp"
 #include "System.hpp"
 
+#include <array>
+#include <bit>
 #include <cassert>
+#include <limits>
 #include <memory>
-#include <unordered_map>
+#include <span>
+#include <vector>
 
 namespace Vulqian::Engine::ECS {
 
@@ -19,58 +24,148 @@ class SystemManager {
   public:
     template <typename T>
     std::shared_ptr<T> register_system() {
-        const char* typeName = typeid(T).name();
+        const std::size_t type_index = TypeIndex<SystemFamily>::of<T>();
 
-        assert(systems.find(typeName) == systems.end() && "Registering system more than once.");
+        assert(!this->is_registered(type_index) && "Registering system more than once.");
+
+        if (type_index >= this->system_slots.size()) {
+            this->system_slots.resize(type_index + 1, INVALID_SLOT);
+        }
 
         // Create a pointer to the system and return it so it can be used externally
         auto system = std::make_shared<T>();
-        systems.insert({typeName, system});
+        this->system_slots[type_index] = this->systems.size();
+        this->systems.push_back(system);
+        this->signatures.emplace_back();
+        this->rebuild_index();
         return system;
     }
 
     template <typename T>
     void set_signature(Signature signature) {
-        const char* typeName = typeid(T).name();
+        const std::size_t type_index = TypeIndex<SystemFamily>::of<T>();
 
-        assert(systems.find(typeName) != systems.end() && "System used before registered.");
+        assert(this->is_registered(type_index) && "System used before registered.");
 
         // Set the signature for this system
-        signatures.try_emplace(typeName, signature);
+        this->signatures[this->system_slots[type_index]] = signature;
+        this->rebuild_index();
+    }
+
+    // Only the systems requiring one of the entity's components can hold it
+    void entity_destroyed(Entity entity, Signature const& entitySignature) const {
+        this->for_each_affected(entitySignature, [this, entity](std::size_t system) { leave(*this->systems[system], entity); });
+    }
+
+    // Only the systems requiring a component that was added or removed are tested
+    void entity_signature_changed(Entity entity, Signature const& previous, Signature const& entitySignature) {
+        this->for_each_affected(previous ^ entitySignature, [this, entity, &entitySignature](std::size_t system) {
+            this->update(system, entity, entitySignature);
+        });
+    }
+
+    // Batched versions of the above
+    void entities_destroyed(std::span<const Entity> entities, std::span<const Signature> entitySignatures) const {
+        assert(entities.size() == entitySignatures.size() && "one signature is needed per entity");
+
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            this->entity_destroyed(entities[i], entitySignatures[i]);
+        }
+    }
+
+    void entities_signature_changed(std::span<const Entity> entities, std::span<const Signature> previous, std::span<const Signature> entitySignatures) {
+        assert(entities.size() == entitySignatures.size() && entities.size() == previous.size() && "one signature is needed per entity");
+
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            this->entity_signature_changed(entities[i], previous[i], entitySignatures[i]);
+        }
+    }
+
+  private:
+    void update(std::size_t system, Entity entity, Signature const& entitySignature) const {
+        auto const& systemSignature = this->signatures[system];
+
+        // Entity signature matches system signature - insert into set, otherwise erase from set
+        if ((entitySignature & systemSignature) == systemSignature) {
+            join(*this->systems[system], entity);
+        } else {
+            leave(*this->systems[system], entity);
+        }
     }
 
-    void entity_destroyed(Entity entity) const {
-        // Erase a destroyed entity from all system lists
-        // entities is a set so no check needed
-        for (auto const& [type, system_ptr] : this->systems) {
-            auto const& system = system_ptr;
+    // Calls fn(system) once for every system whose signature shares a bit with `components`,
+    // plus the systems with an empty signature which follow every entity
+    template <typename Function>
+    void for_each_affected(Signature const& components, Function&& fn) const {
+        if (components.none()) {
+            return;
+        }
 
-            system->entities.erase(entity);
+        for (std::size_t system : this->unfiltered_systems) {
+            fn(system);
+        }
+
+        auto bits = components.to_ulong();
+        while (bits != 0) {
+            const auto type = static_cast<ComponentType>(std::countr_zero(bits));
+            bits &= bits - 1;
+
+            // A system listed under several of the bits is only visited for the lowest one
+            const Signature lower = components & Signature{(1ul << type) - 1};
+            for (std::size_t system : this->systems_by_component[type]) {
+                if ((this->signatures[system] & lower).none()) {
+                    fn(system);
+                }
+            }
         }
     }
 
-    void entity_signature_changed(Entity entity, Signature const& entitySignature) {
-        // Notify each system that an entity's signature changed
-        for (auto const& [type, system] : systems) {
-            auto const& systemSignature = signatures[type];
+    void rebuild_index() {
+        for (auto& systems : this->systems_by_component) {
+            systems.clear();
+        }
+        this->unfiltered_systems.clear();
 
-            // Entity signature matches system signature - insert into set
-            if ((entitySignature & systemSignature) == systemSignature) {
-                system->entities.insert(entity);
+        for (std::size_t system = 0; system < this->signatures.size(); ++system) {
+            if (this->signatures[system].none()) {
+                this->unfiltered_systems.push_back(system);
             }
-            // Entity signature does not match system signature - erase from set
-            else {
-                system->entities.erase(entity);
+            for (ComponentType type = 0; type < MAX_COMPONENTS; ++type) {
+                if (this->signatures[system].test(type)) {
+                    this->systems_by_component[type].push_back(system);
+                }
             }
         }
     }
 
-  private:
-    // Map from system type string pointer to a signature
-    std::unordered_map<const char*, Signature> signatures{};
+    static void join(System& system, Entity entity) {
+        if (!system.members.contains(entity)) {
+            system.members.insert(entity);
+        }
+    }
+
+    static void leave(System& system, Entity entity) {
+        if (system.members.contains(entity)) {
+            system.members.erase(entity);
+        }
+    }
+
+    static constexpr std::size_t INVALID_SLOT = std::numeric_limits<std::size_t>::max();
+
+    bool is_registered(std::size_t type_index) const noexcept {
+        return type_index < this->system_slots.size() && this->system_slots[type_index] != INVALID_SLOT;
+    }
+
+    // Position of each system in the packed arrays below, indexed by its static type index
+    std::vector<std::size_t> system_slots{};
+
+    // Registered systems and their signatures, in registration order
+    std::vector<std::shared_ptr<System>> systems{};
+    std::vector<Signature>               signatures{};
 
-    // Map from system type string pointer to a system pointer
-    std::unordered_map<const char*, std::shared_ptr<System>> systems{};
+    // Slots of the systems requiring each component, and of the systems requiring none
+    std::array<std::vector<std::size_t>, MAX_COMPONENTS> systems_by_component{};
+    std::vector<std::size_t>                             unfiltered_systems{};
 };
 
 } // namespace Vulqian::Engine::ECS
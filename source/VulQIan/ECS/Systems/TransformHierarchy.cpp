@@ -0,0 +1,188 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include <glm/glm.hpp>
+
+namespace Vulqian::Engine::ECS::Systems {
+
+using Vulqian::Engine::ECS::Components::Children;
+using Vulqian::Engine::ECS::Components::Parent;
+using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+using Vulqian::Engine::ECS::Components::WorldTransform;
+
+void TransformHierarchy::init(Vulqian::Engine::ECS::Coordinator& coordinator) {
+    // Membership or links changed, the depth order has to be rebuilt
+    auto invalidate = [this](Entity) { this->order_dirty = true; };
+    coordinator.on_add<Transform_TB_YXZ>(invalidate);
+    coordinator.on_remove<Transform_TB_YXZ>(invalidate);
+    coordinator.on_add<WorldTransform>(invalidate);
+    coordinator.on_remove<WorldTransform>(invalidate);
+    coordinator.on_add<Parent>(invalidate);
+
+    // A destroyed child leaves its parent's list, children of a destroyed parent become roots on the next rebuild
+    coordinator.on_remove<Parent>([this, &coordinator](Entity child, Parent const& parent) {
+        this->order_dirty = true;
+
+        if (coordinator.is_alive(parent.entity) && coordinator.has_component<Children>(parent.entity)) {
+            std::erase(coordinator.get_component<Children>(parent.entity).entities, child);
+        }
+    });
+}
+
+void TransformHierarchy::set_parent(Vulqian::Engine::ECS::Coordinator& coordinator, Entity child, Entity parent) {
+    assert(child != parent && "an entity cannot be its own parent");
+
+    // Walking up from the new parent must never reach the child
+    for (Entity ancestor = parent; ancestor != NULL_ENTITY && coordinator.has_component<Parent>(ancestor);) {
+        ancestor = coordinator.get_component<const Parent>(ancestor).entity;
+        assert(ancestor != child && "parenting would create a cycle");
+    }
+
+    if (coordinator.has_component<Parent>(child)) {
+        // Detaching runs the on_remove observer, which unlinks the child from its previous parent
+        coordinator.remove_component<Parent>(child);
+    }
+
+    if (parent != NULL_ENTITY) {
+        coordinator.add_component(child, Parent{parent});
+
+        if (!coordinator.has_component<Children>(parent)) {
+            coordinator.add_component(parent, Children{});
+        }
+        coordinator.get_component<Children>(parent).entities.push_back(child);
+    }
+
+    // The local transform is now relative to another matrix
+    if (coordinator.has_component<Transform_TB_YXZ>(child)) {
+        coordinator.mark_changed<Transform_TB_YXZ>(child);
+    }
+
+    this->order_dirty = true;
+}
+
+Entity TransformHierarchy::parent_of(Vulqian::Engine::ECS::Coordinator& coordinator, Entity entity) const {
+    if (!coordinator.has_component<Parent>(entity)) {
+        return NULL_ENTITY;
+    }
+
+    const Entity parent = coordinator.get_component<const Parent>(entity).entity;
+    return coordinator.is_alive(parent) && this->contains(parent) ? parent : NULL_ENTITY;
+}
+
+void TransformHierarchy::rebuild_order(Vulqian::Engine::ECS::Coordinator& coordinator) {
+    this->order.clear();
+    this->parents.clear();
+
+    for (Entity entity : this->entities()) {
+        if (this->parent_of(coordinator, entity) == NULL_ENTITY) {
+            this->order.push_back(entity);
+            this->parents.push_back(NO_PARENT);
+        }
+    }
+    this->root_count = this->order.size();
+
+    // Breadth-first from the roots, so depth never decreases along the order
+    for (std::size_t i = 0; i < this->order.size(); ++i) {
+        const Entity entity = this->order[i];
+        if (!coordinator.has_component<Children>(entity)) {
+            continue;
+        }
+
+        for (Entity child : coordinator.get_component<const Children>(entity).entities) {
+            if (coordinator.is_alive(child) && this->contains(child) && this->parent_of(coordinator, child) == entity) {
+                this->order.push_back(child);
+                this->parents.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+    }
+
+    this->order_dirty = false;
+}
+
+void TransformHierarchy::update(Vulqian::Engine::ECS::Coordinator& coordinator) {
+    const Tick since = this->last_run;
+    this->last_run = coordinator.advance_tick();
+
+    // After a rebuild roots may have lost their parent, everything is recomputed once
+    const bool full_update = this->order_dirty;
+    if (this->order_dirty) {
+        this->rebuild_order(coordinator);
+    }
+
+    this->recomputed.assign(this->order.size(), 0);
+    this->updated_count = 0;
+
+    auto is_dirty = [&](std::size_t i) {
+        const std::uint32_t parent = this->parents[i];
+        return full_update || (parent != NO_PARENT && this->recomputed[parent] != 0) ||
+               coordinator.get_ticks<Transform_TB_YXZ>(this->order[i]).changed > since ||
+               coordinator.get_ticks<WorldTransform>(this->order[i]).added > since;
+    };
+
+    // Roots come first in the order, their local transforms are gathered and computed in one batch
+    this->dirty_roots.clear();
+    for (std::uint32_t i = 0; i < this->root_count; ++i) {
+        if (is_dirty(i)) {
+            this->dirty_roots.push_back(i);
+        }
+    }
+
+    const std::size_t batch_size = this->dirty_roots.size();
+    for (auto& field : this->root_fields) {
+        field.resize(batch_size);
+    }
+    this->root_models.resize(batch_size);
+    this->root_normals.resize(batch_size);
+
+    for (std::size_t k = 0; k < batch_size; ++k) {
+        auto const& local = coordinator.get_component<const Transform_TB_YXZ>(this->order[this->dirty_roots[k]]);
+        for (int axis = 0; axis < 3; ++axis) {
+            this->root_fields[axis][k] = local.translation[axis];
+            this->root_fields[3 + axis][k] = local.rotation[axis];
+            this->root_fields[6 + axis][k] = local.scale[axis];
+        }
+    }
+
+    const Math::TransformArrays roots{
+        this->root_fields[0].data(), this->root_fields[1].data(), this->root_fields[2].data(),
+        this->root_fields[3].data(), this->root_fields[4].data(), this->root_fields[5].data(),
+        this->root_fields[6].data(), this->root_fields[7].data(), this->root_fields[8].data(),
+        batch_size,
+    };
+    Math::compute_transform_matrices(roots, this->root_models.data(), this->root_normals.data());
+
+    for (std::size_t k = 0; k < batch_size; ++k) {
+        auto& world = coordinator.get_component<WorldTransform>(this->order[this->dirty_roots[k]]);
+        world.world_matrix = this->root_models[k];
+        world.normal_matrix = this->root_normals[k];
+
+        this->recomputed[this->dirty_roots[k]] = 1;
+    }
+    this->updated_count = batch_size;
+
+    for (std::size_t i = this->root_count; i < this->order.size(); ++i) {
+        if (!is_dirty(i)) {
+            continue;
+        }
+
+        auto const& local = coordinator.get_component<const Transform_TB_YXZ>(this->order[i]);
+        auto&       world = coordinator.get_component<WorldTransform>(this->order[i]);
+
+        world.world_matrix = coordinator.get_component<const WorldTransform>(this->order[this->parents[i]]).world_matrix * local.mat4();
+
+        // Parents may scale non-uniformly, the inverse transpose keeps normals perpendicular
+        world.normal_matrix = glm::mat4{glm::transpose(glm::inverse(glm::mat3{world.world_matrix}))};
+
+        this->recomputed[i] = 1;
+        ++this->updated_count;
+    }
+}
+
+} // namespace Vulqian::Engine::ECS::Systems
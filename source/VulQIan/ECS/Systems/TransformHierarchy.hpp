@@ -0,0 +1,72 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include "../Components/Hierarchy.hpp"
+#include "../Components/Transform.hpp"
+#include "../Coordinator/Coordinator.hpp"
+#include "Math/TransformKernel.hpp"
+#include "System.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace Vulqian::Engine::ECS::Systems {
+
+// Keeps the WorldTransform of every entity owning Transform_TB_YXZ + WorldTransform up to date.
+// Entities are walked parent first, a world matrix is only recomputed when the entity's local
+// transform changed, it was just added, or its parent's world matrix was recomputed.
+// An entity whose parent is dead or not part of the system is treated as a root.
+// Dirty roots are computed together by the SIMD batch kernel, children one by one after their parent.
+class TransformHierarchy : public System {
+  public:
+    // Registers the observers keeping the hierarchy consistent, the components must be registered first
+    void init(Vulqian::Engine::ECS::Coordinator& coordinator);
+
+    // Attaches `child` under `parent`, detaching it from its previous parent, NULL_ENTITY makes it a root again
+    void set_parent(Vulqian::Engine::ECS::Coordinator& coordinator, Entity child, Entity parent);
+
+    void update(Vulqian::Engine::ECS::Coordinator& coordinator);
+
+    // Members sorted so every parent comes before its children
+    std::span<const Entity> depth_order() const noexcept {
+        return this->order;
+    }
+
+    // World matrices recomputed by the last update
+    std::size_t get_updated_count() const noexcept {
+        return this->updated_count;
+    }
+
+  private:
+    static constexpr std::uint32_t NO_PARENT = std::numeric_limits<std::uint32_t>::max();
+
+    void rebuild_order(Vulqian::Engine::ECS::Coordinator& coordinator);
+
+    // Parent of `entity` if it is alive and part of the system, NULL_ENTITY otherwise
+    Entity parent_of(Vulqian::Engine::ECS::Coordinator& coordinator, Entity entity) const;
+
+    // Depth-sorted members, with the position of each one's parent in `order` or NO_PARENT
+    std::vector<Entity>        order{};
+    std::vector<std::uint32_t> parents{};
+    std::vector<std::uint8_t>  recomputed{};
+    std::size_t                root_count{};
+
+    // Scratch of the root batch: positions in `order`, local transforms as structure of arrays, results
+    std::vector<std::uint32_t>        dirty_roots{};
+    std::array<std::vector<float>, 9> root_fields{};
+    std::vector<glm::mat4>            root_models{};
+    std::vector<glm::mat4>            root_normals{};
+
+    bool        order_dirty{true};
+    Tick        last_run{};
+    std::size_t updated_count{};
+};
+
+} // namespace Vulqian::Engine::ECS::Systems
@@ -0,0 +1,43 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace Vulqian::Engine::ECS {
+
+// Families keep the indices of unrelated kinds of types dense and separate
+struct ComponentFamily {};
+struct SystemFamily {};
+
+// Hands out a dense index per type within a family, without RTTI.
+// The index is assigned the first time a type is seen and cached in a static afterwards,
+// so looking it up is a plain load that can be used to index arrays directly.
+template <typename Family>
+class TypeIndex {
+  public:
+    template <typename T>
+    static std::size_t of() noexcept {
+        return TypeIndex::index_of<std::remove_cv_t<T>>();
+    }
+
+  private:
+    static std::size_t next() noexcept {
+        static std::atomic<std::size_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Function local so the index is valid even when first used during static initialization
+    template <typename T>
+    static std::size_t index_of() noexcept {
+        static const std::size_t index = TypeIndex::next();
+        return index;
+    }
+};
+
+} // namespace Vulqian::Engine::ECS
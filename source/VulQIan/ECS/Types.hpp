@@ -10,8 +10,34 @@
 
 namespace Vulqian::Engine::ECS {
 
+// Entity handles pack a slot index in the low bits and a version in the high bits.
+// The version is bumped every time a slot is recycled, so a handle kept after its entity
+// was destroyed no longer matches the slot and can be detected as stale.
 using Entity = std::uint32_t;
-const Entity MAX_ENTITIES = 500;
+
+const std::uint32_t ENTITY_INDEX_BITS = 20;
+const std::uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+const std::uint32_t ENTITY_VERSION_MASK = (1u << (32 - ENTITY_INDEX_BITS)) - 1;
+
+// Upper bound of the entity index space, storage is grown on demand up to it.
+// The last index is reserved so NULL_ENTITY can never be alive.
+const Entity MAX_ENTITIES = 1u << ENTITY_INDEX_BITS;
+const Entity NULL_ENTITY = ~Entity{0};
+
+// Version reserved for handles recorded in a CommandBuffer before their entity exists, never given to a live entity
+const std::uint32_t PENDING_ENTITY_VERSION = ENTITY_VERSION_MASK;
+
+constexpr std::uint32_t entity_index(Entity entity) noexcept {
+    return entity & ENTITY_INDEX_MASK;
+}
+
+constexpr std::uint32_t entity_version(Entity entity) noexcept {
+    return entity >> ENTITY_INDEX_BITS;
+}
+
+constexpr Entity make_entity(std::uint32_t index, std::uint32_t version) noexcept {
+    return ((version & ENTITY_VERSION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+}
 
 // Used to define the size of arrays later on
 using ComponentType = std::uint8_t;
@@ -19,4 +45,19 @@ const ComponentType MAX_COMPONENTS = 32;
 
 using Signature = std::bitset<MAX_COMPONENTS>;
 
+// Logical clock of the world, advanced by Coordinator::advance_tick and stamped on components when they change
+using Tick = std::uint32_t;
+
+// When a component was added to its entity and when a mutable reference to it was last handed out
+struct ComponentTicks {
+    Tick added{};
+    Tick changed{};
+};
+
+// Layout used by the Coordinator to store components
+enum class StorageMode : std::uint8_t {
+    SparseSet,  // one packed array per component type
+    Archetype   // entities grouped by signature in 16 KiB chunks of per-component columns
+};
+
 } // namespace Vulqian::Engine::ECS
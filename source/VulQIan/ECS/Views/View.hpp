@@ -0,0 +1,215 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../Components/ComponentArray.hpp"
+#include "../Types.hpp"
+
+namespace Vulqian::Engine::ECS {
+
+// Filter tag: entities owning any of these components are skipped by a view
+template <typename... Ts>
+struct Exclude {};
+
+template <typename... Ts>
+inline constexpr Exclude<Ts...> exclude{};
+
+// Filter tags keeping only entities where any of these components changed / was added after `since`,
+// e.g. each<Transform>(fn, changed<Transform>(last_run)) where last_run came from Coordinator::advance_tick
+template <typename... Ts>
+struct Changed {
+    Tick since{};
+};
+
+template <typename... Ts>
+struct Added {
+    Tick since{};
+};
+
+template <typename... Ts>
+constexpr Changed<Ts...> changed(Tick since) noexcept {
+    return Changed<Ts...>{since};
+}
+
+template <typename... Ts>
+constexpr Added<Ts...> added(Tick since) noexcept {
+    return Added<Ts...>{since};
+}
+
+// Iterates every entity owning all of Ts... and none of the excluded components.
+// The smallest of the requested arrays drives the iteration, the others are only probed
+// through their sparse index, so no hashing or signature copy happens per entity.
+// Requesting `const T` hands out a read-only reference, a mutable T stamps the component as changed at `tick`.
+// Adding or removing components of the viewed types while iterating is not supported.
+template <typename... Ts>
+class View {
+    static_assert(sizeof...(Ts) > 0, "a view needs at least one component type");
+
+  public:
+    template <typename T>
+    using array_t = ComponentArray<std::remove_const_t<T>>;
+
+    template <std::size_t ExcludedCount>
+    View(std::tuple<array_t<Ts>*...> arrays, std::array<IComponentArray const*, ExcludedCount> const& excluded_arrays, Tick tick = 0)
+        : arrays{arrays}, tick{tick} {
+        static_assert(ExcludedCount <= MAX_COMPONENTS, "too many excluded components");
+
+        this->excluded_count = ExcludedCount;
+        for (std::size_t i = 0; i < ExcludedCount; ++i) {
+            this->excluded[i] = excluded_arrays[i];
+        }
+
+        // The smallest array bounds the amount of entities that can match
+        std::apply([this](auto*... array) {
+            for (IComponentArray const* candidate : {static_cast<IComponentArray const*>(array)...}) {
+                if (this->driver == nullptr || candidate->size() < this->driver->size()) {
+                    this->driver = candidate;
+                }
+            }
+        },
+                   this->arrays);
+    }
+
+    bool contains(Entity entity) const noexcept {
+        const bool has_all = std::apply([entity](auto*... array) { return (array->contains(entity) && ...); }, this->arrays);
+
+        return has_all && !this->excluded_by(entity);
+    }
+
+    template <typename T>
+    T& get(Entity entity) {
+        return this->at<T>(std::get<array_t<T>*>(this->arrays)->index_of(entity));
+    }
+
+    // Calls fn(entity, components...) or fn(components...) for every matching entity
+    template <typename Function>
+    void each(Function&& fn) {
+        this->each_in(0, this->driver->size(), fn);
+    }
+
+    // Same as each() restricted to candidates()[first, last), used to split the work between threads
+    template <typename Function>
+    void each_in(std::size_t first, std::size_t last, Function&& fn) {
+        this->each_in(first, last, fn, std::index_sequence_for<Ts...>{});
+    }
+
+    // Entities the view walks before filtering, an upper bound of the matches
+    std::span<const Entity> candidates() const noexcept { return this->driver->entities(); }
+
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entity;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entity*;
+        using reference = Entity;
+
+        Iterator() = default;
+        Iterator(View const* view, std::span<const Entity>::iterator current, std::span<const Entity>::iterator last)
+            : view{view}, current{current}, last{last} {
+            this->skip_mismatches();
+        }
+
+        Entity operator*() const noexcept { return *this->current; }
+
+        Iterator& operator++() {
+            ++this->current;
+            this->skip_mismatches();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(Iterator const& other) const noexcept { return this->current == other.current; }
+
+      private:
+        void skip_mismatches() {
+            while (this->current != this->last && !this->view->contains(*this->current)) {
+                ++this->current;
+            }
+        }
+
+        View const*                       view{nullptr};
+        std::span<const Entity>::iterator current{};
+        std::span<const Entity>::iterator last{};
+    };
+
+    Iterator begin() const {
+        auto entities = this->driver->entities();
+        return Iterator{this, entities.begin(), entities.end()};
+    }
+
+    Iterator end() const {
+        auto entities = this->driver->entities();
+        return Iterator{this, entities.end(), entities.end()};
+    }
+
+  private:
+    template <typename Function, std::size_t... Is>
+    void each_in(std::size_t first, std::size_t last, Function& fn, std::index_sequence<Is...> /*indices*/) {
+        std::array<std::size_t, sizeof...(Ts)> indices{};
+
+        for (Entity entity : this->candidates().subspan(first, last - first)) {
+            // Each dense index is looked up once, then serves both the membership test and the component access
+            const bool has_all = (((indices[Is] = std::get<Is>(this->arrays)->find(entity)) != SparseSet::NOT_FOUND) && ...);
+            if (!has_all || this->excluded_by(entity)) {
+                continue;
+            }
+
+            if constexpr (std::is_invocable_v<Function&, Entity, Ts&...>) {
+                fn(entity, this->at<Ts>(indices[Is])...);
+            } else {
+                fn(this->at<Ts>(indices[Is])...);
+            }
+        }
+    }
+
+    // Component at a dense index of its array
+    template <typename T>
+    T& at(std::size_t index) {
+        auto* array = std::get<array_t<T>*>(this->arrays);
+
+        if constexpr (!std::is_const_v<T>) {
+            array->ticks_at(index).changed = this->tick;
+        }
+        return array->data_at(index);
+    }
+
+    bool excluded_by(Entity entity) const noexcept {
+        for (std::size_t i = 0; i < this->excluded_count; ++i) {
+            if (this->excluded[i]->contains(entity)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::tuple<array_t<Ts>*...> arrays;
+
+    // Array of the requested component with the fewest entries
+    IComponentArray const* driver{nullptr};
+
+    std::array<IComponentArray const*, MAX_COMPONENTS> excluded{};
+    std::size_t                                        excluded_count{};
+
+    // Stamped on the mutable components handed out
+    Tick tick{};
+};
+
+} // namespace Vulqian::Engine::ECS
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "Assets/AssetRegistry.hpp"
+
 #include "ECS/ECS.hpp"
 
 #include "Exception/Exception.hpp"
@@ -15,6 +17,7 @@
 #include "Graphics/Device/Device.hpp"
 #include "Graphics/Frames/Frame.hpp"
 #include "Graphics/Model/Model.hpp"
+#include "Graphics/Pipeline/ComputePipeline.hpp"
 #include "Graphics/Pipeline/Pipeline.hpp"
 #include "Graphics/Renderer/RenderSystem.hpp"
 #include "Graphics/Renderer/Renderer.hpp"
@@ -23,6 +26,8 @@
 #include "Input/Keyboard/Keyboard.hpp"
 #include "Input/Mouse/Mouse.hpp"
 
+#include "Jobs/ThreadPool.hpp"
+
 #include "Window/Window.hpp"
 
 #include "Utils/Utils.hpp"
@@ -9,6 +9,8 @@
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
 
+#include "../../Math/Frustum.hpp"
+
 namespace Vulqian::Engine::Graphics {
 class Camera {
    public:
@@ -27,6 +29,11 @@ class Camera {
     const glm::mat4& get_inverse_view() const noexcept { return this->inverse_view_matrix; }
     glm::vec3        get_position() const noexcept { return glm::vec3(inverse_view_matrix[3]); }
 
+    // Planes of what the camera sees, from the current projection and view
+    Vulqian::Engine::Math::Frustum get_frustum() const noexcept {
+        return Vulqian::Engine::Math::Frustum::from_matrix(this->projection_matrix * this->view_matrix);
+    }
+
    private:
     glm::mat4 projection_matrix{1.f};
     glm::mat4 view_matrix{1.f};
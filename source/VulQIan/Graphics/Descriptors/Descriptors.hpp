@@ -3,6 +3,8 @@
 // This software is provided 'as is' and without any warranty, express or implied.
 // The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
 
+#pragma once
+
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -49,6 +49,8 @@ class Device {
     VkQueue                    graphicsQueue() const noexcept { return this->graphics_queue; }
     VkQueue                    presentQueue() const noexcept { return this->present_queue; }
     VkPhysicalDeviceProperties get_physical_device_properties() const noexcept { return this->properties; }
+    // Indirect draws may start past instance 0, which the GPU-driven path of RenderSystem needs
+    bool                       supports_indirect_first_instance() const noexcept { return this->indirect_first_instance; }
 
     SwapChainSupportDetails getSwapChainSupport() noexcept { return querySwapChainSupport(this->physical_device); }
     uint32_t                findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
@@ -99,6 +101,8 @@ class Device {
     VkQueue      graphics_queue;
     VkQueue      present_queue;
 
+    bool indirect_first_instance{false};
+
     const std::vector<const char*> validation_layers = {"VK_LAYER_KHRONOS_validation"};
     const std::vector<const char*> device_extensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 };
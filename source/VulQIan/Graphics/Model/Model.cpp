@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <unordered_map>
 
@@ -33,9 +34,64 @@ struct hash<Vulqian::Engine::Graphics::Model::Vertex> {
 } // namespace std
 
 namespace Vulqian::Engine::Graphics {
-Model::Model(Vulqian::Engine::Graphics::Device& device, const Data& data) : device(device), file_name(data.filepath) {
+
+namespace {
+
+// Box around the vertices, and the sphere centered on it through the farthest vertex
+void bounds_of(std::vector<Model::Vertex> const& vertices, Vulqian::Engine::Math::BoundingBox& box, Vulqian::Engine::Math::BoundingSphere& sphere) {
+    if (vertices.empty()) {
+        box = {};
+        sphere = {};
+        return;
+    }
+
+    box = {vertices.front().position, vertices.front().position};
+    for (auto const& vertex : vertices) {
+        box.min = glm::min(box.min, vertex.position);
+        box.max = glm::max(box.max, vertex.position);
+    }
+
+    sphere.center = (box.min + box.max) * .5f;
+    float farthest = 0.f;
+    for (auto const& vertex : vertices) {
+        const glm::vec3 offset = vertex.position - sphere.center;
+        farthest = std::max(farthest, glm::dot(offset, offset));
+    }
+    sphere.radius = std::sqrt(farthest);
+}
+
+void split_attributes(std::vector<Model::Vertex> const& vertices, std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals) {
+    positions.resize(vertices.size());
+    normals.resize(vertices.size());
+    std::transform(vertices.begin(), vertices.end(), positions.begin(), [](Model::Vertex const& vertex) { return vertex.position; });
+    std::transform(vertices.begin(), vertices.end(), normals.begin(), [](Model::Vertex const& vertex) { return vertex.normal; });
+}
+
+} // namespace
+Model::Model(Vulqian::Engine::Graphics::Device& device, const Data& data) : device(device), file_name(data.filepath), box(data.box), sphere(data.sphere) {
     this->create_vertex_buffers(data.vertices);
     this->create_index_buffers(data.indices);
+
+    // Data filled by hand rather than loaded
+    if (this->sphere.radius < 0.f) {
+        bounds_of(data.vertices, this->box, this->sphere);
+    }
+
+    this->lods = data.lods;
+    if (this->lods.empty()) {
+        this->lods.push_back({0, this->has_index_buffer ? this->index_count : this->vertex_count, 0.f});
+    }
+
+    // Kept on the CPU for the software occlusion culling
+    this->positions.reserve(data.vertices.size());
+    for (Vertex const& vertex : data.vertices) {
+        this->positions.push_back(vertex.position);
+    }
+    if (this->has_index_buffer) {
+        this->meshlets = data.meshlets;
+        this->create_meshlet_buffers(this->meshlets);
+        this->indices.assign(data.indices.begin() + this->lods[0].first_index, data.indices.begin() + this->lods[0].first_index + this->lods[0].index_count);
+    }
 }
 
 void Model::create_vertex_buffers(const std::vector<Vertex>& vertices) {
@@ -93,13 +149,48 @@ void Model::create_index_buffers(const std::vector<uint32_t>& indices) {
         this->device,
         index_size,
         this->index_count,
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,  // read by the cluster culling too
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT // host = cpu
     );
 
     this->device.copyBuffer(index_buffer.getBuffer(), this->index_buffer->getBuffer(), buffer_size);
 }
 
+void Model::create_meshlet_buffers(const std::vector<Vulqian::Engine::Math::Meshlet>& meshlets) {
+    if (meshlets.empty()) {
+        return;
+    }
+
+    std::vector<MeshletData> data(meshlets.size());
+    std::transform(meshlets.begin(), meshlets.end(), data.begin(), [](Vulqian::Engine::Math::Meshlet const& meshlet) {
+        return MeshletData{
+            glm::vec4{meshlet.sphere.center, meshlet.sphere.radius},
+            glm::vec4{meshlet.cone_apex, 0.f},
+            glm::vec4{meshlet.cone_axis, meshlet.cone_cutoff},
+            meshlet.first_index,
+            meshlet.index_count};
+    });
+
+    Vulqian::Engine::Graphics::Buffer staging_buffer{
+        this->device,
+        sizeof(MeshletData),
+        static_cast<uint32_t>(data.size()),
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    };
+    staging_buffer.map();
+    staging_buffer.writeToBuffer((void*)data.data());
+
+    this->meshlet_buffer = std::make_unique<Vulqian::Engine::Graphics::Buffer>(
+        this->device,
+        sizeof(MeshletData),
+        static_cast<uint32_t>(data.size()),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    this->device.copyBuffer(staging_buffer.getBuffer(), this->meshlet_buffer->getBuffer(), sizeof(MeshletData) * data.size());
+}
+
 std::unique_ptr<Model> Model::create_model_from_file(Vulqian::Engine::Graphics::Device& device, const std::string& filepath) {
     Data data{};
     data.load_model(filepath);
@@ -117,11 +208,49 @@ void Model::bind(VkCommandBuffer command_buffer) {
     }
 }
 
-void Model::draw(VkCommandBuffer command_buffer) const {
+void Model::draw(VkCommandBuffer command_buffer, uint32_t instance_count, uint32_t first_instance, uint32_t lod) const {
+    assert(lod < this->lods.size() && "Level of detail out of range.");
+    if (this->has_index_buffer) {
+        vkCmdDrawIndexed(command_buffer, this->lods[lod].index_count, instance_count, this->lods[lod].first_index, 0, first_instance);
+    } else {
+        vkCmdDraw(command_buffer, this->vertex_count, instance_count, 0, first_instance);
+    }
+}
+
+void Model::draw_range(VkCommandBuffer command_buffer, Vulqian::Engine::Math::IndexRange const& range, uint32_t instance_count, uint32_t first_instance) const {
+    assert(this->has_index_buffer && "Index ranges need an index buffer.");
+    vkCmdDrawIndexed(command_buffer, range.index_count, instance_count, range.first_index, 0, first_instance);
+}
+
+VkDescriptorBufferInfo Model::get_meshlet_buffer_info() const noexcept {
+    assert(this->meshlet_buffer != nullptr && "Model has no meshlets.");
+    return {this->meshlet_buffer->getBuffer(), 0, VK_WHOLE_SIZE};
+}
+
+VkDescriptorBufferInfo Model::get_index_buffer_info() const noexcept {
+    assert(this->has_index_buffer && "Model has no index buffer.");
+    return {this->index_buffer->getBuffer(), 0, VK_WHOLE_SIZE};
+}
+
+void Model::write_indirect_command(VkDrawIndexedIndirectCommand& command, uint32_t first_instance, uint32_t lod) const noexcept {
+    assert(lod < this->lods.size() && "Level of detail out of range.");
+    command = {};
+    if (this->has_index_buffer) {
+        command.indexCount = this->lods[lod].index_count;
+        command.firstIndex = this->lods[lod].first_index;
+        command.firstInstance = first_instance;
+    } else {
+        // instanceCount sits at the same offset in both layouts
+        const VkDrawIndirectCommand draw{this->vertex_count, 0, 0, first_instance};
+        std::memcpy(&command, &draw, sizeof(draw));
+    }
+}
+
+void Model::draw_indirect(VkCommandBuffer command_buffer, VkBuffer commands, VkDeviceSize offset) const {
     if (this->has_index_buffer) {
-        vkCmdDrawIndexed(command_buffer, this->index_count, 1, 0, 0, 0);
+        vkCmdDrawIndexedIndirect(command_buffer, commands, offset, 1, sizeof(VkDrawIndexedIndirectCommand));
     } else {
-        vkCmdDraw(command_buffer, this->vertex_count, 1, 0, 0);
+        vkCmdDrawIndirect(command_buffer, commands, offset, 1, sizeof(VkDrawIndexedIndirectCommand));
     }
 }
 
@@ -194,6 +323,58 @@ void Model::Data::load_model(const std::string& model_filepath) {
             indices.push_back(unique_vertices[vertex]);
         }
     }
+
+    this->compute_bounds();
+    this->generate_lods();
+    this->build_meshlets();
+}
+
+void Model::Data::compute_bounds() {
+    bounds_of(this->vertices, this->box, this->sphere);
+}
+
+void Model::Data::generate_lods(std::size_t count) {
+    this->lods.clear();
+    if (this->indices.empty()) {
+        return;
+    }
+    this->lods.push_back({0, static_cast<uint32_t>(this->indices.size()), 0.f});
+
+    std::vector<glm::vec3> positions{};
+    std::vector<glm::vec3> normals{};
+    split_attributes(this->vertices, positions, normals);
+
+    // Each level simplified from the original, so its error is measured against it. The levels then follow
+    // the original in the one index buffer, all drawn from the same vertices.
+    const std::vector<uint32_t> original = this->indices;
+    while (this->lods.size() < count) {
+        const auto simplified = Vulqian::Engine::Math::simplify(positions, normals, original, this->lods.back().index_count / 2);
+        if (simplified.indices.empty() || simplified.indices.size() * 10 > this->lods.back().index_count * 9) {
+            break;
+        }
+        this->lods.push_back({static_cast<uint32_t>(this->indices.size()), static_cast<uint32_t>(simplified.indices.size()), simplified.error});
+        this->indices.insert(this->indices.end(), simplified.indices.begin(), simplified.indices.end());
+    }
+}
+
+void Model::Data::build_meshlets(std::size_t min_triangles) {
+    this->meshlets.clear();
+    const Vulqian::Engine::Math::LodLevel finest = this->lods.empty() ? Vulqian::Engine::Math::LodLevel{0, static_cast<uint32_t>(this->indices.size()), 0.f} : this->lods.front();
+    if (finest.index_count / 3 < min_triangles) {
+        return;
+    }
+
+    std::vector<glm::vec3> positions{};
+    std::vector<glm::vec3> normals{};
+    split_attributes(this->vertices, positions, normals);
+
+    // Same triangles, meshlet after meshlet, so each visible meshlet is one range of the level
+    auto clustered = Vulqian::Engine::Math::build_meshlets(positions, normals, std::span<const uint32_t>{this->indices}.subspan(finest.first_index, finest.index_count));
+    std::copy(clustered.indices.begin(), clustered.indices.end(), this->indices.begin() + finest.first_index);
+    for (auto& meshlet : clustered.meshlets) {
+        meshlet.first_index += finest.first_index;
+    }
+    this->meshlets = std::move(clustered.meshlets);
 }
 
 } // namespace Vulqian::Engine::Graphics
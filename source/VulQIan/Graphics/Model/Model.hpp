@@ -5,6 +5,10 @@
 
 #pragma once
 
+#include "../../Assets/AssetRegistry.hpp"
+#include "../../Math/Frustum.hpp"
+#include "../../Math/Meshlets.hpp"
+#include "../../Math/Simplifier.hpp"
 #include "../Buffer/Buffer.hpp"
 #include "../Device/Device.hpp"
 
@@ -37,9 +41,40 @@ class Model {
         std::vector<uint32_t> indices{};
         std::string           filepath;
 
+        // Local space bounds of the vertices, a negative radius until computed
+        Vulqian::Engine::Math::BoundingBox    box{};
+        Vulqian::Engine::Math::BoundingSphere sphere{{}, -1.f};
+
+        // Index ranges of the levels of detail, finest first, the whole of `indices` as one level when empty
+        std::vector<Vulqian::Engine::Math::LodLevel> lods{};
+
+        // Clusters of the finest level, whose indices they reorder, none for small meshes
+        std::vector<Vulqian::Engine::Math::Meshlet> meshlets{};
+
         void load_model(const std::string& filepath);
+        void compute_bounds();
+        // Appends up to `count` - 1 simplified copies of the indices, each about half the previous one,
+        // stopping early once simplifying stops paying off
+        void generate_lods(std::size_t count = MAX_LODS);
+        // Splits the finest level into meshlets when it has at least `min_triangles` triangles
+        void build_meshlets(std::size_t min_triangles = MIN_CLUSTERED_TRIANGLES);
+    };
+
+    // A meshlet as cull_clusters.comp reads it, std430 layout
+    struct MeshletData {
+        glm::vec4     sphere{};     // radius in w
+        glm::vec4     cone_apex{};
+        glm::vec4     cone_axis{};  // cutoff in w
+        uint32_t      first_index{};
+        uint32_t      index_count{};
+        uint32_t      padding[2]{};
     };
 
+    static constexpr std::size_t MAX_LODS = 4;
+
+    // Below this many triangles culling the whole model is fine enough, and one draw is cheaper than a few ranges
+    static constexpr std::size_t MIN_CLUSTERED_TRIANGLES = 1024;
+
     Model(Vulqian::Engine::Graphics::Device& device, const Data& vertices);
     ~Model() = default;
 
@@ -50,13 +85,38 @@ class Model {
     static std::unique_ptr<Model> create_model_from_file(Vulqian::Engine::Graphics::Device& device, const std::string& filepath);
 
     void bind(VkCommandBuffer command_buffer);
-    void draw(VkCommandBuffer command_buffer) const;
+    // Instances [first_instance, first_instance + instance_count) of the vertex buffers bound at binding 1 and up,
+    // with the indices of level of detail `lod`
+    void draw(VkCommandBuffer command_buffer, uint32_t instance_count = 1, uint32_t first_instance = 0, uint32_t lod = 0) const;
+    // Only the indices of `range`, as kept by the culling of the meshlets
+    void draw_range(VkCommandBuffer command_buffer, Vulqian::Engine::Math::IndexRange const& range, uint32_t instance_count = 1, uint32_t first_instance = 0) const;
+    // Indirect draws: the command is written with no instance yet, a compute pass then counts them into instanceCount.
+    // The record is always sizeof(VkDrawIndexedIndirectCommand), a model without indices uses its first VkDrawIndirectCommand bytes.
+    void write_indirect_command(VkDrawIndexedIndirectCommand& command, uint32_t first_instance, uint32_t lod = 0) const noexcept;
+    void draw_indirect(VkCommandBuffer command_buffer, VkBuffer commands, VkDeviceSize offset) const;
 
     std::string get_file_name(void) const noexcept { return this->file_name; }
 
+    Vulqian::Engine::Math::BoundingBox const&    get_bounding_box() const noexcept { return this->box; }
+    Vulqian::Engine::Math::BoundingSphere const& get_bounding_sphere() const noexcept { return this->sphere; }
+
+    // At least one, a model without indices has only one
+    std::vector<Vulqian::Engine::Math::LodLevel> const& get_lods() const noexcept { return this->lods; }
+
+    // Local space triangles of the finest level, for the CPU rasterizer of the occlusion culling
+    std::vector<glm::vec3> const& get_positions() const noexcept { return this->positions; }
+    std::vector<uint32_t> const&  get_indices() const noexcept { return this->indices; }
+
+    // Meshlets of the finest level, empty for a model drawn whole
+    std::vector<Vulqian::Engine::Math::Meshlet> const& get_meshlets() const noexcept { return this->meshlets; }
+    // Storage buffers of the cluster culling pass: the meshlets as MeshletData, and the indices they point into
+    VkDescriptorBufferInfo get_meshlet_buffer_info() const noexcept;
+    VkDescriptorBufferInfo get_index_buffer_info() const noexcept;
+
   private:
     void create_vertex_buffers(const std::vector<Vertex>& vertices);
     void create_index_buffers(const std::vector<uint32_t>& indices);
+    void create_meshlet_buffers(const std::vector<Vulqian::Engine::Math::Meshlet>& meshlets);
 
     Vulqian::Engine::Graphics::Device& device;
 
@@ -65,9 +125,24 @@ class Model {
 
     std::unique_ptr<Vulqian::Engine::Graphics::Buffer> vertex_buffer;
     std::unique_ptr<Vulqian::Engine::Graphics::Buffer> index_buffer;
+    std::unique_ptr<Vulqian::Engine::Graphics::Buffer> meshlet_buffer;
 
     bool has_index_buffer{false};
 
     std::string file_name;
+
+    Vulqian::Engine::Math::BoundingBox    box{};
+    Vulqian::Engine::Math::BoundingSphere sphere{};
+
+    std::vector<Vulqian::Engine::Math::LodLevel> lods{};
+
+    std::vector<glm::vec3> positions{};
+    std::vector<uint32_t>  indices{};
+
+    std::vector<Vulqian::Engine::Math::Meshlet> meshlets{};
 };
+
+// Models shared by path and contents, their vertex and index buffers freed once no Mesh uses them
+using ModelRegistry = Vulqian::Engine::Assets::AssetRegistry<Model>;
+
 } // namespace Vulqian::Engine::Graphics
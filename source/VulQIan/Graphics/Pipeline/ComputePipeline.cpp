@@ -0,0 +1,66 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "ComputePipeline.hpp"
+
+#include <bit>
+#include <cassert>
+
+#include "../../Exception/Exception.hpp"
+#include "Pipeline.hpp"
+
+namespace Vulqian::Engine::Graphics {
+
+ComputePipeline::ComputePipeline(Vulqian::Engine::Graphics::Device& device, const std::string& comp_filepath, VkPipelineLayout pipeline_layout)
+    : device(device) {
+    assert(pipeline_layout != VK_NULL_HANDLE && "Cannot create compute pipeline:: no pipeline_layout provided.");
+
+    auto comp_code = Pipeline::read_file(comp_filepath);
+
+    VkShaderModuleCreateInfo module_info{};
+    module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    module_info.codeSize = comp_code.size();
+    module_info.pCode = std::bit_cast<const uint32_t*>(comp_code.data());
+
+    if (vkCreateShaderModule(this->device.get_device(), &module_info, nullptr, &this->comp_module) != VK_SUCCESS) {
+        throw Vulqian::Exception::failed_to_create("shader module");
+    }
+
+    VkComputePipelineCreateInfo pipeline_info{};
+    pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline_info.stage.module = this->comp_module;
+    pipeline_info.stage.pName = "main";
+    pipeline_info.layout = pipeline_layout;
+    pipeline_info.basePipelineIndex = -1;
+    pipeline_info.basePipelineHandle = VK_NULL_HANDLE;
+
+    if (vkCreateComputePipelines(this->device.get_device(), VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &this->compute_pipeline) != VK_SUCCESS) {
+        vkDestroyShaderModule(this->device.get_device(), this->comp_module, nullptr);
+        throw Vulqian::Exception::failed_to_create("compute pipeline");
+    }
+}
+
+ComputePipeline::~ComputePipeline() {
+    vkDestroyShaderModule(this->device.get_device(), this->comp_module, nullptr);
+    vkDestroyPipeline(this->device.get_device(), this->compute_pipeline, nullptr);
+}
+
+void ComputePipeline::bind(VkCommandBuffer command_buffer) {
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->compute_pipeline);
+}
+
+void ComputePipeline::dispatch(VkCommandBuffer command_buffer, uint32_t invocations, uint32_t group_size) {
+    assert(group_size > 0 && "workgroup size must not be 0");
+    vkCmdDispatch(command_buffer, (invocations + group_size - 1) / group_size, 1, 1);
+}
+
+void ComputePipeline::dispatch(VkCommandBuffer command_buffer, VkExtent2D invocations, uint32_t group_size) {
+    assert(group_size > 0 && "workgroup size must not be 0");
+    vkCmdDispatch(command_buffer, (invocations.width + group_size - 1) / group_size, (invocations.height + group_size - 1) / group_size, 1);
+}
+
+}  // namespace Vulqian::Engine::Graphics
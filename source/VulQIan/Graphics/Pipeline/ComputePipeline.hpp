@@ -0,0 +1,35 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <string>
+
+#include "../Device/Device.hpp"
+
+namespace Vulqian::Engine::Graphics {
+
+// A single compute shader with its layout, recorded outside of any render pass
+class ComputePipeline {
+   public:
+    ComputePipeline(Vulqian::Engine::Graphics::Device& device, const std::string& comp_filepath, VkPipelineLayout pipeline_layout);
+    ~ComputePipeline();
+
+    ComputePipeline(const ComputePipeline&) = delete;
+    ComputePipeline& operator=(const ComputePipeline&) = delete;
+
+    void bind(VkCommandBuffer command_buffer);
+    // As many workgroups of `group_size` invocations as needed to cover `invocations`
+    void dispatch(VkCommandBuffer command_buffer, uint32_t invocations, uint32_t group_size);
+    // Same over an image, with square workgroups of `group_size` x `group_size` invocations
+    void dispatch(VkCommandBuffer command_buffer, VkExtent2D invocations, uint32_t group_size);
+
+   private:
+    Device&        device;
+    VkPipeline     compute_pipeline;
+    VkShaderModule comp_module;
+};
+
+}  // namespace Vulqian::Engine::Graphics
@@ -46,11 +46,13 @@ class Pipeline {
     static void get_default_config(PipelineConstructInfo& default_conf) noexcept;
     static void enable_alpha_blending(PipelineConstructInfo& configInfo);
 
+    // Whole SPIR-V file, shared with the ComputePipeline
+    static std::vector<char> read_file(const std::string& path);
+
    private:
     void create_graphics_pipeline(const std::string& vert_filepath, const std::string& frag_filepath, const PipelineConstructInfo& config);
     void create_shader_module(const std::vector<char>& code, VkShaderModule* shader_mod) const;
 
-    static std::vector<char> read_file(const std::string& path);
     Device&                  device;
     VkPipeline               graphics_pipeline;
     VkShaderModule           vert_module;
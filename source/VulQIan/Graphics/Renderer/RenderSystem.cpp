@@ -9,11 +9,76 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
 #include <iostream>
+#include <limits>
 #include <map>
 
 namespace Vulqian::Engine::Graphics {
 
+namespace {
+
+// Grown by doubling like the instance buffers, the host visible ones kept mapped. True when `buffer` was recreated.
+bool reserve_buffer(Vulqian::Engine::Graphics::Device& device, std::unique_ptr<Vulqian::Engine::Graphics::Buffer>& buffer,
+                    VkDeviceSize element_size, std::size_t count, VkBufferUsageFlags usage, VkMemoryPropertyFlags memory) {
+    if (buffer != nullptr && buffer->getInstanceCount() >= count) {
+        return false;
+    }
+    const std::size_t capacity = std::max<std::size_t>(count, buffer == nullptr ? count : 2 * buffer->getInstanceCount());
+    buffer = std::make_unique<Vulqian::Engine::Graphics::Buffer>(device, element_size, static_cast<uint32_t>(capacity), usage, memory);
+    if (memory & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        buffer->map();
+    }
+    return true;
+}
+
+}  // namespace
+
+// local_size_x of cull_instances.comp and cull_clusters.comp, and both local sizes of hiz_reduce.comp
+constexpr uint32_t CULLING_GROUP_SIZE = 64;
+constexpr uint32_t REDUCE_GROUP_SIZE = 8;
+
+// Down to one texel for attachments up to 32768 wide
+constexpr uint32_t MAX_PYRAMID_LEVELS = 16;
+
+static_assert(sizeof(RenderSystem::SceneInstance) == 176, "SceneInstance must match the std430 layout of cull_instances.comp");
+static_assert(sizeof(Model::MeshletData) == 64, "MeshletData must match the std430 layout of cull_clusters.comp");
+
+struct RenderSystem::CullingPush {
+    glm::mat4     view_projection{1.f};  // of the frame the pyramid was built from
+    glm::vec2     pyramid_size{};
+    std::uint32_t instance_count{};
+    std::uint32_t draw_count{};
+    std::uint32_t phase{};      // 0 before the opaque draws, 1 to test their occluded instances again
+    std::uint32_t occlusion{};  // whether the first phase tests the pyramid
+    std::uint32_t pyramid_levels{};
+    std::uint32_t padding{};
+};
+
+// Counters buffer of cull_instances.comp
+struct CullingCounters {
+    std::uint32_t visible{};      // kept by the first phase
+    std::uint32_t occluded{};     // set aside by the first phase
+    std::uint32_t disoccluded{};  // kept by the second phase
+    std::uint32_t padding{};
+};
+
+// Push constants of cull_clusters.comp, the entities of one model
+struct ClusterPush {
+    std::uint32_t first_instance{};  // in the frame's instances and commands
+    std::uint32_t instance_count{};
+    std::uint32_t meshlet_count{};
+    std::uint32_t cone_culling{};
+};
+
+struct ReducePushConstantData {
+    glm::ivec2 source_size{};
+    glm::ivec2 destination_size{};
+};
+
 struct SimplePushConstantData {
     glm::mat4 model_matrix{1.f};
     glm::mat4 normal_matrix{1.f};
@@ -23,10 +88,18 @@ struct SimplePushConstantData {
 RenderSystem::RenderSystem(Vulqian::Engine::Graphics::Device& device, VkRenderPass render_pass, VkDescriptorSetLayout global_set_layout) : device{device} {
     this->create_pipeline_layout(global_set_layout);
     this->create_pipeline(render_pass);
+    this->create_culling_pipeline(global_set_layout);
+    this->create_cluster_pipeline(global_set_layout);
+    this->create_reduce_pipeline();
 }
 
 RenderSystem::~RenderSystem() {
+    this->destroy_depth_pyramid();
+    vkDestroySampler(this->device.get_device(), this->pyramid_sampler, nullptr);
     vkDestroyPipelineLayout(this->device.get_device(), this->pipeline_layout, nullptr);
+    vkDestroyPipelineLayout(this->device.get_device(), this->culling_layout, nullptr);
+    vkDestroyPipelineLayout(this->device.get_device(), this->cluster_layout, nullptr);
+    vkDestroyPipelineLayout(this->device.get_device(), this->reduce_layout, nullptr);
 }
 
 void RenderSystem::create_pipeline_layout(VkDescriptorSetLayout global_set_layout) {
@@ -63,38 +136,223 @@ void RenderSystem::create_pipeline(VkRenderPass render_pass) {
         "./conan-build/Shaders/simple_shader.vert.spv",
         "./conan-build/Shaders/simple_shader.frag.spv",
         pipeline_info);
+
+    // Opaque only, so without blending, and with the instance attributes next to the vertex ones
+    Vulqian::Engine::Graphics::PipelineConstructInfo instanced_info{};
+    Vulqian::Engine::Graphics::Pipeline::get_default_config(instanced_info);
+    instanced_info.binding_descriptions = InstanceData::get_binding_descriptions();
+    instanced_info.attribute_descriptions = InstanceData::get_attribute_descriptions();
+    instanced_info.render_pass = render_pass;
+    instanced_info.pipeline_layout = this->pipeline_layout;
+    this->instanced_pipeline = std::make_unique<Vulqian::Engine::Graphics::Pipeline>(
+        this->device,
+        "./conan-build/Shaders/simple_shader_instanced.vert.spv",
+        "./conan-build/Shaders/simple_shader.frag.spv",
+        instanced_info);
 }
 
-void RenderSystem::render_entities(Vulqian::Engine::Graphics::Frames::Info& frame_info, const std::vector<Vulqian::Engine::ECS::Entity>& entities, Vulqian::Engine::ECS::Coordinator& coordinator) {
-    // Separate entities into opaque and transparent
-    std::vector<Vulqian::Engine::ECS::Entity>     opaque_entities;
-    std::map<float, Vulqian::Engine::ECS::Entity> transparent_entities;  // sorted by distance
+void RenderSystem::create_culling_pipeline(VkDescriptorSetLayout global_set_layout) {
+    constexpr uint32_t frames = Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT;
 
-    for (const auto& entity : entities) {
-        // Only process entities that have BOTH Transform AND Mesh components
-        if (coordinator.has_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity) &&
-            coordinator.has_component<Vulqian::Engine::ECS::Components::Mesh>(entity)) {
-            if (coordinator.has_component<Vulqian::Engine::ECS::Components::Transparency>(entity)) {
-                // Calculate distance from camera for depth sorting
-                auto const& transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-                auto        offset = frame_info.camera.get_position() - transform.translation;
-                float       distanceSquared = glm::dot(offset, offset);
-                transparent_entities[distanceSquared] = entity;
-            } else {
-                opaque_entities.push_back(entity);
-            }
+    // Scene instances, indirect commands, visible instances and their counts, the depth pyramid and the occluded instances
+    this->culling_set_layout = Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout::Builder(this->device)
+                                   .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .addBinding(4, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .addBinding(5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .build();
+    this->culling_pool = Vulqian::Engine::Graphics::Descriptors::DescriptorPool::Builder(this->device)
+                             .setMaxSets(frames)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5 * frames)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frames)
+                             .build();
+
+    VkPushConstantRange constant_range{};
+    constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    constant_range.offset = 0;
+    constant_range.size = sizeof(CullingPush);
+
+    std::vector<VkDescriptorSetLayout> descriptor_set_layouts{global_set_layout, this->culling_set_layout->getDescriptorSetLayout()};
+
+    VkPipelineLayoutCreateInfo pipeline_create_info{};
+    pipeline_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_create_info.setLayoutCount = static_cast<uint32_t>(descriptor_set_layouts.size());
+    pipeline_create_info.pSetLayouts = descriptor_set_layouts.data();
+    pipeline_create_info.pushConstantRangeCount = 1;
+    pipeline_create_info.pPushConstantRanges = &constant_range;
+
+    if (vkCreatePipelineLayout(this->device.get_device(), &pipeline_create_info, nullptr, &this->culling_layout) != VK_SUCCESS) {
+        throw Vulqian::Exception::failed_to_create("culling pipeline layout");
+    }
+
+    this->culling_pipeline = std::make_unique<Vulqian::Engine::Graphics::ComputePipeline>(
+        this->device,
+        "./conan-build/Shaders/cull_instances.comp.spv",
+        this->culling_layout);
+}
+
+void RenderSystem::create_cluster_pipeline(VkDescriptorSetLayout global_set_layout) {
+    constexpr uint32_t frames = Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT;
+
+    // A frame's instances, indirect commands and compacted indices, then a model's meshlets and indices
+    this->cluster_set_layout = Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout::Builder(this->device)
+                                   .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                   .build();
+    this->cluster_model_layout = Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout::Builder(this->device)
+                                     .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                     .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                     .build();
+    this->cluster_pool = Vulqian::Engine::Graphics::Descriptors::DescriptorPool::Builder(this->device)
+                             .setMaxSets(frames)
+                             .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3 * frames)
+                             .build();
+
+    VkPushConstantRange constant_range{};
+    constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    constant_range.offset = 0;
+    constant_range.size = sizeof(ClusterPush);
+
+    std::vector<VkDescriptorSetLayout> descriptor_set_layouts{global_set_layout,
+                                                              this->cluster_set_layout->getDescriptorSetLayout(),
+                                                              this->cluster_model_layout->getDescriptorSetLayout()};
+
+    VkPipelineLayoutCreateInfo pipeline_create_info{};
+    pipeline_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_create_info.setLayoutCount = static_cast<uint32_t>(descriptor_set_layouts.size());
+    pipeline_create_info.pSetLayouts = descriptor_set_layouts.data();
+    pipeline_create_info.pushConstantRangeCount = 1;
+    pipeline_create_info.pPushConstantRanges = &constant_range;
+
+    if (vkCreatePipelineLayout(this->device.get_device(), &pipeline_create_info, nullptr, &this->cluster_layout) != VK_SUCCESS) {
+        throw Vulqian::Exception::failed_to_create("cluster culling pipeline layout");
+    }
+
+    this->cluster_pipeline = std::make_unique<Vulqian::Engine::Graphics::ComputePipeline>(
+        this->device,
+        "./conan-build/Shaders/cull_clusters.comp.spv",
+        this->cluster_layout);
+}
+
+void RenderSystem::create_reduce_pipeline() {
+    constexpr uint32_t frames = Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT;
+    constexpr uint32_t sets = frames + MAX_PYRAMID_LEVELS - 1;
+
+    // The level below, or the depth attachment for level 0, and the level written
+    this->reduce_set_layout = Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout::Builder(this->device)
+                                  .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+                                  .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT)
+                                  .build();
+    this->reduce_pool = Vulqian::Engine::Graphics::Descriptors::DescriptorPool::Builder(this->device)
+                            .setMaxSets(sets)
+                            .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, sets)
+                            .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, sets)
+                            .build();
+
+    // Allocated once, only their images change
+    this->level_sets.resize(MAX_PYRAMID_LEVELS - 1);
+    auto allocate = [this](VkDescriptorSet& set) {
+        if (!this->reduce_pool->allocateDescriptor(this->reduce_set_layout->getDescriptorSetLayout(), set)) {
+            throw Vulqian::Exception::failed_to_create("depth pyramid descriptor set");
         }
+    };
+    std::for_each(this->source_sets.begin(), this->source_sets.end(), allocate);
+    std::for_each(this->level_sets.begin(), this->level_sets.end(), allocate);
+
+    // The source and destination sizes
+    VkPushConstantRange constant_range{};
+    constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    constant_range.offset = 0;
+    constant_range.size = sizeof(ReducePushConstantData);
+
+    VkDescriptorSetLayout set_layout = this->reduce_set_layout->getDescriptorSetLayout();
+
+    VkPipelineLayoutCreateInfo pipeline_create_info{};
+    pipeline_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_create_info.setLayoutCount = 1;
+    pipeline_create_info.pSetLayouts = &set_layout;
+    pipeline_create_info.pushConstantRangeCount = 1;
+    pipeline_create_info.pPushConstantRanges = &constant_range;
+
+    if (vkCreatePipelineLayout(this->device.get_device(), &pipeline_create_info, nullptr, &this->reduce_layout) != VK_SUCCESS) {
+        throw Vulqian::Exception::failed_to_create("depth pyramid pipeline layout");
+    }
+
+    this->reduce_pipeline = std::make_unique<Vulqian::Engine::Graphics::ComputePipeline>(
+        this->device,
+        "./conan-build/Shaders/hiz_reduce.comp.spv",
+        this->reduce_layout);
+
+    // The shaders fetch texels by level and position, nothing is filtered
+    VkSamplerCreateInfo sampler_info{};
+    sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler_info.magFilter = VK_FILTER_NEAREST;
+    sampler_info.minFilter = VK_FILTER_NEAREST;
+    sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.minLod = 0.f;
+    sampler_info.maxLod = VK_LOD_CLAMP_NONE;
+
+    if (vkCreateSampler(this->device.get_device(), &sampler_info, nullptr, &this->pyramid_sampler) != VK_SUCCESS) {
+        throw Vulqian::Exception::failed_to_create("depth pyramid sampler");
+    }
+}
+
+std::vector<VkVertexInputBindingDescription> RenderSystem::InstanceData::get_binding_descriptions() {
+    std::vector<VkVertexInputBindingDescription> binding_descriptions = Vulqian::Engine::Graphics::Model::Vertex::get_binding_descriptions();
+    binding_descriptions.push_back({1, sizeof(InstanceData), VK_VERTEX_INPUT_RATE_INSTANCE});
+    return binding_descriptions;
+    // binding, stride, inputrate
+}
+
+std::vector<VkVertexInputAttributeDescription> RenderSystem::InstanceData::get_attribute_descriptions() {
+    std::vector<VkVertexInputAttributeDescription> attribute_descriptions = Vulqian::Engine::Graphics::Model::Vertex::get_attribute_descriptions();
+
+    // A matrix takes one location per column
+    for (uint32_t column = 0; column < 4; ++column) {
+        attribute_descriptions.push_back({4 + column, 1, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(offsetof(InstanceData, model_matrix) + column * sizeof(glm::vec4))});
+    }
+    for (uint32_t column = 0; column < 3; ++column) {
+        attribute_descriptions.push_back({8 + column, 1, VK_FORMAT_R32G32B32_SFLOAT, static_cast<uint32_t>(offsetof(InstanceData, normal_matrix) + column * sizeof(glm::vec4))});
     }
+    attribute_descriptions.push_back({11, 1, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(InstanceData, color)});
+    return attribute_descriptions;
+    // location, binding, format, offset
+}
+
+void RenderSystem::render_entities(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Coordinator& coordinator) {
+    // Only entities that have BOTH Transform AND Mesh components are rendered, opaque ones go first
+    std::map<float, Vulqian::Engine::ECS::Entity> transparent_entities;  // sorted by distance
+
+    coordinator.each<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ,
+                     const Vulqian::Engine::ECS::Components::Mesh,
+                     const Vulqian::Engine::ECS::Components::Transparency>(
+        [&frame_info, &transparent_entities](Vulqian::Engine::ECS::Entity entity, auto const& transform, auto const&, auto const&) {
+            // Calculate distance from camera for depth sorting
+            auto  offset = frame_info.camera.get_position() - transform.translation;
+            float distanceSquared = glm::dot(offset, offset);
+            transparent_entities[distanceSquared] = entity;
+        });
 
     // Debug output only occasionally to reduce spam
     if (static int frame_counter = 0; ++frame_counter % 60 == 0) {  // Print every 60 frames (roughly once per second)
-        std::cout << "Opaque entities: " << opaque_entities.size()
+        std::size_t opaque_count = 0;
+        coordinator.each<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ, const Vulqian::Engine::ECS::Components::Mesh>(
+            [&opaque_count](auto const&, auto const&) { ++opaque_count; },
+            Vulqian::Engine::ECS::exclude<Vulqian::Engine::ECS::Components::Transparency>);
+
+        std::cout << "Opaque entities: " << opaque_count
                   << ", Transparent entities: " << transparent_entities.size() << std::endl;
 
         if (!transparent_entities.empty()) {
             auto const& entity = transparent_entities.begin()->second;
-            auto const& transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-            auto const& transparency = coordinator.get_component<Vulqian::Engine::ECS::Components::Transparency>(entity);
+            auto const& transform = coordinator.get_component<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
+            auto const& transparency = coordinator.get_component<const Vulqian::Engine::ECS::Components::Transparency>(entity);
             std::cout << "Transparent quad position: ("
                       << transform.translation.x << ", "
                       << transform.translation.y << ", "
@@ -103,51 +361,35 @@ void RenderSystem::render_entities(Vulqian::Engine::Graphics::Frames::Info& fram
         }
     }
 
-    this->pipeline->bind(frame_info.command_buffer);
-
-    vkCmdBindDescriptorSets(
-        frame_info.command_buffer,
-        VK_PIPELINE_BIND_POINT_GRAPHICS,
-        this->pipeline_layout,
-        0,
-        1,
-        &frame_info.global_descriptor_set,
-        0,
-        nullptr);
-
     // Render opaque objects first
-    for (const auto& entity : opaque_entities) {
-        render_single_entity(frame_info, entity, coordinator);
-    }
+    this->render_opaque_entities_only(frame_info, coordinator);
 
-    // Render transparent objects back-to-front (farthest to nearest)
+    // Render transparent objects back-to-front (farthest to nearest), the opaque pass may have left the instanced pipeline bound
+    this->bind_single(frame_info);
+    const auto frustum = frame_info.camera.get_frustum();
     for (auto it = transparent_entities.rbegin(); it != transparent_entities.rend(); ++it) {
-        render_single_entity(frame_info, it->second, coordinator);
-    }
-}
-
-void RenderSystem::render_single_entity(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Entity entity, Vulqian::Engine::ECS::Coordinator& coordinator) {
-    auto const& mesh = coordinator.get_component<Vulqian::Engine::ECS::Components::Mesh>(entity);
-    auto&       transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
+        auto const& world = coordinator.get_component<const Vulqian::Engine::ECS::Components::WorldTransform>(it->second);
+        auto const& mesh = coordinator.get_component<const Vulqian::Engine::ECS::Components::Mesh>(it->second);
+        auto const& transparency = coordinator.get_component<const Vulqian::Engine::ECS::Components::Transparency>(it->second);
+        if (!this->in_view(frustum, world, mesh)) {
+            continue;
+        }
 
-    // Update rotation for colored cubes
-    if (mesh.model->get_file_name() == Vulqian::Engine::Utils::colored_cube) {
-        transform.rotation.y = glm::mod(transform.rotation.y + 0.001f, glm::two_pi<float>());
-        transform.rotation.x = glm::mod(transform.rotation.x + 0.0005f, glm::two_pi<float>());
+        this->render_single_entity(frame_info, world, mesh, glm::vec4(transparency.color, transparency.alpha), this->select_lod(it->second, world, *mesh.model, frame_info.camera));
     }
+}
 
+void RenderSystem::render_single_entity(Vulqian::Engine::Graphics::Frames::Info&                frame_info,
+                                        Vulqian::Engine::ECS::Components::WorldTransform const& world,
+                                        Vulqian::Engine::ECS::Components::Mesh const&           mesh,
+                                        glm::vec4 const&                                        color,
+                                        std::uint32_t                                           lod,
+                                        std::span<const Vulqian::Engine::Math::IndexRange>      ranges) {
     // Prepare push constants
     SimplePushConstantData push{};
-    push.model_matrix = transform.mat4();
-    push.normal_matrix = transform.normal_matrix();
-
-    // Handle transparency if present
-    if (coordinator.has_component<Vulqian::Engine::ECS::Components::Transparency>(entity)) {
-        auto const& transparency = coordinator.get_component<Vulqian::Engine::ECS::Components::Transparency>(entity);
-        push.color = glm::vec4(transparency.color, transparency.alpha);
-    } else {
-        push.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);  // Default opaque white
-    }
+    push.model_matrix = world.world_matrix;
+    push.normal_matrix = world.normal_matrix;
+    push.color = color;  // Transparency tint and alpha, opaque white otherwise
 
     // Push constants to shader
     vkCmdPushConstants(
@@ -159,12 +401,276 @@ void RenderSystem::render_single_entity(Vulqian::Engine::Graphics::Frames::Info&
         &push);
 
     mesh.model->bind(frame_info.command_buffer);
-    mesh.model->draw(frame_info.command_buffer);
+    if (ranges.empty()) {
+        mesh.model->draw(frame_info.command_buffer, 1, 0, lod);
+        return;
+    }
+    for (auto const& range : ranges) {
+        mesh.model->draw_range(frame_info.command_buffer, range);
+    }
+}
+
+void RenderSystem::render_opaque_entities_only(Vulqian::Engine::Graphics::Frames::Info& frame_info,
+                                               Vulqian::Engine::ECS::Coordinator&       coordinator) {
+    if (this->culled_on_gpu) {
+        this->culled_on_gpu = false;
+        this->render_indirect(frame_info);
+        return;
+    }
+
+    this->bind_single(frame_info);
+
+    this->collect_visible(frame_info, coordinator);
+    this->cull_clusters(frame_info);
+    if (this->instanced) {
+        this->render_instanced(frame_info);
+        return;
+    }
+
+    // Render only opaque entities
+    for (auto const& entity : this->visible) {
+        this->render_single_entity(frame_info, *entity.world, *entity.mesh, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), entity.lod);  // Default opaque white
+    }
+    for (std::size_t i = 0; i < this->clustered.size(); ++i) {
+        this->render_single_entity(frame_info, *this->clustered[i].world, *this->clustered[i].mesh, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), 0, this->ranges_of(i));
+    }
+    this->stats.draw_calls = static_cast<std::uint32_t>(this->visible.size() + this->cluster_ranges.size());
+    this->stats.instances = static_cast<std::uint32_t>(this->visible.size() + this->clustered.size());
+}
+
+void RenderSystem::collect_candidates(Vulqian::Engine::ECS::Coordinator& coordinator) {
+    using Vulqian::Engine::ECS::Components::Mesh;
+    using Vulqian::Engine::ECS::Components::Transparency;
+    using Vulqian::Engine::ECS::Components::WorldTransform;
+
+    this->candidates.clear();
+    coordinator.each<const WorldTransform, const Mesh>(
+        [this](Vulqian::Engine::ECS::Entity entity, WorldTransform const& world, Mesh const& mesh) { this->candidates.push_back({&world, &mesh, entity}); },
+        Vulqian::Engine::ECS::exclude<Transparency>);
+}
+
+void RenderSystem::collect_visible(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Coordinator& coordinator) {
+    this->stats = {};
+    this->collect_candidates(coordinator);
+    if (!this->frustum_culling) {
+        this->visible = this->candidates;
+        this->cull_occluded(frame_info, coordinator);
+        this->select_lods(frame_info.camera, this->visible);
+        return;
+    }
+
+    for (auto& axis : this->spheres) {
+        axis.resize(this->candidates.size());
+    }
+    for (std::size_t i = 0; i < this->candidates.size(); ++i) {
+        auto const& entity = this->candidates[i];
+        const auto  sphere = Vulqian::Engine::Math::transform_sphere(entity.mesh->model->get_bounding_sphere(), entity.world->world_matrix);
+        this->spheres[0][i] = sphere.center.x;
+        this->spheres[1][i] = sphere.center.y;
+        this->spheres[2][i] = sphere.center.z;
+        this->spheres[3][i] = sphere.radius;
+    }
+
+    // Spheres first, 4 at a time, then the few that pass are checked again with their tighter box
+    const auto frustum = frame_info.camera.get_frustum();
+    this->sphere_visible.resize(this->candidates.size());
+    Vulqian::Engine::Math::cull_spheres(
+        frustum,
+        {this->spheres[0].data(), this->spheres[1].data(), this->spheres[2].data(), this->spheres[3].data(), this->candidates.size()},
+        this->sphere_visible.data());
+
+    this->visible.clear();
+    for (std::size_t i = 0; i < this->candidates.size(); ++i) {
+        auto const& entity = this->candidates[i];
+        if (this->sphere_visible[i] && frustum.intersects(Vulqian::Engine::Math::transform_box(entity.mesh->model->get_bounding_box(), entity.world->world_matrix))) {
+            this->visible.push_back(entity);
+        }
+    }
+    this->stats.culled = static_cast<std::uint32_t>(this->candidates.size() - this->visible.size());
+    this->cull_occluded(frame_info, coordinator);
+    this->select_lods(frame_info.camera, this->visible);
+}
+
+void RenderSystem::cull_occluded(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Coordinator& coordinator) {
+    if (!this->cpu_occlusion_culling) {
+        return;
+    }
+
+    // The occluders in view, rasterized on the workers, then every entity in view tested against them
+    this->occlusion_buffer.begin(frame_info.camera.get_projection() * frame_info.camera.get_view());
+    for (auto const& entity : this->visible) {
+        if (entity.mesh->occluder) {
+            Vulqian::Engine::Graphics::Model const& model = *entity.mesh->model;
+            this->occlusion_buffer.add_occluder(model.get_positions(), model.get_indices(), entity.world->world_matrix);
+        }
+    }
+    this->occlusion_buffer.rasterize(coordinator.get_thread_pool());
+
+    if (!this->occlusion_dump_path.empty()) {
+        this->occlusion_buffer.write_pgm(this->occlusion_dump_path);
+        this->occlusion_dump_path.clear();
+    }
+
+    const auto hidden = std::remove_if(this->visible.begin(), this->visible.end(), [this](VisibleEntity const& entity) {
+        return !this->occlusion_buffer.is_visible(Vulqian::Engine::Math::transform_box(entity.mesh->model->get_bounding_box(), entity.world->world_matrix));
+    });
+    this->stats.occluded = static_cast<std::uint32_t>(this->visible.end() - hidden);
+    this->visible.erase(hidden, this->visible.end());
+}
+
+bool RenderSystem::in_view(Vulqian::Engine::Math::Frustum const&                   frustum,
+                           Vulqian::Engine::ECS::Components::WorldTransform const& world,
+                           Vulqian::Engine::ECS::Components::Mesh const&           mesh) const noexcept {
+    return !this->frustum_culling || frustum.intersects(Vulqian::Engine::Math::transform_sphere(mesh.model->get_bounding_sphere(), world.world_matrix));
+}
+
+void RenderSystem::select_lods(Vulqian::Engine::Graphics::Camera const& camera, std::vector<VisibleEntity>& entities) {
+    for (auto& entity : entities) {
+        entity.lod = this->select_lod(entity.entity, *entity.world, *entity.mesh->model, camera);
+    }
+}
+
+std::uint32_t RenderSystem::select_lod(Vulqian::Engine::ECS::Entity                            entity,
+                                       Vulqian::Engine::ECS::Components::WorldTransform const& world,
+                                       Vulqian::Engine::Graphics::Model const&                 model,
+                                       Vulqian::Engine::Graphics::Camera const&                camera) {
+    auto const& lods = model.get_lods();
+    if (!this->lod_selection || lods.size() == 1) {
+        return 0;
+    }
+
+    // Pixels covered by one local unit at the nearest point of the bounding sphere, the finest level from inside it
+    auto const& local = model.get_bounding_sphere();
+    const auto  sphere = Vulqian::Engine::Math::transform_sphere(local, world.world_matrix);
+    const float distance = glm::length(sphere.center - camera.get_position()) - sphere.radius;
+    const float scale = local.radius > 0.f ? sphere.radius / local.radius : 1.f;
+    const float pixels_per_unit = distance > 0.f ? scale * camera.get_projection()[1][1] * .5f * this->viewport_height / distance : std::numeric_limits<float>::infinity();
+
+    // A recycled index starts over from the finest level instead of inheriting the dead entity's
+    const std::uint32_t index = Vulqian::Engine::ECS::entity_index(entity);
+    const std::uint32_t version = Vulqian::Engine::ECS::entity_version(entity);
+    if (index >= this->entity_lods.size()) {
+        this->entity_lods.resize(index + 1);
+    }
+    auto& current = this->entity_lods[index];
+    if (current.version != version) {
+        current = EntityLod{version, 0};
+    }
+    current.lod = static_cast<std::uint8_t>(Vulqian::Engine::Math::select_lod(lods, pixels_per_unit, current.lod, this->lod_error_pixels, this->lod_hysteresis));
+    return current.lod;
+}
+
+void RenderSystem::split_clustered(std::vector<VisibleEntity>& entities) {
+    this->clustered.clear();
+    if (!this->cluster_culling) {
+        return;
+    }
+
+    // The coarser levels are for far away entities, small on screen, which gain nothing from culling their parts
+    const auto first = std::stable_partition(entities.begin(), entities.end(), [](VisibleEntity const& entity) {
+        return entity.lod != 0 || entity.mesh->model->get_meshlets().empty();
+    });
+    this->clustered.assign(first, entities.end());
+    entities.erase(first, entities.end());
+}
+
+void RenderSystem::cull_clusters(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    this->split_clustered(this->visible);
+    this->cluster_ranges.clear();
+    this->cluster_ends.clear();
+
+    // Planes that never cull without the frustum culling, only the cones do then
+    const auto  frustum = this->frustum_culling ? frame_info.camera.get_frustum() : Vulqian::Engine::Math::Frustum{};
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < this->clustered.size(); ++i) {
+        auto const& entity = this->clustered[i];
+        auto const& meshlets = entity.mesh->model->get_meshlets();
+        const std::size_t visible_meshlets = Vulqian::Engine::Math::cull_meshlets(
+            meshlets, entity.world->world_matrix, entity.world->normal_matrix, frustum, frame_info.camera.get_position(), this->cluster_cone_culling, this->cluster_ranges);
+        this->stats.meshlets += static_cast<std::uint32_t>(visible_meshlets);
+        this->stats.culled_meshlets += static_cast<std::uint32_t>(meshlets.size() - visible_meshlets);
+        if (visible_meshlets > 0) {
+            this->clustered[kept++] = entity;
+            this->cluster_ends.push_back(static_cast<std::uint32_t>(this->cluster_ranges.size()));
+        }
+    }
+    this->clustered.resize(kept);
+}
+
+std::span<const Vulqian::Engine::Math::IndexRange> RenderSystem::ranges_of(std::size_t clustered_index) const noexcept {
+    const std::uint32_t first = clustered_index == 0 ? 0 : this->cluster_ends[clustered_index - 1];
+    return std::span<const Vulqian::Engine::Math::IndexRange>{this->cluster_ranges}.subspan(first, this->cluster_ends[clustered_index] - first);
 }
 
-void RenderSystem::render_opaque_entities_only(Vulqian::Engine::Graphics::Frames::Info&         frame_info,
-                                               const std::vector<Vulqian::Engine::ECS::Entity>& entities,
-                                               Vulqian::Engine::ECS::Coordinator&               coordinator) {
+void RenderSystem::group_by_model(std::vector<VisibleEntity> const& entities) {
+    // Entities counted per model and level of detail. Scenes hold few models, the last one found is tried first.
+    this->groups.clear();
+    this->group_of.clear();
+    std::size_t last_group = 0;
+    for (auto const& entity : entities) {
+        Vulqian::Engine::Graphics::Model* model = entity.mesh->model.get();
+        const std::uint32_t               lod = entity.lod;
+        if (last_group >= this->groups.size() || this->groups[last_group].model != model || this->groups[last_group].lod != lod) {
+            auto found = std::find_if(this->groups.begin(), this->groups.end(), [model, lod](InstanceGroup const& group) { return group.model == model && group.lod == lod; });
+            if (found == this->groups.end()) {
+                found = this->groups.insert(this->groups.end(), InstanceGroup{model, lod, 0, 0});
+            }
+            last_group = static_cast<std::size_t>(found - this->groups.begin());
+        }
+        ++this->groups[last_group].count;
+        this->group_of.push_back(static_cast<std::uint32_t>(last_group));
+    }
+
+    std::uint32_t first = 0;
+    for (auto& group : this->groups) {
+        group.first = first;
+        first += group.count;
+    }
+}
+
+void RenderSystem::render_instanced(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    this->group_by_model(this->visible);
+    this->stats.draw_calls = static_cast<std::uint32_t>(this->groups.size() + this->cluster_ranges.size());
+    this->stats.instances = static_cast<std::uint32_t>(this->group_of.size() + this->clustered.size());
+    if (this->stats.instances == 0) {
+        return;
+    }
+
+    // Each entity's matrices written straight into its model's range of the mapped buffer, the clustered entities after them
+    const std::size_t clustered_first = this->group_of.size();
+    InstanceData*     instances = this->reserve_instances(frame_info.frame_index, clustered_first + this->clustered.size());
+    std::vector<std::uint32_t> cursors(this->groups.size());
+    std::transform(this->groups.begin(), this->groups.end(), cursors.begin(), [](InstanceGroup const& group) { return group.first; });
+
+    for (std::size_t i = 0; i < this->visible.size(); ++i) {
+        InstanceData& instance = instances[cursors[this->group_of[i]]++];
+        instance.model_matrix = this->visible[i].world->world_matrix;
+        instance.normal_matrix = this->visible[i].world->normal_matrix;
+        instance.color = glm::vec4{1.f};  // Default opaque white
+    }
+    for (std::size_t i = 0; i < this->clustered.size(); ++i) {
+        InstanceData& instance = instances[clustered_first + i];
+        instance.model_matrix = this->clustered[i].world->world_matrix;
+        instance.normal_matrix = this->clustered[i].world->normal_matrix;
+        instance.color = glm::vec4{1.f};
+    }
+
+    this->bind_instanced(frame_info, this->instance_buffers[frame_info.frame_index]->getBuffer());
+    for (auto const& group : this->groups) {
+        group.model->bind(frame_info.command_buffer);
+        group.model->draw(frame_info.command_buffer, group.count, group.first, group.lod);
+    }
+
+    // A draw per range of visible meshlets, of the entity's one instance
+    for (std::size_t i = 0; i < this->clustered.size(); ++i) {
+        this->clustered[i].mesh->model->bind(frame_info.command_buffer);
+        for (auto const& range : this->ranges_of(i)) {
+            this->clustered[i].mesh->model->draw_range(frame_info.command_buffer, range, 1, static_cast<uint32_t>(clustered_first + i));
+        }
+    }
+}
+
+void RenderSystem::bind_single(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
     this->pipeline->bind(frame_info.command_buffer);
     vkCmdBindDescriptorSets(
         frame_info.command_buffer,
@@ -173,21 +679,10 @@ void RenderSystem::render_opaque_entities_only(Vulqian::Engine::Graphics::Frames
         0, 1,
         &frame_info.global_descriptor_set,
         0, nullptr);
-
-    // Render only opaque entities
-    for (const auto& entity : entities) {
-        if (coordinator.has_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity) &&
-            coordinator.has_component<Vulqian::Engine::ECS::Components::Mesh>(entity) &&
-            !coordinator.has_component<Vulqian::Engine::ECS::Components::Transparency>(entity)) {
-            render_single_entity(frame_info, entity, coordinator);
-        }
-    }
 }
 
-void RenderSystem::render_transparent_entity(Vulqian::Engine::Graphics::Frames::Info& frame_info,
-                                             Vulqian::Engine::ECS::Entity             entity,
-                                             Vulqian::Engine::ECS::Coordinator&       coordinator) {
-    this->pipeline->bind(frame_info.command_buffer);
+void RenderSystem::bind_instanced(Vulqian::Engine::Graphics::Frames::Info& frame_info, VkBuffer instance_buffer) {
+    this->instanced_pipeline->bind(frame_info.command_buffer);
     vkCmdBindDescriptorSets(
         frame_info.command_buffer,
         VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -196,7 +691,561 @@ void RenderSystem::render_transparent_entity(Vulqian::Engine::Graphics::Frames::
         &frame_info.global_descriptor_set,
         0, nullptr);
 
-    render_single_entity(frame_info, entity, coordinator);
+    // The fragment shader still reads its tint from the push constants, pushed once for every instance
+    SimplePushConstantData push{};
+    vkCmdPushConstants(
+        frame_info.command_buffer,
+        this->pipeline_layout,
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+        0,
+        sizeof(SimplePushConstantData),
+        &push);
+
+    const VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(frame_info.command_buffer, 1, 1, &instance_buffer, &offset);
+}
+
+void RenderSystem::record_culling(Vulqian::Engine::Graphics::Frames::Info&      frame_info,
+                                  Vulqian::Engine::ECS::Coordinator&            coordinator,
+                                  Vulqian::Engine::Graphics::DepthTarget const& depth) {
+    this->culled_on_gpu = false;
+    this->occlusion_pending = false;
+    this->disoccluded_on_gpu = false;
+    if (!this->gpu_driven || !this->frustum_culling || !this->device.supports_indirect_first_instance()) {
+        return;
+    }
+
+    // Before any set of the frame is bound, as recreating the pyramid rewrites them
+    this->depth_target = depth;
+    if (this->pyramid.image == VK_NULL_HANDLE || this->pyramid.source.width != depth.extent.width || this->pyramid.source.height != depth.extent.height) {
+        this->create_depth_pyramid(depth.extent);
+    }
+
+    this->collect_candidates(coordinator);
+    this->select_lods(frame_info.camera, this->candidates);
+    this->split_clustered(this->candidates);
+    this->group_by_model(this->candidates);
+
+    // What the last use of this frame's buffers kept, complete since its fence signaled
+    auto& frame = this->culling_frames[frame_info.frame_index];
+    this->stats = {};
+    this->stats.draw_calls = static_cast<std::uint32_t>(this->groups.size() * (this->occlusion_culling ? 2 : 1) + this->clustered.size());
+    if (frame.counter != nullptr) {
+        auto const& counters = *static_cast<CullingCounters const*>(frame.counter->getMappedMemory());
+        this->stats.instances = counters.visible + counters.disoccluded;
+        this->stats.culled = frame.submitted - counters.visible - counters.occluded;
+        this->stats.occluded = counters.occluded - counters.disoccluded;
+        this->stats.disoccluded = counters.disoccluded;
+    }
+
+    // Every opaque entity with its model's draw, and each draw with no instance yet
+    this->reserve_culling(frame_info.frame_index, std::max<std::size_t>(this->candidates.size(), 1), std::max<std::size_t>(this->groups.size(), 1));
+    auto* scene = static_cast<SceneInstance*>(frame.scene->getMappedMemory());
+    for (std::size_t i = 0; i < this->candidates.size(); ++i) {
+        auto const& entity = this->candidates[i];
+        auto const& sphere = entity.mesh->model->get_bounding_sphere();
+        SceneInstance& instance = scene[i];
+        instance.model_matrix = entity.world->world_matrix;
+        instance.normal_matrix = entity.world->normal_matrix;
+        instance.color = glm::vec4{1.f};  // Default opaque white
+        instance.sphere = glm::vec4{sphere.center, sphere.radius};
+        instance.draw = this->group_of[i];
+        instance.first_instance = this->groups[instance.draw].first;
+    }
+
+    // The second phase's draws follow the first's, their instances too
+    const auto instance_count = static_cast<std::uint32_t>(this->candidates.size());
+    auto*      commands = static_cast<VkDrawIndexedIndirectCommand*>(frame.commands->getMappedMemory());
+    for (std::size_t group = 0; group < this->groups.size(); ++group) {
+        auto const& draw = this->groups[group];
+        draw.model->write_indirect_command(commands[group], draw.first, draw.lod);
+        draw.model->write_indirect_command(commands[this->groups.size() + group], instance_count + draw.first, draw.lod);
+    }
+
+    *static_cast<CullingCounters*>(frame.counter->getMappedMemory()) = {};
+    frame.submitted = instance_count;
+    this->culled_on_gpu = true;
+    this->record_cluster_culling(frame_info);
+    if (this->candidates.empty()) {
+        return;
+    }
+
+    // Its first use since it was created, nothing to keep
+    if (!this->pyramid.initialized) {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = this->pyramid.image;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, 1};
+        vkCmdPipelineBarrier(frame_info.command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        this->pyramid.initialized = true;
+    }
+
+    // The previous frame's pyramid is tested with its own view, so the objects are found where they were in it
+    CullingPush push{};
+    push.view_projection = this->pyramid.view_projection;
+    push.pyramid_size = {static_cast<float>(this->pyramid.extent.width), static_cast<float>(this->pyramid.extent.height)};
+    push.instance_count = instance_count;
+    push.draw_count = static_cast<std::uint32_t>(this->groups.size());
+    push.occlusion = this->occlusion_culling && this->pyramid.built;
+    push.pyramid_levels = static_cast<std::uint32_t>(this->pyramid.levels.size());
+    this->dispatch_culling(frame_info, push);
+    this->occlusion_pending = this->occlusion_culling;
+}
+
+void RenderSystem::dispatch_culling(Vulqian::Engine::Graphics::Frames::Info& frame_info, CullingPush const& push) {
+    static_assert(sizeof(CullingPush) == 96, "CullingPush must match the push constants of cull_instances.comp");
+
+    // Host writes are visible to the commands once submitted, no barrier needed before the dispatch
+    auto const&                          frame = this->culling_frames[frame_info.frame_index];
+    const std::array<VkDescriptorSet, 2> sets{frame_info.global_descriptor_set, frame.set};
+    this->culling_pipeline->bind(frame_info.command_buffer);
+    vkCmdBindDescriptorSets(
+        frame_info.command_buffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        this->culling_layout,
+        0, static_cast<uint32_t>(sets.size()),
+        sets.data(),
+        0, nullptr);
+    vkCmdPushConstants(frame_info.command_buffer, this->culling_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullingPush), &push);
+    this->culling_pipeline->dispatch(frame_info.command_buffer, push.instance_count, CULLING_GROUP_SIZE);
+
+    // The draws read the commands and the visible instances, the second phase the occluded ones,
+    // and the host reads the counts once the fence signaled
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(
+        frame_info.command_buffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr);
+}
+
+void RenderSystem::render_indirect(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    // One indirect draw per model, its instance count decided by the culling pass
+    if (!this->groups.empty()) {
+        auto const& frame = this->culling_frames[frame_info.frame_index];
+        this->bind_instanced(frame_info, frame.visible->getBuffer());
+        for (std::size_t group = 0; group < this->groups.size(); ++group) {
+            this->groups[group].model->bind(frame_info.command_buffer);
+            this->groups[group].model->draw_indirect(frame_info.command_buffer, frame.commands->getBuffer(), group * sizeof(VkDrawIndexedIndirectCommand));
+        }
+    }
+    this->render_clusters_indirect(frame_info);
+}
+
+void RenderSystem::record_cluster_culling(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    this->cluster_groups.clear();
+    if (this->clustered.empty()) {
+        return;
+    }
+
+    // Sorted by model, so each model is dispatched once over the meshlets of all its entities
+    std::sort(this->clustered.begin(), this->clustered.end(), [](VisibleEntity const& a, VisibleEntity const& b) {
+        return std::less<>{}(a.mesh->model.get(), b.mesh->model.get());
+    });
+    std::size_t index_count = 0;
+    for (std::size_t i = 0; i < this->clustered.size(); ++i) {
+        Vulqian::Engine::Graphics::Model* model = this->clustered[i].mesh->model.get();
+        if (this->cluster_groups.empty() || this->cluster_groups.back().model != model) {
+            this->cluster_groups.push_back({model, static_cast<std::uint32_t>(i), 0});
+        }
+        ++this->cluster_groups.back().count;
+        index_count += model->get_lods().front().index_count;
+    }
+    this->reserve_clusters(frame_info.frame_index, this->clustered.size(), index_count, this->cluster_groups.size());
+
+    // Each entity's command starts with no index, at the entity's range of the compacted indices, drawing its one instance
+    auto&         frame = this->cluster_frames[frame_info.frame_index];
+    auto*         instances = static_cast<InstanceData*>(frame.instances->getMappedMemory());
+    auto*         commands = static_cast<VkDrawIndexedIndirectCommand*>(frame.commands->getMappedMemory());
+    std::uint32_t first_index = 0;
+    for (std::size_t i = 0; i < this->clustered.size(); ++i) {
+        auto const& entity = this->clustered[i];
+        instances[i].model_matrix = entity.world->world_matrix;
+        instances[i].normal_matrix = entity.world->normal_matrix;
+        instances[i].color = glm::vec4{1.f};  // Default opaque white
+        commands[i] = {0, 1, first_index, 0, static_cast<uint32_t>(i)};
+        first_index += entity.mesh->model->get_lods().front().index_count;
+    }
+
+    const std::array<VkDescriptorSet, 2> sets{frame_info.global_descriptor_set, frame.set};
+    this->cluster_pipeline->bind(frame_info.command_buffer);
+    vkCmdBindDescriptorSets(
+        frame_info.command_buffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        this->cluster_layout,
+        0, static_cast<uint32_t>(sets.size()),
+        sets.data(),
+        0, nullptr);
+    for (auto const& group : this->cluster_groups) {
+        const VkDescriptorBufferInfo meshlet_info = group.model->get_meshlet_buffer_info();
+        const VkDescriptorBufferInfo index_info = group.model->get_index_buffer_info();
+        VkDescriptorSet              model_set{VK_NULL_HANDLE};
+        if (!Vulqian::Engine::Graphics::Descriptors::DescriptorWriter{*this->cluster_model_layout, *frame.model_pool}
+                 .writeBuffer(0, &meshlet_info)
+                 .writeBuffer(1, &index_info)
+                 .build(model_set)) {
+            throw Vulqian::Exception::failed_to_create("cluster culling descriptor set");
+        }
+        vkCmdBindDescriptorSets(frame_info.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->cluster_layout, 2, 1, &model_set, 0, nullptr);
+
+        const auto        meshlet_count = static_cast<std::uint32_t>(group.model->get_meshlets().size());
+        const ClusterPush push{group.first, group.count, meshlet_count, this->cluster_cone_culling};
+        vkCmdPushConstants(frame_info.command_buffer, this->cluster_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ClusterPush), &push);
+        this->cluster_pipeline->dispatch(frame_info.command_buffer, group.count * meshlet_count, CULLING_GROUP_SIZE);
+    }
+
+    // The draws read the commands and the compacted indices
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+    vkCmdPipelineBarrier(
+        frame_info.command_buffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr);
+}
+
+void RenderSystem::render_clusters_indirect(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    if (this->cluster_groups.empty()) {
+        return;
+    }
+
+    // One indirect draw per entity over its range of the compacted indices, with the vertices of its model.
+    // Without multiDrawIndirect the draws of a model cannot go in one call.
+    auto const& frame = this->cluster_frames[frame_info.frame_index];
+    this->bind_instanced(frame_info, frame.instances->getBuffer());
+    for (auto const& group : this->cluster_groups) {
+        group.model->bind(frame_info.command_buffer);
+        vkCmdBindIndexBuffer(frame_info.command_buffer, frame.indices->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+        for (std::uint32_t i = group.first; i < group.first + group.count; ++i) {
+            group.model->draw_indirect(frame_info.command_buffer, frame.commands->getBuffer(), i * sizeof(VkDrawIndexedIndirectCommand));
+        }
+    }
+}
+
+void RenderSystem::record_occlusion(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    assert(this->occlusion_pending && "record_occlusion needs the first phase recorded by record_culling");
+    this->occlusion_pending = false;
+
+    // This frame's depth, with this frame's view, then tested again by the instances the previous one hid
+    this->build_depth_pyramid(frame_info);
+
+    CullingPush push{};
+    push.view_projection = this->pyramid.view_projection;
+    push.pyramid_size = {static_cast<float>(this->pyramid.extent.width), static_cast<float>(this->pyramid.extent.height)};
+    push.instance_count = this->culling_frames[frame_info.frame_index].submitted;
+    push.draw_count = static_cast<std::uint32_t>(this->groups.size());
+    push.phase = 1;
+    push.occlusion = 1;
+    push.pyramid_levels = static_cast<std::uint32_t>(this->pyramid.levels.size());
+    this->dispatch_culling(frame_info, push);
+    this->disoccluded_on_gpu = true;
+}
+
+void RenderSystem::render_disoccluded_entities(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    if (!this->disoccluded_on_gpu) {
+        return;
+    }
+    this->disoccluded_on_gpu = false;
+
+    // The second half of the commands, most of them drawing no instance at all
+    auto const& frame = this->culling_frames[frame_info.frame_index];
+    this->bind_instanced(frame_info, frame.visible->getBuffer());
+    for (std::size_t group = 0; group < this->groups.size(); ++group) {
+        this->groups[group].model->bind(frame_info.command_buffer);
+        this->groups[group].model->draw_indirect(frame_info.command_buffer, frame.commands->getBuffer(), (this->groups.size() + group) * sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+void RenderSystem::create_depth_pyramid(VkExtent2D source) {
+    if (this->pyramid.image != VK_NULL_HANDLE) {
+        // Only on resize, the frames in flight may still sample the previous one
+        vkDeviceWaitIdle(this->device.get_device());
+        this->destroy_depth_pyramid();
+    }
+
+    this->pyramid.source = source;
+    this->pyramid.extent = {std::bit_floor(std::max(source.width, 1u)), std::bit_floor(std::max(source.height, 1u))};
+    const auto level_count = static_cast<uint32_t>(std::bit_width(std::max(this->pyramid.extent.width, this->pyramid.extent.height)));
+    assert(level_count <= MAX_PYRAMID_LEVELS && "depth attachment too large for the depth pyramid");
+
+    VkImageCreateInfo image_info{};
+    image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.imageType = VK_IMAGE_TYPE_2D;
+    image_info.extent = {this->pyramid.extent.width, this->pyramid.extent.height, 1};
+    image_info.mipLevels = level_count;
+    image_info.arrayLayers = 1;
+    image_info.format = VK_FORMAT_R32_SFLOAT;
+    image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    image_info.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    this->device.createImageWithInfo(image_info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, this->pyramid.image, this->pyramid.memory);
+
+    auto create_view = [this, level_count](uint32_t first_level, uint32_t count) {
+        VkImageViewCreateInfo view_info{};
+        view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_info.image = this->pyramid.image;
+        view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        view_info.format = VK_FORMAT_R32_SFLOAT;
+        view_info.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, first_level, count, 0, 1};
+
+        VkImageView view{VK_NULL_HANDLE};
+        if (vkCreateImageView(this->device.get_device(), &view_info, nullptr, &view) != VK_SUCCESS) {
+            throw Vulqian::Exception::failed_to_create("depth pyramid image view");
+        }
+        return view;
+    };
+    this->pyramid.view = create_view(0, level_count);
+    for (uint32_t level = 0; level < level_count; ++level) {
+        this->pyramid.levels.push_back(create_view(level, 1));
+    }
+
+    // Each level past 0 reads the one below it
+    for (uint32_t level = 1; level < level_count; ++level) {
+        const VkDescriptorImageInfo source_info{this->pyramid_sampler, this->pyramid.levels[level - 1], VK_IMAGE_LAYOUT_GENERAL};
+        const VkDescriptorImageInfo destination_info{VK_NULL_HANDLE, this->pyramid.levels[level], VK_IMAGE_LAYOUT_GENERAL};
+        Vulqian::Engine::Graphics::Descriptors::DescriptorWriter{*this->reduce_set_layout, *this->reduce_pool}
+            .writeImage(0, &source_info)
+            .writeImage(1, &destination_info)
+            .overwrite(this->level_sets[level - 1]);
+    }
+
+    // The culling sets created so far still point to the previous pyramid
+    const VkDescriptorImageInfo pyramid_info{this->pyramid_sampler, this->pyramid.view, VK_IMAGE_LAYOUT_GENERAL};
+    for (auto& frame : this->culling_frames) {
+        if (frame.set != VK_NULL_HANDLE) {
+            Vulqian::Engine::Graphics::Descriptors::DescriptorWriter{*this->culling_set_layout, *this->culling_pool}.writeImage(4, &pyramid_info).overwrite(frame.set);
+        }
+    }
+}
+
+void RenderSystem::destroy_depth_pyramid() {
+    for (VkImageView view : this->pyramid.levels) {
+        vkDestroyImageView(this->device.get_device(), view, nullptr);
+    }
+    vkDestroyImageView(this->device.get_device(), this->pyramid.view, nullptr);
+    vkDestroyImage(this->device.get_device(), this->pyramid.image, nullptr);
+    vkFreeMemory(this->device.get_device(), this->pyramid.memory, nullptr);
+    this->pyramid = {};
+}
+
+void RenderSystem::build_depth_pyramid(Vulqian::Engine::Graphics::Frames::Info& frame_info) {
+    VkCommandBuffer command_buffer = frame_info.command_buffer;
+    auto const&     depth = this->depth_target;
+    const bool      has_stencil = depth.format == VK_FORMAT_D32_SFLOAT_S8_UINT || depth.format == VK_FORMAT_D24_UNORM_S8_UINT;
+
+    // The depth attachment sampled once the first phase's draws wrote it, the pyramid written once the first phase read it,
+    // an execution dependency only
+    VkImageMemoryBarrier depth_barrier{};
+    depth_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    depth_barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depth_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    depth_barrier.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depth_barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    depth_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    depth_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    depth_barrier.image = depth.image;
+    depth_barrier.subresourceRange = {static_cast<VkImageAspectFlags>(VK_IMAGE_ASPECT_DEPTH_BIT | (has_stencil ? VK_IMAGE_ASPECT_STENCIL_BIT : 0)), 0, 1, 0, 1};
+
+    VkImageMemoryBarrier pyramid_barrier{};
+    pyramid_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    pyramid_barrier.srcAccessMask = 0;
+    pyramid_barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    pyramid_barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    pyramid_barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    pyramid_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pyramid_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pyramid_barrier.image = this->pyramid.image;
+    pyramid_barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, 1};
+
+    const std::array<VkImageMemoryBarrier, 2> barriers{depth_barrier, pyramid_barrier};
+    vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    // Level 0 reads the attachment of the image being drawn, so its set is rewritten every frame
+    VkDescriptorSet             source_set = this->source_sets[frame_info.frame_index];
+    const VkDescriptorImageInfo source_info{this->pyramid_sampler, depth.view, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+    const VkDescriptorImageInfo destination_info{VK_NULL_HANDLE, this->pyramid.levels[0], VK_IMAGE_LAYOUT_GENERAL};
+    Vulqian::Engine::Graphics::Descriptors::DescriptorWriter{*this->reduce_set_layout, *this->reduce_pool}
+        .writeImage(0, &source_info)
+        .writeImage(1, &destination_info)
+        .overwrite(source_set);
+
+    this->reduce_pipeline->bind(command_buffer);
+    VkExtent2D source = depth.extent;
+    for (uint32_t level = 0; level < this->pyramid.levels.size(); ++level) {
+        const VkExtent2D destination{std::max(this->pyramid.extent.width >> level, 1u), std::max(this->pyramid.extent.height >> level, 1u)};
+        VkDescriptorSet  set = level == 0 ? source_set : this->level_sets[level - 1];
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->reduce_layout, 0, 1, &set, 0, nullptr);
+
+        const ReducePushConstantData push{
+            {static_cast<int>(source.width), static_cast<int>(source.height)},
+            {static_cast<int>(destination.width), static_cast<int>(destination.height)}};
+        vkCmdPushConstants(command_buffer, this->reduce_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReducePushConstantData), &push);
+        this->reduce_pipeline->dispatch(command_buffer, destination, REDUCE_GROUP_SIZE);
+
+        // Read by the next level, then by both culling phases
+        pyramid_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        pyramid_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        pyramid_barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1};
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &pyramid_barrier);
+        source = destination;
+    }
+
+    // Back to an attachment for the resumed render pass
+    depth_barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    depth_barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depth_barrier.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    depth_barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &depth_barrier);
+
+    this->pyramid.view_projection = frame_info.camera.get_projection() * frame_info.camera.get_view();
+    this->pyramid.built = true;
+}
+
+void RenderSystem::reserve_culling(int frame_index, std::size_t instance_count, std::size_t draw_count) {
+    assert(frame_index >= 0 && frame_index < Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT && "frame index out of range");
+
+    // Their descriptors are rewritten on growth, the set is not in use anymore once the frame's fence signaled
+    auto& frame = this->culling_frames[frame_index];
+    bool  grown = false;
+    auto  reserve = [this, &grown](std::unique_ptr<Vulqian::Engine::Graphics::Buffer>& buffer,
+                                  VkDeviceSize element_size, std::size_t count, VkBufferUsageFlags usage, VkMemoryPropertyFlags memory) {
+        grown |= reserve_buffer(this->device, buffer, element_size, count, usage, memory);
+    };
+
+    const VkMemoryPropertyFlags host = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    reserve(frame.scene, sizeof(SceneInstance), std::max<std::size_t>(instance_count, 1024), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, host);
+    // Commands and visible instances twice, for each phase of the occlusion culling
+    reserve(frame.commands, sizeof(VkDrawIndexedIndirectCommand), 2 * draw_count, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, host);
+    reserve(frame.visible, sizeof(InstanceData), 2 * std::max<std::size_t>(instance_count, 1024),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    reserve(frame.counter, sizeof(CullingCounters), 1, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, host);
+    reserve(frame.occluded, sizeof(std::uint32_t), std::max<std::size_t>(instance_count, 1024), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!grown) {
+        return;
+    }
+
+    auto scene_info = frame.scene->descriptorInfo();
+    auto commands_info = frame.commands->descriptorInfo();
+    auto visible_info = frame.visible->descriptorInfo();
+    auto counter_info = frame.counter->descriptorInfo();
+    auto occluded_info = frame.occluded->descriptorInfo();
+    const VkDescriptorImageInfo pyramid_info{this->pyramid_sampler, this->pyramid.view, VK_IMAGE_LAYOUT_GENERAL};
+    Vulqian::Engine::Graphics::Descriptors::DescriptorWriter writer{*this->culling_set_layout, *this->culling_pool};
+    writer.writeBuffer(0, &scene_info).writeBuffer(1, &commands_info).writeBuffer(2, &visible_info).writeBuffer(3, &counter_info);
+    writer.writeImage(4, &pyramid_info).writeBuffer(5, &occluded_info);
+    if (frame.set == VK_NULL_HANDLE) {
+        if (!writer.build(frame.set)) {
+            throw Vulqian::Exception::failed_to_create("culling descriptor set");
+        }
+    } else {
+        writer.overwrite(frame.set);
+    }
+}
+
+void RenderSystem::reserve_clusters(int frame_index, std::size_t instance_count, std::size_t index_count, std::size_t model_count) {
+    assert(frame_index >= 0 && frame_index < Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT && "frame index out of range");
+
+    // As for the culling buffers, the frame's sets are not in use anymore once its fence signaled
+    auto&                       frame = this->cluster_frames[frame_index];
+    const VkMemoryPropertyFlags host = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    bool                        grown = false;
+    grown |= reserve_buffer(this->device, frame.instances, sizeof(InstanceData), std::max<std::size_t>(instance_count, 64),
+                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, host);
+    grown |= reserve_buffer(this->device, frame.commands, sizeof(VkDrawIndexedIndirectCommand), std::max<std::size_t>(instance_count, 64),
+                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, host);
+    // Room for every index of every entity, as all of an entity's meshlets may be visible
+    grown |= reserve_buffer(this->device, frame.indices, sizeof(std::uint32_t), std::max<std::size_t>(index_count, 1 << 16),
+                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (grown) {
+        auto instances_info = frame.instances->descriptorInfo();
+        auto commands_info = frame.commands->descriptorInfo();
+        auto indices_info = frame.indices->descriptorInfo();
+        Vulqian::Engine::Graphics::Descriptors::DescriptorWriter writer{*this->cluster_set_layout, *this->cluster_pool};
+        writer.writeBuffer(0, &instances_info).writeBuffer(1, &commands_info).writeBuffer(2, &indices_info);
+        if (frame.set == VK_NULL_HANDLE) {
+            if (!writer.build(frame.set)) {
+                throw Vulqian::Exception::failed_to_create("cluster culling descriptor set");
+            }
+        } else {
+            writer.overwrite(frame.set);
+        }
+    }
+
+    // The models' sets of the frame's last use freed all at once, or with their pool when it is too small
+    if (frame.model_pool == nullptr || frame.model_sets < model_count) {
+        frame.model_sets = std::max<std::uint32_t>(static_cast<std::uint32_t>(model_count), std::max<std::uint32_t>(16, 2 * frame.model_sets));
+        frame.model_pool = Vulqian::Engine::Graphics::Descriptors::DescriptorPool::Builder(this->device)
+                               .setMaxSets(frame.model_sets)
+                               .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 * frame.model_sets)
+                               .build();
+    } else {
+        frame.model_pool->resetPool();
+    }
+}
+
+RenderSystem::InstanceData* RenderSystem::reserve_instances(int frame_index, std::size_t count) {
+    assert(frame_index >= 0 && frame_index < Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT && "frame index out of range");
+
+    // Grown by doubling, kept mapped for the lifetime of the buffer
+    auto& buffer = this->instance_buffers[frame_index];
+    if (buffer == nullptr || buffer->getInstanceCount() < count) {
+        const std::size_t capacity = std::max<std::size_t>(count, buffer == nullptr ? 1024 : 2 * buffer->getInstanceCount());
+        buffer = std::make_unique<Vulqian::Engine::Graphics::Buffer>(
+            this->device,
+            sizeof(InstanceData),
+            static_cast<uint32_t>(capacity),
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        buffer->map();
+    }
+    return static_cast<InstanceData*>(buffer->getMappedMemory());
+}
+
+void RenderSystem::render_transparent_entity(Vulqian::Engine::Graphics::Frames::Info& frame_info,
+                                             Vulqian::Engine::ECS::Entity             entity,
+                                             Vulqian::Engine::ECS::Coordinator&       coordinator) {
+    this->bind_single(frame_info);
+
+    auto const& world = coordinator.get_component<const Vulqian::Engine::ECS::Components::WorldTransform>(entity);
+    auto const& mesh = coordinator.get_component<const Vulqian::Engine::ECS::Components::Mesh>(entity);
+    auto const& transparency = coordinator.get_component<const Vulqian::Engine::ECS::Components::Transparency>(entity);
+    if (!this->in_view(frame_info.camera.get_frustum(), world, mesh)) {
+        return;
+    }
+
+    this->render_single_entity(frame_info, world, mesh, glm::vec4(transparency.color, transparency.alpha), this->select_lod(entity, world, *mesh.model, frame_info.camera));
 }
 
 }  // namespace Vulqian::Engine::Graphics
@@ -5,41 +5,307 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "../../ECS/ECS.hpp"
+#include "../../Math/Frustum.hpp"
+#include "../../Math/Meshlets.hpp"
+#include "../../Math/OcclusionBuffer.hpp"
 #include "../../Utils/Utils.hpp"
+#include "../Buffer/Buffer.hpp"
 #include "../Camera/Camera.hpp"
+#include "../Descriptors/Descriptors.hpp"
 #include "../Device/Device.hpp"
 #include "../Frames/Frame.hpp"
+#include "../Model/Model.hpp"
+#include "../Pipeline/ComputePipeline.hpp"
 #include "../Pipeline/Pipeline.hpp"
+#include "../SwapChain/SwapChain.hpp"
 #include "Renderer.hpp"
 
 namespace Vulqian::Engine::Graphics {
 
+// Draws of the last render_opaque_entities_only, `culled` opaque entities were outside the camera's frustum.
+// On the GPU-driven path the instances and culled counts are read back, so they lag a few frames behind,
+// as do the occlusion counts. On the CPU path `occluded` counts the entities the occlusion buffer hid,
+// and the meshlet counts those of the entities culled cluster by cluster.
+struct RenderStats {
+    std::uint32_t draw_calls{};
+    std::uint32_t instances{};
+    std::uint32_t culled{};
+    std::uint32_t occluded{};         // in the frustum but behind the depth of both phases, or of the occlusion buffer
+    std::uint32_t disoccluded{};      // hidden by the previous frame's depth, drawn after the second phase
+    std::uint32_t meshlets{};         // drawn
+    std::uint32_t culled_meshlets{};  // outside the frustum or facing away
+};
+
 class RenderSystem {
    public:
+    // Per-instance vertex data of the instanced pipeline, laid out like the push constants of the single draws
+    struct InstanceData {
+        glm::mat4 model_matrix{1.f};
+        glm::mat4 normal_matrix{1.f};  // only the upper 3x3 is read
+        glm::vec4 color{1.f, 1.f, 1.f, 1.f};
+
+        // The model's vertices at binding 0, instances at binding 1
+        static std::vector<VkVertexInputBindingDescription>   get_binding_descriptions();
+        static std::vector<VkVertexInputAttributeDescription> get_attribute_descriptions();
+    };
+
+    // An opaque entity as the culling compute shader of the GPU-driven path reads it, std430 layout of cull_instances.comp
+    struct SceneInstance {
+        glm::mat4     model_matrix{1.f};
+        glm::mat4     normal_matrix{1.f};
+        glm::vec4     color{1.f, 1.f, 1.f, 1.f};
+        glm::vec4     sphere{};          // the model's bounding sphere, radius in w
+        std::uint32_t draw{};            // indirect command of its model
+        std::uint32_t first_instance{};  // where that model's visible instances start
+        std::uint32_t padding[2]{};
+    };
+
     RenderSystem(Vulqian::Engine::Graphics::Device& device, VkRenderPass render_pass, VkDescriptorSetLayout global_set_layout);
     ~RenderSystem();
 
     RenderSystem(const RenderSystem&) = delete;
     RenderSystem& operator=(const RenderSystem&) = delete;
 
-    void render_entities(Vulqian::Engine::Graphics::Frames::Info& frame_info, const std::vector<Vulqian::Engine::ECS::Entity>& entities, Vulqian::Engine::ECS::Coordinator& coordinator);
-    void render_single_entity(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Entity entity, Vulqian::Engine::ECS::Coordinator& coordinator);
-    void render_opaque_entities_only(Vulqian::Engine::Graphics::Frames::Info& frame_info, const std::vector<Vulqian::Engine::ECS::Entity>& entities, Vulqian::Engine::ECS::Coordinator& coordinator);
+    void render_entities(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Coordinator& coordinator);
+    // Draws with the matrices cached by the TransformHierarchy system, nothing is recomputed per draw
+    void render_single_entity(Vulqian::Engine::Graphics::Frames::Info&                frame_info,
+                              Vulqian::Engine::ECS::Components::WorldTransform const& world,
+                              Vulqian::Engine::ECS::Components::Mesh const&           mesh,
+                              glm::vec4 const&                                        color,
+                              std::uint32_t                                           lod = 0,
+                              std::span<const Vulqian::Engine::Math::IndexRange>      ranges = {});
+    void render_opaque_entities_only(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Coordinator& coordinator);
+    // GPU-driven path: uploads every opaque entity and records the compute pass culling them into indirect draws.
+    // Must be recorded before the render pass begins, render_opaque_entities_only then draws what the pass kept.
+    // `depth` is the attachment the pass draws into, the depth pyramid of the occlusion culling follows its size.
+    void record_culling(Vulqian::Engine::Graphics::Frames::Info&     frame_info,
+                        Vulqian::Engine::ECS::Coordinator&           coordinator,
+                        Vulqian::Engine::Graphics::DepthTarget const& depth);
+    // Occlusion culling, second phase: when pending, end the render pass after render_opaque_entities_only,
+    // record_occlusion rebuilds the depth pyramid from what was drawn and tests the instances it hid again,
+    // then resume the pass and draw the ones found visible with render_disoccluded_entities.
+    bool is_occlusion_pending() const noexcept { return this->occlusion_pending; }
+    void record_occlusion(Vulqian::Engine::Graphics::Frames::Info& frame_info);
+    void render_disoccluded_entities(Vulqian::Engine::Graphics::Frames::Info& frame_info);
     void render_transparent_entity(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Entity entity, Vulqian::Engine::ECS::Coordinator& coordinator);
 
+    RenderStats const& get_stats() const noexcept { return this->stats; }
+
+    // Opaque entities sharing a Mesh::model are drawn with one instanced call, one draw per entity otherwise
+    bool instanced{true};
+
+    // Entities whose bounds are outside the camera's frustum are not drawn
+    bool frustum_culling{true};
+
+    // Cull on the GPU and draw indirectly, when the device can start indirect draws past instance 0.
+    // Otherwise, or when record_culling was not called for the frame, the opaque entities go through the CPU path.
+    bool gpu_driven{true};
+
+    // On the GPU-driven path, entities hidden behind the depth of the previous frame are not drawn,
+    // unless the second phase finds them visible behind the depth of this one
+    bool occlusion_culling{true};
+
+    // On the CPU path, entities hidden behind the Mesh::occluder entities in view are not drawn.
+    // For devices without the compute to spare, software rasterizers first, whose draws cost the most.
+    bool cpu_occlusion_culling{false};
+
+    // Each entity draws the coarsest level of detail of its model whose error covers at most lod_error_pixels
+    // once projected on a viewport_height pixels high screen, and only switches once that limit is crossed
+    // by lod_hysteresis of it, so objects at the limit do not pop
+    bool  lod_selection{true};
+    float lod_error_pixels{1.f};
+    float lod_hysteresis{.25f};
+    float viewport_height{1080.f};
+
+    // Entities drawing the finest level of a model split into meshlets are culled meshlet by meshlet, against the
+    // frustum and, with cluster_cone_culling, against the cones of their normals, then draw the ranges left.
+    // The cones assume closed meshes: both faces of a triangle are drawn, so turn them off for open surfaces.
+    // On the GPU-driven path a compute pass copies the visible meshlets' indices into one range per entity,
+    // these entities then skip the occlusion culling.
+    bool cluster_culling{true};
+    bool cluster_cone_culling{true};
+
+    // When set, the occlusion buffer is written there as a PGM image after the next rasterization, then cleared
+    std::string occlusion_dump_path{};
+
+    Vulqian::Engine::Math::OcclusionBuffer const& get_occlusion_buffer() const noexcept { return this->occlusion_buffer; }
+
    private:
+    // An opaque entity of this frame, pointing into its components
+    struct VisibleEntity {
+        Vulqian::Engine::ECS::Components::WorldTransform const* world{};
+        Vulqian::Engine::ECS::Components::Mesh const*           mesh{};
+        Vulqian::Engine::ECS::Entity                            entity{};
+        std::uint32_t                                           lod{};  // of its model, once selected
+    };
+
     void create_pipeline_layout(VkDescriptorSetLayout global_set_layout);
     void create_pipeline(VkRenderPass render_pass);
+    void create_culling_pipeline(VkDescriptorSetLayout global_set_layout);
+    void create_cluster_pipeline(VkDescriptorSetLayout global_set_layout);
+    void create_reduce_pipeline(void);
+    void render_instanced(Vulqian::Engine::Graphics::Frames::Info& frame_info);
+    void render_indirect(Vulqian::Engine::Graphics::Frames::Info& frame_info);
+    // The pipeline drawing one entity at a time with its push constants
+    void bind_single(Vulqian::Engine::Graphics::Frames::Info& frame_info);
+    // The instanced pipeline with its per-instance attributes read from `instance_buffer`
+    void bind_instanced(Vulqian::Engine::Graphics::Frames::Info& frame_info, VkBuffer instance_buffer);
+    // Fills `candidates` with every opaque entity, then `visible` with the ones to draw this frame
+    void collect_visible(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Coordinator& coordinator);
+    void collect_candidates(Vulqian::Engine::ECS::Coordinator& coordinator);
+    // Drops from `visible` the entities the occluders among them hide, with cpu_occlusion_culling
+    void cull_occluded(Vulqian::Engine::Graphics::Frames::Info& frame_info, Vulqian::Engine::ECS::Coordinator& coordinator);
+    bool in_view(Vulqian::Engine::Math::Frustum const&                   frustum,
+                 Vulqian::Engine::ECS::Components::WorldTransform const& world,
+                 Vulqian::Engine::ECS::Components::Mesh const&           mesh) const noexcept;
+    // Level of detail of each of `entities`, remembered per entity for the hysteresis
+    void          select_lods(Vulqian::Engine::Graphics::Camera const& camera, std::vector<VisibleEntity>& entities);
+    std::uint32_t select_lod(Vulqian::Engine::ECS::Entity                            entity,
+                             Vulqian::Engine::ECS::Components::WorldTransform const& world,
+                             Vulqian::Engine::Graphics::Model const&                 model,
+                             Vulqian::Engine::Graphics::Camera const&                camera);
+    // Moves the entities of `entities` to cull meshlet by meshlet into `clustered`
+    void split_clustered(std::vector<VisibleEntity>& entities);
+    // CPU path: the ranges of the visible meshlets of each clustered entity, the ones with none left out
+    void cull_clusters(Vulqian::Engine::Graphics::Frames::Info& frame_info);
+    std::span<const Vulqian::Engine::Math::IndexRange> ranges_of(std::size_t clustered_index) const noexcept;
+    // GPU-driven path: the compute pass compacting the visible meshlets' indices of every clustered entity
+    void record_cluster_culling(Vulqian::Engine::Graphics::Frames::Info& frame_info);
+    void render_clusters_indirect(Vulqian::Engine::Graphics::Frames::Info& frame_info);
+    // Fills groups and group_of for `entities`, each group's instances following the previous group's
+    void          group_by_model(std::vector<VisibleEntity> const& entities);
+    InstanceData* reserve_instances(int frame_index, std::size_t count);
+    void          reserve_culling(int frame_index, std::size_t instance_count, std::size_t draw_count);
+    void          reserve_clusters(int frame_index, std::size_t instance_count, std::size_t index_count, std::size_t model_count);
+
+    // Push constants of cull_instances.comp
+    struct CullingPush;
+    void dispatch_culling(Vulqian::Engine::Graphics::Frames::Info& frame_info, CullingPush const& push);
+    // Sized for `source`, after waiting for the device if a previous pyramid may still be in use
+    void create_depth_pyramid(VkExtent2D source);
+    void destroy_depth_pyramid(void);
+    void build_depth_pyramid(Vulqian::Engine::Graphics::Frames::Info& frame_info);
 
     Vulqian::Engine::Graphics::Device& device;
 
     VkPipelineLayout pipeline_layout;
 
     std::unique_ptr<Vulqian::Engine::Graphics::Pipeline> pipeline;
+    std::unique_ptr<Vulqian::Engine::Graphics::Pipeline> instanced_pipeline;
+
+    // One host visible instance buffer per frame in flight, a frame only rewrites its own once its fence signaled
+    std::array<std::unique_ptr<Vulqian::Engine::Graphics::Buffer>, Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT> instance_buffers{};
+
+    // Opaque entities of this frame, the world spheres of their models as arrays for Math::cull_spheres, then the ones in view
+    std::vector<VisibleEntity>        candidates{};
+    std::array<std::vector<float>, 4> spheres{};  // x, y, z, radius
+    std::vector<std::uint8_t>         sphere_visible{};
+    std::vector<VisibleEntity>        visible{};
+
+    Vulqian::Engine::Math::OcclusionBuffer occlusion_buffer{};
+
+    // Level each entity drew last, indexed by entity index and tagged with the version that drew it
+    struct EntityLod {
+        std::uint32_t version{};
+        std::uint8_t  lod{};
+    };
+    std::vector<EntityLod> entity_lods{};
+
+    // Models drawn this frame at each level of detail with their instance ranges, and the group of each visible entity
+    struct InstanceGroup {
+        Vulqian::Engine::Graphics::Model* model{};
+        std::uint32_t                     lod{};
+        std::uint32_t                     first{};
+        std::uint32_t                     count{};
+    };
+    std::vector<InstanceGroup> groups{};
+    std::vector<std::uint32_t> group_of{};
+
+    // Entities culled meshlet by meshlet. On the CPU path their visible ranges follow each other, cluster_ends[i] past entity i's last.
+    std::vector<VisibleEntity>                     clustered{};
+    std::vector<Vulqian::Engine::Math::IndexRange> cluster_ranges{};
+    std::vector<std::uint32_t>                     cluster_ends{};
+
+    // GPU-driven path. Set 1 of the culling layout holds the buffers of one frame in flight:
+    // the scene instances and the indirect commands written by the host, the visible instances
+    // written by the shader for the instanced pipeline, and the count of visible instances read back.
+    // The occluded instances set aside by the first phase of the occlusion culling are listed after them,
+    // and the depth pyramid they are tested against is sampled from the same set.
+    struct CullingFrame {
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer> scene{};
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer> commands{};
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer> visible{};
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer> counter{};
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer> occluded{};
+        VkDescriptorSet                                    set{VK_NULL_HANDLE};
+        std::uint32_t                                      submitted{};  // scene instances of its last use
+    };
+    VkPipelineLayout                                                                     culling_layout{VK_NULL_HANDLE};
+    std::unique_ptr<Vulqian::Engine::Graphics::ComputePipeline>                          culling_pipeline{};
+    std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout>         culling_set_layout{};
+    std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorPool>              culling_pool{};
+    std::array<CullingFrame, Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT> culling_frames{};
+    bool                                                                                 culled_on_gpu{false};  // by record_culling, for the frame being drawn
+
+    // GPU-driven path of the clustered entities, sorted by model. Set 1 of the cluster layout holds the buffers of one
+    // frame in flight: the instances written by the host, one indirect command per entity, and the compacted indices
+    // the shader fills. Set 2 points to one model's meshlets and indices, allocated again every frame from the frame's pool.
+    struct ClusterFrame {
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer>                      instances{};
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer>                      commands{};
+        std::unique_ptr<Vulqian::Engine::Graphics::Buffer>                      indices{};
+        VkDescriptorSet                                                         set{VK_NULL_HANDLE};
+        std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorPool> model_pool{};
+        std::uint32_t                                                           model_sets{};  // capacity of model_pool
+    };
+    // The clustered entities of one model, a range of `clustered`
+    struct ClusterGroup {
+        Vulqian::Engine::Graphics::Model* model{};
+        std::uint32_t                     first{};
+        std::uint32_t                     count{};
+    };
+    VkPipelineLayout                                                                     cluster_layout{VK_NULL_HANDLE};
+    std::unique_ptr<Vulqian::Engine::Graphics::ComputePipeline>                          cluster_pipeline{};
+    std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout>         cluster_set_layout{};
+    std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout>         cluster_model_layout{};
+    std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorPool>              cluster_pool{};
+    std::array<ClusterFrame, Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT> cluster_frames{};
+    std::vector<ClusterGroup>                                                            cluster_groups{};
+
+    // Occlusion culling. The farthest depth of the opaque draws, halved level after level down to one texel,
+    // one image in the GENERAL layout shared by the frames in flight, their barriers keeping them in order.
+    struct DepthPyramid {
+        VkImage                  image{VK_NULL_HANDLE};
+        VkDeviceMemory           memory{VK_NULL_HANDLE};
+        VkImageView              view{VK_NULL_HANDLE};  // every level, sampled by the culling
+        std::vector<VkImageView> levels{};              // one level each, written by the reduction
+        VkExtent2D               extent{};              // of level 0, the largest power of two fitting the source
+        VkExtent2D               source{};              // of the depth attachments it is built from
+        glm::mat4                view_projection{1.f};  // of the frame whose depth it holds
+        bool                     initialized{false};    // moved to the GENERAL layout
+        bool                     built{false};          // holds a depth, false again once recreated
+    };
+    VkPipelineLayout                                                                      reduce_layout{VK_NULL_HANDLE};
+    std::unique_ptr<Vulqian::Engine::Graphics::ComputePipeline>                           reduce_pipeline{};
+    std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout>          reduce_set_layout{};
+    std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorPool>               reduce_pool{};
+    std::array<VkDescriptorSet, Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT> source_sets{};  // depth attachment to level 0, rewritten every build
+    std::vector<VkDescriptorSet>                                                          level_sets{};     // level - 1 to level, rewritten on recreation
+    VkSampler                                                                             pyramid_sampler{VK_NULL_HANDLE};
+    DepthPyramid                                                                          pyramid{};
+    Vulqian::Engine::Graphics::DepthTarget                                                depth_target{};  // of the frame being drawn
+    bool                                                                                  occlusion_pending{false};
+    bool                                                                                  disoccluded_on_gpu{false};
+
+    RenderStats stats{};
 };
 
 }  // namespace Vulqian::Engine::Graphics
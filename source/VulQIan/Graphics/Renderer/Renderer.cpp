@@ -116,18 +116,45 @@ void Renderer::end_frame(void) {
     this->current_frame_index = (this->current_frame_index + 1) % Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT;
 }
 
-void Renderer::begin_SwapChain_RenderPass(VkCommandBuffer command_buffer) {
+void Renderer::begin_SwapChain_RenderPass(VkCommandBuffer command_buffer, bool store_depth) {
     assert(is_frame_started && "Can't call begin_SwapChain_RenderPass while frame is not in progress");
     assert(command_buffer == this->get_current_commanBuffer() && "Can't begin render pass on command buffer from different frame");
 
+    this->begin_render_pass(command_buffer, store_depth ? this->swap_chain->getDepthStoringRenderPass() : this->swap_chain->getRenderPass());
+}
+
+void Renderer::resume_SwapChain_RenderPass(VkCommandBuffer command_buffer) {
+    assert(is_frame_started && "Can't call resume_SwapChain_RenderPass while frame is not in progress");
+    assert(command_buffer == this->get_current_commanBuffer() && "Can't resume render pass on command buffer from different frame");
+
+    // The passes share the external dependency of the first one, which does not wait for attachment writes.
+    // The depth was already handed back by the work in between, the color still has to be written before it is loaded.
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr);
+
+    this->begin_render_pass(command_buffer, this->swap_chain->getResumeRenderPass());
+}
+
+void Renderer::begin_render_pass(VkCommandBuffer command_buffer, VkRenderPass render_pass) {
     VkRenderPassBeginInfo render_pass_info{};
     render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    render_pass_info.renderPass = this->swap_chain->getRenderPass();
+    render_pass_info.renderPass = render_pass;
     render_pass_info.framebuffer = this->swap_chain->getFrameBuffer(this->current_image_index);
 
     render_pass_info.renderArea.offset = {0, 0};
     render_pass_info.renderArea.extent = this->swap_chain->getSwapChainExtent();
 
+    // Ignored by the resume pass, which loads both attachments
     std::array<VkClearValue, 2> clear_values{};
     clear_values[0].color = {0.01f, 0.01f, 0.01f, 1.0f};
     clear_values[1].depthStencil = {1.0f, static_cast<uint32_t>(0.0f)};
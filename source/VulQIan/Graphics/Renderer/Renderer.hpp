@@ -28,6 +28,7 @@ class Renderer {
 
     VkRenderPass get_SwapChain_RenderPass(void) const noexcept { return this->swap_chain->getRenderPass(); }
     float        get_aspect_ratio() const noexcept { return this->swap_chain->extentAspectRatio(); }
+    VkExtent2D   get_extent(void) const noexcept { return this->swap_chain->getSwapChainExtent(); }
     int          get_frame_index(void) const noexcept {
         assert(this->is_frame_started && "Cannot get current frame index when frame not in progress");
         return this->current_frame_index;
@@ -39,12 +40,22 @@ class Renderer {
         return this->command_buffers[this->current_frame_index];
     }
 
+    // Depth attachment of the image being drawn
+    Vulqian::Engine::Graphics::DepthTarget get_depth_target(void) const noexcept {
+        assert(this->is_frame_started && "Cannot get depth target when frame not in progress");
+        return this->swap_chain->getDepthTarget(static_cast<int>(this->current_image_index));
+    }
+
     VkCommandBuffer begin_frame(void);
     void            end_frame(void);
-    void            begin_SwapChain_RenderPass(VkCommandBuffer command_buffer);
+    // With store_depth, the depth attachment outlives the pass, for work recorded before resume_SwapChain_RenderPass
+    void            begin_SwapChain_RenderPass(VkCommandBuffer command_buffer, bool store_depth = false);
+    // Begins the pass again after end_SwapChain_RenderPass, keeping what was drawn, to run compute work in between
+    void            resume_SwapChain_RenderPass(VkCommandBuffer command_buffer);
     void            end_SwapChain_RenderPass(VkCommandBuffer command_buffer) const;
 
   private:
+    void begin_render_pass(VkCommandBuffer command_buffer, VkRenderPass render_pass);
     void create_command_buffers(void);
     void free_command_buffers(void);
     void recreate_swap_chain(void);
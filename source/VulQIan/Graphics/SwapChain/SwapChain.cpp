@@ -47,6 +47,8 @@ SwapChain::~SwapChain() {
     }
 
     vkDestroyRenderPass(device.get_device(), renderPass, nullptr);
+    vkDestroyRenderPass(device.get_device(), depthStoringRenderPass, nullptr);
+    vkDestroyRenderPass(device.get_device(), resumeRenderPass, nullptr);
 
     // cleanup synchronization objects
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
@@ -260,6 +262,28 @@ void SwapChain::createRenderPass() {
     if (vkCreateRenderPass(device.get_device(), &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
         throw Vulqian::Exception::failed_to_create("render pass");
     }
+
+    // The passes below only differ from it by their load / store ops and layouts, so they stay compatible with the
+    // framebuffers and pipelines. Their dependency is the same too: the work in between synchronizes with pipeline barriers.
+    // This one keeps the depth for the depth pyramid of the occlusion culling.
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    attachments = {colorAttachment, depthAttachment};
+
+    if (vkCreateRenderPass(device.get_device(), &renderPassInfo, nullptr, &depthStoringRenderPass) != VK_SUCCESS) {
+        throw Vulqian::Exception::failed_to_create("depth storing render pass");
+    }
+
+    // Starting from where the first pass left them
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    attachments = {colorAttachment, depthAttachment};
+
+    if (vkCreateRenderPass(device.get_device(), &renderPassInfo, nullptr, &resumeRenderPass) != VK_SUCCESS) {
+        throw Vulqian::Exception::failed_to_create("resume render pass");
+    }
 }
 
 void SwapChain::createFramebuffers() {
@@ -304,7 +328,7 @@ void SwapChain::createDepthResources() {
         imageInfo.format = depthFormat;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
         imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
         imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         imageInfo.flags = 0;
@@ -398,6 +422,6 @@ VkFormat SwapChain::findDepthFormat() {
     return device.findSupportedFormat(
         {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
         VK_IMAGE_TILING_OPTIMAL,
-        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
 }
 } // namespace Vulqian::Engine::Graphics
@@ -23,6 +23,14 @@
 
 namespace Vulqian::Engine::Graphics {
 
+// The depth attachment of one swap chain image, sampled between two render passes by the occlusion culling
+struct DepthTarget {
+    VkImage     image{VK_NULL_HANDLE};
+    VkImageView view{VK_NULL_HANDLE};
+    VkFormat    format{VK_FORMAT_UNDEFINED};
+    VkExtent2D  extent{};
+};
+
 class SwapChain {
   public:
     static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
@@ -39,6 +47,11 @@ class SwapChain {
     VkFormat      getSwapChainImageFormat() const noexcept { return swapChainImageFormat; }
     VkImageView   getImageView(int index) noexcept { return swapChainImageViews[index]; }
     VkRenderPass  getRenderPass() noexcept { return renderPass; }
+    // Compatible with getRenderPass, but stores the depth attachment for work after the pass
+    VkRenderPass  getDepthStoringRenderPass() noexcept { return depthStoringRenderPass; }
+    // Compatible with getRenderPass, but loads what an earlier pass of the frame drew instead of clearing it
+    VkRenderPass  getResumeRenderPass() noexcept { return resumeRenderPass; }
+    DepthTarget   getDepthTarget(int index) const noexcept { return {depthImages[index], depthImageViews[index], swapChainDepthFormat, swapChainExtent}; }
 
     size_t imageCount() const noexcept { return swapChainImages.size(); }
 
@@ -78,6 +91,8 @@ class SwapChain {
 
     std::vector<VkFramebuffer> swapChainFramebuffers;
     VkRenderPass               renderPass;
+    VkRenderPass               depthStoringRenderPass;
+    VkRenderPass               resumeRenderPass;
 
     std::vector<VkImage>        depthImages;
     std::vector<VkDeviceMemory> depthImageMemorys;
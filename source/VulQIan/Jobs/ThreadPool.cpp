@@ -0,0 +1,144 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "ThreadPool.hpp"
+
+#include <limits>
+#include <utility>
+
+namespace Vulqian::Engine::Jobs {
+
+namespace {
+// Queue owned by the current thread, threads outside the pool share the last queue
+constexpr std::size_t EXTERNAL_THREAD = std::numeric_limits<std::size_t>::max();
+
+thread_local ThreadPool const* current_pool{nullptr};
+thread_local std::size_t       current_queue{EXTERNAL_THREAD};
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    for (std::size_t i = 0; i <= thread_count; ++i) {
+        this->queues.push_back(std::make_unique<Queue>());
+    }
+
+    this->workers.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        this->workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{this->sleep_mutex};
+        this->stopping = true;
+    }
+    this->wake_up.notify_all();
+
+    for (auto& worker : this->workers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::default_thread_count() noexcept {
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void ThreadPool::submit(Job job, WaitGroup& group) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    const std::size_t queue = current_pool == this ? current_queue : this->queues.size() - 1;
+    {
+        std::lock_guard lock{this->queues[queue]->mutex};
+        this->queues[queue]->tasks.push_back(Task{std::move(job), &group});
+    }
+
+    {
+        // Taking the lock orders the increment with a worker about to sleep
+        std::lock_guard lock{this->sleep_mutex};
+        this->queued.fetch_add(1, std::memory_order_release);
+    }
+    this->wake_up.notify_one();
+}
+
+void ThreadPool::wait(WaitGroup& group) {
+    const std::size_t preferred = current_pool == this ? current_queue : this->queues.size() - 1;
+
+    while (!group.done()) {
+        if (Task task{}; this->try_pop(preferred, task)) {
+            this->run(task);
+        } else {
+            // The remaining jobs are running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::worker_loop(std::size_t index) {
+    current_pool = this;
+    current_queue = index;
+
+    while (true) {
+        if (Task task{}; this->try_pop(index, task)) {
+            this->run(task);
+            continue;
+        }
+
+        std::unique_lock lock{this->sleep_mutex};
+        this->wake_up.wait(lock, [this] { return this->stopping || this->queued.load(std::memory_order_acquire) > 0; });
+
+        if (this->stopping && this->queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::try_pop(std::size_t preferred, Task& task) {
+    {
+        auto& own = *this->queues[preferred];
+        std::lock_guard lock{own.mutex};
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            this->queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < this->queues.size(); ++offset) {
+        auto& victim = *this->queues[(preferred + offset) % this->queues.size()];
+        std::lock_guard lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            this->queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(Task& task) {
+    task.job();
+    task.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void run_jobs(ThreadPool* pool, std::size_t count, std::function<void(std::size_t)> const& job) {
+    if (pool == nullptr || count < 2) {
+        for (std::size_t i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    WaitGroup group{};
+    for (std::size_t i = 0; i < count; ++i) {
+        pool->submit([&job, i] { job(i); }, group);
+    }
+    pool->wait(group);
+}
+
+} // namespace Vulqian::Engine::Jobs
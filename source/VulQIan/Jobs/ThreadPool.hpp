@@ -0,0 +1,85 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Vulqian::Engine::Jobs {
+
+// Counts the jobs of a batch still running, wait() on it returns once they all finished
+class WaitGroup {
+  public:
+    bool done() const noexcept { return this->pending.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class ThreadPool;
+
+    std::atomic<std::size_t> pending{};
+};
+
+// Fixed set of worker threads, each owning a job deque.
+// A worker pops its own newest job first and steals the oldest job of another worker when idle,
+// which keeps freshly spawned (cache-hot) work local and balances long batches across cores.
+class ThreadPool {
+  public:
+    using Job = std::function<void()>;
+
+    // A pool of zero threads is valid: jobs then run on the thread calling wait()
+    explicit ThreadPool(std::size_t thread_count = default_thread_count());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Job job, WaitGroup& group);
+
+    // Runs pending jobs on the calling thread until every job of the group finished
+    void wait(WaitGroup& group);
+
+    std::size_t get_thread_count() const noexcept { return this->workers.size(); }
+
+    // Every hardware thread but the one running the frame loop
+    static std::size_t default_thread_count() noexcept;
+
+  private:
+    struct Task {
+        Job        job;
+        WaitGroup* group{nullptr};
+    };
+
+    struct Queue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(std::size_t index);
+
+    // Pops from the back of `preferred`, then steals from the front of the other queues
+    bool try_pop(std::size_t preferred, Task& task);
+    void run(Task& task);
+
+    // One queue per worker plus a last one shared by the threads outside the pool
+    std::vector<std::unique_ptr<Queue>> queues{};
+    std::vector<std::thread>            workers{};
+
+    std::mutex               sleep_mutex{};
+    std::condition_variable  wake_up{};
+    std::atomic<std::size_t> queued{};
+    bool                     stopping{false};
+};
+
+// Runs job(i) for every i in [0, count) on `pool` and waits for them, inline without a pool or for a single job
+void run_jobs(ThreadPool* pool, std::size_t count, std::function<void(std::size_t)> const& job);
+
+} // namespace Vulqian::Engine::Jobs
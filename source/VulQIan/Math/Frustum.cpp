@@ -0,0 +1,107 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Frustum.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define VULQIAN_FRUSTUM_SSE2 1
+#include <emmintrin.h>
+#else
+#define VULQIAN_FRUSTUM_SSE2 0
+#endif
+
+namespace Vulqian::Engine::Math {
+
+BoundingSphere transform_sphere(BoundingSphere const& sphere, glm::mat4 const& matrix) noexcept {
+    const float scale = std::sqrt(std::max({glm::dot(glm::vec3{matrix[0]}, glm::vec3{matrix[0]}), glm::dot(glm::vec3{matrix[1]}, glm::vec3{matrix[1]}),
+                                            glm::dot(glm::vec3{matrix[2]}, glm::vec3{matrix[2]})}));
+    return {glm::vec3{matrix * glm::vec4{sphere.center, 1.f}}, sphere.radius * scale};
+}
+
+BoundingBox transform_box(BoundingBox const& box, glm::mat4 const& matrix) noexcept {
+    // Center moved, each world axis takes the absolute projection of the three local half extents
+    const glm::vec3 center = glm::vec3{matrix * glm::vec4{(box.min + box.max) * .5f, 1.f}};
+    const glm::vec3 half = (box.max - box.min) * .5f;
+    const glm::vec3 extent = glm::abs(glm::vec3{matrix[0]}) * half.x + glm::abs(glm::vec3{matrix[1]}) * half.y + glm::abs(glm::vec3{matrix[2]}) * half.z;
+    return {center - extent, center + extent};
+}
+
+Frustum Frustum::from_matrix(glm::mat4 const& view_projection) noexcept {
+    // Gribb & Hartmann: each plane is a sum or difference of rows of the matrix
+    auto row = [&view_projection](int i) { return glm::vec4{view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]}; };
+
+    Frustum frustum{};
+    frustum.planes[Left] = row(3) + row(0);
+    frustum.planes[Right] = row(3) - row(0);
+    frustum.planes[Top] = row(3) + row(1);  // clip y points down in Vulkan
+    frustum.planes[Bottom] = row(3) - row(1);
+    frustum.planes[Near] = row(2);  // 0 <= z
+    frustum.planes[Far] = row(3) - row(2);
+
+    // Normalized so the plane equation gives distances, which the sphere test compares with radii
+    for (auto& plane : frustum.planes) {
+        plane = plane / glm::length(glm::vec3{plane});
+    }
+    return frustum;
+}
+
+bool Frustum::intersects(BoundingSphere const& sphere) const noexcept {
+    return std::all_of(this->planes.begin(), this->planes.end(),
+                       [&sphere](glm::vec4 const& plane) { return glm::dot(glm::vec3{plane}, sphere.center) + plane.w >= -sphere.radius; });
+}
+
+bool Frustum::intersects(BoundingBox const& box) const noexcept {
+    // Only the corner farthest along each plane's normal needs to be inside
+    return std::all_of(this->planes.begin(), this->planes.end(), [&box](glm::vec4 const& plane) {
+        const glm::vec3 corner{plane.x >= 0.f ? box.max.x : box.min.x, plane.y >= 0.f ? box.max.y : box.min.y, plane.z >= 0.f ? box.max.z : box.min.z};
+        return glm::dot(glm::vec3{plane}, corner) + plane.w >= 0.f;
+    });
+}
+
+std::size_t cull_spheres(Frustum const& frustum, SphereArrays const& spheres, std::uint8_t* visible) noexcept {
+    std::size_t visible_count = 0;
+    std::size_t i = 0;
+
+#if VULQIAN_FRUSTUM_SSE2
+    __m128 planes[6][4];
+    for (std::size_t p = 0; p < frustum.planes.size(); ++p) {
+        for (int component = 0; component < 4; ++component) {
+            planes[p][component] = _mm_set1_ps(frustum.planes[p][component]);
+        }
+    }
+
+    for (; i + 4 <= spheres.count; i += 4) {
+        const __m128 x = _mm_loadu_ps(spheres.x + i);
+        const __m128 y = _mm_loadu_ps(spheres.y + i);
+        const __m128 z = _mm_loadu_ps(spheres.z + i);
+        const __m128 negative_radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius + i));
+
+        // Lanes stay set while every plane distance is at least -radius
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (auto const& plane : planes) {
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[0], x), _mm_mul_ps(plane[1], y)), _mm_add_ps(_mm_mul_ps(plane[2], z), plane[3]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negative_radius));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible[i + lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+        }
+        visible_count += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+#endif
+
+    for (; i < spheres.count; ++i) {
+        visible[i] = frustum.intersects(BoundingSphere{{spheres.x[i], spheres.y[i], spheres.z[i]}, spheres.radius[i]});
+        visible_count += visible[i];
+    }
+    return visible_count;
+}
+
+} // namespace Vulqian::Engine::Math
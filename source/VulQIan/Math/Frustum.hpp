@@ -0,0 +1,57 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace Vulqian::Engine::Math {
+
+struct BoundingBox {
+    glm::vec3 min{};
+    glm::vec3 max{};
+};
+
+struct BoundingSphere {
+    glm::vec3 center{};
+    float     radius{};
+};
+
+// Bounds of a model once placed by `matrix`, a sphere grows with the largest scale of the three axes
+BoundingSphere transform_sphere(BoundingSphere const& sphere, glm::mat4 const& matrix) noexcept;
+BoundingBox    transform_box(BoundingBox const& box, glm::mat4 const& matrix) noexcept;
+
+// The six planes of a view-projection, normals pointing inside: a point p is inside a plane when
+// dot(plane.xyz, p) + plane.w >= 0. Clip depth goes from 0 to 1, as in Vulkan.
+struct Frustum {
+    enum Plane : std::uint8_t { Left, Right, Top, Bottom, Near, Far };
+
+    std::array<glm::vec4, 6> planes{};
+
+    static Frustum from_matrix(glm::mat4 const& view_projection) noexcept;
+
+    // Conservative: false only when the bounds are entirely outside one of the planes
+    bool intersects(BoundingSphere const& sphere) const noexcept;
+    bool intersects(BoundingBox const& box) const noexcept;
+};
+
+// Structure-of-arrays view over `count` world space spheres
+struct SphereArrays {
+    float const* x{};
+    float const* y{};
+    float const* z{};
+    float const* radius{};
+    std::size_t  count{};
+};
+
+// Frustum::intersects over every sphere, 4 at a time with SSE2 on x86 (part of every x86-64 CPU, so
+// nothing to detect), one at a time elsewhere. Writes 1 or 0 to visible[i] and returns how many are visible.
+std::size_t cull_spheres(Frustum const& frustum, SphereArrays const& spheres, std::uint8_t* visible) noexcept;
+
+} // namespace Vulqian::Engine::Math
@@ -0,0 +1,253 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Meshlets.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+namespace Vulqian::Engine::Math {
+
+namespace {
+
+constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+// Point of each vertex, vertices sharing a position sharing one
+std::vector<std::uint32_t> weld(std::span<const glm::vec3> positions, std::uint32_t& point_count) {
+    std::vector<std::uint32_t> order(positions.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [positions](std::uint32_t a, std::uint32_t b) {
+        return std::tie(positions[a].x, positions[a].y, positions[a].z) < std::tie(positions[b].x, positions[b].y, positions[b].z);
+    });
+
+    std::vector<std::uint32_t> point_of(positions.size());
+    point_count = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && positions[order[i]] != positions[order[i - 1]]) {
+            ++point_count;
+        }
+        point_of[order[i]] = point_count;
+    }
+    point_count += order.empty() ? 0 : 1;
+    return point_of;
+}
+
+// Sphere around the box of its vertices, and the cone of its triangles' normals
+void compute_bounds(Meshlet& meshlet, std::span<const glm::vec3> positions, std::span<const glm::vec3> normals, std::span<const std::uint32_t> indices) {
+    glm::vec3 low{std::numeric_limits<float>::max()};
+    glm::vec3 high{std::numeric_limits<float>::lowest()};
+    for (const std::uint32_t index : indices) {
+        low = glm::min(low, positions[index]);
+        high = glm::max(high, positions[index]);
+    }
+    meshlet.sphere.center = (low + high) * .5f;
+    float farthest = 0.f;
+    for (const std::uint32_t index : indices) {
+        const glm::vec3 offset = positions[index] - meshlet.sphere.center;
+        farthest = std::max(farthest, glm::dot(offset, offset));
+    }
+    meshlet.sphere.radius = std::sqrt(farthest);
+    meshlet.cone_apex = meshlet.sphere.center;
+
+    // Unit face normals, turned the way the vertex normals point when there are any
+    std::vector<std::pair<glm::vec3, glm::vec3>> faces{};  // normal, a corner
+    faces.reserve(indices.size() / 3);
+    glm::vec3 sum{0.f};
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const glm::vec3 a = positions[indices[i]], b = positions[indices[i + 1]], c = positions[indices[i + 2]];
+        glm::vec3       normal = glm::cross(b - a, c - a);
+        const float     length = glm::length(normal);
+        if (length == 0.f) {
+            continue;
+        }
+        normal /= length;
+        if (!normals.empty() && glm::dot(normal, normals[indices[i]] + normals[indices[i + 1]] + normals[indices[i + 2]]) < 0.f) {
+            normal = -normal;
+        }
+        faces.emplace_back(normal, a);
+        sum += normal;
+    }
+    if (faces.empty() || glm::length(sum) < 1e-6f) {
+        return;
+    }
+
+    // The widest angle between the axis and a normal. Past about 84 degrees the cone hardly ever culls, so it never does.
+    meshlet.cone_axis = glm::normalize(sum);
+    float min_dot = 1.f;
+    for (auto const& [normal, corner] : faces) {
+        min_dot = std::min(min_dot, glm::dot(normal, meshlet.cone_axis));
+    }
+    if (min_dot <= .1f) {
+        return;
+    }
+
+    // The apex goes back along the axis until it is behind every triangle's plane. Any viewpoint within the cone
+    // of half angle asin(min_dot) behind it then sees the back of every triangle.
+    float back = std::numeric_limits<float>::lowest();
+    for (auto const& [normal, corner] : faces) {
+        back = std::max(back, glm::dot(meshlet.sphere.center - corner, normal) / glm::dot(meshlet.cone_axis, normal));
+    }
+    meshlet.cone_apex = meshlet.sphere.center - meshlet.cone_axis * back;
+    meshlet.cone_cutoff = std::sqrt(1.f - min_dot * min_dot);
+}
+
+} // namespace
+
+ClusteredMesh build_meshlets(std::span<const glm::vec3>     positions,
+                             std::span<const glm::vec3>     normals,
+                             std::span<const std::uint32_t> indices,
+                             std::size_t                    max_vertices,
+                             std::size_t                    max_triangles) {
+    assert(max_vertices >= 3 && max_triangles >= 1 && "A meshlet must hold at least one triangle.");
+    assert((normals.empty() || normals.size() == positions.size()) && "One normal per vertex, or none.");
+
+    // Triangles around each point, in compressed rows
+    std::uint32_t                    point_count = 0;
+    const std::vector<std::uint32_t> point_of = weld(positions, point_count);
+    const std::size_t                triangle_count = indices.size() / 3;
+    std::vector<std::uint32_t>       first_triangle(point_count + 1);
+    for (std::size_t i = 0; i < 3 * triangle_count; ++i) {
+        ++first_triangle[point_of[indices[i]] + 1];
+    }
+    std::partial_sum(first_triangle.begin(), first_triangle.end(), first_triangle.begin());
+    std::vector<std::uint32_t> triangles_around(3 * triangle_count);
+    {
+        std::vector<std::uint32_t> cursors(first_triangle.begin(), first_triangle.end() - 1);
+        for (std::size_t i = 0; i < 3 * triangle_count; ++i) {
+            triangles_around[cursors[point_of[indices[i]]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+    }
+
+    ClusteredMesh result{};
+    result.indices.reserve(3 * triangle_count);
+
+    std::vector<std::uint8_t>  emitted(triangle_count);
+    std::vector<std::uint32_t> vertex_meshlet(positions.size(), NONE);   // last meshlet holding each vertex
+    std::vector<std::uint32_t> candidate_meshlet(triangle_count, NONE);  // last meshlet each triangle was a candidate of
+    std::vector<std::uint32_t> candidates{};
+    std::size_t                next_seed = 0;
+    while (true) {
+        // Next to the previous meshlet when it left any triangle around it, the next one in order otherwise
+        std::uint32_t seed = NONE;
+        for (const std::uint32_t candidate : candidates) {
+            if (!emitted[candidate]) {
+                seed = candidate;
+                break;
+            }
+        }
+        for (; seed == NONE && next_seed < triangle_count; ++next_seed) {
+            if (!emitted[next_seed]) {
+                seed = static_cast<std::uint32_t>(next_seed);
+            }
+        }
+        if (seed == NONE) {
+            break;
+        }
+
+        const auto  id = static_cast<std::uint32_t>(result.meshlets.size());
+        Meshlet     meshlet{static_cast<std::uint32_t>(result.indices.size())};
+        std::size_t vertex_count = 0;
+        std::size_t meshlet_triangles = 0;
+        candidates.clear();
+
+        const auto new_vertices = [&](std::uint32_t triangle) {
+            std::size_t count = 0;
+            for (std::size_t k = 0; k < 3; ++k) {
+                const std::uint32_t vertex = indices[3 * triangle + k];
+                // A vertex repeated within the triangle only counts once
+                count += vertex_meshlet[vertex] != id && (k == 0 || vertex != indices[3 * triangle]) && (k < 2 || vertex != indices[3 * triangle + 1]);
+            }
+            return count;
+        };
+        const auto add = [&](std::uint32_t triangle) {
+            emitted[triangle] = 1;
+            ++meshlet_triangles;
+            for (std::size_t k = 0; k < 3; ++k) {
+                const std::uint32_t vertex = indices[3 * triangle + k];
+                if (vertex_meshlet[vertex] != id) {
+                    vertex_meshlet[vertex] = id;
+                    ++vertex_count;
+                }
+                result.indices.push_back(vertex);
+
+                const std::uint32_t point = point_of[vertex];
+                for (std::uint32_t j = first_triangle[point]; j < first_triangle[point + 1]; ++j) {
+                    const std::uint32_t neighbour = triangles_around[j];
+                    if (!emitted[neighbour] && candidate_meshlet[neighbour] != id) {
+                        candidate_meshlet[neighbour] = id;
+                        candidates.push_back(neighbour);
+                    }
+                }
+            }
+        };
+
+        add(seed);
+        while (meshlet_triangles < max_triangles) {
+            // The neighbour bringing the fewest new vertices, the earliest found among equals so the meshlet grows round
+            std::uint32_t best = NONE;
+            std::size_t   best_count = 4;
+            std::size_t   kept = 0;
+            for (std::size_t i = 0; i < candidates.size(); ++i) {
+                const std::uint32_t candidate = candidates[i];
+                if (emitted[candidate]) {
+                    continue;
+                }
+                candidates[kept++] = candidate;
+                const std::size_t count = new_vertices(candidate);
+                if (count < best_count && vertex_count + count <= max_vertices) {
+                    best = candidate;
+                    best_count = count;
+                }
+            }
+            candidates.resize(kept);
+            if (best == NONE) {
+                break;
+            }
+            add(best);
+        }
+
+        meshlet.index_count = static_cast<std::uint32_t>(result.indices.size()) - meshlet.first_index;
+        compute_bounds(meshlet, positions, normals, std::span<const std::uint32_t>{result.indices}.subspan(meshlet.first_index, meshlet.index_count));
+        result.meshlets.push_back(meshlet);
+    }
+    return result;
+}
+
+std::size_t cull_meshlets(std::span<const Meshlet> meshlets,
+                          glm::mat4 const&         world_matrix,
+                          glm::mat4 const&         normal_matrix,
+                          Frustum const&           frustum,
+                          glm::vec3 const&         camera_position,
+                          bool                     cone_culling,
+                          std::vector<IndexRange>& ranges) {
+    // The normal matrix is the inverse transpose of the world one, so its transpose undoes the world's rotation and scale
+    const glm::vec3 local_camera = glm::transpose(glm::mat3{normal_matrix}) * (camera_position - glm::vec3{world_matrix[3]});
+
+    const std::size_t first_range = ranges.size();
+    std::size_t       visible = 0;
+    for (Meshlet const& meshlet : meshlets) {
+        if (!frustum.intersects(transform_sphere(meshlet.sphere, world_matrix))) {
+            continue;
+        }
+        // A camera on the apex gives a NaN, which never culls
+        if (cone_culling && glm::dot(glm::normalize(meshlet.cone_apex - local_camera), meshlet.cone_axis) >= meshlet.cone_cutoff) {
+            continue;
+        }
+
+        ++visible;
+        if (ranges.size() > first_range && ranges.back().first_index + ranges.back().index_count == meshlet.first_index) {
+            ranges.back().index_count += meshlet.index_count;
+        } else {
+            ranges.push_back({meshlet.first_index, meshlet.index_count});
+        }
+    }
+    return visible;
+}
+
+} // namespace Vulqian::Engine::Math
@@ -0,0 +1,68 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Frustum.hpp"
+
+namespace Vulqian::Engine::Math {
+
+// Up to 64 vertices and 124 triangles per meshlet, the sizes mesh shaders favor, small enough to cull
+// a large mesh piece by piece while each range stays worth its own draw
+constexpr std::size_t MAX_MESHLET_VERTICES = 64;
+constexpr std::size_t MAX_MESHLET_TRIANGLES = 124;
+
+// A cluster of neighbouring triangles, its indices contiguous in the mesh's index buffer.
+// Every one of its triangles faces away from a viewpoint v when dot(normalize(cone_apex - v), cone_axis) >= cone_cutoff,
+// a cutoff above 1 when they face too many ways for the test to ever pass.
+struct Meshlet {
+    std::uint32_t  first_index{};
+    std::uint32_t  index_count{};
+    BoundingSphere sphere{};
+    glm::vec3      cone_apex{};
+    glm::vec3      cone_axis{};
+    float          cone_cutoff{2.f};
+};
+
+struct IndexRange {
+    std::uint32_t first_index{};
+    std::uint32_t index_count{};
+};
+
+struct ClusteredMesh {
+    std::vector<Meshlet>       meshlets{};
+    std::vector<std::uint32_t> indices{};  // the triangles of the original, reordered meshlet after meshlet
+};
+
+// Grows each meshlet from a seed triangle, adding the neighbour that brings the fewest new vertices until either
+// limit is reached, then seeds the next one next to it. Vertices sharing a position are neighbours, so flat shaded
+// meshes cluster as well as smooth ones. The cone orients each triangle along its vertex normals when `normals`
+// is not empty, by its winding otherwise. Meshlet ranges start at 0, offset them by where `indices` start.
+ClusteredMesh build_meshlets(std::span<const glm::vec3>     positions,
+                             std::span<const glm::vec3>     normals,
+                             std::span<const std::uint32_t> indices,
+                             std::size_t                    max_vertices = MAX_MESHLET_VERTICES,
+                             std::size_t                    max_triangles = MAX_MESHLET_TRIANGLES);
+
+// Appends to `ranges` the index ranges of the meshlets of a mesh placed by `world_matrix` that may be seen from
+// `camera_position`: their sphere touches the frustum and, with `cone_culling`, some triangle faces the camera.
+// The cone is tested in the mesh's space, camera brought back by the inverse of `normal_matrix`, so it stays exact
+// under non-uniform scales. Neighbouring visible meshlets share one range. Returns how many meshlets are visible.
+std::size_t cull_meshlets(std::span<const Meshlet> meshlets,
+                          glm::mat4 const&         world_matrix,
+                          glm::mat4 const&         normal_matrix,
+                          Frustum const&           frustum,
+                          glm::vec3 const&         camera_position,
+                          bool                     cone_culling,
+                          std::vector<IndexRange>& ranges);
+
+} // namespace Vulqian::Engine::Math
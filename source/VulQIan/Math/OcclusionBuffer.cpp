@@ -0,0 +1,296 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define VULQIAN_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#else
+#define VULQIAN_OCCLUSION_SSE2 0
+#endif
+
+namespace Vulqian::Engine::Math {
+
+namespace {
+
+// a * x + b * y + c, positive on the left of p -> q in a screen whose y points down
+glm::vec3 edge(glm::vec3 const& p, glm::vec3 const& q) noexcept {
+    const float a = p.y - q.y;
+    const float b = q.x - p.x;
+    return {a, b, -(a * p.x + b * p.y)};
+}
+
+} // namespace
+
+OcclusionBuffer::OcclusionBuffer(std::uint32_t width, std::uint32_t height)
+    : width{(std::max(width, 1u) + TILE_WIDTH - 1) / TILE_WIDTH * TILE_WIDTH},
+      height{(std::max(height, 1u) + TILE_HEIGHT - 1) / TILE_HEIGHT * TILE_HEIGHT},
+      tiles_x{this->width / TILE_WIDTH},
+      depth(static_cast<std::size_t>(this->width) * this->height, 1.f),
+      tile_depth(static_cast<std::size_t>(this->tiles_x) * (this->height / TILE_HEIGHT), 1.f),
+      bins(this->height / TILE_HEIGHT) {}
+
+void OcclusionBuffer::begin(glm::mat4 const& view_projection) {
+    this->view_projection = view_projection;
+    std::fill(this->depth.begin(), this->depth.end(), 1.f);
+    std::fill(this->tile_depth.begin(), this->tile_depth.end(), 1.f);
+    this->triangles.clear();
+    for (auto& bin : this->bins) {
+        bin.clear();
+    }
+}
+
+void OcclusionBuffer::add_occluder(std::span<const glm::vec3> positions, std::span<const std::uint32_t> indices, glm::mat4 const& model) {
+    const glm::mat4 matrix = this->view_projection * model;
+    this->clip_positions.resize(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        this->clip_positions[i] = matrix * glm::vec4{positions[i], 1.f};
+    }
+
+    if (indices.empty()) {
+        for (std::size_t i = 0; i + 2 < positions.size(); i += 3) {
+            this->queue(this->clip_positions[i], this->clip_positions[i + 1], this->clip_positions[i + 2]);
+        }
+        return;
+    }
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        this->queue(this->clip_positions[indices[i]], this->clip_positions[indices[i + 1]], this->clip_positions[indices[i + 2]]);
+    }
+}
+
+void OcclusionBuffer::queue(glm::vec4 const& a, glm::vec4 const& b, glm::vec4 const& c) {
+    // Sutherland-Hodgman against the near plane z >= 0 only, a triangle becomes at most a quad
+    const std::array<glm::vec4, 3> corners{a, b, c};
+    std::array<glm::vec4, 4>       clipped{};
+    std::size_t                    count = 0;
+    for (std::size_t i = 0; i < 3; ++i) {
+        glm::vec4 const& current = corners[i];
+        glm::vec4 const& next = corners[(i + 1) % 3];
+        if (current.z >= 0.f) {
+            clipped[count++] = current;
+        }
+        if ((current.z >= 0.f) != (next.z >= 0.f)) {
+            clipped[count++] = current + (next - current) * (current.z / (current.z - next.z));
+        }
+    }
+    if (count < 3) {
+        return;
+    }
+
+    // To pixels, the center of pixel (x, y) being at (x + .5, y + .5)
+    std::array<glm::vec3, 4> screen{};
+    for (std::size_t i = 0; i < count; ++i) {
+        if (clipped[i].w <= 0.f) {
+            return;
+        }
+        const float inverse = 1.f / clipped[i].w;
+        screen[i] = {(clipped[i].x * inverse * .5f + .5f) * static_cast<float>(this->width),
+                     (clipped[i].y * inverse * .5f + .5f) * static_cast<float>(this->height),
+                     clipped[i].z * inverse};
+    }
+    this->setup(screen[0], screen[1], screen[2]);
+    if (count == 4) {
+        this->setup(screen[0], screen[2], screen[3]);
+    }
+}
+
+void OcclusionBuffer::setup(glm::vec3 const& a, glm::vec3 const& b, glm::vec3 const& c) {
+    // Counter-clockwise on screen, whichever way the occluder faces
+    float            area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    glm::vec3 const* second = &b;
+    glm::vec3 const* third = &c;
+    if (area < 0.f) {
+        std::swap(second, third);
+        area = -area;
+    }
+    if (area < 1e-6f) {
+        return;
+    }
+
+    Triangle triangle{};
+    triangle.min_x = std::max(static_cast<std::int32_t>(std::ceil(std::min({a.x, b.x, c.x}) - .5f)), 0);
+    triangle.max_x = std::min(static_cast<std::int32_t>(std::floor(std::max({a.x, b.x, c.x}) - .5f)), static_cast<std::int32_t>(this->width) - 1);
+    triangle.min_y = std::max(static_cast<std::int32_t>(std::ceil(std::min({a.y, b.y, c.y}) - .5f)), 0);
+    triangle.max_y = std::min(static_cast<std::int32_t>(std::floor(std::max({a.y, b.y, c.y}) - .5f)), static_cast<std::int32_t>(this->height) - 1);
+    if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+        return;
+    }
+
+    // Each edge function is the barycentric weight of the opposite corner times the area
+    triangle.edges = {edge(*second, *third), edge(*third, a), edge(a, *second)};
+    triangle.depth = (triangle.edges[0] * a.z + triangle.edges[1] * second->z + triangle.edges[2] * third->z) / area;
+
+    const auto index = static_cast<std::uint32_t>(this->triangles.size());
+    this->triangles.push_back(triangle);
+    for (std::int32_t band = triangle.min_y / static_cast<std::int32_t>(TILE_HEIGHT); band <= triangle.max_y / static_cast<std::int32_t>(TILE_HEIGHT); ++band) {
+        this->bins[band].push_back(index);
+    }
+}
+
+void OcclusionBuffer::rasterize(Jobs::ThreadPool* pool) {
+    // Bands own their rows, so the jobs never write the same pixel
+    Jobs::run_jobs(pool, this->bins.size(), [this](std::size_t band) { this->rasterize_band(band); });
+}
+
+void OcclusionBuffer::rasterize_band(std::size_t band) noexcept {
+    if (this->bins[band].empty()) {
+        return;
+    }
+
+    const auto first_row = static_cast<std::int32_t>(band * TILE_HEIGHT);
+    const auto last_row = first_row + static_cast<std::int32_t>(TILE_HEIGHT) - 1;
+    for (const std::uint32_t index : this->bins[band]) {
+        Triangle const& triangle = this->triangles[index];
+        glm::vec3 const& e0 = triangle.edges[0];
+        glm::vec3 const& e1 = triangle.edges[1];
+        glm::vec3 const& e2 = triangle.edges[2];
+        glm::vec3 const& z = triangle.depth;
+
+        for (std::int32_t y = std::max(triangle.min_y, first_row); y <= std::min(triangle.max_y, last_row); ++y) {
+            const float center_y = static_cast<float>(y) + .5f;
+            float*      row = this->depth.data() + static_cast<std::size_t>(y) * this->width;
+
+#if VULQIAN_OCCLUSION_SSE2
+            // From the multiple of 4 at or before min_x, rows being whole tiles wide the last group stays inside.
+            // Pixels left of min_x are outside an edge anyway.
+            const __m128 a0 = _mm_set1_ps(e0.x), a1 = _mm_set1_ps(e1.x), a2 = _mm_set1_ps(e2.x), az = _mm_set1_ps(z.x);
+            const __m128 c0 = _mm_set1_ps(e0.y * center_y + e0.z);
+            const __m128 c1 = _mm_set1_ps(e1.y * center_y + e1.z);
+            const __m128 c2 = _mm_set1_ps(e2.y * center_y + e2.z);
+            const __m128 cz = _mm_set1_ps(z.y * center_y + z.z);
+            const __m128 lanes = _mm_setr_ps(.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 zero = _mm_setzero_ps();
+            for (std::int32_t x = triangle.min_x & ~3; x <= triangle.max_x; x += 4) {
+                const __m128 center_x = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lanes);
+                const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, center_x), c0), zero),
+                                                            _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, center_x), c1), zero)),
+                                                 _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, center_x), c2), zero));
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 nearer = _mm_min_ps(current, _mm_add_ps(_mm_mul_ps(az, center_x), cz));
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+            }
+#else
+            for (std::int32_t x = triangle.min_x; x <= triangle.max_x; ++x) {
+                const float center_x = static_cast<float>(x) + .5f;
+                if (e0.x * center_x + (e0.y * center_y + e0.z) >= 0.f && e1.x * center_x + (e1.y * center_y + e1.z) >= 0.f &&
+                    e2.x * center_x + (e2.y * center_y + e2.z) >= 0.f) {
+                    row[x] = std::min(row[x], z.x * center_x + (z.y * center_y + z.z));
+                }
+            }
+#endif
+        }
+    }
+
+    // Farthest depth of each tile of the band
+    for (std::uint32_t tile = 0; tile < this->tiles_x; ++tile) {
+        float farthest = 0.f;
+        for (std::int32_t y = first_row; y <= last_row; ++y) {
+            float const* pixels = this->depth.data() + static_cast<std::size_t>(y) * this->width + tile * TILE_WIDTH;
+            farthest = std::max(farthest, *std::max_element(pixels, pixels + TILE_WIDTH));
+        }
+        this->tile_depth[band * this->tiles_x + tile] = farthest;
+    }
+}
+
+bool OcclusionBuffer::is_visible(BoundingBox const& box) const noexcept {
+    // Screen rectangle and nearest depth of the 8 corners
+    glm::vec2 low{std::numeric_limits<float>::max()};
+    glm::vec2 high{std::numeric_limits<float>::lowest()};
+    float     nearest = 1.f;
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec3 corner{(i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 4) ? box.max.z : box.min.z};
+        const glm::vec4 clip = this->view_projection * glm::vec4{corner, 1.f};
+        if (clip.z < 0.f || clip.w <= 0.f) {
+            return true;
+        }
+        const float inverse = 1.f / clip.w;
+        low = glm::min(low, glm::vec2{clip.x, clip.y} * inverse);
+        high = glm::max(high, glm::vec2{clip.x, clip.y} * inverse);
+        nearest = std::min(nearest, clip.z * inverse);
+    }
+
+    // Every pixel the rectangle touches
+    const float left = (low.x * .5f + .5f) * static_cast<float>(this->width);
+    const float right = (high.x * .5f + .5f) * static_cast<float>(this->width);
+    const float top = (low.y * .5f + .5f) * static_cast<float>(this->height);
+    const float bottom = (high.y * .5f + .5f) * static_cast<float>(this->height);
+    if (right < 0.f || bottom < 0.f || left >= static_cast<float>(this->width) || top >= static_cast<float>(this->height)) {
+        return true;  // off-screen, left to the frustum test
+    }
+    const auto x0 = std::clamp(static_cast<std::int32_t>(std::floor(left)), 0, static_cast<std::int32_t>(this->width) - 1);
+    const auto x1 = std::clamp(static_cast<std::int32_t>(std::floor(right)), 0, static_cast<std::int32_t>(this->width) - 1);
+    const auto y0 = std::clamp(static_cast<std::int32_t>(std::floor(top)), 0, static_cast<std::int32_t>(this->height) - 1);
+    const auto y1 = std::clamp(static_cast<std::int32_t>(std::floor(bottom)), 0, static_cast<std::int32_t>(this->height) - 1);
+
+    constexpr auto tile_width = static_cast<std::int32_t>(TILE_WIDTH);
+    constexpr auto tile_height = static_cast<std::int32_t>(TILE_HEIGHT);
+    for (std::int32_t tile_y = y0 / tile_height; tile_y <= y1 / tile_height; ++tile_y) {
+        for (std::int32_t tile_x = x0 / tile_width; tile_x <= x1 / tile_width; ++tile_x) {
+            // A tile whose farthest occluder is nearer than the box hides its part of it
+            if (this->tile_depth[static_cast<std::size_t>(tile_y) * this->tiles_x + tile_x] < nearest) {
+                continue;
+            }
+
+            const std::int32_t first_x = std::max(x0, tile_x * tile_width);
+            const std::int32_t last_x = std::min(x1, tile_x * tile_width + tile_width - 1);
+            for (std::int32_t y = std::max(y0, tile_y * tile_height); y <= std::min(y1, tile_y * tile_height + tile_height - 1); ++y) {
+                float const* row = this->depth.data() + static_cast<std::size_t>(y) * this->width;
+#if VULQIAN_OCCLUSION_SSE2
+                const __m128 box_depth = _mm_set1_ps(nearest);
+                for (std::int32_t x = first_x & ~3; x <= last_x; x += 4) {
+                    // Lanes of the group inside [first_x, last_x]
+                    int lanes = 0xF;
+                    if (x < first_x) {
+                        lanes &= 0xF << (first_x - x);
+                    }
+                    if (x + 3 > last_x) {
+                        lanes &= 0xF >> (x + 3 - last_x);
+                    }
+                    if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), box_depth)) & lanes) {
+                        return true;
+                    }
+                }
+#else
+                for (std::int32_t x = first_x; x <= last_x; ++x) {
+                    if (row[x] >= nearest) {
+                        return true;
+                    }
+                }
+#endif
+            }
+        }
+    }
+    return false;
+}
+
+bool OcclusionBuffer::write_pgm(std::string const& path) const {
+    std::ofstream file{path, std::ios::binary};
+    if (!file) {
+        return false;
+    }
+
+    // Perspective depth crowds near 1, so the covered range is stretched over the grey levels
+    const float nearest = *std::min_element(this->depth.begin(), this->depth.end());
+    const float range = std::max(1.f - nearest, 1e-6f);
+
+    std::vector<unsigned char> pixels(this->depth.size());
+    std::transform(this->depth.begin(), this->depth.end(), pixels.begin(), [nearest, range](float value) {
+        return value >= 1.f ? static_cast<unsigned char>(0) : static_cast<unsigned char>(255.f - 200.f * (value - nearest) / range);
+    });
+
+    file << "P5\n"
+         << this->width << ' ' << this->height << "\n255\n";
+    file.write(reinterpret_cast<char const*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace Vulqian::Engine::Math
@@ -0,0 +1,88 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../Jobs/ThreadPool.hpp"
+#include "Frustum.hpp"
+
+namespace Vulqian::Engine::Math {
+
+// Software occlusion culling, for devices where GPU compute costs as much as the draws it saves (lavapipe).
+// A few large occluder meshes are rasterized at low resolution into a depth buffer on the CPU, then the
+// bounds of the entities are tested against it: a box is hidden when every pixel its screen rectangle
+// touches holds an occluder nearer than the box's nearest corner.
+// Rows of tiles are rasterized as bands in parallel, 4 pixels at a time with SSE2 on x86 (part of every
+// x86-64 CPU), one at a time elsewhere. Each tile also keeps its farthest depth, so most tests stop there.
+// Depth goes from 0 at the near plane to 1 at the far one and row 0 is the top of the screen, as in Vulkan.
+class OcclusionBuffer {
+  public:
+    // Pixels of a tile, the unit of the coarse test and of the bands: the width is a multiple of the SIMD width
+    static constexpr std::uint32_t TILE_WIDTH = 8;
+    static constexpr std::uint32_t TILE_HEIGHT = 8;
+
+    // Rounded up to whole tiles
+    explicit OcclusionBuffer(std::uint32_t width = 256, std::uint32_t height = 128);
+
+    // Starts a frame: the depth back to the far plane, the occluders of the previous frame dropped
+    void begin(glm::mat4 const& view_projection);
+
+    // Queues the triangles of a mesh placed by `model`, three indices each, or three positions each without indices.
+    // Both windings are kept, an occluder hides what is behind it from either side.
+    void add_occluder(std::span<const glm::vec3> positions, std::span<const std::uint32_t> indices, glm::mat4 const& model);
+
+    // Rasterizes the queued occluders, one band of tile rows per job on `pool`, inline without one
+    void rasterize(Jobs::ThreadPool* pool = nullptr);
+
+    // Whether any of the world space box may be seen past the occluders, once rasterized.
+    // Boxes crossing the near plane are always visible.
+    bool is_visible(BoundingBox const& box) const noexcept;
+
+    std::uint32_t get_width() const noexcept { return this->width; }
+    std::uint32_t get_height() const noexcept { return this->height; }
+    float         depth_at(std::uint32_t x, std::uint32_t y) const noexcept { return this->depth[y * this->width + x]; }
+
+    // Triangles queued since begin, after clipping by the near plane and dropping the off-screen ones
+    std::size_t get_triangle_count() const noexcept { return this->triangles.size(); }
+
+    // Debug dump as a binary PGM: nearer occluders are brighter, pixels no occluder covered are black
+    bool write_pgm(std::string const& path) const;
+
+  private:
+    // A triangle set up for the rasterizer: at the center (x, y) of a pixel, the pixel is covered when
+    // the three edge functions a * x + b * y + c are positive, its depth follows the same form
+    struct Triangle {
+        std::array<glm::vec3, 3> edges{};
+        glm::vec3                depth{};
+        std::int32_t             min_x{}, max_x{}, min_y{}, max_y{};  // covered pixels, inclusive
+    };
+
+    // Clip space triangle, clipped by the near plane then set up
+    void queue(glm::vec4 const& a, glm::vec4 const& b, glm::vec4 const& c);
+    void setup(glm::vec3 const& a, glm::vec3 const& b, glm::vec3 const& c);
+    void rasterize_band(std::size_t band) noexcept;
+
+    std::uint32_t width{};
+    std::uint32_t height{};
+    std::uint32_t tiles_x{};
+    glm::mat4     view_projection{1.f};
+
+    std::vector<float>                      depth{};
+    std::vector<float>                      tile_depth{};  // farthest depth of each tile
+    std::vector<Triangle>                   triangles{};
+    std::vector<std::vector<std::uint32_t>> bins{};  // triangles touching each band of tile rows
+    std::vector<glm::vec4>                  clip_positions{};  // scratch of add_occluder
+};
+
+} // namespace Vulqian::Engine::Math
@@ -0,0 +1,348 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Simplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+namespace Vulqian::Engine::Math {
+
+namespace {
+
+// Sum of the squared distances to a set of planes, the upper half of a symmetric 4 x 4 matrix
+struct Quadric {
+    double aa{}, ab{}, ac{}, ad{}, bb{}, bc{}, bd{}, cc{}, cd{}, dd{};
+
+    // Plane a * x + b * y + c * z + d = 0 with (a, b, c) of unit length
+    static Quadric of_plane(double a, double b, double c, double d) noexcept {
+        return {a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d};
+    }
+
+    Quadric& operator+=(Quadric const& other) noexcept {
+        aa += other.aa, ab += other.ab, ac += other.ac, ad += other.ad, bb += other.bb;
+        bc += other.bc, bd += other.bd, cc += other.cc, cd += other.cd, dd += other.dd;
+        return *this;
+    }
+
+    double error(glm::vec3 const& point) const noexcept {
+        const double x = point.x, y = point.y, z = point.z;
+        return aa * x * x + bb * y * y + cc * z * z + dd + 2. * (ab * x * y + ac * x * z + ad * x + bc * y * z + bd * y + cd * z);
+    }
+};
+
+// `from` moved onto `to`, stale once either was changed by another collapse
+struct Collapse {
+    double        cost{};
+    std::uint32_t from{};
+    std::uint32_t to{};
+    std::uint32_t from_version{};
+    std::uint32_t to_version{};
+
+    bool operator>(Collapse const& other) const noexcept { return this->cost > other.cost; }
+};
+
+// Bits of a position, -0 taken as 0 so equal positions hash the same
+struct PositionKey {
+    std::array<std::uint32_t, 3> bits{};
+
+    explicit PositionKey(glm::vec3 const& position) noexcept {
+        const glm::vec3 normalized = position + glm::vec3{0.f};
+        std::memcpy(this->bits.data(), &normalized.x, sizeof(float));
+        std::memcpy(this->bits.data() + 1, &normalized.y, sizeof(float));
+        std::memcpy(this->bits.data() + 2, &normalized.z, sizeof(float));
+    }
+
+    bool operator==(PositionKey const& other) const noexcept = default;
+};
+
+struct PositionKeyHash {
+    std::size_t operator()(PositionKey const& key) const noexcept {
+        return (static_cast<std::size_t>(key.bits[0]) * 73856093u) ^ (static_cast<std::size_t>(key.bits[1]) * 19349663u) ^ (static_cast<std::size_t>(key.bits[2]) * 83492791u);
+    }
+};
+
+std::uint64_t edge_key(std::uint32_t a, std::uint32_t b) noexcept {
+    return a < b ? (static_cast<std::uint64_t>(a) << 32) | b : (static_cast<std::uint64_t>(b) << 32) | a;
+}
+
+// The mesh being collapsed, over welded positions: a point per distinct position
+class Collapser {
+  public:
+    Collapser(std::span<const glm::vec3> positions, std::span<const std::uint32_t> indices) {
+        this->weld(positions);
+
+        const std::size_t triangle_count = indices.size() / 3;
+        this->triangles.resize(triangle_count);
+        this->alive.resize(triangle_count);
+        this->triangles_of.resize(this->points.size());
+        this->quadrics.resize(this->points.size());
+        for (std::size_t t = 0; t < triangle_count; ++t) {
+            auto& triangle = this->triangles[t];
+            for (std::size_t k = 0; k < 3; ++k) {
+                triangle[k] = this->group_of[indices[3 * t + k]];
+            }
+            if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+                continue;
+            }
+
+            // Unweighted planes, so the error stays a distance whatever the size of the triangles
+            const glm::vec3 normal = glm::cross(this->points[triangle[1]] - this->points[triangle[0]], this->points[triangle[2]] - this->points[triangle[0]]);
+            const float     length = glm::length(normal);
+            if (length > 0.f) {
+                const glm::vec3 unit = normal / length;
+                const Quadric   plane = Quadric::of_plane(unit.x, unit.y, unit.z, -glm::dot(unit, this->points[triangle[0]]));
+                for (const std::uint32_t point : triangle) {
+                    this->quadrics[point] += plane;
+                }
+            }
+            this->alive[t] = 1;
+            ++this->alive_count;
+            for (const std::uint32_t point : triangle) {
+                this->triangles_of[point].push_back(static_cast<std::uint32_t>(t));
+            }
+        }
+
+        // Edges of one triangle are open borders, of more than two non-manifold: their points never move
+        std::unordered_map<std::uint64_t, std::uint32_t> edges{};
+        for (std::size_t t = 0; t < triangle_count; ++t) {
+            if (this->alive[t]) {
+                auto const& triangle = this->triangles[t];
+                for (std::size_t k = 0; k < 3; ++k) {
+                    ++edges[edge_key(triangle[k], triangle[(k + 1) % 3])];
+                }
+            }
+        }
+        this->locked.resize(this->points.size());
+        this->removed.resize(this->points.size());
+        this->versions.resize(this->points.size());
+        for (auto const& [key, count] : edges) {
+            if (count != 2) {
+                this->locked[key >> 32] = 1;
+                this->locked[key & 0xFFFFFFFFu] = 1;
+            }
+        }
+        for (auto const& [key, count] : edges) {
+            this->push(static_cast<std::uint32_t>(key >> 32), static_cast<std::uint32_t>(key & 0xFFFFFFFFu));
+        }
+    }
+
+    // Cheapest valid collapses first until at most `target_triangles` are left, or none is possible
+    void run(std::size_t target_triangles) {
+        while (this->alive_count > target_triangles && !this->queue.empty()) {
+            const Collapse collapse = this->queue.top();
+            this->queue.pop();
+            if (this->removed[collapse.from] || this->removed[collapse.to] || this->versions[collapse.from] != collapse.from_version ||
+                this->versions[collapse.to] != collapse.to_version || !this->is_valid(collapse.from, collapse.to)) {
+                continue;
+            }
+            this->worst = std::max(this->worst, collapse.cost);
+            this->collapse(collapse.from, collapse.to);
+        }
+    }
+
+    // Remaining triangles on the original vertices
+    std::vector<std::uint32_t> indices(std::span<const std::uint32_t> original, std::span<const glm::vec3> normals) const {
+        // Vertices of each point, to pick the one a moved corner takes
+        std::vector<std::uint32_t> offsets(this->points.size() + 1);
+        for (const std::uint32_t point : this->group_of) {
+            ++offsets[point + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<std::uint32_t> members(this->group_of.size());
+        std::vector<std::uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+        for (std::uint32_t vertex = 0; vertex < this->group_of.size(); ++vertex) {
+            members[cursors[this->group_of[vertex]]++] = vertex;
+        }
+
+        std::vector<std::uint32_t> result{};
+        result.reserve(this->alive_count * 3);
+        for (std::size_t t = 0; t < this->triangles.size(); ++t) {
+            if (!this->alive[t]) {
+                continue;
+            }
+            for (std::size_t k = 0; k < 3; ++k) {
+                const std::uint32_t vertex = original[3 * t + k];
+                const std::uint32_t point = this->triangles[t][k];
+                if (this->group_of[vertex] == point || normals.empty()) {
+                    result.push_back(this->group_of[vertex] == point ? vertex : members[offsets[point]]);
+                    continue;
+                }
+                const auto best = std::max_element(members.begin() + offsets[point], members.begin() + offsets[point + 1], [&](std::uint32_t a, std::uint32_t b) {
+                    return glm::dot(normals[vertex], normals[a]) < glm::dot(normals[vertex], normals[b]);
+                });
+                result.push_back(*best);
+            }
+        }
+        return result;
+    }
+
+    float error() const noexcept { return static_cast<float>(std::sqrt(this->worst)); }
+
+  private:
+    void weld(std::span<const glm::vec3> positions) {
+        std::unordered_map<PositionKey, std::uint32_t, PositionKeyHash> points_by_position{};
+        points_by_position.reserve(positions.size());
+        this->group_of.resize(positions.size());
+        for (std::size_t vertex = 0; vertex < positions.size(); ++vertex) {
+            const auto [found, inserted] = points_by_position.try_emplace(PositionKey{positions[vertex]}, static_cast<std::uint32_t>(this->points.size()));
+            if (inserted) {
+                this->points.push_back(positions[vertex]);
+            }
+            this->group_of[vertex] = found->second;
+        }
+    }
+
+    // Queues the cheaper of the two directions of the edge, as the quadrics are now
+    void push(std::uint32_t a, std::uint32_t b) {
+        Quadric quadric = this->quadrics[a];
+        quadric += this->quadrics[b];
+
+        Collapse best{};
+        bool     found = false;
+        if (!this->locked[a]) {
+            best = {std::max(quadric.error(this->points[b]), 0.), a, b, this->versions[a], this->versions[b]};
+            found = true;
+        }
+        if (!this->locked[b]) {
+            const double cost = std::max(quadric.error(this->points[a]), 0.);
+            if (!found || cost < best.cost) {
+                best = {cost, b, a, this->versions[b], this->versions[a]};
+                found = true;
+            }
+        }
+        if (found) {
+            this->queue.push(best);
+        }
+    }
+
+    void neighbors_of(std::uint32_t point, std::vector<std::uint32_t>& neighbors) const {
+        neighbors.clear();
+        for (const std::uint32_t t : this->triangles_of[point]) {
+            if (this->alive[t]) {
+                for (const std::uint32_t corner : this->triangles[t]) {
+                    if (corner != point && std::find(neighbors.begin(), neighbors.end(), corner) == neighbors.end()) {
+                        neighbors.push_back(corner);
+                    }
+                }
+            }
+        }
+    }
+
+    bool is_valid(std::uint32_t from, std::uint32_t to) {
+        // Link condition: the endpoints only share the points opposite the edge, or the collapse pinches the surface
+        this->neighbors_of(from, this->from_neighbors);
+        this->neighbors_of(to, this->to_neighbors);
+        std::size_t shared_triangles = 0;
+        for (const std::uint32_t t : this->triangles_of[from]) {
+            shared_triangles += this->alive[t] && std::find(this->triangles[t].begin(), this->triangles[t].end(), to) != this->triangles[t].end();
+        }
+        const auto shared_points = std::count_if(this->from_neighbors.begin(), this->from_neighbors.end(), [this](std::uint32_t point) {
+            return std::find(this->to_neighbors.begin(), this->to_neighbors.end(), point) != this->to_neighbors.end();
+        });
+        if (static_cast<std::size_t>(shared_points) > shared_triangles) {
+            return false;
+        }
+
+        // No triangle left around `from` may turn over
+        for (const std::uint32_t t : this->triangles_of[from]) {
+            auto const& triangle = this->triangles[t];
+            if (!this->alive[t] || std::find(triangle.begin(), triangle.end(), to) != triangle.end()) {
+                continue;
+            }
+            std::array<glm::vec3, 3> corners{this->points[triangle[0]], this->points[triangle[1]], this->points[triangle[2]]};
+            const glm::vec3          before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            for (std::size_t k = 0; k < 3; ++k) {
+                if (triangle[k] == from) {
+                    corners[k] = this->points[to];
+                }
+            }
+            const glm::vec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            if (glm::dot(before, after) <= 0.f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void collapse(std::uint32_t from, std::uint32_t to) {
+        for (const std::uint32_t t : this->triangles_of[from]) {
+            if (!this->alive[t]) {
+                continue;
+            }
+            auto& triangle = this->triangles[t];
+            if (std::find(triangle.begin(), triangle.end(), to) != triangle.end()) {
+                this->alive[t] = 0;  // along the edge, flattened
+                --this->alive_count;
+                continue;
+            }
+            std::replace(triangle.begin(), triangle.end(), from, to);
+            this->triangles_of[to].push_back(t);
+        }
+        this->triangles_of[from].clear();
+        std::erase_if(this->triangles_of[to], [this](std::uint32_t t) { return !this->alive[t]; });
+
+        this->removed[from] = 1;
+        this->quadrics[to] += this->quadrics[from];
+        ++this->versions[to];
+
+        this->neighbors_of(to, this->to_neighbors);
+        for (const std::uint32_t neighbor : this->to_neighbors) {
+            this->push(to, neighbor);
+        }
+    }
+
+    std::vector<glm::vec3>                    points{};
+    std::vector<std::uint32_t>                group_of{};   // point of each vertex
+    std::vector<std::array<std::uint32_t, 3>> triangles{};  // points, moved along by the collapses
+    std::vector<std::uint8_t>                 alive{};
+    std::size_t                               alive_count{};
+    std::vector<std::vector<std::uint32_t>>   triangles_of{};  // alive and dead triangles of each point
+    std::vector<Quadric>                      quadrics{};
+    std::vector<std::uint8_t>                 locked{};
+    std::vector<std::uint8_t>                 removed{};
+    std::vector<std::uint32_t>                versions{};
+    double                                    worst{};
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> queue{};
+    std::vector<std::uint32_t>                                           from_neighbors{};
+    std::vector<std::uint32_t>                                           to_neighbors{};
+};
+
+} // namespace
+
+SimplifiedMesh simplify(std::span<const glm::vec3>     positions,
+                        std::span<const glm::vec3>     normals,
+                        std::span<const std::uint32_t> indices,
+                        std::size_t                    target_index_count) {
+    if (target_index_count >= indices.size()) {
+        return {{indices.begin(), indices.end()}, 0.f};
+    }
+
+    Collapser collapser{positions, indices};
+    collapser.run(target_index_count / 3);
+    return {collapser.indices(indices, normals), collapser.error()};
+}
+
+std::uint32_t select_lod(std::span<const LodLevel> levels, float pixels_per_unit, std::uint32_t current, float threshold, float hysteresis) noexcept {
+    const auto coarsest_within = [levels, pixels_per_unit](float limit) {
+        std::uint32_t level = 0;
+        while (level + 1 < levels.size() && levels[level + 1].error * pixels_per_unit <= limit) {
+            ++level;
+        }
+        return level;
+    };
+
+    // Coarser than the loose limit is too coarse, finer than the strict one is too fine, in between stays
+    return std::clamp(current, coarsest_within(threshold * (1.f - hysteresis)), coarsest_within(threshold * (1.f + hysteresis)));
+}
+
+} // namespace Vulqian::Engine::Math
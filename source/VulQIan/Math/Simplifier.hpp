@@ -0,0 +1,47 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Vulqian::Engine::Math {
+
+// One level of detail of a mesh whose levels share one vertex buffer and follow each other in one index buffer.
+// `error` is how far the simplified surface may lie from the original, in the units of the positions.
+struct LodLevel {
+    std::uint32_t first_index{};
+    std::uint32_t index_count{};
+    float         error{};
+};
+
+struct SimplifiedMesh {
+    std::vector<std::uint32_t> indices{};  // of the original vertices, none is added or moved
+    float                      error{};
+};
+
+// Quadric error metric simplification (Garland and Heckbert): the edge whose collapse moves the surface the least
+// is collapsed first, one endpoint onto the other, until about `target_index_count` indices are left.
+// Vertices sharing a position are welded for the collapses, then each corner keeps the vertex of its new position
+// whose normal is closest to its own, so flat shaded and seamed meshes stay shaded. Open borders never move,
+// and collapses folding a triangle over are skipped, so a mesh may stop above the target.
+// The error is the square root of the largest quadric error of a collapse, which bounds the distance to the planes
+// of the original triangles merged into a vertex. Simplifying the same mesh to a smaller target repeats the same
+// collapses then goes on, so the levels of a mesh are nested and their errors increase.
+SimplifiedMesh simplify(std::span<const glm::vec3>     positions,
+                        std::span<const glm::vec3>     normals,
+                        std::span<const std::uint32_t> indices,
+                        std::size_t                    target_index_count);
+
+// Level to draw: the coarsest whose error covers at most `threshold` pixels once multiplied by `pixels_per_unit`,
+// the size on screen of one unit at the object. Switching from `current` waits until the limit is crossed by
+// `hysteresis` of the threshold, so an object at the limit does not pop from one level to the other every frame.
+std::uint32_t select_lod(std::span<const LodLevel> levels, float pixels_per_unit, std::uint32_t current, float threshold, float hysteresis) noexcept;
+
+} // namespace Vulqian::Engine::Math
@@ -0,0 +1,29 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+// Kept free of glm: the instruction set TUs of the TransformKernel include it
+
+#include <cstddef>
+
+namespace Vulqian::Engine::Math {
+
+// Structure-of-arrays view over `count` Transform_TB_YXZ values, one array per scalar field.
+// Rotations are Tait-Bryan angles in radians applied Y, X then Z.
+struct TransformArrays {
+    float const* translation_x{};
+    float const* translation_y{};
+    float const* translation_z{};
+    float const* rotation_x{};
+    float const* rotation_y{};
+    float const* rotation_z{};
+    float const* scale_x{};
+    float const* scale_y{};
+    float const* scale_z{};
+    std::size_t  count{};
+};
+
+} // namespace Vulqian::Engine::Math
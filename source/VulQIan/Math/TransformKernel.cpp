@@ -0,0 +1,166 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "TransformKernel.hpp"
+#include "TransformKernelImpl.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if VULQIAN_MATH_X86 && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace Vulqian::Engine::Math {
+
+namespace {
+
+// One transform at a time with the exact operations of the vector Ops, the reference every level matches
+struct ScalarOps {
+    static constexpr std::size_t WIDTH = 1;
+
+    using Float = float;
+    using Int = std::int32_t;
+
+    static Float splat(float value) noexcept { return value; }
+    static Int   splat_int(std::int32_t value) noexcept { return value; }
+    static Float load(float const* source) noexcept { return *source; }
+    static void  store(float* destination, Float value) noexcept { *destination = value; }
+
+    static Float add(Float a, Float b) noexcept { return a + b; }
+    static Float sub(Float a, Float b) noexcept { return a - b; }
+    static Float mul(Float a, Float b) noexcept { return a * b; }
+    static Float div(Float a, Float b) noexcept { return a / b; }
+
+    static Float bit_and(Float a, Float b) noexcept { return std::bit_cast<float>(std::bit_cast<std::uint32_t>(a) & std::bit_cast<std::uint32_t>(b)); }
+    static Float bit_xor(Float a, Float b) noexcept { return std::bit_cast<float>(std::bit_cast<std::uint32_t>(a) ^ std::bit_cast<std::uint32_t>(b)); }
+    static Float abs(Float a) noexcept { return std::bit_cast<float>(std::bit_cast<std::uint32_t>(a) & 0x7FFFFFFFu); }
+
+    static Int   truncate(Float a) noexcept { return static_cast<std::int32_t>(a); }
+    static Float to_float(Int a) noexcept { return static_cast<float>(a); }
+    static Float as_float(Int a) noexcept { return std::bit_cast<float>(a); }
+
+    // Wrapping arithmetic like the vector instructions
+    static Int add_int(Int a, Int b) noexcept { return static_cast<std::int32_t>(static_cast<std::uint32_t>(a) + static_cast<std::uint32_t>(b)); }
+    static Int sub_int(Int a, Int b) noexcept { return static_cast<std::int32_t>(static_cast<std::uint32_t>(a) - static_cast<std::uint32_t>(b)); }
+    static Int and_int(Int a, Int b) noexcept { return a & b; }
+    static Int and_not_int(Int a, Int b) noexcept { return ~a & b; }
+
+    template <int Bits>
+    static Int shift_left(Int a) noexcept {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(a) << Bits);
+    }
+
+    static bool  is_zero(Int a) noexcept { return a == 0; }
+    static Float select(bool mask, Float if_set, Float if_clear) noexcept { return mask ? if_set : if_clear; }
+};
+
+#if VULQIAN_MATH_X86 && defined(_MSC_VER)
+bool cpu_has(int leaf, int sub_leaf, int register_index, int bit) noexcept {
+    int registers[4]{};
+    __cpuidex(registers, leaf, sub_leaf);
+    return (registers[register_index] >> bit) & 1;
+}
+#endif
+
+SimdLevel detect() noexcept {
+#if VULQIAN_MATH_X86 && (defined(__GNUC__) || defined(__clang__))
+    // The builtins also check that the OS saves the wider registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SimdLevel::SSE;
+    }
+#elif VULQIAN_MATH_X86 && defined(_MSC_VER)
+    const bool sse41 = cpu_has(1, 0, 2, 19);
+    const bool os_saves_ymm = cpu_has(1, 0, 2, 27) && (_xgetbv(0) & 0x6) == 0x6;
+    const bool os_saves_zmm = os_saves_ymm && (_xgetbv(0) & 0xE6) == 0xE6;
+
+    if (os_saves_zmm && cpu_has(7, 0, 1, 16)) {
+        return SimdLevel::AVX512;
+    }
+    if (os_saves_ymm && cpu_has(7, 0, 1, 5)) {
+        return SimdLevel::AVX2;
+    }
+    if (sse41) {
+        return SimdLevel::SSE;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+} // namespace
+
+SimdLevel detect_simd_level() noexcept {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+std::size_t simd_width(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::SSE:
+        return 4;
+    case SimdLevel::AVX2:
+        return 8;
+    case SimdLevel::AVX512:
+        return 16;
+    default:
+        return 1;
+    }
+}
+
+char const* simd_level_name(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::SSE:
+        return "SSE4.1";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+void compute_transform_matrices(TransformArrays const& transforms, glm::mat4* model_matrices, glm::mat4* normal_matrices, SimdLevel level) {
+    level = std::min(level, detect_simd_level());
+
+    // The kernels write plain column major floats, exactly the storage of a glm::mat4
+    static_assert(sizeof(glm::mat4) == Detail::MATRIX_FLOATS * sizeof(float));
+    float* model_floats = reinterpret_cast<float*>(model_matrices);
+    float* normal_floats = reinterpret_cast<float*>(normal_matrices);
+
+    // Whole vectors first, the remaining transforms go through the scalar path which rounds identically
+    std::size_t done = 0;
+#if VULQIAN_MATH_X86
+    switch (level) {
+    case SimdLevel::AVX512:
+        done = Detail::compute_batch_avx512(transforms, 0, transforms.count, model_floats, normal_floats);
+        break;
+    case SimdLevel::AVX2:
+        done = Detail::compute_batch_avx2(transforms, 0, transforms.count, model_floats, normal_floats);
+        break;
+    case SimdLevel::SSE:
+        done = Detail::compute_batch_sse(transforms, 0, transforms.count, model_floats, normal_floats);
+        break;
+    default:
+        break;
+    }
+#endif
+
+    Detail::compute_batch<ScalarOps>(transforms, done, transforms.count, model_floats, normal_floats);
+}
+
+void sincos(float angle, float& sine, float& cosine) noexcept {
+    Detail::sincos<ScalarOps>(angle, sine, cosine);
+}
+
+} // namespace Vulqian::Engine::Math
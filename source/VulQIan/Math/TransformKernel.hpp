@@ -0,0 +1,44 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "TransformArrays.hpp"
+
+namespace Vulqian::Engine::Math {
+
+// Instruction sets the batch kernels are compiled for, picked at runtime
+enum class SimdLevel : std::uint8_t {
+    Scalar,  // 1 transform per step
+    SSE,     // 4, SSE4.1
+    AVX2,    // 8
+    AVX512   // 16, AVX-512F
+};
+
+// Best level supported by the CPU and the OS, detected once
+SimdLevel detect_simd_level() noexcept;
+
+// Transforms handled per step at a level
+std::size_t simd_width(SimdLevel level) noexcept;
+
+char const* simd_level_name(SimdLevel level) noexcept;
+
+// Writes the model matrix and the normal matrix (inverse scale, upper 3x3 of a mat4) of every transform,
+// the same matrices as Transform_TB_YXZ::mat4() / normal_matrix() with each sin/cos evaluated once.
+// Every level produces bit-identical results: all of them run the same sequence of IEEE single precision
+// operations, including the polynomial sincos below, and none of them contracts into fused multiply-adds.
+// A level the CPU lacks falls back to the best supported one.
+void compute_transform_matrices(TransformArrays const& transforms, glm::mat4* model_matrices, glm::mat4* normal_matrices,
+                                SimdLevel level = detect_simd_level());
+
+// Scalar version of the vectorized sine / cosine used by the kernels, accurate to a few ulp for |angle| < 8192
+void sincos(float angle, float& sine, float& cosine) noexcept;
+
+} // namespace Vulqian::Engine::Math
@@ -0,0 +1,64 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+// Compiled with -mavx2 (and deliberately without -mfma), only called once detect_simd_level() reports AVX2 or better
+
+#include "TransformKernelImpl.hpp"
+
+#if VULQIAN_MATH_X86
+
+#include <immintrin.h>
+
+namespace Vulqian::Engine::Math::Detail {
+
+namespace {
+
+struct Avx2Ops {
+    static constexpr std::size_t WIDTH = 8;
+
+    using Float = __m256;
+    using Int = __m256i;
+
+    static Float splat(float value) noexcept { return _mm256_set1_ps(value); }
+    static Int   splat_int(std::int32_t value) noexcept { return _mm256_set1_epi32(value); }
+    static Float load(float const* source) noexcept { return _mm256_loadu_ps(source); }
+    static void  store(float* destination, Float value) noexcept { _mm256_store_ps(destination, value); }
+
+    static Float add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+    static Float sub(Float a, Float b) noexcept { return _mm256_sub_ps(a, b); }
+    static Float mul(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+    static Float div(Float a, Float b) noexcept { return _mm256_div_ps(a, b); }
+
+    static Float bit_and(Float a, Float b) noexcept { return _mm256_and_ps(a, b); }
+    static Float bit_xor(Float a, Float b) noexcept { return _mm256_xor_ps(a, b); }
+    static Float abs(Float a) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+
+    static Int   truncate(Float a) noexcept { return _mm256_cvttps_epi32(a); }
+    static Float to_float(Int a) noexcept { return _mm256_cvtepi32_ps(a); }
+    static Float as_float(Int a) noexcept { return _mm256_castsi256_ps(a); }
+
+    static Int add_int(Int a, Int b) noexcept { return _mm256_add_epi32(a, b); }
+    static Int sub_int(Int a, Int b) noexcept { return _mm256_sub_epi32(a, b); }
+    static Int and_int(Int a, Int b) noexcept { return _mm256_and_si256(a, b); }
+    static Int and_not_int(Int a, Int b) noexcept { return _mm256_andnot_si256(a, b); }
+
+    template <int Bits>
+    static Int shift_left(Int a) noexcept {
+        return _mm256_slli_epi32(a, Bits);
+    }
+
+    static Float is_zero(Int a) noexcept { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, _mm256_setzero_si256())); }
+    static Float select(Float mask, Float if_set, Float if_clear) noexcept { return _mm256_blendv_ps(if_clear, if_set, mask); }
+};
+
+} // namespace
+
+std::size_t compute_batch_avx2(TransformArrays const& transforms, std::size_t first, std::size_t last, float* model_floats, float* normal_floats) noexcept {
+    return compute_batch<Avx2Ops>(transforms, first, last, model_floats, normal_floats);
+}
+
+} // namespace Vulqian::Engine::Math::Detail
+
+#endif
@@ -0,0 +1,65 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+// Compiled with -mavx512f, only called once detect_simd_level() reports AVX-512
+
+#include "TransformKernelImpl.hpp"
+
+#if VULQIAN_MATH_X86
+
+#include <immintrin.h>
+
+namespace Vulqian::Engine::Math::Detail {
+
+namespace {
+
+// Float bit operations go through the integer unit, _mm512_and_ps and friends need AVX-512DQ
+struct Avx512Ops {
+    static constexpr std::size_t WIDTH = 16;
+
+    using Float = __m512;
+    using Int = __m512i;
+
+    static Float splat(float value) noexcept { return _mm512_set1_ps(value); }
+    static Int   splat_int(std::int32_t value) noexcept { return _mm512_set1_epi32(value); }
+    static Float load(float const* source) noexcept { return _mm512_loadu_ps(source); }
+    static void  store(float* destination, Float value) noexcept { _mm512_store_ps(destination, value); }
+
+    static Float add(Float a, Float b) noexcept { return _mm512_add_ps(a, b); }
+    static Float sub(Float a, Float b) noexcept { return _mm512_sub_ps(a, b); }
+    static Float mul(Float a, Float b) noexcept { return _mm512_mul_ps(a, b); }
+    static Float div(Float a, Float b) noexcept { return _mm512_div_ps(a, b); }
+
+    static Float bit_and(Float a, Float b) noexcept { return as_float(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+    static Float bit_xor(Float a, Float b) noexcept { return as_float(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+    static Float abs(Float a) noexcept { return as_float(_mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF))); }
+
+    static Int   truncate(Float a) noexcept { return _mm512_cvttps_epi32(a); }
+    static Float to_float(Int a) noexcept { return _mm512_cvtepi32_ps(a); }
+    static Float as_float(Int a) noexcept { return _mm512_castsi512_ps(a); }
+
+    static Int add_int(Int a, Int b) noexcept { return _mm512_add_epi32(a, b); }
+    static Int sub_int(Int a, Int b) noexcept { return _mm512_sub_epi32(a, b); }
+    static Int and_int(Int a, Int b) noexcept { return _mm512_and_si512(a, b); }
+    static Int and_not_int(Int a, Int b) noexcept { return _mm512_andnot_si512(a, b); }
+
+    template <int Bits>
+    static Int shift_left(Int a) noexcept {
+        return _mm512_slli_epi32(a, Bits);
+    }
+
+    static __mmask16 is_zero(Int a) noexcept { return _mm512_cmpeq_epi32_mask(a, _mm512_setzero_si512()); }
+    static Float     select(__mmask16 mask, Float if_set, Float if_clear) noexcept { return _mm512_mask_blend_ps(mask, if_clear, if_set); }
+};
+
+} // namespace
+
+std::size_t compute_batch_avx512(TransformArrays const& transforms, std::size_t first, std::size_t last, float* model_floats, float* normal_floats) noexcept {
+    return compute_batch<Avx512Ops>(transforms, first, last, model_floats, normal_floats);
+}
+
+} // namespace Vulqian::Engine::Math::Detail
+
+#endif
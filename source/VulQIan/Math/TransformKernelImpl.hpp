@@ -0,0 +1,193 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+// Internal to the TransformKernel translation units: the kernel is written once against a
+// small set of lane operations, each instruction set provides its own Ops and instantiates it.
+// Everything here is a template on Ops, so TUs compiled with different -m flags never share code.
+// Nothing here may include glm or any other header with inline functions the TUs would share: the
+// linker keeps one copy of each, possibly the one built with -mavx512f. The kernels only see raw
+// floats, TransformKernel.cpp, built with the baseline flags, owns the glm::mat4 side.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "TransformArrays.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VULQIAN_MATH_X86 1
+#else
+#define VULQIAN_MATH_X86 0
+#endif
+
+namespace Vulqian::Engine::Math::Detail {
+
+// Cephes single precision constants, the reduction splits pi/4 in three parts so x - j * pi/4 stays exact
+inline constexpr float FOUR_OVER_PI = 1.27323954473516f;
+inline constexpr float PI_OVER_4_PART_1 = 0.78515625f;
+inline constexpr float PI_OVER_4_PART_2 = 2.4187564849853515625e-4f;
+inline constexpr float PI_OVER_4_PART_3 = 3.77489497744594108e-8f;
+
+inline constexpr float COS_C0 = 2.443315711809948e-5f;
+inline constexpr float COS_C1 = -1.388731625493765e-3f;
+inline constexpr float COS_C2 = 4.166664568298827e-2f;
+
+inline constexpr float SIN_C0 = -1.9515295891e-4f;
+inline constexpr float SIN_C1 = 8.3321608736e-3f;
+inline constexpr float SIN_C2 = -1.6666654611e-1f;
+
+inline constexpr std::int32_t SIGN_MASK = static_cast<std::int32_t>(0x80000000u);
+
+// Sine and cosine of every lane, only plain multiplies and adds so every Ops rounds the same way
+template <typename Ops>
+inline void sincos(typename Ops::Float angle, typename Ops::Float& sine, typename Ops::Float& cosine) noexcept {
+    using Float = typename Ops::Float;
+    using Int = typename Ops::Int;
+
+    // Work on |angle| and put the sign back on the sine at the end
+    Float sign_sin = Ops::bit_and(angle, Ops::as_float(Ops::splat_int(SIGN_MASK)));
+    Float x = Ops::abs(angle);
+
+    // Octant of the angle, rounded up to an even one
+    Int octant = Ops::truncate(Ops::mul(x, Ops::splat(FOUR_OVER_PI)));
+    octant = Ops::and_int(Ops::add_int(octant, Ops::splat_int(1)), Ops::splat_int(~1));
+    const Float y = Ops::to_float(octant);
+
+    const auto  use_cos_poly_for_sin = Ops::is_zero(Ops::and_int(octant, Ops::splat_int(2)));
+    const Float swap_sign_sin = Ops::as_float(Ops::template shift_left<29>(Ops::and_int(octant, Ops::splat_int(4))));
+    const Float sign_cos = Ops::as_float(Ops::template shift_left<29>(Ops::and_not_int(Ops::sub_int(octant, Ops::splat_int(2)), Ops::splat_int(4))));
+    sign_sin = Ops::bit_xor(sign_sin, swap_sign_sin);
+
+    // x - y * pi / 4 in three steps
+    x = Ops::sub(x, Ops::mul(y, Ops::splat(PI_OVER_4_PART_1)));
+    x = Ops::sub(x, Ops::mul(y, Ops::splat(PI_OVER_4_PART_2)));
+    x = Ops::sub(x, Ops::mul(y, Ops::splat(PI_OVER_4_PART_3)));
+
+    const Float z = Ops::mul(x, x);
+
+    // Cosine polynomial on [-pi/4, pi/4]
+    Float cos_poly = Ops::splat(COS_C0);
+    cos_poly = Ops::add(Ops::mul(cos_poly, z), Ops::splat(COS_C1));
+    cos_poly = Ops::add(Ops::mul(cos_poly, z), Ops::splat(COS_C2));
+    cos_poly = Ops::mul(Ops::mul(cos_poly, z), z);
+    cos_poly = Ops::sub(cos_poly, Ops::mul(z, Ops::splat(0.5f)));
+    cos_poly = Ops::add(cos_poly, Ops::splat(1.f));
+
+    // Sine polynomial on [-pi/4, pi/4]
+    Float sin_poly = Ops::splat(SIN_C0);
+    sin_poly = Ops::add(Ops::mul(sin_poly, z), Ops::splat(SIN_C1));
+    sin_poly = Ops::add(Ops::mul(sin_poly, z), Ops::splat(SIN_C2));
+    sin_poly = Ops::mul(Ops::mul(sin_poly, z), x);
+    sin_poly = Ops::add(sin_poly, x);
+
+    sine = Ops::bit_xor(Ops::select(use_cos_poly_for_sin, sin_poly, cos_poly), sign_sin);
+    cosine = Ops::bit_xor(Ops::select(use_cos_poly_for_sin, cos_poly, sin_poly), sign_cos);
+}
+
+// Rows of the output written per lane: 16 model floats then the 9 normal matrix floats
+inline constexpr std::size_t OUTPUT_FLOATS = 25;
+
+// Computes transforms [first, first + Ops::WIDTH) into lanes[output float][lane]
+template <typename Ops>
+inline void compute_lanes(TransformArrays const& transforms, std::size_t first, float (*lanes)[Ops::WIDTH]) noexcept {
+    using Float = typename Ops::Float;
+
+    Float s1, c1, s2, c2, s3, c3;
+    sincos<Ops>(Ops::load(transforms.rotation_y + first), s1, c1);
+    sincos<Ops>(Ops::load(transforms.rotation_x + first), s2, c2);
+    sincos<Ops>(Ops::load(transforms.rotation_z + first), s3, c3);
+
+    // Rotation Ry * Rx * Rz, shared by both matrices, in the operation order of Transform_TB_YXZ
+    const Float r00 = Ops::add(Ops::mul(c1, c3), Ops::mul(Ops::mul(s1, s2), s3));
+    const Float r01 = Ops::mul(c2, s3);
+    const Float r02 = Ops::sub(Ops::mul(Ops::mul(c1, s2), s3), Ops::mul(c3, s1));
+    const Float r10 = Ops::sub(Ops::mul(Ops::mul(c3, s1), s2), Ops::mul(c1, s3));
+    const Float r11 = Ops::mul(c2, c3);
+    const Float r12 = Ops::add(Ops::mul(Ops::mul(c1, c3), s2), Ops::mul(s1, s3));
+    const Float r20 = Ops::mul(c2, s1);
+    const Float r21 = Ops::bit_xor(s2, Ops::as_float(Ops::splat_int(SIGN_MASK)));
+    const Float r22 = Ops::mul(c1, c2);
+
+    const Float sx = Ops::load(transforms.scale_x + first);
+    const Float sy = Ops::load(transforms.scale_y + first);
+    const Float sz = Ops::load(transforms.scale_z + first);
+    const Float one = Ops::splat(1.f);
+    const Float zero = Ops::splat(0.f);
+
+    // Model matrix, column major
+    Ops::store(lanes[0], Ops::mul(sx, r00));
+    Ops::store(lanes[1], Ops::mul(sx, r01));
+    Ops::store(lanes[2], Ops::mul(sx, r02));
+    Ops::store(lanes[3], zero);
+    Ops::store(lanes[4], Ops::mul(sy, r10));
+    Ops::store(lanes[5], Ops::mul(sy, r11));
+    Ops::store(lanes[6], Ops::mul(sy, r12));
+    Ops::store(lanes[7], zero);
+    Ops::store(lanes[8], Ops::mul(sz, r20));
+    Ops::store(lanes[9], Ops::mul(sz, r21));
+    Ops::store(lanes[10], Ops::mul(sz, r22));
+    Ops::store(lanes[11], zero);
+    Ops::store(lanes[12], Ops::load(transforms.translation_x + first));
+    Ops::store(lanes[13], Ops::load(transforms.translation_y + first));
+    Ops::store(lanes[14], Ops::load(transforms.translation_z + first));
+    Ops::store(lanes[15], one);
+
+    // Normal matrix, the same rotation with the inverse scale
+    const Float ix = Ops::div(one, sx);
+    const Float iy = Ops::div(one, sy);
+    const Float iz = Ops::div(one, sz);
+
+    Ops::store(lanes[16], Ops::mul(ix, r00));
+    Ops::store(lanes[17], Ops::mul(ix, r01));
+    Ops::store(lanes[18], Ops::mul(ix, r02));
+    Ops::store(lanes[19], Ops::mul(iy, r10));
+    Ops::store(lanes[20], Ops::mul(iy, r11));
+    Ops::store(lanes[21], Ops::mul(iy, r12));
+    Ops::store(lanes[22], Ops::mul(iz, r20));
+    Ops::store(lanes[23], Ops::mul(iz, r21));
+    Ops::store(lanes[24], Ops::mul(iz, r22));
+}
+
+// Floats written per transform to each output array, a column major 4x4 matrix.
+// The normal matrix fills its upper 3x3 and is padded like an identity.
+inline constexpr std::size_t MATRIX_FLOATS = 16;
+
+// Runs the kernel on every whole group of Ops::WIDTH transforms in [first, last) and returns where it stopped.
+// Transform i is written to model_floats[i * MATRIX_FLOATS] and normal_floats[i * MATRIX_FLOATS].
+template <typename Ops>
+inline std::size_t compute_batch(TransformArrays const& transforms, std::size_t first, std::size_t last, float* model_floats,
+                                 float* normal_floats) noexcept {
+    alignas(64) float lanes[OUTPUT_FLOATS][Ops::WIDTH];
+
+    for (; first + Ops::WIDTH <= last; first += Ops::WIDTH) {
+        compute_lanes<Ops>(transforms, first, lanes);
+
+        // Lanes back to one matrix per transform
+        for (std::size_t lane = 0; lane < Ops::WIDTH; ++lane) {
+            float* model = model_floats + (first + lane) * MATRIX_FLOATS;
+            float* normal = normal_floats + (first + lane) * MATRIX_FLOATS;
+
+            for (std::size_t i = 0; i < MATRIX_FLOATS; ++i) {
+                model[i] = lanes[i][lane];
+            }
+
+            for (std::size_t column = 0; column < 4; ++column) {
+                for (std::size_t row = 0; row < 4; ++row) {
+                    normal[column * 4 + row] = column < 3 && row < 3 ? lanes[16 + column * 3 + row][lane] : (column == row ? 1.f : 0.f);
+                }
+            }
+        }
+    }
+
+    return first;
+}
+
+// Entry points of the instruction set TUs, each one only compiled where its compiler flags are available
+std::size_t compute_batch_sse(TransformArrays const& transforms, std::size_t first, std::size_t last, float* model_floats, float* normal_floats) noexcept;
+std::size_t compute_batch_avx2(TransformArrays const& transforms, std::size_t first, std::size_t last, float* model_floats, float* normal_floats) noexcept;
+std::size_t compute_batch_avx512(TransformArrays const& transforms, std::size_t first, std::size_t last, float* model_floats, float* normal_floats) noexcept;
+
+} // namespace Vulqian::Engine::Math::Detail
@@ -0,0 +1,64 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+// Compiled with -msse4.1, only called once detect_simd_level() reports SSE or better
+
+#include "TransformKernelImpl.hpp"
+
+#if VULQIAN_MATH_X86
+
+#include <immintrin.h>
+
+namespace Vulqian::Engine::Math::Detail {
+
+namespace {
+
+struct SseOps {
+    static constexpr std::size_t WIDTH = 4;
+
+    using Float = __m128;
+    using Int = __m128i;
+
+    static Float splat(float value) noexcept { return _mm_set1_ps(value); }
+    static Int   splat_int(std::int32_t value) noexcept { return _mm_set1_epi32(value); }
+    static Float load(float const* source) noexcept { return _mm_loadu_ps(source); }
+    static void  store(float* destination, Float value) noexcept { _mm_store_ps(destination, value); }
+
+    static Float add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+    static Float sub(Float a, Float b) noexcept { return _mm_sub_ps(a, b); }
+    static Float mul(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+    static Float div(Float a, Float b) noexcept { return _mm_div_ps(a, b); }
+
+    static Float bit_and(Float a, Float b) noexcept { return _mm_and_ps(a, b); }
+    static Float bit_xor(Float a, Float b) noexcept { return _mm_xor_ps(a, b); }
+    static Float abs(Float a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+
+    static Int   truncate(Float a) noexcept { return _mm_cvttps_epi32(a); }
+    static Float to_float(Int a) noexcept { return _mm_cvtepi32_ps(a); }
+    static Float as_float(Int a) noexcept { return _mm_castsi128_ps(a); }
+
+    static Int add_int(Int a, Int b) noexcept { return _mm_add_epi32(a, b); }
+    static Int sub_int(Int a, Int b) noexcept { return _mm_sub_epi32(a, b); }
+    static Int and_int(Int a, Int b) noexcept { return _mm_and_si128(a, b); }
+    static Int and_not_int(Int a, Int b) noexcept { return _mm_andnot_si128(a, b); }
+
+    template <int Bits>
+    static Int shift_left(Int a) noexcept {
+        return _mm_slli_epi32(a, Bits);
+    }
+
+    static Float is_zero(Int a) noexcept { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, _mm_setzero_si128())); }
+    static Float select(Float mask, Float if_set, Float if_clear) noexcept { return _mm_blendv_ps(if_clear, if_set, mask); }
+};
+
+} // namespace
+
+std::size_t compute_batch_sse(TransformArrays const& transforms, std::size_t first, std::size_t last, float* model_floats, float* normal_floats) noexcept {
+    return compute_batch<SseOps>(transforms, first, last, model_floats, normal_floats);
+}
+
+} // namespace Vulqian::Engine::Math::Detail
+
+#endif
@@ -13,5 +13,9 @@ echo glslc.exe found for shader compilation.
 
 "%GLSLC_EXE%" ./source/VulQIan/Shaders/simple_shader.vert -o ./source/VulQIan/Shaders/simple_shader.vert.spv
 "%GLSLC_EXE%" ./source/VulQIan/Shaders/simple_shader.frag -o ./source/VulQIan/Shaders/simple_shader.frag.spv
+"%GLSLC_EXE%" ./source/VulQIan/Shaders/simple_shader_instanced.vert -o ./source/VulQIan/Shaders/simple_shader_instanced.vert.spv
+"%GLSLC_EXE%" ./source/VulQIan/Shaders/cull_instances.comp -o ./source/VulQIan/Shaders/cull_instances.comp.spv
+"%GLSLC_EXE%" ./source/VulQIan/Shaders/hiz_reduce.comp -o ./source/VulQIan/Shaders/hiz_reduce.comp.spv
+"%GLSLC_EXE%" ./source/VulQIan/Shaders/cull_clusters.comp -o ./source/VulQIan/Shaders/cull_clusters.comp.spv
 
 pause
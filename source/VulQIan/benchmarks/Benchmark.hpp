@@ -0,0 +1,82 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Vulqian::Benchmarks {
+
+// Keeps the compiler from optimizing away a value computed by a benchmark
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(_MSC_VER)
+    static volatile const void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+struct Case {
+    std::string           name;
+    std::function<void()> run;
+};
+
+inline std::vector<Case>& registry() {
+    static std::vector<Case> cases{};
+    return cases;
+}
+
+struct Registrar {
+    Registrar(std::string name, std::function<void()> run) {
+        registry().push_back({std::move(name), std::move(run)});
+    }
+};
+
+// Runs `body` `repetitions` times and prints the best time per operation.
+// The best run is reported since it is the least disturbed by the rest of the machine.
+template <typename Function>
+void measure(std::string_view label, std::size_t operations, Function&& body, int repetitions = 5) {
+    double best_ns = std::numeric_limits<double>::max();
+
+    for (int repetition = 0; repetition < repetitions; ++repetition) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const auto stop = std::chrono::steady_clock::now();
+
+        best_ns = std::min(best_ns, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+
+    std::cout << "  " << std::left << std::setw(56) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << best_ns / static_cast<double>(operations) << " ns/op"
+              << std::setw(12) << best_ns / 1'000'000.0 << " ms total" << std::endl;
+}
+
+} // namespace Vulqian::Benchmarks
+
+#define VULQIAN_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define VULQIAN_BENCHMARK_CONCAT(a, b) VULQIAN_BENCHMARK_CONCAT_IMPL(a, b)
+
+// Registers a benchmark case, run by the VulQIanBenchmarks executable
+#define VULQIAN_BENCHMARK(name)                                                                             \
+    static void                          VULQIAN_BENCHMARK_CONCAT(vulqian_benchmark_, name)();             \
+    static Vulqian::Benchmarks::Registrar VULQIAN_BENCHMARK_CONCAT(vulqian_registrar_, name){               \
+        #name, &VULQIAN_BENCHMARK_CONCAT(vulqian_benchmark_, name)};                                          \
+    static void VULQIAN_BENCHMARK_CONCAT(vulqian_benchmark_, name)()
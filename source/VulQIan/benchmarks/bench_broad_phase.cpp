@@ -0,0 +1,62 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "Collision/BroadPhase.hpp"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+VULQIAN_BENCHMARK(BroadPhase) {
+    using Vulqian::Engine::Collision::AABB;
+    using Vulqian::Engine::Collision::BroadPhase;
+    using Vulqian::Engine::Collision::BroadPhaseMode;
+
+    Vulqian::Engine::Jobs::ThreadPool pool{};
+
+    for (std::size_t count : {10'000, 100'000, 1'000'000}) {
+        // Unit boxes at the same density whatever the count, about one object per 8 cubic units
+        const float                           side = 2.f * std::cbrt(static_cast<float>(count));
+        std::mt19937                          rng{42};
+        std::uniform_real_distribution<float> position{0.f, side};
+        std::uniform_real_distribution<float> step{-.2f, .2f};
+
+        std::vector<AABB> boxes(count);
+        for (AABB& box : boxes) {
+            const glm::vec3 center{position(rng), position(rng), position(rng)};
+            box = {center - .5f, center + .5f};
+        }
+
+        for (BroadPhaseMode mode : {BroadPhaseMode::AABBTree, BroadPhaseMode::SpatialHash}) {
+            const std::string name = std::string{mode == BroadPhaseMode::AABBTree ? "tree" : "hash"} + " @ " + std::to_string(count);
+
+            BroadPhase broad_phase{mode};
+            Vulqian::Benchmarks::measure(name + ", add + first pairs", count, [&] {
+                broad_phase = BroadPhase{mode};
+                for (std::uint32_t i = 0; i < count; ++i) {
+                    broad_phase.add(boxes[i], i);
+                }
+                broad_phase.update_pairs(&pool);
+            }, 1);
+
+            // Frames where a tenth of the objects, then all of them, drift a little
+            std::vector<AABB> moved = boxes;
+            for (std::uint32_t stride : {10u, 1u}) {
+                Vulqian::Benchmarks::measure(name + (stride == 1 ? ", all moving" : ", 10% moving"), count, [&] {
+                    for (std::uint32_t i = 0; i < count; i += stride) {
+                        const glm::vec3 displacement{step(rng), step(rng), step(rng)};
+                        moved[i] = {moved[i].min + displacement, moved[i].max + displacement};
+                        broad_phase.move(i, moved[i], displacement);
+                    }
+                    broad_phase.update_pairs(&pool);
+                    Vulqian::Benchmarks::do_not_optimize(broad_phase.get_pairs().size());
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using Vulqian::Engine::ECS::Coordinator;
+using Vulqian::Engine::ECS::Entity;
+
+struct SpawnPosition {
+    float x{}, y{}, z{};
+};
+
+struct SpawnShape {
+    int id{};
+};
+
+class SpawnSystem : public Vulqian::Engine::ECS::System {};
+
+void setup(Coordinator& coordinator) {
+    coordinator.init();
+    coordinator.register_component<SpawnPosition>();
+    coordinator.register_component<SpawnShape>();
+    coordinator.register_system<SpawnSystem>();
+    coordinator.set_system_signature<SpawnSystem>(coordinator.signature_of<SpawnPosition, SpawnShape>());
+}
+
+} // namespace
+
+VULQIAN_BENCHMARK(BulkSpawn) {
+    for (std::size_t count : {10'000u, 100'000u}) {
+        std::vector<SpawnPosition> positions(count, SpawnPosition{1.f, 2.f, 3.f});
+
+        Vulqian::Benchmarks::measure("create_entity + 2 add_component @ " + std::to_string(count), count, [&] {
+            Coordinator coordinator{};
+            setup(coordinator);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                Entity entity = coordinator.create_entity();
+                coordinator.add_component(entity, positions[i]);
+                coordinator.add_component(entity, SpawnShape{7});
+            }
+            Vulqian::Benchmarks::do_not_optimize(coordinator);
+        });
+
+        Vulqian::Benchmarks::measure("create_entities + add_components @ " + std::to_string(count), count, [&] {
+            Coordinator coordinator{};
+            setup(coordinator);
+
+            auto entities = coordinator.create_entities(count, SpawnShape{7});
+            coordinator.add_components<SpawnPosition>(entities, positions);
+            Vulqian::Benchmarks::do_not_optimize(coordinator);
+        });
+    }
+}
@@ -0,0 +1,109 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "ECS/Components/ComponentArray.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Vulqian::Engine::ECS::Entity;
+
+// Same footprint as Transform_TB_YXZ, without pulling glm in
+struct BenchTransform {
+    float translation[3]{};
+    float scale[3]{1.f, 1.f, 1.f};
+    float rotation[3]{};
+};
+
+// Previous ComponentArray layout, kept here as the reference point:
+// packed components addressed through two hash maps.
+template <typename T>
+class HashMapComponentArray {
+  public:
+    explicit HashMapComponentArray(std::size_t capacity) : component_array(capacity) {}
+
+    void insert_data(Entity entity, T component) {
+        std::size_t new_index = this->size;
+        this->entity_to_index_map[entity] = new_index;
+        this->index_to_entity_map[new_index] = entity;
+        this->component_array[new_index] = component;
+        ++this->size;
+    }
+
+    T& get_data(Entity entity) { return this->component_array[this->entity_to_index_map[entity]]; }
+
+  private:
+    std::vector<T>                          component_array;
+    std::unordered_map<Entity, std::size_t> entity_to_index_map;
+    std::unordered_map<std::size_t, Entity> index_to_entity_map;
+    std::size_t                             size{};
+};
+
+void run_component_array_benchmark(std::size_t count) {
+    std::vector<Entity> entities(count);
+    std::iota(entities.begin(), entities.end(), Entity{0});
+
+    // Random access order, the same for both layouts
+    std::vector<Entity> lookups{entities};
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937{42});
+
+    HashMapComponentArray<BenchTransform>                   hash_map_array{count};
+    Vulqian::Engine::ECS::ComponentArray<BenchTransform> sparse_set_array{};
+    sparse_set_array.reserve(count);
+
+    for (Entity entity : entities) {
+        hash_map_array.insert_data(entity, BenchTransform{});
+        sparse_set_array.insert_data(entity, BenchTransform{});
+    }
+
+    const std::string suffix = " @ " + std::to_string(count);
+
+    Vulqian::Benchmarks::measure("lookup   hash map" + suffix, count, [&] {
+        float sum = 0.f;
+        for (Entity entity : lookups) {
+            sum += hash_map_array.get_data(entity).translation[0];
+        }
+        Vulqian::Benchmarks::do_not_optimize(sum);
+    });
+
+    Vulqian::Benchmarks::measure("lookup   sparse set" + suffix, count, [&] {
+        float sum = 0.f;
+        for (Entity entity : lookups) {
+            sum += sparse_set_array.get_data(entity).translation[0];
+        }
+        Vulqian::Benchmarks::do_not_optimize(sum);
+    });
+
+    // Systems used to walk an entity list and look every component up
+    Vulqian::Benchmarks::measure("iterate  hash map (per entity lookup)" + suffix, count, [&] {
+        for (Entity entity : entities) {
+            hash_map_array.get_data(entity).translation[1] += 1.f;
+        }
+        Vulqian::Benchmarks::do_not_optimize(hash_map_array.get_data(0));
+    });
+
+    Vulqian::Benchmarks::measure("iterate  sparse set (packed components)" + suffix, count, [&] {
+        for (auto& component : sparse_set_array.components()) {
+            component.translation[1] += 1.f;
+        }
+        Vulqian::Benchmarks::do_not_optimize(sparse_set_array.get_data(0));
+    });
+}
+
+} // namespace
+
+VULQIAN_BENCHMARK(ComponentArray) {
+    for (std::size_t count : {10'000u, 100'000u, 1'000'000u}) {
+        run_component_array_benchmark(count);
+    }
+}
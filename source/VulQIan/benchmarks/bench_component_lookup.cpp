@@ -0,0 +1,127 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "ECS/Components/ComponentManager.hpp"
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace {
+
+using Vulqian::Engine::ECS::ComponentArray;
+using Vulqian::Engine::ECS::ComponentType;
+using Vulqian::Engine::ECS::Entity;
+using Vulqian::Engine::ECS::IComponentArray;
+
+struct LookupPosition {
+    float x{}, y{}, z{};
+};
+
+struct LookupVelocity {
+    float x{}, y{}, z{};
+};
+
+// Previous ComponentManager resolution path, kept here as the reference point:
+// every call hashes typeid(T).name() and static_pointer_casts a shared_ptr.
+class TypeNameComponentManager {
+  public:
+    template <typename T>
+    void register_component() {
+        const char* type_name = typeid(T).name();
+        this->component_types.insert({type_name, this->next_component_type++});
+        this->component_arrays.insert({type_name, std::make_shared<ComponentArray<T>>()});
+    }
+
+    template <typename T>
+    ComponentType get_component_type() {
+        return this->component_types[typeid(T).name()];
+    }
+
+    template <typename T>
+    void add_component(Entity entity, T component) {
+        this->get_component_array<T>()->insert_data(entity, component);
+    }
+
+    template <typename T>
+    T& get_component(Entity entity) {
+        return this->get_component_array<T>()->get_data(entity);
+    }
+
+  private:
+    template <typename T>
+    std::shared_ptr<ComponentArray<T>> get_component_array() {
+        return std::static_pointer_cast<ComponentArray<T>>(this->component_arrays[typeid(T).name()]);
+    }
+
+    std::unordered_map<const char*, ComponentType>                    component_types{};
+    std::unordered_map<const char*, std::shared_ptr<IComponentArray>> component_arrays{};
+    ComponentType                                                     next_component_type{};
+};
+
+template <typename Manager>
+void fill(Manager& manager, std::size_t count) {
+    manager.template register_component<LookupPosition>();
+    manager.template register_component<LookupVelocity>();
+
+    for (Entity entity = 0; entity < count; ++entity) {
+        manager.add_component(entity, LookupPosition{});
+        manager.add_component(entity, LookupVelocity{1.f, 1.f, 1.f});
+    }
+}
+
+template <typename Manager>
+void integrate(Manager& manager, std::size_t count) {
+    for (Entity entity = 0; entity < count; ++entity) {
+        auto&       position = manager.template get_component<LookupPosition>(entity);
+        auto const& velocity = manager.template get_component<LookupVelocity>(entity);
+        position.x += velocity.x;
+        position.y += velocity.y;
+        position.z += velocity.z;
+    }
+}
+
+} // namespace
+
+VULQIAN_BENCHMARK(ComponentLookup) {
+    constexpr std::size_t count = 100'000;
+    constexpr std::size_t calls = count * 2;  // two get_component per entity
+
+    TypeNameComponentManager type_name_manager{};
+    fill(type_name_manager, count);
+
+    Vulqian::Engine::ECS::ComponentManager type_index_manager{};
+    fill(type_index_manager, count);
+
+    Vulqian::Benchmarks::measure("get_component typeid().name() map @ " + std::to_string(count), calls, [&] {
+        integrate(type_name_manager, count);
+        Vulqian::Benchmarks::do_not_optimize(type_name_manager.get_component<LookupPosition>(0));
+    });
+
+    Vulqian::Benchmarks::measure("get_component static type index @ " + std::to_string(count), calls, [&] {
+        integrate(type_index_manager, count);
+        Vulqian::Benchmarks::do_not_optimize(type_index_manager.get_component<LookupPosition>(0));
+    });
+
+    Vulqian::Benchmarks::measure("get_component_type typeid().name() map", calls, [&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            sum += type_name_manager.get_component_type<LookupVelocity>();
+        }
+        Vulqian::Benchmarks::do_not_optimize(sum);
+    });
+
+    Vulqian::Benchmarks::measure("get_component_type static type index", calls, [&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < calls; ++i) {
+            sum += type_index_manager.get_component_type<LookupVelocity>();
+        }
+        Vulqian::Benchmarks::do_not_optimize(sum);
+    });
+}
@@ -0,0 +1,51 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "Graphics/Camera/Camera.hpp"
+#include "Math/Frustum.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+VULQIAN_BENCHMARK(FrustumCulling) {
+    using Vulqian::Engine::Math::BoundingSphere;
+
+    Vulqian::Engine::Graphics::Camera camera{};
+    camera.set_perspective_projection(glm::radians(60.f), 16.f / 9.f, .1f, 500.f);
+    camera.set_view_direction(glm::vec3{0.f}, glm::vec3{0.f, 0.f, 1.f});
+    const auto frustum = camera.get_frustum();
+
+    for (std::size_t count : {10'000, 100'000, 1'000'000}) {
+        // Spheres all around the camera, about a tenth of them in view
+        std::mt19937                          rng{42};
+        std::uniform_real_distribution<float> position{-500.f, 500.f};
+        std::uniform_real_distribution<float> size{.5f, 4.f};
+        std::vector<float>                    x(count), y(count), z(count), radius(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            x[i] = position(rng);
+            y[i] = position(rng);
+            z[i] = position(rng);
+            radius[i] = size(rng);
+        }
+        std::vector<std::uint8_t> visible(count);
+        std::size_t               visible_count = 0;
+
+        Vulqian::Benchmarks::measure("one at a time @ " + std::to_string(count), count, [&] {
+            visible_count = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                visible[i] = frustum.intersects(BoundingSphere{{x[i], y[i], z[i]}, radius[i]});
+                visible_count += visible[i];
+            }
+        });
+        Vulqian::Benchmarks::measure("cull_spheres @ " + std::to_string(count), count, [&] {
+            visible_count = Vulqian::Engine::Math::cull_spheres(frustum, {x.data(), y.data(), z.data(), radius.data(), count}, visible.data());
+        });
+        std::cout << "  visible: " << visible_count << std::endl;
+    }
+}
@@ -0,0 +1,57 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "Graphics/Camera/Camera.hpp"
+#include "Math/Meshlets.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+VULQIAN_BENCHMARK(Meshlets) {
+    for (std::uint32_t size : {64u, 256u}) {
+        // A sphere of size x 2 size quads
+        std::vector<glm::vec3>     positions{};
+        std::vector<std::uint32_t> indices{};
+        for (std::uint32_t ring = 0; ring <= size; ++ring) {
+            const float theta = 3.14159265f * static_cast<float>(ring) / static_cast<float>(size);
+            for (std::uint32_t segment = 0; segment < 2 * size; ++segment) {
+                const float phi = 3.14159265f * static_cast<float>(segment) / static_cast<float>(size);
+                positions.push_back({std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            }
+        }
+        for (std::uint32_t ring = 0; ring < size; ++ring) {
+            for (std::uint32_t segment = 0; segment < 2 * size; ++segment) {
+                const std::uint32_t a = ring * 2 * size + segment;
+                const std::uint32_t b = ring * 2 * size + (segment + 1) % (2 * size);
+                indices.insert(indices.end(), {a, b, b + 2 * size, a, b + 2 * size, a + 2 * size});
+            }
+        }
+
+        const std::size_t                     triangles = indices.size() / 3;
+        Vulqian::Engine::Math::ClusteredMesh clustered{};
+        Vulqian::Benchmarks::measure("build_meshlets @ " + std::to_string(triangles) + " triangles", triangles, [&] {
+            clustered = Vulqian::Engine::Math::build_meshlets(positions, positions, indices);
+        }, 3);
+        std::cout << "  meshlets: " << clustered.meshlets.size() << ", " << static_cast<float>(triangles) / static_cast<float>(clustered.meshlets.size()) << " triangles each" << std::endl;
+
+        // Close enough for the frustum to cut the sphere, half of the rest facing away
+        Vulqian::Engine::Graphics::Camera camera{};
+        camera.set_perspective_projection(glm::radians(60.f), 2.f, .1f, 100.f);
+        camera.set_view_direction(glm::vec3{0.f, 0.f, -1.6f}, glm::vec3{0.f, 0.f, 1.f});
+        const auto frustum = camera.get_frustum();
+
+        std::vector<Vulqian::Engine::Math::IndexRange> ranges{};
+        std::size_t                                    visible = 0;
+        Vulqian::Benchmarks::measure("cull_meshlets @ " + std::to_string(clustered.meshlets.size()) + " meshlets", clustered.meshlets.size(), [&] {
+            ranges.clear();
+            visible = Vulqian::Engine::Math::cull_meshlets(clustered.meshlets, glm::mat4{1.f}, glm::mat4{1.f}, frustum, camera.get_position(), true, ranges);
+        });
+        std::cout << "  visible: " << visible << " of " << clustered.meshlets.size() << " in " << ranges.size() << " ranges" << std::endl;
+    }
+}
@@ -0,0 +1,66 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "Graphics/Camera/Camera.hpp"
+#include "Jobs/ThreadPool.hpp"
+#include "Math/OcclusionBuffer.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+VULQIAN_BENCHMARK(OcclusionBuffer) {
+    using Vulqian::Engine::Math::BoundingBox;
+
+    Vulqian::Engine::Graphics::Camera camera{};
+    camera.set_perspective_projection(glm::radians(60.f), 2.f, .1f, 500.f);
+    camera.set_view_direction(glm::vec3{0.f}, glm::vec3{0.f, 0.f, 1.f});
+    const glm::mat4 view_projection = camera.get_projection() * camera.get_view();
+
+    // Walls standing across the view, 2 triangles each, as a city block of occluders would
+    const std::vector<glm::vec3>     quad{{-1.f, -1.f, 0.f}, {1.f, -1.f, 0.f}, {1.f, 1.f, 0.f}, {-1.f, 1.f, 0.f}};
+    const std::vector<std::uint32_t> indices{0, 1, 2, 0, 2, 3};
+    std::mt19937                          rng{42};
+    std::uniform_real_distribution<float> spread{-60.f, 60.f};
+    std::uniform_real_distribution<float> distance{10.f, 120.f};
+    std::uniform_real_distribution<float> size{2.f, 10.f};
+    std::vector<glm::mat4>                walls(64, glm::mat4{1.f});
+    for (auto& wall : walls) {
+        wall[0].x = size(rng);
+        wall[1].y = size(rng);
+        wall[3] = glm::vec4{spread(rng), spread(rng) * .3f, distance(rng), 1.f};
+    }
+
+    std::vector<BoundingBox> boxes(100'000);
+    for (auto& box : boxes) {
+        const glm::vec3 center{spread(rng), spread(rng) * .3f, distance(rng) + 20.f};
+        box = BoundingBox{center - glm::vec3{1.f}, center + glm::vec3{1.f}};
+    }
+
+    Vulqian::Engine::Math::OcclusionBuffer buffer{256, 128};
+    Vulqian::Engine::Jobs::ThreadPool      pool{};
+    for (Vulqian::Engine::Jobs::ThreadPool* jobs : {static_cast<Vulqian::Engine::Jobs::ThreadPool*>(nullptr), &pool}) {
+        const std::string where = jobs ? " on the pool" : " inline";
+        Vulqian::Benchmarks::measure("rasterize " + std::to_string(walls.size()) + " walls" + where, walls.size(), [&] {
+            buffer.begin(view_projection);
+            for (auto const& wall : walls) {
+                buffer.add_occluder(quad, indices, wall);
+            }
+            buffer.rasterize(jobs);
+        });
+    }
+
+    std::size_t visible_count = 0;
+    Vulqian::Benchmarks::measure("is_visible @ " + std::to_string(boxes.size()), boxes.size(), [&] {
+        visible_count = 0;
+        for (auto const& box : boxes) {
+            visible_count += buffer.is_visible(box);
+        }
+    });
+    std::cout << "  visible: " << visible_count << " of " << boxes.size() << std::endl;
+}
@@ -0,0 +1,52 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+#include <cmath>
+#include <string>
+
+namespace {
+
+struct EachTransform {
+    float x{}, y{}, z{};
+    float angle{};
+};
+
+struct EachSpin {
+    float speed{1.f};
+};
+
+void spin(EachTransform& transform, EachSpin const& spin) {
+    transform.angle += spin.speed * 0.016f;
+    transform.x = std::cos(transform.angle);
+    transform.z = std::sin(transform.angle);
+}
+
+} // namespace
+
+VULQIAN_BENCHMARK(ParallelEach) {
+    constexpr std::size_t count = 100'000;
+
+    Vulqian::Engine::Jobs::ThreadPool pool{};
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    coordinator.init();
+    coordinator.set_thread_pool(&pool);
+    coordinator.register_component<EachTransform>();
+    coordinator.register_component<EachSpin>();
+    coordinator.create_entities(count, EachTransform{}, EachSpin{});
+
+    const std::string suffix = " @ " + std::to_string(count) + " (" + std::to_string(pool.get_thread_count() + 1) + " threads)";
+
+    Vulqian::Benchmarks::measure("each" + suffix, count, [&] {
+        coordinator.each<EachTransform, const EachSpin>(spin);
+    });
+
+    Vulqian::Benchmarks::measure("parallel_each" + suffix, count, [&] {
+        coordinator.parallel_each<EachTransform, const EachSpin>(spin);
+    });
+}
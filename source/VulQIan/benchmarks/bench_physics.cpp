@@ -0,0 +1,108 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "ECS/Coordinator/Coordinator.hpp"
+#include "ECS/Systems/Physics.hpp"
+
+#include <string>
+
+VULQIAN_BENCHMARK(PhysicsIntegration) {
+    using Vulqian::Engine::ECS::Components::RigidBody;
+    using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+    using Vulqian::Engine::ECS::Components::Velocity;
+    using Vulqian::Engine::ECS::Systems::Physics;
+
+    constexpr std::size_t count = 100'000;
+
+    Vulqian::Engine::Jobs::ThreadPool pool{};
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    coordinator.init();
+    coordinator.register_component<Transform_TB_YXZ>();
+    coordinator.register_component<RigidBody>();
+    coordinator.register_component<Velocity>();
+
+    auto physics = coordinator.register_system<Physics>();
+    coordinator.set_system_signature<Physics>(coordinator.signature_of<Transform_TB_YXZ, RigidBody, Velocity>());
+    coordinator.create_entities(count, Transform_TB_YXZ{}, RigidBody{}, Velocity{{1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}});
+
+    // One update of 4 fixed steps, including the gather from and scatter to the components
+    for (auto* threads : {static_cast<Vulqian::Engine::Jobs::ThreadPool*>(nullptr), &pool}) {
+        coordinator.set_thread_pool(threads);
+
+        const std::string label = threads == nullptr ? "inline" : std::to_string(pool.get_thread_count()) + " workers";
+        Vulqian::Benchmarks::measure("Physics::update 4 steps @ 100000, " + label, count, [&] {
+            physics->update(coordinator, 4.f * physics->fixed_timestep + 1e-4f);
+            Vulqian::Benchmarks::do_not_optimize(coordinator);
+        });
+    }
+}
+
+VULQIAN_BENCHMARK(PhysicsContacts) {
+    using Vulqian::Engine::ECS::Components::Collider;
+    using Vulqian::Engine::ECS::Components::RigidBody;
+    using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+    using Vulqian::Engine::ECS::Components::Velocity;
+    using Vulqian::Engine::ECS::Systems::Physics;
+
+    // Stacks of 5 unit boxes on a static floor, each stack its own island
+    constexpr int         side = 40;
+    constexpr int         height = 5;
+    constexpr std::size_t count = side * side * height;
+
+    Vulqian::Engine::Jobs::ThreadPool pool{};
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    coordinator.init();
+    coordinator.register_component<Transform_TB_YXZ>();
+    coordinator.register_component<RigidBody>();
+    coordinator.register_component<Velocity>();
+    coordinator.register_component<Collider>();
+    coordinator.set_thread_pool(&pool);
+
+    auto physics = coordinator.register_system<Physics>();
+    coordinator.set_system_signature<Physics>(coordinator.signature_of<Transform_TB_YXZ, RigidBody, Velocity>());
+    physics->solve_contacts = true;
+
+    RigidBody floor_body{};
+    floor_body.inverse_mass = 0.f;
+    Collider floor_shape{};
+    floor_shape.half_extents = {2.f * side, .5f, 2.f * side};
+    const auto floor = coordinator.create_entity();
+    coordinator.add_component(floor, Transform_TB_YXZ{{side, .5f, side}, glm::vec3{1.f}, glm::vec3{0.f}});
+    coordinator.add_component(floor, floor_body);
+    coordinator.add_component(floor, Velocity{});
+    coordinator.add_component(floor, floor_shape);
+
+    RigidBody box{};
+    box.inverse_inertia = glm::vec3{6.f};
+    for (int x = 0; x < side; ++x) {
+        for (int z = 0; z < side; ++z) {
+            for (int level = 0; level < height; ++level) {
+                const auto entity = coordinator.create_entity();
+                const glm::vec3 position{2.f * x, -.5f - static_cast<float>(level), 2.f * z};
+                coordinator.add_component(entity, Transform_TB_YXZ{position, glm::vec3{1.f}, glm::vec3{0.f}});
+                coordinator.add_component(entity, box);
+                coordinator.add_component(entity, Velocity{});
+                coordinator.add_component(entity, Collider{});
+            }
+        }
+    }
+
+    const std::string label = std::to_string(count) + " boxes, " + std::to_string(pool.get_thread_count()) + " workers";
+    Vulqian::Benchmarks::measure("Physics::step contacts, awake @ " + label, count, [&] {
+        physics->step(coordinator);
+        Vulqian::Benchmarks::do_not_optimize(coordinator);
+    });
+
+    // Once the stacks settled every island sleeps and a step only gathers the bodies
+    for (int frame = 0; frame < 120; ++frame) {
+        physics->step(coordinator);
+    }
+    Vulqian::Benchmarks::measure("Physics::step contacts, asleep @ " + label + " (" + std::to_string(physics->get_stats().sleeping_bodies) + " sleeping)", count, [&] {
+        physics->step(coordinator);
+        Vulqian::Benchmarks::do_not_optimize(coordinator);
+    });
+}
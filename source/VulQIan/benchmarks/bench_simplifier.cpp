@@ -0,0 +1,47 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "Math/Simplifier.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+VULQIAN_BENCHMARK(Simplifier) {
+    for (std::uint32_t size : {32u, 128u, 256u}) {
+        // A bumpy sphere of size x 2 size quads, so the collapses do not all cost nothing
+        std::vector<glm::vec3>     positions{};
+        std::vector<glm::vec3>     normals{};
+        std::vector<std::uint32_t> indices{};
+        for (std::uint32_t ring = 0; ring <= size; ++ring) {
+            const float theta = 3.14159265f * static_cast<float>(ring) / static_cast<float>(size);
+            for (std::uint32_t segment = 0; segment < 2 * size; ++segment) {
+                const float phi = 3.14159265f * static_cast<float>(segment) / static_cast<float>(size);
+                const float radius = 1.f + .05f * std::sin(7.f * theta) * std::cos(5.f * phi);
+                normals.push_back({std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+                positions.push_back(normals.back() * radius);
+            }
+        }
+        for (std::uint32_t ring = 0; ring < size; ++ring) {
+            for (std::uint32_t segment = 0; segment < 2 * size; ++segment) {
+                const std::uint32_t a = ring * 2 * size + segment;
+                const std::uint32_t b = ring * 2 * size + (segment + 1) % (2 * size);
+                indices.insert(indices.end(), {a, b, b + 2 * size, a, b + 2 * size, a + 2 * size});
+            }
+        }
+
+        const std::size_t triangles = indices.size() / 3;
+        float             error = 0.f;
+        for (std::size_t divisor : {2u, 8u}) {
+            Vulqian::Benchmarks::measure("simplify 1/" + std::to_string(divisor) + " @ " + std::to_string(triangles) + " triangles", triangles, [&] {
+                error = Vulqian::Engine::Math::simplify(positions, normals, indices, indices.size() / divisor).error;
+            }, 3);
+            std::cout << "  error: " << error << std::endl;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include "ECS/Components/Transform.hpp"
+#include "Math/TransformKernel.hpp"
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+VULQIAN_BENCHMARK(TransformKernel) {
+    using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+    using Vulqian::Engine::Math::SimdLevel;
+
+    constexpr std::size_t count = 100'000;
+
+    std::mt19937                          generator{7};
+    std::uniform_real_distribution<float> angle{-3.14f, 3.14f};
+    std::uniform_real_distribution<float> scale{0.5f, 2.f};
+
+    // The same transforms as components and as the kernel's structure of arrays
+    std::vector<Transform_TB_YXZ>     transforms(count);
+    std::array<std::vector<float>, 9> fields{};
+    for (auto& field : fields) {
+        field.resize(count);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        transforms[i].translation = {static_cast<float>(i), 0.f, 1.f};
+        transforms[i].rotation = {angle(generator), angle(generator), angle(generator)};
+        transforms[i].scale = {scale(generator), scale(generator), scale(generator)};
+
+        for (int axis = 0; axis < 3; ++axis) {
+            fields[axis][i] = transforms[i].translation[axis];
+            fields[3 + axis][i] = transforms[i].rotation[axis];
+            fields[6 + axis][i] = transforms[i].scale[axis];
+        }
+    }
+
+    const Vulqian::Engine::Math::TransformArrays arrays{fields[0].data(), fields[1].data(), fields[2].data(), fields[3].data(), fields[4].data(),
+                                                        fields[5].data(), fields[6].data(), fields[7].data(), fields[8].data(), count};
+
+    std::vector<glm::mat4> models(count), normals(count);
+
+    Vulqian::Benchmarks::measure("Transform_TB_YXZ mat4 + normal_matrix @ 100000", count, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            models[i] = transforms[i].mat4();
+            normals[i] = glm::mat4{transforms[i].normal_matrix()};
+        }
+        Vulqian::Benchmarks::do_not_optimize(models.data());
+    });
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > Vulqian::Engine::Math::detect_simd_level()) {
+            continue;
+        }
+
+        Vulqian::Benchmarks::measure(std::string{"compute_transform_matrices "} + Vulqian::Engine::Math::simd_level_name(level) + " @ 100000",
+                                     count, [&] {
+                                         Vulqian::Engine::Math::compute_transform_matrices(arrays, models.data(), normals.data(), level);
+                                         Vulqian::Benchmarks::do_not_optimize(models.data());
+                                     });
+    }
+}
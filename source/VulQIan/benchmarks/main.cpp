@@ -0,0 +1,26 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include "Benchmark.hpp"
+
+#include <cstdlib>
+#include <string_view>
+
+// Usage: VulQIanBenchmarks [filter]
+// Only the cases whose name contains the filter are run
+int main(int argc, char** argv) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    for (auto const& benchmark : Vulqian::Benchmarks::registry()) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        std::cout << "[" << benchmark.name << "]" << std::endl;
+        benchmark.run();
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+struct Position {
+    float x{};
+};
+
+struct Velocity {
+    float dx{};
+};
+
+// Non trivially copyable, checks components are moved and destroyed properly
+struct Name {
+    std::shared_ptr<int> id{};
+};
+
+class ArchetypeStorageTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        this->coordinator.init(Vulqian::Engine::ECS::StorageMode::Archetype);
+        this->coordinator.register_component<Position>();
+        this->coordinator.register_component<Velocity>();
+        this->coordinator.register_component<Name>();
+    }
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+};
+
+} // namespace
+
+TEST_F(ArchetypeStorageTest, ComponentsSurviveArchetypeMoves) {
+    auto entity = this->coordinator.create_entity();
+    auto id = std::make_shared<int>(7);
+
+    this->coordinator.add_component(entity, Position{1.f});
+    this->coordinator.add_component(entity, Name{id});
+    this->coordinator.add_component(entity, Velocity{2.f});
+    this->coordinator.remove_component<Position>(entity);
+
+    ASSERT_FALSE(this->coordinator.has_component<Position>(entity));
+    ASSERT_TRUE(this->coordinator.has_component<Velocity>(entity));
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<Velocity>(entity).dx, 2.f);
+    ASSERT_EQ(this->coordinator.get_component<Name>(entity).id, id);
+    ASSERT_EQ(id.use_count(), 2);
+
+    this->coordinator.destroy_entity(entity);
+    ASSERT_EQ(id.use_count(), 1);
+}
+
+TEST_F(ArchetypeStorageTest, EachSpansChunksAndArchetypes) {
+    constexpr int count = 10000;
+    std::vector<Vulqian::Engine::ECS::Entity> entities{};
+
+    for (int i = 0; i < count; ++i) {
+        auto entity = this->coordinator.create_entity();
+        this->coordinator.add_component(entity, Position{static_cast<float>(i)});
+        this->coordinator.add_component(entity, Velocity{1.f});
+        if (i % 2 == 0) {
+            this->coordinator.add_component(entity, Name{});
+        }
+        entities.push_back(entity);
+    }
+
+    // Removing rows in the middle of chunks must keep the others addressable
+    for (int i = 0; i < count; i += 3) {
+        this->coordinator.destroy_entity(entities[i]);
+    }
+
+    int visited{0};
+    this->coordinator.each<Position, const Velocity>([&](Position& position, Velocity const& velocity) {
+        position.x += velocity.dx;
+        ++visited;
+    });
+    ASSERT_EQ(visited, count - (count + 2) / 3);
+
+    int named{0};
+    this->coordinator.each<const Position>([&](auto const&) { ++named; }, Vulqian::Engine::ECS::exclude<Name>);
+    ASSERT_EQ(named, visited / 2);
+
+    for (int i = 1; i < count; i += 3) {
+        ASSERT_FLOAT_EQ(this->coordinator.get_component<Position>(entities[i]).x, static_cast<float>(i) + 1.f);
+    }
+}
+
+TEST_F(ArchetypeStorageTest, BulkAddMovesEveryArchetypeAsABlock) {
+    constexpr int count = 5000;
+    auto          id = std::make_shared<int>(3);
+
+    // Two source archetypes, interleaved, plus entities left without any component
+    std::vector<Vulqian::Engine::ECS::Entity> all{};
+    std::vector<Vulqian::Engine::ECS::Entity> entities{};
+    std::vector<Vulqian::Engine::ECS::Entity> bystanders{};
+    for (int i = 0; i < count; ++i) {
+        auto entity = all.emplace_back(this->coordinator.create_entity());
+        if (i % 5 != 0) {
+            this->coordinator.add_component(entity, Position{static_cast<float>(i)});
+            if (i % 2 == 0) {
+                this->coordinator.add_component(entity, Name{id});
+            }
+        }
+
+        // Every third one stays behind, its row is refilled by the rows past the new end
+        if (i % 3 == 0 && i % 5 != 0) {
+            bystanders.push_back(entity);
+        } else {
+            entities.push_back(entity);
+        }
+    }
+
+    std::vector<Velocity> velocities{};
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        velocities.push_back(Velocity{static_cast<float>(i)});
+    }
+    this->coordinator.add_components<Velocity>(entities, velocities);
+
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        ASSERT_FLOAT_EQ(this->coordinator.get_component<Velocity>(entities[i]).dx, static_cast<float>(i));
+    }
+    for (int i = 0; i < count; ++i) {
+        if (i % 5 != 0) {
+            ASSERT_FLOAT_EQ(this->coordinator.get_component<Position>(all[i]).x, static_cast<float>(i));
+            ASSERT_EQ(this->coordinator.has_component<Name>(all[i]), i % 2 == 0);
+        }
+    }
+    for (auto entity : bystanders) {
+        ASSERT_FALSE(this->coordinator.has_component<Velocity>(entity));
+    }
+
+    int moving{0};
+    this->coordinator.each<const Velocity>([&](auto const&) { ++moving; });
+    ASSERT_EQ(moving, static_cast<int>(entities.size()));
+
+    // No Name was lost or duplicated on the way
+    const auto named = static_cast<long>(std::count_if(entities.begin(), entities.end(), [&](auto entity) {
+                           return this->coordinator.has_component<Name>(entity);
+                       }) +
+                       std::count_if(bystanders.begin(), bystanders.end(), [&](auto entity) {
+                           return this->coordinator.has_component<Name>(entity);
+                       }));
+    ASSERT_EQ(id.use_count(), named + 1);
+}
@@ -0,0 +1,97 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "Assets/AssetRegistry.hpp"
+#include "Exception/Exception.hpp"
+
+namespace {
+
+using Vulqian::Engine::Assets::AssetRegistry;
+
+// Stands for a model, remembers which file it was loaded from
+struct FakeAsset {
+    std::string path{};
+};
+
+class AssetRegistryTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        this->directory = std::filesystem::temp_directory_path() / ("vulqian_assets_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::create_directories(this->directory / "models");
+        this->write("models/cube.obj", "v 0 0 0\n");
+        this->write("models/copy.obj", "v 0 0 0\n");
+        this->write("models/vase.obj", "v 1 1 1\n");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(this->directory);
+    }
+
+    void write(std::string const& name, std::string const& contents) {
+        std::ofstream{this->directory / name} << contents;
+    }
+
+    std::string path(std::string const& name) {
+        return (this->directory / name).string();
+    }
+
+    std::filesystem::path    directory{};
+    AssetRegistry<FakeAsset> registry{[](std::string const& path) { return std::make_shared<FakeAsset>(FakeAsset{path}); }};
+};
+
+TEST_F(AssetRegistryTest, SamePathOrContentsLoadsOnce) {
+    auto cube = this->registry.load(this->path("models/cube.obj"));
+    ASSERT_EQ(this->registry.load(this->path("models/../models/./cube.obj")), cube);
+    ASSERT_EQ(this->registry.load(this->path("models/copy.obj")), cube);
+    ASSERT_EQ(this->registry.get_load_count(), 1u);
+
+    auto vase = this->registry.load(this->path("models/vase.obj"));
+    ASSERT_NE(vase, cube);
+    ASSERT_EQ(this->registry.get_load_count(), 2u);
+    ASSERT_EQ(this->registry.get_asset_count(), 2u);
+
+    ASSERT_THROW(this->registry.load(this->path("models/missing.obj")), Vulqian::Exception::failed_to_open);
+}
+
+TEST_F(AssetRegistryTest, HashCollisionsKeepDistinctAssets) {
+    // Every file hashes the same, only the byte comparison tells them apart
+    AssetRegistry<FakeAsset> colliding{[](std::string const& path) { return std::make_shared<FakeAsset>(FakeAsset{path}); },
+                                       [](std::string const&) { return std::uint64_t{42}; }};
+
+    auto cube = colliding.load(this->path("models/cube.obj"));
+    auto vase = colliding.load(this->path("models/vase.obj"));
+    ASSERT_NE(vase, cube);
+    ASSERT_EQ(colliding.load(this->path("models/copy.obj")), cube);
+    ASSERT_EQ(colliding.get_load_count(), 2u);
+
+    vase.reset();
+    ASSERT_EQ(colliding.evict_unused(), 1u);
+    ASSERT_EQ(colliding.load(this->path("models/copy.obj")), cube);
+    ASSERT_NE(colliding.load(this->path("models/vase.obj")), cube);
+    ASSERT_EQ(colliding.get_load_count(), 3u);
+}
+
+TEST_F(AssetRegistryTest, EvictsOnlyUnreferencedAssets) {
+    auto cube = this->registry.load(this->path("models/cube.obj"));
+    this->registry.load(this->path("models/vase.obj"));
+
+    ASSERT_EQ(this->registry.evict_unused(), 1u);
+    ASSERT_EQ(this->registry.get_asset_count(), 1u);
+    ASSERT_EQ(this->registry.load(this->path("models/cube.obj")), cube);
+
+    // Loaded again after its eviction
+    cube.reset();
+    ASSERT_EQ(this->registry.evict_unused(), 1u);
+    this->registry.load(this->path("models/cube.obj"));
+    ASSERT_EQ(this->registry.get_load_count(), 3u);
+}
+
+} // namespace
@@ -0,0 +1,269 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "Collision/BroadPhase.hpp"
+#include "ECS/Coordinator/Coordinator.hpp"
+#include "ECS/Systems/Collisions.hpp"
+
+namespace {
+
+using Vulqian::Engine::Collision::AABB;
+using Vulqian::Engine::Collision::BroadPhase;
+using Vulqian::Engine::Collision::BroadPhaseMode;
+using Vulqian::Engine::Collision::DynamicAABBTree;
+using Vulqian::Engine::Collision::Ray;
+
+// Boxes of 0.2 to 2 units scattered in a 40 unit cube, a few of them much larger
+std::vector<AABB> random_boxes(std::size_t count, std::uint32_t seed) {
+    std::mt19937                          rng{seed};
+    std::uniform_real_distribution<float> position{-20.f, 20.f};
+    std::uniform_real_distribution<float> size{.1f, 1.f};
+
+    std::vector<AABB> boxes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const glm::vec3 center{position(rng), position(rng), position(rng)};
+        const glm::vec3 half{size(rng), size(rng), size(rng)};
+        boxes[i] = {center - half * (i % 50 == 0 ? 8.f : 1.f), center + half * (i % 50 == 0 ? 8.f : 1.f)};
+    }
+    return boxes;
+}
+
+std::vector<BroadPhase::Pair> brute_force(std::vector<AABB> const& boxes) {
+    std::vector<BroadPhase::Pair> pairs{};
+    for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+        for (std::uint32_t j = i + 1; j < boxes.size(); ++j) {
+            if (boxes[i].overlaps(boxes[j])) {
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+    return pairs;
+}
+
+std::vector<BroadPhase::Pair> pairs_of(BroadPhase const& broad_phase) {
+    return {broad_phase.get_pairs().begin(), broad_phase.get_pairs().end()};
+}
+
+TEST(BroadPhaseTest, BothModesMatchBruteForceWhileMoving) {
+    std::vector<AABB> boxes = random_boxes(2000, 7);
+
+    for (BroadPhaseMode mode : {BroadPhaseMode::AABBTree, BroadPhaseMode::SpatialHash}) {
+        BroadPhase                     broad_phase{mode};
+        std::vector<BroadPhase::ProxyId> proxies{};
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            proxies.push_back(broad_phase.add(boxes[i], i));
+        }
+
+        std::vector<AABB> moved = boxes;
+        std::mt19937      rng{11};
+        for (int frame = 0; frame < 5; ++frame) {
+            broad_phase.update_pairs();
+            EXPECT_EQ(pairs_of(broad_phase), brute_force(moved));
+
+            // Small and large moves, so some proxies stay in their fat box and others leave it
+            std::uniform_real_distribution<float> offset{frame % 2 == 0 ? -.05f : -3.f, frame % 2 == 0 ? .05f : 3.f};
+            for (std::uint32_t i = 0; i < moved.size(); i += 3) {
+                const glm::vec3 displacement{offset(rng), offset(rng), offset(rng)};
+                moved[i] = {moved[i].min + displacement, moved[i].max + displacement};
+                broad_phase.move(proxies[i], moved[i], displacement);
+            }
+        }
+
+        if (mode == BroadPhaseMode::AABBTree) {
+            EXPECT_GT(broad_phase.get_rebuild_count(), 0u);
+            EXPECT_TRUE(broad_phase.get_tree().validate());
+        }
+    }
+}
+
+TEST(BroadPhaseTest, ParallelUpdatesMatchSerialOnes) {
+    // Enough boxes for the parallel tree build and the chunked sort of the hash
+    const std::vector<AABB>           boxes = random_boxes(20000, 13);
+    Vulqian::Engine::Jobs::ThreadPool pool{4};
+
+    for (BroadPhaseMode mode : {BroadPhaseMode::AABBTree, BroadPhaseMode::SpatialHash}) {
+        BroadPhase serial{mode};
+        BroadPhase parallel{mode};
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            serial.add(boxes[i], i);
+            parallel.add(boxes[i], i);
+        }
+
+        // Far moves past the rebuild threshold
+        for (BroadPhase::ProxyId proxy = 0; proxy < boxes.size(); proxy += 4) {
+            const AABB moved{boxes[proxy].min + 4.f, boxes[proxy].max + 4.f};
+            serial.move(proxy, moved);
+            parallel.move(proxy, moved);
+        }
+
+        serial.update_pairs();
+        parallel.update_pairs(&pool);
+        EXPECT_FALSE(serial.get_pairs().empty());
+        EXPECT_EQ(pairs_of(parallel), pairs_of(serial));
+        if (mode == BroadPhaseMode::AABBTree) {
+            EXPECT_EQ(parallel.get_rebuild_count(), 1u);
+            EXPECT_TRUE(parallel.get_tree().validate());
+        }
+    }
+}
+
+TEST(BroadPhaseTest, RemovedProxiesLeaveThePairs) {
+    for (BroadPhaseMode mode : {BroadPhaseMode::AABBTree, BroadPhaseMode::SpatialHash}) {
+        BroadPhase                broad_phase{mode};
+        const BroadPhase::ProxyId a = broad_phase.add({{0.f, 0.f, 0.f}, {1.f, 1.f, 1.f}}, 10);
+        const BroadPhase::ProxyId b = broad_phase.add({{.5f, .5f, .5f}, {2.f, 2.f, 2.f}}, 4);
+        broad_phase.add({{1.5f, 1.5f, 1.5f}, {3.f, 3.f, 3.f}}, 7);
+
+        broad_phase.update_pairs();
+        EXPECT_EQ(pairs_of(broad_phase), (std::vector<BroadPhase::Pair>{{4, 7}, {4, 10}}));
+
+        broad_phase.remove(b);
+        broad_phase.update_pairs();
+        EXPECT_TRUE(broad_phase.get_pairs().empty());
+
+        // The free proxy is reused
+        EXPECT_EQ(broad_phase.add({{.9f, .9f, .9f}, {1.6f, 1.6f, 1.6f}}, 2), b);
+        broad_phase.update_pairs();
+        EXPECT_EQ(pairs_of(broad_phase), (std::vector<BroadPhase::Pair>{{2, 7}, {2, 10}}));
+        EXPECT_EQ(broad_phase.get_proxy_count(), 3u);
+        (void)a;
+    }
+}
+
+TEST(BroadPhaseTest, QueriesAndRayCastsMatchBruteForce) {
+    const std::vector<AABB> boxes = random_boxes(1000, 3);
+
+    for (BroadPhaseMode mode : {BroadPhaseMode::AABBTree, BroadPhaseMode::SpatialHash}) {
+        BroadPhase broad_phase{mode};
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            broad_phase.add(boxes[i], i);
+        }
+        broad_phase.update_pairs();
+
+        std::mt19937                          rng{5};
+        std::uniform_real_distribution<float> position{-25.f, 25.f};
+        for (int test = 0; test < 50; ++test) {
+            const glm::vec3 corner{position(rng), position(rng), position(rng)};
+            const AABB      box{corner, corner + glm::vec3{static_cast<float>(test % 7)}};
+
+            std::vector<std::uint32_t> found{};
+            broad_phase.query(box, [&](std::uint32_t item) { found.push_back(item); });
+            std::sort(found.begin(), found.end());
+
+            std::vector<std::uint32_t> expected{};
+            for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+                if (boxes[i].overlaps(box)) {
+                    expected.push_back(i);
+                }
+            }
+            EXPECT_EQ(found, expected);
+
+            // Towards a random point, clipped at 30 units
+            const glm::vec3 target{position(rng), position(rng), position(rng)};
+            const Ray       ray{corner, glm::normalize(target - corner), 30.f};
+            const glm::vec3 inverse_direction = 1.f / ray.direction;
+
+            float closest = ray.max_distance;
+            bool  hit = false;
+            for (AABB const& candidate : boxes) {
+                const float entry = Vulqian::Engine::Collision::ray_entry(candidate, ray.origin, inverse_direction, ray.max_distance);
+                if (entry >= 0.f && entry <= closest) {
+                    closest = entry;
+                    hit = true;
+                }
+            }
+
+            const auto result = broad_phase.ray_cast(ray);
+            ASSERT_EQ(result.has_value(), hit);
+            if (hit) {
+                EXPECT_FLOAT_EQ(result->distance, closest);
+            }
+        }
+    }
+}
+
+TEST(BroadPhaseTest, TreeStaysValidThroughInsertsRemovesAndRebuilds) {
+    const std::vector<AABB> boxes = random_boxes(3000, 9);
+
+    DynamicAABBTree                       tree{};
+    std::vector<DynamicAABBTree::ProxyId> proxies{};
+    for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+        proxies.push_back(tree.create_proxy(boxes[i], i));
+    }
+    EXPECT_TRUE(tree.validate());
+
+    for (std::size_t i = 0; i < proxies.size(); i += 2) {
+        tree.destroy_proxy(proxies[i]);
+    }
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.get_proxy_count(), 1500u);
+
+    // Staying within the margin keeps the fat box
+    EXPECT_FALSE(tree.move_proxy(proxies[1], {boxes[1].min + .05f, boxes[1].max + .05f}));
+    EXPECT_TRUE(tree.move_proxy(proxies[1], {boxes[1].min + 5.f, boxes[1].max + 5.f}, glm::vec3{5.f}));
+    EXPECT_EQ(tree.get_enlarged_count(), 1u);
+    EXPECT_TRUE(tree.validate());
+
+    tree.rebuild();
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.get_enlarged_count(), 0u);
+    EXPECT_EQ(tree.get_proxy_count(), 1500u);
+    EXPECT_EQ(tree.get_user_data(proxies[3]), 3u);
+}
+
+TEST(BroadPhaseTest, CollisionsSystemReportsOverlappingEntities) {
+    using Vulqian::Engine::ECS::Entity;
+    using Vulqian::Engine::ECS::Components::Collider;
+    using Vulqian::Engine::ECS::Components::ColliderShape;
+    using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+    using Vulqian::Engine::ECS::Systems::Collisions;
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    coordinator.init();
+    coordinator.register_component<Transform_TB_YXZ>();
+    coordinator.register_component<Collider>();
+
+    auto collisions = coordinator.register_system<Collisions>();
+    coordinator.set_system_signature<Collisions>(coordinator.signature_of<Transform_TB_YXZ, Collider>());
+    collisions->init(coordinator);
+
+    auto spawn = [&](glm::vec3 position, Collider collider) {
+        const Entity entity = coordinator.create_entity();
+        coordinator.add_component(entity, Transform_TB_YXZ{.translation = position});
+        coordinator.add_component(entity, collider);
+        return entity;
+    };
+
+    const Entity box = spawn({0.f, 0.f, 0.f}, Collider{});
+    const Entity sphere = spawn({.9f, 0.f, 0.f}, Collider{.shape = ColliderShape::Sphere, .radius = .5f});
+    const Entity far = spawn({10.f, 0.f, 0.f}, Collider{});
+
+    collisions->update(coordinator);
+    EXPECT_EQ(std::vector<Collisions::Pair>(collisions->get_pairs().begin(), collisions->get_pairs().end()), (std::vector<Collisions::Pair>{{box, sphere}}));
+
+    // A box rotated by 45 degrees reaches sqrt(2) / 2 from its center
+    coordinator.get_component<Transform_TB_YXZ>(far).translation = {1.6f, 0.f, 0.f};
+    coordinator.get_component<Transform_TB_YXZ>(far).rotation = {0.f, 0.f, glm::pi<float>() / 4.f};
+    collisions->update(coordinator);
+    EXPECT_EQ(collisions->get_pairs().size(), 2u);
+
+    const auto hit = collisions->ray_cast(Ray{{-5.f, 0.f, 0.f}, {1.f, 0.f, 0.f}});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->user_data, box);
+    EXPECT_FLOAT_EQ(hit->distance, 4.5f);
+
+    // Destroyed entities leave the broad phase
+    coordinator.destroy_entity(sphere);
+    collisions->update(coordinator);
+    EXPECT_TRUE(collisions->get_pairs().empty());
+    EXPECT_EQ(collisions->get_broad_phase().get_proxy_count(), 2u);
+}
+
+} // namespace
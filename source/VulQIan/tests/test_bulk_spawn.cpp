@@ -0,0 +1,51 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+struct Position {
+    float x{};
+};
+
+struct Shape {
+    int id{};
+};
+
+class Movers : public Vulqian::Engine::ECS::System {};
+
+} // namespace
+
+TEST(BulkSpawnTest, CreateEntitiesThenAddComponents) {
+    for (auto mode : {Vulqian::Engine::ECS::StorageMode::SparseSet, Vulqian::Engine::ECS::StorageMode::Archetype}) {
+        Vulqian::Engine::ECS::Coordinator coordinator{};
+        coordinator.init(mode);
+        coordinator.register_component<Position>();
+        coordinator.register_component<Shape>();
+
+        auto movers = coordinator.register_system<Movers>();
+        coordinator.set_system_signature<Movers>(coordinator.signature_of<Position, Shape>());
+
+        auto entities = coordinator.create_entities(1000, Shape{3});
+        ASSERT_EQ(entities.size(), 1000u);
+        ASSERT_TRUE(movers->entities().empty());
+
+        std::vector<Position> positions{};
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            positions.push_back(Position{static_cast<float>(i)});
+        }
+        coordinator.add_components<Position>(entities, positions);
+
+        ASSERT_EQ(movers->entities().size(), 1000u);
+        ASSERT_EQ(coordinator.get_component<Shape>(entities[10]).id, 3);
+        ASSERT_FLOAT_EQ(coordinator.get_component<Position>(entities[999]).x, 999.f);
+    }
+}
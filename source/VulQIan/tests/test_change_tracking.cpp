@@ -0,0 +1,118 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+using Vulqian::Engine::ECS::Entity;
+using Vulqian::Engine::ECS::StorageMode;
+using Vulqian::Engine::ECS::Tick;
+
+struct Position {
+    float x{};
+};
+
+struct Velocity {
+    float dx{};
+};
+
+class ChangeTrackingTest : public ::testing::TestWithParam<StorageMode> {
+  protected:
+    void SetUp() override {
+        this->coordinator.init(GetParam());
+        this->coordinator.register_component<Position>();
+        this->coordinator.register_component<Velocity>();
+    }
+
+    // Entities visited by a changed<Position>(since) query
+    std::vector<Entity> changed_since(Tick since) {
+        std::vector<Entity> visited{};
+        this->coordinator.each<const Position>([&visited](Entity entity, Position const&) { visited.push_back(entity); },
+                                               Vulqian::Engine::ECS::changed<Position>(since));
+        return visited;
+    }
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+};
+
+TEST_P(ChangeTrackingTest, OnlyMutableAccessMarksChanged) {
+    const auto entities = this->coordinator.create_entities(3, Position{}, Velocity{});
+
+    Tick last_run = this->coordinator.advance_tick();
+    ASSERT_TRUE(this->changed_since(last_run).empty());
+
+    // Reading never stamps a change
+    this->coordinator.advance_tick();
+    [[maybe_unused]] auto const& read = this->coordinator.get_component<const Position>(entities[0]);
+    this->coordinator.each<const Position, const Velocity>([](Position const&, Velocity const&) {});
+    ASSERT_TRUE(this->changed_since(last_run).empty());
+
+    this->coordinator.get_component<Position>(entities[1]).x = 1.f;
+    this->coordinator.mark_changed<Position>(entities[2]);
+    ASSERT_EQ(this->changed_since(last_run), (std::vector<Entity>{entities[1], entities[2]}));
+
+    // A mutable query stamps everything it visits
+    last_run = this->coordinator.advance_tick();
+    this->coordinator.each<Position>([](Position& position) { position.x += 1.f; });
+    ASSERT_EQ(this->changed_since(last_run).size(), 3u);
+}
+
+TEST_P(ChangeTrackingTest, FilteredQueryOnlyStampsVisitedEntities) {
+    const auto entities = this->coordinator.create_entities(4, Position{}, Velocity{});
+    Tick       last_run = this->coordinator.advance_tick();
+
+    this->coordinator.get_component<Velocity>(entities[3]).dx = 2.f;
+
+    // Integrate only the entities whose velocity changed, the others keep their Position tick
+    const Tick since = last_run;
+    last_run = this->coordinator.advance_tick();
+
+    int integrated{};
+    this->coordinator.each<Position, const Velocity>(
+        [&integrated](Position& position, Velocity const& velocity) {
+            position.x += velocity.dx;
+            ++integrated;
+        },
+        Vulqian::Engine::ECS::changed<Velocity>(since));
+
+    ASSERT_EQ(integrated, 1);
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<const Position>(entities[3]).x, 2.f);
+    ASSERT_EQ(this->changed_since(last_run), (std::vector<Entity>{entities[3]}));
+
+    // Nothing changed Velocity since the last run
+    std::vector<Entity> moved{};
+    this->coordinator.each<const Velocity>([&moved](Entity entity, Velocity const&) { moved.push_back(entity); },
+                                           Vulqian::Engine::ECS::changed<Velocity>(last_run));
+    ASSERT_TRUE(moved.empty());
+}
+
+TEST_P(ChangeTrackingTest, AddedFilterAndTicksSurviveStructuralChanges) {
+    const Entity first = this->coordinator.create_entity();
+    this->coordinator.add_component(first, Position{});
+    const Tick last_run = this->coordinator.advance_tick();
+
+    const Entity second = this->coordinator.create_entity();
+    this->coordinator.add_component(second, Position{});
+
+    // Moving `first` to another archetype keeps the ticks of the components it already had
+    this->coordinator.add_component(first, Velocity{});
+
+    std::vector<Entity> added{};
+    this->coordinator.each<const Position>([&added](Entity entity, Position const&) { added.push_back(entity); },
+                                           Vulqian::Engine::ECS::added<Position>(last_run));
+
+    ASSERT_EQ(added, std::vector<Entity>{second});
+    ASSERT_GT(this->coordinator.get_ticks<Velocity>(first).added, last_run);
+    ASSERT_LE(this->coordinator.get_ticks<Position>(first).added, last_run);
+}
+
+INSTANTIATE_TEST_SUITE_P(StorageModes, ChangeTrackingTest, ::testing::Values(StorageMode::SparseSet, StorageMode::Archetype));
+
+} // namespace
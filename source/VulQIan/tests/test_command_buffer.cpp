@@ -0,0 +1,96 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+struct Position {
+    float x{};
+};
+
+struct Name {
+    std::shared_ptr<int> id{};
+};
+
+class Tracker : public Vulqian::Engine::ECS::System {};
+
+class CommandBufferTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        this->coordinator.init();
+        this->coordinator.register_component<Position>();
+        this->coordinator.register_component<Name>();
+
+        this->tracker = this->coordinator.register_system<Tracker>();
+        this->coordinator.set_system_signature<Tracker>(this->coordinator.signature_of<Position>());
+    }
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    std::shared_ptr<Tracker>          tracker{};
+};
+
+} // namespace
+
+TEST_F(CommandBufferTest, ChangesApplyOnlyOnFlush) {
+    auto existing = this->coordinator.create_entity();
+
+    Vulqian::Engine::ECS::CommandBuffer buffer{};
+    auto                                spawned = buffer.create_entity();
+    buffer.add_component(spawned, Position{4.f});
+    buffer.add_component(existing, Position{1.f});
+    buffer.add_component(existing, Position{2.f});
+
+    ASSERT_FALSE(this->coordinator.is_alive(spawned));
+    ASSERT_FALSE(this->coordinator.has_component<Position>(existing));
+
+    this->coordinator.flush(buffer);
+
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<Position>(existing).x, 2.f);
+    ASSERT_EQ(this->tracker->entities().size(), 2u);
+}
+
+TEST_F(CommandBufferTest, DestroyWinsAndReleasesPayloads) {
+    auto doomed = this->coordinator.create_entity();
+    this->coordinator.add_component(doomed, Position{});
+    auto id = std::make_shared<int>(1);
+
+    std::vector<Vulqian::Engine::ECS::CommandBuffer> buffers(2);
+    buffers[0].add_component(doomed, Name{id});
+    buffers[1].destroy_entity(doomed);
+    buffers[1].remove_component<Position>(doomed);
+
+    this->coordinator.flush(buffers);
+
+    ASSERT_FALSE(this->coordinator.is_alive(doomed));
+    ASSERT_TRUE(this->tracker->entities().empty());
+    ASSERT_EQ(id.use_count(), 1);
+}
+
+TEST_F(CommandBufferTest, MoveAssignmentReleasesOverwrittenPayloads) {
+    auto entity = this->coordinator.create_entity();
+    auto id = std::make_shared<int>(1);
+
+    Vulqian::Engine::ECS::CommandBuffer buffer{};
+    buffer.add_component(entity, Name{id});
+    ASSERT_EQ(id.use_count(), 2);
+
+    Vulqian::Engine::ECS::CommandBuffer other{};
+    other.add_component(entity, Position{3.f});
+    buffer = std::move(other);
+    ASSERT_EQ(id.use_count(), 1);
+
+    // The moved-from buffer can record again
+    other.add_component(entity, Position{1.f});
+
+    this->coordinator.flush(buffer);
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<Position>(entity).x, 3.f);
+}
@@ -0,0 +1,54 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include "ECS/Components/ComponentArray.hpp"
+
+using Vulqian::Engine::ECS::ComponentArray;
+using Vulqian::Engine::ECS::Entity;
+
+TEST(ComponentArrayTest, InsertAndGet) {
+    ComponentArray<int> array{};
+    array.insert_data(3, 30);
+    array.insert_data(7, 70);
+
+    ASSERT_EQ(array.size(), 2u);
+    ASSERT_TRUE(array.contains(3));
+    ASSERT_FALSE(array.contains(4));
+    ASSERT_EQ(array.get_data(3), 30);
+    ASSERT_EQ(array.get_data(7), 70);
+}
+
+TEST(ComponentArrayTest, RemoveKeepsArrayPacked) {
+    ComponentArray<int> array{};
+    for (Entity entity = 0; entity < 4; ++entity) {
+        array.insert_data(entity, static_cast<int>(entity) * 10);
+    }
+
+    array.remove_data(1);
+
+    ASSERT_EQ(array.size(), 3u);
+    ASSERT_FALSE(array.contains(1));
+    ASSERT_EQ(array.get_data(3), 30);
+
+    // Packed components stay parallel to the packed entities
+    for (std::size_t i = 0; i < array.size(); ++i) {
+        ASSERT_EQ(array.components()[i], static_cast<int>(array.entities()[i]) * 10);
+    }
+}
+
+TEST(ComponentArrayTest, GrowsPastFormerEntityCap) {
+    ComponentArray<int> array{};
+    const Entity        far_entity = 250'000;
+
+    array.insert_data(far_entity, 1);
+    array.insert_data(0, 2);
+    array.entity_destroyed(far_entity);
+    array.entity_destroyed(far_entity);
+
+    ASSERT_FALSE(array.contains(far_entity));
+    ASSERT_EQ(array.get_data(0), 2);
+}
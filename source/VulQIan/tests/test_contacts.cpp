@@ -0,0 +1,201 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Collision/NarrowPhase.hpp"
+#include "ECS/Coordinator/Coordinator.hpp"
+#include "ECS/Systems/Physics.hpp"
+
+namespace {
+
+using Vulqian::Engine::Collision::Manifold;
+using Vulqian::Engine::Collision::Shape;
+using Vulqian::Engine::Collision::ShapeType;
+using Vulqian::Engine::ECS::Entity;
+using Vulqian::Engine::ECS::Components::Collider;
+using Vulqian::Engine::ECS::Components::ColliderShape;
+using Vulqian::Engine::ECS::Components::RigidBody;
+using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+using Vulqian::Engine::ECS::Components::Velocity;
+using Vulqian::Engine::ECS::Systems::Physics;
+
+TEST(NarrowPhaseTest, SpheresTouchAlongTheirCenters) {
+    Shape a{};
+    a.type = ShapeType::Sphere;
+    Shape b = a;
+    b.center = {.8f, 0.f, 0.f};
+
+    Manifold manifold{};
+    ASSERT_TRUE(Vulqian::Engine::Collision::collide(a, b, manifold));
+    ASSERT_EQ(manifold.count, 1u);
+    ASSERT_NEAR(manifold.normal.x, 1.f, 1e-5f);
+    ASSERT_NEAR(manifold.points[0].penetration, .2f, 1e-5f);
+
+    b.center.x = 1.1f;
+    ASSERT_FALSE(Vulqian::Engine::Collision::collide(a, b, manifold));
+}
+
+TEST(NarrowPhaseTest, BoxOnBoxGivesFourPoints) {
+    Shape ground{};
+    ground.half_extents = {5.f, .5f, 5.f};
+    Shape box{};
+    box.center = {0.f, -.95f, 0.f};  // +Y down: resting on top of the ground, sunk by .05
+
+    Manifold manifold{};
+    ASSERT_TRUE(Vulqian::Engine::Collision::collide(ground, box, manifold));
+    ASSERT_EQ(manifold.count, 4u);
+    ASSERT_NEAR(manifold.normal.y, -1.f, 1e-5f);
+    for (std::uint32_t i = 0; i < manifold.count; ++i) {
+        ASSERT_NEAR(manifold.points[i].penetration, .05f, 1e-4f);
+        ASSERT_NEAR(std::abs(manifold.points[i].position.x), .5f, 1e-4f);
+        ASSERT_NEAR(std::abs(manifold.points[i].position.z), .5f, 1e-4f);
+    }
+}
+
+class ContactTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        this->coordinator.init();
+        this->coordinator.register_component<Transform_TB_YXZ>();
+        this->coordinator.register_component<RigidBody>();
+        this->coordinator.register_component<Velocity>();
+        this->coordinator.register_component<Collider>();
+
+        this->physics = this->coordinator.register_system<Physics>();
+        this->coordinator.set_system_signature<Physics>(this->coordinator.signature_of<Transform_TB_YXZ, RigidBody, Velocity>());
+        this->physics->solve_contacts = true;
+    }
+
+    Entity spawn(glm::vec3 position, Collider collider, float inverse_mass = 1.f) {
+        RigidBody body{};
+        body.inverse_mass = inverse_mass;
+        body.inverse_inertia = glm::vec3{6.f * inverse_mass};  // unit cube
+
+        const Entity entity = this->coordinator.create_entity();
+        this->coordinator.add_component(entity, Transform_TB_YXZ{position, glm::vec3{1.f}, glm::vec3{0.f}});
+        this->coordinator.add_component(entity, body);
+        this->coordinator.add_component(entity, Velocity{});
+        this->coordinator.add_component(entity, collider);
+        return entity;
+    }
+
+    // A static floor whose top is at y = 0, and a column of unit boxes above it starting at x
+    std::vector<Entity> stack(float x, int height) {
+        std::vector<Entity> boxes{};
+        for (int level = 0; level < height; ++level) {
+            boxes.push_back(this->spawn({x, -.5f - static_cast<float>(level), 0.f}, Collider{}));
+        }
+        return boxes;
+    }
+
+    void floor() {
+        Collider ground{};
+        ground.half_extents = {50.f, .5f, 50.f};
+        this->spawn({0.f, .5f, 0.f}, ground, 0.f);
+    }
+
+    glm::vec3 position(Entity entity) {
+        return this->coordinator.get_component<const Transform_TB_YXZ>(entity).translation;
+    }
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    std::shared_ptr<Physics>          physics{};
+};
+
+TEST_F(ContactTest, StackSettlesThenSleeps) {
+    this->floor();
+    const auto boxes = this->stack(0.f, 3);
+
+    for (int frame = 0; frame < 120; ++frame) {
+        this->physics->step(this->coordinator);
+    }
+
+    // Resting on each other within the slop, not sunk nor fallen through
+    for (std::size_t level = 0; level < boxes.size(); ++level) {
+        ASSERT_NEAR(this->position(boxes[level]).y, -.5f - static_cast<float>(level), .02f);
+        ASSERT_NEAR(this->position(boxes[level]).x, 0.f, .01f);
+    }
+    for (const Entity box : boxes) {
+        ASSERT_TRUE(this->coordinator.get_component<const RigidBody>(box).sleeping);
+    }
+
+    auto const& stats = this->physics->get_stats();
+    ASSERT_EQ(stats.awake_bodies, 0u);
+    ASSERT_EQ(stats.sleeping_bodies, 3u);
+    ASSERT_EQ(stats.contacts, 0u);
+
+    // A sleeping body is left untouched, until a force wakes its island up
+    const glm::vec3 rest = this->position(boxes.back());
+    this->physics->step(this->coordinator);
+    ASSERT_EQ(this->position(boxes.back()), rest);
+
+    this->coordinator.get_component<RigidBody>(boxes.back()).force = {200.f, 0.f, 0.f};
+    this->physics->step(this->coordinator);
+    ASSERT_GT(this->position(boxes.back()).x, rest.x);
+    ASSERT_FALSE(this->coordinator.get_component<const RigidBody>(boxes.back()).sleeping);
+    ASSERT_GE(this->physics->get_stats().awake_bodies, 2u);
+}
+
+TEST_F(ContactTest, StatsCountIslandsAndContacts) {
+    this->floor();
+    this->stack(0.f, 2);
+    this->stack(4.f, 2);
+    Collider ball{};
+    ball.shape = ColliderShape::Sphere;
+    this->spawn({-4.f, -10.f, 0.f}, ball);
+
+    this->physics->step(this->coordinator);
+
+    // Two stacks and a falling sphere, each box touching the one below it
+    auto const& stats = this->physics->get_stats();
+    ASSERT_EQ(stats.awake_bodies, 5u);
+    ASSERT_EQ(stats.islands, 3u);
+    ASSERT_EQ(stats.contacts, 4u);
+    ASSERT_EQ(stats.contact_points, 16u);
+    ASSERT_EQ(stats.solver_iterations, 2u * this->physics->solver.velocity_iterations);
+}
+
+TEST_F(ContactTest, ParallelIslandsMatchSerial) {
+    Vulqian::Engine::Jobs::ThreadPool pool{4};
+
+    this->floor();
+    for (int column = 0; column < 40; ++column) {
+        this->stack(static_cast<float>(column) * 2.f, 4);
+    }
+
+    Vulqian::Engine::ECS::Coordinator reference{};
+    reference.init();
+    reference.register_component<Transform_TB_YXZ>();
+    reference.register_component<RigidBody>();
+    reference.register_component<Velocity>();
+    reference.register_component<Collider>();
+    auto serial = reference.register_system<Physics>();
+    reference.set_system_signature<Physics>(reference.signature_of<Transform_TB_YXZ, RigidBody, Velocity>());
+    serial->solve_contacts = true;
+    for (auto const entity : this->physics->entities()) {
+        const Entity copy = reference.create_entity();
+        reference.add_component(copy, this->coordinator.get_component<const Transform_TB_YXZ>(entity));
+        reference.add_component(copy, this->coordinator.get_component<const RigidBody>(entity));
+        reference.add_component(copy, this->coordinator.get_component<const Velocity>(entity));
+        reference.add_component(copy, this->coordinator.get_component<const Collider>(entity));
+    }
+
+    this->coordinator.set_thread_pool(&pool);
+    this->physics->grain = 16;
+    for (int frame = 0; frame < 30; ++frame) {
+        this->physics->step(this->coordinator);
+        serial->step(reference);
+    }
+
+    ASSERT_EQ(this->physics->get_stats().islands, serial->get_stats().islands);
+    for (std::size_t i = 0; i < this->physics->entities().size(); ++i) {
+        ASSERT_EQ(this->position(this->physics->entities()[i]), reference.get_component<const Transform_TB_YXZ>(serial->entities()[i]).translation);
+    }
+}
+
+} // namespace
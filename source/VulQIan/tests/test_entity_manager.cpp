@@ -0,0 +1,49 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+struct Position {
+    float x{};
+};
+
+} // namespace
+
+TEST(EntityManagerTest, RecycledIndexGetsNewVersion) {
+    Vulqian::Engine::ECS::EntityManager manager{};
+
+    auto first = manager.create_entity();
+    manager.destroy_entity(first);
+    auto second = manager.create_entity();
+
+    ASSERT_EQ(Vulqian::Engine::ECS::entity_index(first), Vulqian::Engine::ECS::entity_index(second));
+    ASSERT_NE(first, second);
+    ASSERT_FALSE(manager.is_alive(first));
+    ASSERT_TRUE(manager.is_alive(second));
+    ASSERT_FALSE(manager.is_alive(Vulqian::Engine::ECS::NULL_ENTITY));
+}
+
+TEST(EntityManagerTest, StaleHandleDoesNotSeeNewComponents) {
+    for (auto mode : {Vulqian::Engine::ECS::StorageMode::SparseSet, Vulqian::Engine::ECS::StorageMode::Archetype}) {
+        Vulqian::Engine::ECS::Coordinator coordinator{};
+        coordinator.init(mode);
+        coordinator.register_component<Position>();
+
+        auto stale = coordinator.create_entity();
+        coordinator.add_component(stale, Position{1.f});
+        coordinator.destroy_entity(stale);
+
+        auto fresh = coordinator.create_entity();
+        coordinator.add_component(fresh, Position{2.f});
+
+        ASSERT_FALSE(coordinator.is_alive(stale));
+        ASSERT_FALSE(coordinator.has_component<Position>(stale));
+        ASSERT_TRUE(coordinator.has_component<Position>(fresh));
+    }
+}
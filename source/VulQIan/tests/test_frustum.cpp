@@ -0,0 +1,95 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Graphics/Camera/Camera.hpp"
+#include "Math/Frustum.hpp"
+
+namespace {
+
+using Vulqian::Engine::Math::BoundingBox;
+using Vulqian::Engine::Math::BoundingSphere;
+using Vulqian::Engine::Math::Frustum;
+
+// 90 degrees wide, looking along +Z from the origin, depth from 1 to 100
+Frustum camera_frustum() {
+    Vulqian::Engine::Graphics::Camera camera{};
+    camera.set_perspective_projection(glm::radians(90.f), 1.f, 1.f, 100.f);
+    camera.set_view_direction(glm::vec3{0.f}, glm::vec3{0.f, 0.f, 1.f});
+    return camera.get_frustum();
+}
+
+TEST(FrustumTest, SpheresAgainstEveryPlane) {
+    const Frustum frustum = camera_frustum();
+
+    ASSERT_TRUE(frustum.intersects(BoundingSphere{{0.f, 0.f, 10.f}, 1.f}));
+    ASSERT_TRUE(frustum.intersects(BoundingSphere{{0.f, 0.f, .5f}, 1.f}));      // across the near plane
+    ASSERT_TRUE(frustum.intersects(BoundingSphere{{10.5f, 0.f, 10.f}, 1.f}));  // across the right plane
+
+    ASSERT_FALSE(frustum.intersects(BoundingSphere{{0.f, 0.f, -5.f}, 1.f}));  // behind
+    ASSERT_FALSE(frustum.intersects(BoundingSphere{{0.f, 0.f, 102.f}, 1.f}));
+    ASSERT_FALSE(frustum.intersects(BoundingSphere{{-20.f, 0.f, 10.f}, 1.f}));
+    ASSERT_FALSE(frustum.intersects(BoundingSphere{{20.f, 0.f, 10.f}, 1.f}));
+    ASSERT_FALSE(frustum.intersects(BoundingSphere{{0.f, -20.f, 10.f}, 1.f}));
+    ASSERT_FALSE(frustum.intersects(BoundingSphere{{0.f, 20.f, 10.f}, 1.f}));
+}
+
+TEST(FrustumTest, BoxesFollowTheirTransform) {
+    const Frustum     frustum = camera_frustum();
+    const BoundingBox unit{glm::vec3{-.5f}, glm::vec3{.5f}};
+
+    ASSERT_TRUE(frustum.intersects(BoundingBox{{-.5f, -.5f, 9.5f}, {.5f, .5f, 10.5f}}));
+    ASSERT_FALSE(frustum.intersects(unit));  // around the eye, in front of the near plane
+
+    // Moved then scaled into view, and moved out of it
+    glm::mat4 matrix{1.f};
+    matrix[3] = glm::vec4{0.f, 0.f, 10.f, 1.f};
+    ASSERT_TRUE(frustum.intersects(Vulqian::Engine::Math::transform_box(unit, matrix)));
+    matrix[3].x = -30.f;
+    ASSERT_FALSE(frustum.intersects(Vulqian::Engine::Math::transform_box(unit, matrix)));
+    matrix[0].x = 50.f;
+    ASSERT_TRUE(frustum.intersects(Vulqian::Engine::Math::transform_box(unit, matrix)));
+
+    const BoundingSphere sphere = Vulqian::Engine::Math::transform_sphere(BoundingSphere{{}, 1.f}, matrix);
+    ASSERT_FLOAT_EQ(sphere.radius, 50.f);
+    ASSERT_FLOAT_EQ(sphere.center.x, -30.f);
+}
+
+TEST(FrustumTest, BatchMatchesSingleTests) {
+    const Frustum frustum = camera_frustum();
+
+    // Not a multiple of 4, so the scalar tail runs too
+    constexpr std::size_t                 count = 1003;
+    std::mt19937                          random{7};
+    std::uniform_real_distribution<float> position{-120.f, 120.f};
+    std::uniform_real_distribution<float> size{0.f, 8.f};
+    std::vector<float>                    x(count), y(count), z(count), radius(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] = position(random);
+        y[i] = position(random);
+        z[i] = position(random);
+        radius[i] = size(random);
+    }
+
+    std::vector<std::uint8_t> visible(count, 2);
+    const std::size_t         visible_count = Vulqian::Engine::Math::cull_spheres(frustum, {x.data(), y.data(), z.data(), radius.data(), count}, visible.data());
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const bool inside = frustum.intersects(BoundingSphere{{x[i], y[i], z[i]}, radius[i]});
+        ASSERT_EQ(visible[i], inside ? 1u : 0u) << "sphere " << i;
+        expected += inside;
+    }
+    ASSERT_EQ(visible_count, expected);
+    ASSERT_GT(visible_count, 0u);
+    ASSERT_LT(visible_count, count);
+}
+
+} // namespace
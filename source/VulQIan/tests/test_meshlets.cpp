@@ -0,0 +1,207 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "Math/Meshlets.hpp"
+
+namespace {
+
+using Vulqian::Engine::Math::IndexRange;
+using Vulqian::Engine::Math::Meshlet;
+
+struct TestMesh {
+    std::vector<glm::vec3>     positions{};
+    std::vector<glm::vec3>     normals{};
+    std::vector<std::uint32_t> indices{};
+};
+
+// Unit sphere of rings x segments quads, normals pointing out
+TestMesh sphere(std::uint32_t rings, std::uint32_t segments) {
+    TestMesh mesh{};
+    for (std::uint32_t ring = 0; ring <= rings; ++ring) {
+        const float theta = 3.14159265f * static_cast<float>(ring) / static_cast<float>(rings);
+        for (std::uint32_t segment = 0; segment < segments; ++segment) {
+            const float phi = 6.2831853f * static_cast<float>(segment) / static_cast<float>(segments);
+            mesh.positions.push_back({std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            mesh.normals.push_back(mesh.positions.back());
+        }
+    }
+    for (std::uint32_t ring = 0; ring < rings; ++ring) {
+        for (std::uint32_t segment = 0; segment < segments; ++segment) {
+            const std::uint32_t a = ring * segments + segment;
+            const std::uint32_t b = ring * segments + (segment + 1) % segments;
+            mesh.indices.insert(mesh.indices.end(), {a, b, b + segments, a, b + segments, a + segments});
+        }
+    }
+    return mesh;
+}
+
+// Normal of a triangle turned outward, as the sphere's vertex normals are
+glm::vec3 outward_normal(TestMesh const& mesh, std::span<const std::uint32_t> triangle) {
+    const glm::vec3 a = mesh.positions[triangle[0]], b = mesh.positions[triangle[1]], c = mesh.positions[triangle[2]];
+    const glm::vec3 normal = glm::cross(b - a, c - a);
+    return glm::dot(normal, a + b + c) < 0.f ? -normal : normal;
+}
+
+TEST(MeshletsTest, MeshletsStayWithinTheLimitsAndKeepEveryTriangle) {
+    const TestMesh mesh = sphere(48, 64);
+    const auto     clustered = Vulqian::Engine::Math::build_meshlets(mesh.positions, mesh.normals, mesh.indices);
+    ASSERT_EQ(clustered.indices.size(), mesh.indices.size());
+
+    // Contiguous ranges covering the reordered indices, each within both limits
+    std::uint32_t next = 0;
+    for (Meshlet const& meshlet : clustered.meshlets) {
+        ASSERT_EQ(meshlet.first_index, next);
+        ASSERT_EQ(meshlet.index_count % 3, 0u);
+        ASSERT_GT(meshlet.index_count, 0u);
+        ASSERT_LE(meshlet.index_count / 3, Vulqian::Engine::Math::MAX_MESHLET_TRIANGLES);
+        const std::set<std::uint32_t> vertices(clustered.indices.begin() + meshlet.first_index, clustered.indices.begin() + meshlet.first_index + meshlet.index_count);
+        ASSERT_LE(vertices.size(), Vulqian::Engine::Math::MAX_MESHLET_VERTICES);
+        next += meshlet.index_count;
+    }
+    ASSERT_EQ(next, clustered.indices.size());
+
+    // Full enough not to waste draws: on a regular grid a meshlet of 64 vertices holds about 90 triangles
+    ASSERT_LT(clustered.meshlets.size(), mesh.indices.size() / 3 / 60);
+
+    // The same triangles, winding included
+    auto triangles = [](std::vector<std::uint32_t> const& indices) {
+        std::multiset<std::array<std::uint32_t, 3>> set{};
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+            std::array<std::uint32_t, 3> triangle{indices[i], indices[i + 1], indices[i + 2]};
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            set.insert(triangle);
+        }
+        return set;
+    };
+    ASSERT_EQ(triangles(clustered.indices), triangles(mesh.indices));
+}
+
+TEST(MeshletsTest, BoundsHoldTheirTriangles) {
+    // Flat shaded: every triangle with its own vertices, clustered through their shared positions
+    const TestMesh smooth = sphere(16, 24);
+    TestMesh       flat{};
+    for (std::size_t i = 0; i < smooth.indices.size(); i += 3) {
+        const glm::vec3 normal = glm::normalize(outward_normal(smooth, std::span<const std::uint32_t>{smooth.indices}.subspan(i, 3)));
+        for (std::size_t k = 0; k < 3; ++k) {
+            flat.indices.push_back(static_cast<std::uint32_t>(flat.positions.size()));
+            flat.positions.push_back(smooth.positions[smooth.indices[i + k]]);
+            flat.normals.push_back(normal);
+        }
+    }
+
+    const auto clustered = Vulqian::Engine::Math::build_meshlets(flat.positions, flat.normals, flat.indices);
+    ASSERT_LT(clustered.meshlets.size(), flat.indices.size() / 3 / 15);  // 3 vertices a triangle, at least 21 a meshlet
+    for (Meshlet const& meshlet : clustered.meshlets) {
+        for (std::uint32_t i = meshlet.first_index; i < meshlet.first_index + meshlet.index_count; ++i) {
+            ASSERT_LE(glm::length(flat.positions[clustered.indices[i]] - meshlet.sphere.center), meshlet.sphere.radius * 1.0001f);
+        }
+        // A few triangles of a sphere face about the same way
+        ASSERT_LT(meshlet.cone_cutoff, 1.f);
+        ASSERT_NEAR(glm::length(meshlet.cone_axis), 1.f, 1e-4f);
+    }
+}
+
+TEST(MeshletsTest, ConesOnlyCullClustersFacingAway) {
+    const TestMesh mesh = sphere(48, 64);
+    const auto     clustered = Vulqian::Engine::Math::build_meshlets(mesh.positions, mesh.normals, mesh.indices);
+
+    // Planes of zero never cull, only the cones do. Non-uniform scales change the angles, the cones are tested in the mesh's space.
+    const Vulqian::Engine::Math::Frustum everything{};
+    for (glm::vec3 const scale : {glm::vec3{1.f}, glm::vec3{3.f, 1.5f, 3.f}}) {
+        glm::mat4 world{1.f};
+        world[0].x = scale.x, world[1].y = scale.y, world[2].z = scale.z;
+        world[3] = glm::vec4{2.f, -1.f, 4.f, 1.f};
+        const glm::mat4 normal_matrix{glm::transpose(glm::inverse(glm::mat3{world}))};
+
+        for (glm::vec3 const camera : {glm::vec3{2.f, -1.f, -4.f}, glm::vec3{12.f, 3.f, 4.f}, glm::vec3{2.f, -1.f, 5.2f}}) {
+            std::vector<IndexRange> ranges{};
+            const std::size_t       visible = Vulqian::Engine::Math::cull_meshlets(clustered.meshlets, world, normal_matrix, everything, camera, true, ranges);
+            ASSERT_LT(visible, clustered.meshlets.size() * 3 / 4);
+
+            // Every triangle left out faces away from the camera
+            std::vector<bool> drawn(clustered.indices.size() / 3);
+            for (IndexRange const& range : ranges) {
+                std::fill(drawn.begin() + range.first_index / 3, drawn.begin() + (range.first_index + range.index_count) / 3, true);
+            }
+            for (std::size_t t = 0; t < drawn.size(); ++t) {
+                if (!drawn[t]) {
+                    const auto      triangle = std::span<const std::uint32_t>{clustered.indices}.subspan(3 * t, 3);
+                    const glm::vec3 corner = glm::vec3{world * glm::vec4{mesh.positions[triangle[0]], 1.f}};
+                    const glm::vec3 normal = glm::mat3{normal_matrix} * outward_normal(mesh, triangle);
+                    ASSERT_GE(glm::dot(corner - camera, normal), -1e-4f) << "triangle " << t;
+                }
+            }
+        }
+    }
+
+    // Without the cones everything is drawn, in the one range
+    std::vector<IndexRange> ranges{};
+    ASSERT_EQ(Vulqian::Engine::Math::cull_meshlets(clustered.meshlets, glm::mat4{1.f}, glm::mat4{1.f}, everything, glm::vec3{0.f, 0.f, 5.f}, false, ranges), clustered.meshlets.size());
+    ASSERT_EQ(ranges.size(), 1u);
+    ASSERT_EQ(ranges[0].first_index, 0u);
+    ASSERT_EQ(ranges[0].index_count, clustered.indices.size());
+}
+
+TEST(MeshletsTest, FrustumKeepsTheClustersItTouches) {
+    // 64 x 64 quads in the y = 0 plane, from x = 0 to 64
+    TestMesh mesh{};
+    for (std::uint32_t z = 0; z <= 64; ++z) {
+        for (std::uint32_t x = 0; x <= 64; ++x) {
+            mesh.positions.push_back({static_cast<float>(x), 0.f, static_cast<float>(z)});
+        }
+    }
+    for (std::uint32_t z = 0; z < 64; ++z) {
+        for (std::uint32_t x = 0; x < 64; ++x) {
+            const std::uint32_t a = z * 65 + x;
+            mesh.indices.insert(mesh.indices.end(), {a, a + 65, a + 1, a + 1, a + 65, a + 66});
+        }
+    }
+    const auto clustered = Vulqian::Engine::Math::build_meshlets(mesh.positions, {}, mesh.indices);
+
+    // Only the x <= 16 side: a meshlet reaching it is kept, one entirely past it is not
+    Vulqian::Engine::Math::Frustum frustum{};
+    frustum.planes[0] = glm::vec4{-1.f, 0.f, 0.f, 16.f};
+    std::vector<IndexRange> ranges{{7, 7}};  // left by a previous mesh, never merged with
+    const std::size_t       visible = Vulqian::Engine::Math::cull_meshlets(clustered.meshlets, glm::mat4{1.f}, glm::mat4{1.f}, frustum, glm::vec3{0.f, 10.f, 0.f}, false, ranges);
+    ASSERT_GT(visible, 0u);
+    ASSERT_LT(visible, clustered.meshlets.size() / 2);
+    ASSERT_EQ(ranges[0].first_index, 7u);
+    ASSERT_EQ(ranges[0].index_count, 7u);
+
+    std::size_t kept = 0;
+    for (Meshlet const& meshlet : clustered.meshlets) {
+        const bool inside = std::any_of(ranges.begin() + 1, ranges.end(), [&meshlet](IndexRange const& range) {
+            return meshlet.first_index >= range.first_index && meshlet.first_index < range.first_index + range.index_count;
+        });
+        float nearest = 64.f;
+        for (std::uint32_t i = meshlet.first_index; i < meshlet.first_index + meshlet.index_count; ++i) {
+            nearest = std::min(nearest, mesh.positions[clustered.indices[i]].x);
+        }
+        if (nearest <= 16.f) {
+            ASSERT_TRUE(inside) << meshlet.first_index;
+        }
+        if (meshlet.sphere.center.x - meshlet.sphere.radius > 16.f) {
+            ASSERT_FALSE(inside) << meshlet.first_index;
+        }
+        kept += inside;
+    }
+    ASSERT_EQ(kept, visible);
+
+    // Ranges are disjoint and merged: no two of them follow each other
+    for (std::size_t i = 2; i < ranges.size(); ++i) {
+        ASSERT_GT(ranges[i].first_index, ranges[i - 1].first_index + ranges[i - 1].index_count);
+    }
+}
+
+} // namespace
@@ -0,0 +1,114 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+using Vulqian::Engine::ECS::Entity;
+
+struct Position {
+    float x{};
+};
+
+struct Velocity {
+    float dx{};
+};
+
+struct Tag {};
+
+class Movement : public Vulqian::Engine::ECS::System {};
+class Tagged : public Vulqian::Engine::ECS::System {};
+
+class ObserverTest : public ::testing::TestWithParam<Vulqian::Engine::ECS::StorageMode> {
+  protected:
+    void SetUp() override {
+        this->coordinator.init(GetParam());
+        this->coordinator.register_component<Position>();
+        this->coordinator.register_component<Velocity>();
+        this->coordinator.register_component<Tag>();
+    }
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+};
+
+TEST_P(ObserverTest, AddAndRemoveReachOnlyTheirComponent) {
+    std::vector<float> added{};
+    std::vector<Entity> removed{};
+    this->coordinator.on_add<Position>([&added](Entity, Position const& position) { added.push_back(position.x); });
+    this->coordinator.on_remove<Position>([&removed](Entity entity) { removed.push_back(entity); });
+
+    const Entity first = this->coordinator.create_entity();
+    this->coordinator.add_component(first, Position{1.f});
+    this->coordinator.add_component(first, Velocity{});
+
+    const auto batch = this->coordinator.create_entities(2, Position{2.f});
+
+    Vulqian::Engine::ECS::CommandBuffer commands{};
+    const Entity deferred = commands.create_entity();
+    commands.add_component(deferred, Position{3.f});
+    commands.destroy_entity(batch[0]);
+    this->coordinator.flush(commands);
+
+    this->coordinator.remove_component<Velocity>(first);
+    this->coordinator.remove_component<Position>(first);
+
+    ASSERT_EQ(added, (std::vector<float>{1.f, 2.f, 2.f, 3.f}));
+    ASSERT_EQ(removed, (std::vector<Entity>{batch[0], first}));
+}
+
+TEST_P(ObserverTest, ChangesAreReportedOncePerDispatch) {
+    std::vector<Entity> changed{};
+    this->coordinator.on_change<Position>([&changed](Entity entity) { changed.push_back(entity); });
+
+    const auto entities = this->coordinator.create_entities(3, Position{}, Velocity{});
+
+    // Freshly added components are not reported as changed
+    this->coordinator.dispatch_changes();
+    ASSERT_TRUE(changed.empty());
+
+    this->coordinator.get_component<Position>(entities[2]).x = 1.f;
+    this->coordinator.get_component<Position>(entities[2]).x = 2.f;
+    this->coordinator.get_component<Velocity>(entities[0]).dx = 1.f;
+    this->coordinator.dispatch_changes();
+    ASSERT_EQ(changed, std::vector<Entity>{entities[2]});
+
+    changed.clear();
+    this->coordinator.dispatch_changes();
+    ASSERT_TRUE(changed.empty());
+}
+
+TEST_P(ObserverTest, SystemsOnlyFollowTheirComponents) {
+    auto movement = this->coordinator.register_system<Movement>();
+    auto tagged = this->coordinator.register_system<Tagged>();
+    this->coordinator.set_system_signature<Movement>(this->coordinator.signature_of<Position, Velocity>());
+    this->coordinator.set_system_signature<Tagged>(this->coordinator.signature_of<Tag>());
+
+    const Entity entity = this->coordinator.create_entity();
+    this->coordinator.add_component(entity, Position{});
+    this->coordinator.add_component(entity, Tag{});
+    ASSERT_FALSE(movement->contains(entity));
+    ASSERT_TRUE(tagged->contains(entity));
+
+    this->coordinator.add_component(entity, Velocity{});
+    ASSERT_TRUE(movement->contains(entity));
+    ASSERT_TRUE(tagged->contains(entity));
+
+    this->coordinator.remove_component<Tag>(entity);
+    ASSERT_TRUE(movement->contains(entity));
+    ASSERT_FALSE(tagged->contains(entity));
+
+    this->coordinator.destroy_entity(entity);
+    ASSERT_TRUE(movement->entities().empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(StorageModes, ObserverTest,
+                         ::testing::Values(Vulqian::Engine::ECS::StorageMode::SparseSet, Vulqian::Engine::ECS::StorageMode::Archetype));
+
+} // namespace
@@ -0,0 +1,148 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Graphics/Camera/Camera.hpp"
+#include "Math/OcclusionBuffer.hpp"
+
+namespace {
+
+using Vulqian::Engine::Math::BoundingBox;
+using Vulqian::Engine::Math::OcclusionBuffer;
+
+// 90 degrees wide, looking along +Z from the origin, depth from 1 to 100
+glm::mat4 camera_view_projection() {
+    Vulqian::Engine::Graphics::Camera camera{};
+    camera.set_perspective_projection(glm::radians(90.f), 1.f, 1.f, 100.f);
+    camera.set_view_direction(glm::vec3{0.f}, glm::vec3{0.f, 0.f, 1.f});
+    return camera.get_projection() * camera.get_view();
+}
+
+const std::vector<glm::vec3>     quad_positions{{-1.f, -1.f, 0.f}, {1.f, -1.f, 0.f}, {1.f, 1.f, 0.f}, {-1.f, 1.f, 0.f}};
+const std::vector<std::uint32_t> quad_indices{0, 1, 2, 0, 2, 3};
+
+BoundingBox box_at(glm::vec3 center, float half_size) {
+    return BoundingBox{center - glm::vec3{half_size}, center + glm::vec3{half_size}};
+}
+
+TEST(OcclusionTest, WallHidesOnlyWhatIsBehindIt) {
+    OcclusionBuffer buffer{64, 64};
+    buffer.begin(camera_view_projection());
+
+    // 10 x 10 facing the camera 10 away, half the screen wide
+    glm::mat4 wall{1.f};
+    wall[0].x = 5.f;
+    wall[1].y = 5.f;
+    wall[3] = glm::vec4{0.f, 0.f, 10.f, 1.f};
+    buffer.add_occluder(quad_positions, quad_indices, wall);
+    buffer.rasterize();
+    ASSERT_EQ(buffer.get_triangle_count(), 2u);
+    ASSERT_LT(buffer.depth_at(32, 32), 1.f);
+    ASSERT_EQ(buffer.depth_at(2, 2), 1.f);
+
+    ASSERT_FALSE(buffer.is_visible(box_at({0.f, 0.f, 20.f}, 1.f)));
+    ASSERT_FALSE(buffer.is_visible(box_at({3.f, -3.f, 50.f}, 4.f)));
+    ASSERT_TRUE(buffer.is_visible(box_at({0.f, 0.f, 5.f}, 1.f)));     // in front
+    ASSERT_TRUE(buffer.is_visible(box_at({15.f, 0.f, 20.f}, 1.f)));   // beside
+    ASSERT_TRUE(buffer.is_visible(box_at({10.f, 0.f, 20.f}, 2.f)));   // partly behind
+    ASSERT_TRUE(buffer.is_visible(box_at({0.f, 0.f, 10.f}, 1.f)));    // through it
+    ASSERT_TRUE(buffer.is_visible(box_at({0.f, 0.f, -20.f}, 1.f)));   // behind the camera, left to the frustum
+    ASSERT_TRUE(buffer.is_visible(box_at({0.f, 0.f, .5f}, 1.f)));     // across the near plane
+
+    // Nothing is hidden once the occluders are dropped
+    buffer.begin(camera_view_projection());
+    buffer.rasterize();
+    ASSERT_TRUE(buffer.is_visible(box_at({0.f, 0.f, 20.f}, 1.f)));
+}
+
+TEST(OcclusionTest, OccludersCrossingTheNearPlaneAreClipped) {
+    OcclusionBuffer buffer{64, 64};
+    buffer.begin(camera_view_projection());
+
+    // Leaning from behind the camera at the bottom to far away at the top, 17.5 away in the middle
+    const std::vector<glm::vec3> slope{{-50.f, 50.f, -5.f}, {50.f, 50.f, -5.f}, {50.f, -50.f, 40.f}, {-50.f, -50.f, 40.f}};
+    buffer.add_occluder(slope, quad_indices, glm::mat4{1.f});
+    buffer.rasterize();
+    ASSERT_GE(buffer.get_triangle_count(), 2u);
+
+    for (std::uint32_t y = 0; y < buffer.get_height(); ++y) {
+        for (std::uint32_t x = 0; x < buffer.get_width(); ++x) {
+            ASSERT_GE(buffer.depth_at(x, y), 0.f) << x << ", " << y;
+            ASSERT_LT(buffer.depth_at(x, y), 1.f) << x << ", " << y;
+        }
+    }
+    ASSERT_FALSE(buffer.is_visible(box_at({0.f, 0.f, 60.f}, 2.f)));
+    ASSERT_TRUE(buffer.is_visible(box_at({0.f, 0.f, 8.f}, 2.f)));
+}
+
+TEST(OcclusionTest, ParallelBandsMatchInline) {
+    std::mt19937                          random{11};
+    std::uniform_real_distribution<float> position{-20.f, 20.f};
+    std::uniform_real_distribution<float> distance{-5.f, 60.f};
+    std::vector<glm::vec3>                triangles(3 * 500);
+    for (auto& corner : triangles) {
+        corner = {position(random), position(random), distance(random)};
+    }
+
+    // Not a whole number of tiles, rounded up
+    OcclusionBuffer inline_buffer{100, 60};
+    OcclusionBuffer pooled_buffer{100, 60};
+    ASSERT_EQ(inline_buffer.get_width(), 104u);
+    ASSERT_EQ(inline_buffer.get_height(), 64u);
+
+    Vulqian::Engine::Jobs::ThreadPool pool{4};
+    inline_buffer.begin(camera_view_projection());
+    inline_buffer.add_occluder(triangles, {}, glm::mat4{1.f});
+    inline_buffer.rasterize();
+    pooled_buffer.begin(camera_view_projection());
+    pooled_buffer.add_occluder(triangles, {}, glm::mat4{1.f});
+    pooled_buffer.rasterize(&pool);
+
+    for (std::uint32_t y = 0; y < inline_buffer.get_height(); ++y) {
+        for (std::uint32_t x = 0; x < inline_buffer.get_width(); ++x) {
+            ASSERT_EQ(inline_buffer.depth_at(x, y), pooled_buffer.depth_at(x, y)) << x << ", " << y;
+        }
+    }
+}
+
+TEST(OcclusionTest, DumpsAsPgm) {
+    OcclusionBuffer buffer{32, 16};
+    buffer.begin(camera_view_projection());
+    glm::mat4 wall{1.f};
+    wall[3] = glm::vec4{0.f, 0.f, 5.f, 1.f};
+    buffer.add_occluder(quad_positions, quad_indices, wall);
+    buffer.rasterize();
+
+    const std::string path = ::testing::TempDir() + "occlusion_test.pgm";
+    ASSERT_TRUE(buffer.write_pgm(path));
+
+    std::ifstream file{path, std::ios::binary};
+    std::string   magic;
+    int           width = 0, height = 0, levels = 0;
+    file >> magic >> width >> height >> levels;
+    file.get();
+    ASSERT_EQ(magic, "P5");
+    ASSERT_EQ(width, 32);
+    ASSERT_EQ(height, 16);
+    ASSERT_EQ(levels, 255);
+
+    std::vector<char> pixels(32 * 16);
+    file.read(pixels.data(), static_cast<std::streamsize>(pixels.size()));
+    ASSERT_EQ(file.gcount(), static_cast<std::streamsize>(pixels.size()));
+    ASSERT_EQ(static_cast<unsigned char>(pixels[8 * 32 + 16]), 255u);  // the wall, nearest
+    ASSERT_EQ(static_cast<unsigned char>(pixels[0]), 0u);              // nothing
+    file.close();
+    std::remove(path.c_str());
+}
+
+} // namespace
@@ -0,0 +1,78 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+struct Position {
+    float x{};
+};
+
+struct Velocity {
+    float dx{};
+};
+
+struct Bounds {
+    float min{1e30f};
+    float max{-1e30f};
+    float sum{};
+};
+
+} // namespace
+
+TEST(ParallelEachTest, MatchesSerialResultsInBothStorages) {
+    constexpr int count = 20000;
+
+    for (auto mode : {Vulqian::Engine::ECS::StorageMode::SparseSet, Vulqian::Engine::ECS::StorageMode::Archetype}) {
+        float reference_sum{};
+
+        for (std::size_t threads : {0u, 3u}) {
+            Vulqian::Engine::Jobs::ThreadPool pool{threads};
+            Vulqian::Engine::ECS::Coordinator coordinator{};
+            coordinator.init(mode);
+            coordinator.set_thread_pool(&pool);
+            coordinator.register_component<Position>();
+            coordinator.register_component<Velocity>();
+
+            auto entities = coordinator.create_entities(count, Position{}, Velocity{0.5f});
+
+            coordinator.parallel_each<Position, const Velocity>(
+                [](Position& position, Velocity const& velocity) { position.x += velocity.dx * 3.f; }, 1000);
+
+            for (int i = 0; i < count; ++i) {
+                coordinator.get_component<Position>(entities[i]).x += 0.001f * static_cast<float>(i);
+            }
+
+            auto bounds = coordinator.parallel_reduce<const Position>(
+                Bounds{},
+                [](Bounds& partial, Position const& position) {
+                    partial.min = std::min(partial.min, position.x);
+                    partial.max = std::max(partial.max, position.x);
+                    partial.sum += position.x;
+                },
+                [](Bounds& result, Bounds const& partial) {
+                    result.min = std::min(result.min, partial.min);
+                    result.max = std::max(result.max, partial.max);
+                    result.sum += partial.sum;
+                },
+                1000);
+
+            // Same chunks for every thread count, so the float sum is bit-identical
+            if (threads == 0) {
+                reference_sum = bounds.sum;
+            }
+
+            ASSERT_FLOAT_EQ(bounds.min, 1.5f);
+            ASSERT_FLOAT_EQ(bounds.max, 1.5f + 0.001f * (count - 1));
+            ASSERT_EQ(bounds.sum, reference_sum);
+        }
+    }
+}
@@ -0,0 +1,167 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+#include "ECS/Systems/Physics.hpp"
+
+namespace {
+
+using Vulqian::Engine::ECS::Entity;
+using Vulqian::Engine::ECS::Components::RigidBody;
+using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+using Vulqian::Engine::ECS::Components::Velocity;
+using Vulqian::Engine::ECS::Systems::Physics;
+
+class PhysicsTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        this->coordinator.init();
+        this->coordinator.register_component<Transform_TB_YXZ>();
+        this->coordinator.register_component<RigidBody>();
+        this->coordinator.register_component<Velocity>();
+
+        this->physics = this->coordinator.register_system<Physics>();
+        this->coordinator.set_system_signature<Physics>(this->coordinator.signature_of<Transform_TB_YXZ, RigidBody, Velocity>());
+    }
+
+    Entity spawn(RigidBody body, Velocity velocity = {}) {
+        const Entity entity = this->coordinator.create_entity();
+        this->coordinator.add_component(entity, Transform_TB_YXZ{});
+        this->coordinator.add_component(entity, body);
+        this->coordinator.add_component(entity, velocity);
+        return entity;
+    }
+
+    glm::vec3 position(Entity entity) {
+        return this->coordinator.get_component<const Transform_TB_YXZ>(entity).translation;
+    }
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    std::shared_ptr<Physics>          physics{};
+};
+
+TEST_F(PhysicsTest, SemiImplicitEulerUnderGravity) {
+    RigidBody body{};
+    body.linear_damping = 0.f;
+    const Entity falling = this->spawn(body);
+
+    RigidBody anchored{};
+    anchored.inverse_mass = 0.f;
+    const Entity fixed = this->spawn(anchored);
+
+    this->physics->gravity = {0.f, 10.f, 0.f};
+    this->physics->fixed_timestep = 0.5f;
+    this->physics->step(this->coordinator);
+    this->physics->step(this->coordinator);
+
+    // Velocity first: v1 = 5, x1 = 2.5, v2 = 10, x2 = 7.5
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<const Velocity>(falling).linear.y, 10.f);
+    ASSERT_FLOAT_EQ(this->position(falling).y, 7.5f);
+    ASSERT_EQ(this->position(fixed), glm::vec3{0.f});
+}
+
+TEST_F(PhysicsTest, FixedStepsCarryLeftoverTime) {
+    RigidBody body{};
+    body.gravity_scale = 0.f;
+    this->spawn(body, Velocity{{1.f, 0.f, 0.f}, {}});
+
+    this->physics->fixed_timestep = 0.25f;
+    this->physics->update(this->coordinator, 0.125f);
+    ASSERT_EQ(this->physics->get_step_count(), 0u);
+    ASSERT_FLOAT_EQ(this->physics->get_interpolation_alpha(), 0.5f);
+
+    this->physics->update(this->coordinator, 0.625f);
+    ASSERT_EQ(this->physics->get_step_count(), 3u);
+
+    // A long stall is capped instead of replayed
+    this->physics->max_steps_per_update = 4;
+    this->physics->update(this->coordinator, 10.f);
+    ASSERT_EQ(this->physics->get_step_count(), 4u);
+    ASSERT_FLOAT_EQ(this->physics->get_interpolation_alpha(), 0.f);
+}
+
+TEST_F(PhysicsTest, ForcesLastOneUpdateAndDampingSlowsDown) {
+    RigidBody body{};
+    body.gravity_scale = 0.f;
+    body.inverse_mass = 0.5f;
+    body.linear_damping = 1.f;
+    body.force = {4.f, 0.f, 0.f};
+    const Entity entity = this->spawn(body);
+
+    this->physics->fixed_timestep = 1.f;
+    this->physics->step(this->coordinator);
+
+    // (0 + 2 * 1) / (1 + 1)
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<const Velocity>(entity).linear.x, 1.f);
+    ASSERT_EQ(this->coordinator.get_component<const RigidBody>(entity).force, glm::vec3{0.f});
+
+    this->physics->step(this->coordinator);
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<const Velocity>(entity).linear.x, 0.5f);
+}
+
+TEST_F(PhysicsTest, AngularVelocityTurnsAroundWorldAxes) {
+    RigidBody body{};
+    body.gravity_scale = 0.f;
+    body.angular_damping = 0.f;
+    const Entity entity = this->spawn(body, Velocity{{}, {0.f, 0.f, 1.f}});
+    this->coordinator.get_component<Transform_TB_YXZ>(entity).rotation = {0.f, .5f, 0.f};
+
+    this->physics->fixed_timestep = .01f;
+    for (int step = 0; step < 100; ++step) {
+        this->physics->step(this->coordinator);
+    }
+
+    // One radian around world Z applied after the initial yaw, not added to the Z angle
+    const glm::mat4 expected = glm::rotate(glm::mat4{1.f}, 1.f, glm::vec3{0.f, 0.f, 1.f}) * glm::rotate(glm::mat4{1.f}, .5f, glm::vec3{0.f, 1.f, 0.f});
+    const glm::mat4 actual = this->coordinator.get_component<const Transform_TB_YXZ>(entity).mat4();
+    for (int column = 0; column < 3; ++column) {
+        for (int row = 0; row < 3; ++row) {
+            ASSERT_NEAR(actual[column][row], expected[column][row], 1e-4f);
+        }
+    }
+}
+
+TEST_F(PhysicsTest, ChunkedStepsMatchSingleThreaded) {
+    Vulqian::Engine::Jobs::ThreadPool pool{4};
+
+    std::vector<Entity> entities{};
+    for (int i = 0; i < 1000; ++i) {
+        entities.push_back(this->spawn(RigidBody{}, Velocity{{static_cast<float>(i), 0.f, 0.f}, {0.f, 0.01f * i, 0.f}}));
+    }
+
+    Vulqian::Engine::ECS::Coordinator reference{};
+    reference.init();
+    reference.register_component<Transform_TB_YXZ>();
+    reference.register_component<RigidBody>();
+    reference.register_component<Velocity>();
+    auto single = reference.register_system<Physics>();
+    reference.set_system_signature<Physics>(reference.signature_of<Transform_TB_YXZ, RigidBody, Velocity>());
+    for (int i = 0; i < 1000; ++i) {
+        const Entity entity = reference.create_entity();
+        reference.add_component(entity, Transform_TB_YXZ{});
+        reference.add_component(entity, RigidBody{});
+        reference.add_component(entity, Velocity{{static_cast<float>(i), 0.f, 0.f}, {0.f, 0.01f * i, 0.f}});
+    }
+
+    this->coordinator.set_thread_pool(&pool);
+    this->physics->grain = 64;
+    for (int frame = 0; frame < 10; ++frame) {
+        this->physics->step(this->coordinator);
+        single->step(reference);
+    }
+
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        auto const& expected = reference.get_component<const Transform_TB_YXZ>(single->entities()[i]);
+        auto const& actual = this->coordinator.get_component<const Transform_TB_YXZ>(this->physics->entities()[i]);
+        ASSERT_EQ(actual.translation, expected.translation);
+        ASSERT_EQ(actual.rotation, expected.rotation);
+    }
+}
+
+} // namespace
@@ -0,0 +1,71 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+#include "ECS/Systems/Scheduler.hpp"
+
+namespace {
+
+Vulqian::Engine::ECS::SystemAccess make_access(int reads, int writes) {
+    Vulqian::Engine::ECS::SystemAccess access{};
+    access.reads = Vulqian::Engine::ECS::Signature(static_cast<unsigned long long>(reads));
+    access.writes = Vulqian::Engine::ECS::Signature(static_cast<unsigned long long>(writes));
+    return access;
+}
+
+} // namespace
+
+TEST(ThreadPoolTest, WaitRunsNestedJobs) {
+    Vulqian::Engine::Jobs::ThreadPool pool{3};
+    Vulqian::Engine::Jobs::WaitGroup  group{};
+    std::atomic<int>                  counter{0};
+
+    for (int i = 0; i < 64; ++i) {
+        pool.submit([&pool, &group, &counter] {
+            pool.submit([&counter] { counter.fetch_add(1); }, group);
+            counter.fetch_add(1);
+        },
+                    group);
+    }
+    pool.wait(group);
+
+    ASSERT_EQ(counter.load(), 128);
+}
+
+TEST(SchedulerTest, ConflictingSystemsKeepInsertionOrder) {
+    for (std::size_t threads : {0u, 4u}) {
+        Vulqian::Engine::Jobs::ThreadPool pool{threads};
+        Vulqian::Engine::ECS::Scheduler   scheduler{pool};
+
+        std::mutex       mutex{};
+        std::vector<int> order{};
+        auto             record = [&mutex, &order](int id) {
+            std::lock_guard lock{mutex};
+            order.push_back(id);
+        };
+
+        // 0 writes bit 0, 1 reads it, 2 only touches bit 1, 3 writes bit 0 after everyone read it
+        scheduler.add("writer", make_access(0b00, 0b01), [&] { record(0); });
+        scheduler.add("reader", make_access(0b01, 0b00), [&] { record(1); });
+        scheduler.add("unrelated", make_access(0b00, 0b10), [&] { record(2); });
+        scheduler.add("second_writer", make_access(0b00, 0b01), [&] { record(3); });
+        scheduler.run();
+
+        ASSERT_EQ(order.size(), 4u);
+        auto position = [&order](int id) { return std::find(order.begin(), order.end(), id) - order.begin(); };
+        ASSERT_LT(position(0), position(1));
+        ASSERT_LT(position(1), position(3));
+
+        ASSERT_EQ(scheduler.get_timings().size(), 4u);
+        ASSERT_EQ(*scheduler.get_timings()[2].name, "unrelated");
+    }
+}
@@ -0,0 +1,178 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Math/Simplifier.hpp"
+
+namespace {
+
+using Vulqian::Engine::Math::LodLevel;
+
+struct TestMesh {
+    std::vector<glm::vec3>     positions{};
+    std::vector<glm::vec3>     normals{};
+    std::vector<std::uint32_t> indices{};
+};
+
+// Unit sphere of rings x segments quads, shared vertices, the poles repeated along the seam
+TestMesh sphere(std::uint32_t rings, std::uint32_t segments) {
+    TestMesh mesh{};
+    for (std::uint32_t ring = 0; ring <= rings; ++ring) {
+        const float theta = 3.14159265f * static_cast<float>(ring) / static_cast<float>(rings);
+        for (std::uint32_t segment = 0; segment < segments; ++segment) {
+            const float     phi = 6.2831853f * static_cast<float>(segment) / static_cast<float>(segments);
+            const glm::vec3 point{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+            mesh.positions.push_back(ring == 0 ? glm::vec3{0.f, 1.f, 0.f} : ring == rings ? glm::vec3{0.f, -1.f, 0.f} : point);
+            mesh.normals.push_back(mesh.positions.back());
+        }
+    }
+    for (std::uint32_t ring = 0; ring < rings; ++ring) {
+        for (std::uint32_t segment = 0; segment < segments; ++segment) {
+            const std::uint32_t a = ring * segments + segment;
+            const std::uint32_t b = ring * segments + (segment + 1) % segments;
+            const std::uint32_t c = a + segments;
+            const std::uint32_t d = b + segments;
+            mesh.indices.insert(mesh.indices.end(), {a, b, d, a, d, c});
+        }
+    }
+    return mesh;
+}
+
+// Every triangle of the original vertices and not flattened
+void expect_valid(TestMesh const& mesh, std::vector<std::uint32_t> const& indices) {
+    ASSERT_EQ(indices.size() % 3, 0u);
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        ASSERT_LT(indices[i], mesh.positions.size());
+        ASSERT_LT(indices[i + 1], mesh.positions.size());
+        ASSERT_LT(indices[i + 2], mesh.positions.size());
+        const glm::vec3 normal = glm::cross(mesh.positions[indices[i + 1]] - mesh.positions[indices[i]], mesh.positions[indices[i + 2]] - mesh.positions[indices[i]]);
+        ASSERT_GT(glm::length(normal), 0.f) << "triangle " << i / 3;
+    }
+}
+
+TEST(SimplifierTest, LevelsShrinkWithGrowingError) {
+    const TestMesh mesh = sphere(24, 32);
+
+    float       previous_error = 0.f;
+    std::size_t previous_count = mesh.indices.size();
+    for (std::size_t target : {mesh.indices.size() / 2, mesh.indices.size() / 4, mesh.indices.size() / 8}) {
+        const auto simplified = Vulqian::Engine::Math::simplify(mesh.positions, mesh.normals, mesh.indices, target);
+        expect_valid(mesh, simplified.indices);
+        ASSERT_LE(simplified.indices.size(), target);
+        ASSERT_LT(simplified.indices.size(), previous_count);
+        ASSERT_GE(simplified.error, previous_error);
+        ASSERT_LT(simplified.error, .5f);  // still a sphere
+
+        // Kept vertices stay on the original surface, and the error bounds how far the flat triangles cut inside
+        for (std::size_t i = 0; i < simplified.indices.size(); i += 3) {
+            const glm::vec3 center = (mesh.positions[simplified.indices[i]] + mesh.positions[simplified.indices[i + 1]] + mesh.positions[simplified.indices[i + 2]]) / 3.f;
+            ASSERT_LE(1.f - glm::length(center), simplified.error + .02f);
+        }
+        previous_error = simplified.error;
+        previous_count = simplified.indices.size();
+    }
+
+    // Nothing to do above the current size
+    const auto same = Vulqian::Engine::Math::simplify(mesh.positions, mesh.normals, mesh.indices, mesh.indices.size());
+    ASSERT_EQ(same.indices, mesh.indices);
+    ASSERT_EQ(same.error, 0.f);
+}
+
+TEST(SimplifierTest, FlatGridCollapsesWithoutErrorAndKeepsItsBorder) {
+    // 8 x 8 quads in the y = 0 plane
+    TestMesh mesh{};
+    for (std::uint32_t z = 0; z <= 8; ++z) {
+        for (std::uint32_t x = 0; x <= 8; ++x) {
+            mesh.positions.push_back({static_cast<float>(x), 0.f, static_cast<float>(z)});
+            mesh.normals.push_back({0.f, 1.f, 0.f});
+        }
+    }
+    for (std::uint32_t z = 0; z < 8; ++z) {
+        for (std::uint32_t x = 0; x < 8; ++x) {
+            const std::uint32_t a = z * 9 + x;
+            mesh.indices.insert(mesh.indices.end(), {a, a + 9, a + 1, a + 1, a + 9, a + 10});
+        }
+    }
+
+    const auto simplified = Vulqian::Engine::Math::simplify(mesh.positions, mesh.normals, mesh.indices, 0);
+    expect_valid(mesh, simplified.indices);
+    ASSERT_LT(simplified.indices.size(), mesh.indices.size() / 2);
+    ASSERT_NEAR(simplified.error, 0.f, 1e-3f);
+
+    // The 32 border points are still used, the area is unchanged
+    std::vector<bool> used(mesh.positions.size());
+    float             area = 0.f;
+    for (std::size_t i = 0; i < simplified.indices.size(); i += 3) {
+        used[simplified.indices[i]] = used[simplified.indices[i + 1]] = used[simplified.indices[i + 2]] = true;
+        const glm::vec3 normal = glm::cross(mesh.positions[simplified.indices[i + 1]] - mesh.positions[simplified.indices[i]],
+                                            mesh.positions[simplified.indices[i + 2]] - mesh.positions[simplified.indices[i]]);
+        ASSERT_GT(normal.y, 0.f);  // same winding as the original
+        area += glm::length(normal) * .5f;
+    }
+    for (std::uint32_t i = 0; i <= 8; ++i) {
+        ASSERT_TRUE(used[i] && used[72 + i] && used[i * 9] && used[i * 9 + 8]) << i;
+    }
+    ASSERT_NEAR(area, 64.f, 1e-3f);
+}
+
+TEST(SimplifierTest, SeamsAreWeldedAndKeepTheirNormals) {
+    // Flat shaded: every triangle with its own 3 vertices and face normal
+    const TestMesh smooth = sphere(12, 16);
+    TestMesh       flat{};
+    for (std::size_t i = 0; i < smooth.indices.size(); i += 3) {
+        const glm::vec3 a = smooth.positions[smooth.indices[i]], b = smooth.positions[smooth.indices[i + 1]], c = smooth.positions[smooth.indices[i + 2]];
+        const glm::vec3 normal = glm::cross(b - a, c - a);
+        if (glm::length(normal) == 0.f) {
+            continue;  // at the poles
+        }
+        for (glm::vec3 const& corner : {a, b, c}) {
+            flat.indices.push_back(static_cast<std::uint32_t>(flat.positions.size()));
+            flat.positions.push_back(corner);
+            flat.normals.push_back(glm::normalize(normal));
+        }
+    }
+
+    const auto simplified = Vulqian::Engine::Math::simplify(flat.positions, flat.normals, flat.indices, flat.indices.size() / 4);
+    expect_valid(flat, simplified.indices);
+    ASSERT_LE(simplified.indices.size(), flat.indices.size() / 4);
+
+    // Each corner takes the face normal closest to its new triangle's
+    for (std::size_t i = 0; i < simplified.indices.size(); i += 3) {
+        const glm::vec3 normal = glm::normalize(glm::cross(flat.positions[simplified.indices[i + 1]] - flat.positions[simplified.indices[i]],
+                                                           flat.positions[simplified.indices[i + 2]] - flat.positions[simplified.indices[i]]));
+        for (std::size_t k = 0; k < 3; ++k) {
+            ASSERT_GT(glm::dot(normal, flat.normals[simplified.indices[i + k]]), 0.f);
+        }
+    }
+}
+
+TEST(SimplifierTest, SelectionWaitsPastTheHysteresis) {
+    const std::vector<LodLevel> levels{{0, 300, 0.f}, {300, 150, .01f}, {450, 75, .04f}, {525, 36, .2f}};
+    const auto                  select = [&levels](float pixels_per_unit, std::uint32_t current) {
+        return Vulqian::Engine::Math::select_lod(levels, pixels_per_unit, current, 1.f, .25f);
+    };
+
+    // Far from any limit
+    ASSERT_EQ(select(1000.f, 2), 0u);
+    ASSERT_EQ(select(1.f, 0), 3u);
+    ASSERT_EQ(select(50.f, 0), 1u);  // .5 pixel at level 1, 2 at level 2
+
+    // Level 2 covers exactly 1 pixel at 25 pixels per unit: switching to it waits until .75, back from it until 1.25
+    ASSERT_EQ(select(24.f, 1), 1u);
+    ASSERT_EQ(select(18.f, 1), 2u);
+    ASSERT_EQ(select(28.f, 2), 2u);
+    ASSERT_EQ(select(32.f, 2), 1u);
+
+    // A level out of range, a model of one level
+    ASSERT_EQ(select(50.f, 7), 1u);
+    ASSERT_EQ(Vulqian::Engine::Math::select_lod(std::span<const LodLevel>{levels.data(), 1}, 1.f, 0, 1.f, .25f), 0u);
+}
+
+} // namespace
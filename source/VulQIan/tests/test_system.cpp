@@ -0,0 +1,50 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+struct Position {
+    float x{};
+};
+
+struct Velocity {
+    float dx{};
+};
+
+class Movement : public Vulqian::Engine::ECS::System {};
+
+} // namespace
+
+TEST(SystemTest, MembershipIsPackedAndFollowsSignatures) {
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+    coordinator.init();
+    coordinator.register_component<Position>();
+    coordinator.register_component<Velocity>();
+
+    auto movement = coordinator.register_system<Movement>();
+    coordinator.set_system_signature<Movement>(coordinator.signature_of<Position, Velocity>());
+
+    std::vector<Vulqian::Engine::ECS::Entity> entities{};
+    for (int i = 0; i < 4; ++i) {
+        auto entity = coordinator.create_entity();
+        coordinator.add_component(entity, Position{});
+        coordinator.add_component(entity, Velocity{});
+        entities.push_back(entity);
+    }
+
+    coordinator.remove_component<Velocity>(entities[1]);
+    coordinator.destroy_entity(entities[2]);
+
+    // The last member fills each hole
+    std::vector<Vulqian::Engine::ECS::Entity> expected{entities[0], entities[3]};
+    ASSERT_EQ(std::vector<Vulqian::Engine::ECS::Entity>(movement->entities().begin(), movement->entities().end()), expected);
+    ASSERT_FALSE(movement->contains(entities[1]));
+}
@@ -0,0 +1,112 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+#include "ECS/Systems/TransformHierarchy.hpp"
+
+namespace {
+
+using Vulqian::Engine::ECS::Entity;
+using Vulqian::Engine::ECS::Components::Children;
+using Vulqian::Engine::ECS::Components::Parent;
+using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+using Vulqian::Engine::ECS::Components::WorldTransform;
+using Vulqian::Engine::ECS::Systems::TransformHierarchy;
+
+class TransformHierarchyTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        this->coordinator.init();
+        this->coordinator.register_component<Transform_TB_YXZ>();
+        this->coordinator.register_component<WorldTransform>();
+        this->coordinator.register_component<Parent>();
+        this->coordinator.register_component<Children>();
+
+        this->hierarchy = this->coordinator.register_system<TransformHierarchy>();
+        this->coordinator.set_system_signature<TransformHierarchy>(this->coordinator.signature_of<Transform_TB_YXZ, WorldTransform>());
+        this->hierarchy->init(this->coordinator);
+    }
+
+    Entity spawn(glm::vec3 translation) {
+        Transform_TB_YXZ transform{};
+        transform.translation = translation;
+
+        const Entity entity = this->coordinator.create_entity();
+        this->coordinator.add_component(entity, transform);
+        this->coordinator.add_component(entity, WorldTransform{});
+        return entity;
+    }
+
+    glm::vec4 world_position(Entity entity) {
+        return this->coordinator.get_component<const WorldTransform>(entity).world_matrix[3];
+    }
+
+    Vulqian::Engine::ECS::Coordinator   coordinator{};
+    std::shared_ptr<TransformHierarchy> hierarchy{};
+};
+
+TEST_F(TransformHierarchyTest, ChildrenFollowTheirParentsInDepthOrder) {
+    // Created before its parent, still ordered after it
+    const Entity child = this->spawn({0.f, 2.f, 0.f});
+    const Entity parent = this->spawn({1.f, 0.f, 0.f});
+    this->hierarchy->set_parent(this->coordinator, child, parent);
+
+    this->hierarchy->update(this->coordinator);
+
+    const auto order = this->hierarchy->depth_order();
+    ASSERT_LT(std::ranges::find(order, parent) - order.begin(), std::ranges::find(order, child) - order.begin());
+    ASSERT_EQ(this->world_position(child), (glm::vec4{1.f, 2.f, 0.f, 1.f}));
+}
+
+TEST_F(TransformHierarchyTest, OnlyChangedSubtreesAreRecomputed) {
+    const Entity parent = this->spawn({1.f, 0.f, 0.f});
+    const Entity child = this->spawn({0.f, 2.f, 0.f});
+    const Entity grandchild = this->spawn({0.f, 0.f, 3.f});
+    this->spawn({5.f, 5.f, 5.f});
+    this->hierarchy->set_parent(this->coordinator, child, parent);
+    this->hierarchy->set_parent(this->coordinator, grandchild, child);
+
+    this->hierarchy->update(this->coordinator);
+    ASSERT_EQ(this->hierarchy->get_updated_count(), 4u);
+
+    this->hierarchy->update(this->coordinator);
+    ASSERT_EQ(this->hierarchy->get_updated_count(), 0u);
+
+    // Moving the child drags the grandchild along, the parent and the unrelated root stay cached
+    this->coordinator.get_component<Transform_TB_YXZ>(child).translation.y = 4.f;
+    this->hierarchy->update(this->coordinator);
+
+    ASSERT_EQ(this->hierarchy->get_updated_count(), 2u);
+    ASSERT_EQ(this->world_position(grandchild), (glm::vec4{1.f, 4.f, 3.f, 1.f}));
+}
+
+TEST_F(TransformHierarchyTest, ReparentingAndDestroyedParentsKeepLinksConsistent) {
+    const Entity first = this->spawn({1.f, 0.f, 0.f});
+    const Entity second = this->spawn({0.f, 1.f, 0.f});
+    const Entity child = this->spawn({0.f, 0.f, 1.f});
+
+    this->hierarchy->set_parent(this->coordinator, child, first);
+    this->hierarchy->set_parent(this->coordinator, child, second);
+    this->hierarchy->update(this->coordinator);
+
+    ASSERT_TRUE(this->coordinator.get_component<const Children>(first).entities.empty());
+    ASSERT_EQ(this->world_position(child), (glm::vec4{0.f, 1.f, 1.f, 1.f}));
+
+    // The orphan falls back to its local transform
+    this->coordinator.destroy_entity(second);
+    this->hierarchy->update(this->coordinator);
+    ASSERT_EQ(this->world_position(child), (glm::vec4{0.f, 0.f, 1.f, 1.f}));
+
+    // A destroyed child leaves its parent's list
+    this->hierarchy->set_parent(this->coordinator, child, first);
+    this->coordinator.destroy_entity(child);
+    ASSERT_TRUE(this->coordinator.get_component<const Children>(first).entities.empty());
+}
+
+} // namespace
@@ -0,0 +1,107 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ECS/Components/Transform.hpp"
+#include "Math/TransformKernel.hpp"
+
+namespace {
+
+using Vulqian::Engine::ECS::Components::Transform_TB_YXZ;
+using Vulqian::Engine::Math::SimdLevel;
+
+// Transforms stored as structure of arrays, a count that is no multiple of any width exercises the scalar tail
+struct TransformSoA {
+    explicit TransformSoA(std::size_t count) {
+        std::mt19937                          generator{42};
+        std::uniform_real_distribution<float> angle{-20.f, 20.f};
+        std::uniform_real_distribution<float> offset{-100.f, 100.f};
+        std::uniform_real_distribution<float> scale{0.1f, 4.f};
+
+        for (auto& field : this->fields) {
+            field.resize(count);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                this->fields[axis][i] = offset(generator);
+                this->fields[3 + axis][i] = angle(generator);
+                this->fields[6 + axis][i] = scale(generator);
+            }
+        }
+    }
+
+    Vulqian::Engine::Math::TransformArrays arrays() const {
+        return {this->fields[0].data(), this->fields[1].data(), this->fields[2].data(), this->fields[3].data(), this->fields[4].data(),
+                this->fields[5].data(), this->fields[6].data(), this->fields[7].data(), this->fields[8].data(), this->fields[0].size()};
+    }
+
+    Transform_TB_YXZ transform(std::size_t i) const {
+        Transform_TB_YXZ transform{};
+        transform.translation = {this->fields[0][i], this->fields[1][i], this->fields[2][i]};
+        transform.rotation = {this->fields[3][i], this->fields[4][i], this->fields[5][i]};
+        transform.scale = {this->fields[6][i], this->fields[7][i], this->fields[8][i]};
+        return transform;
+    }
+
+    std::array<std::vector<float>, 9> fields{};
+};
+
+TEST(TransformKernelTest, SincosStaysCloseToTheStandardLibrary) {
+    for (float angle = -50.f; angle <= 50.f; angle += 0.01f) {
+        float sine{}, cosine{};
+        Vulqian::Engine::Math::sincos(angle, sine, cosine);
+
+        ASSERT_NEAR(sine, std::sin(angle), 1e-6f) << angle;
+        ASSERT_NEAR(cosine, std::cos(angle), 1e-6f) << angle;
+    }
+}
+
+TEST(TransformKernelTest, ScalarPathMatchesTransformComponent) {
+    const TransformSoA     transforms{257};
+    std::vector<glm::mat4> models(257), normals(257);
+
+    Vulqian::Engine::Math::compute_transform_matrices(transforms.arrays(), models.data(), normals.data(), SimdLevel::Scalar);
+
+    for (std::size_t i = 0; i < models.size(); ++i) {
+        const glm::mat4 model = transforms.transform(i).mat4();
+        const glm::mat4 normal{transforms.transform(i).normal_matrix()};
+
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                ASSERT_NEAR(models[i][column][row], model[column][row], 1e-4f);
+                ASSERT_NEAR(normals[i][column][row], normal[column][row], 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(TransformKernelTest, EverySupportedLevelIsBitIdenticalToScalar) {
+    const TransformSoA     transforms{1001};
+    std::vector<glm::mat4> expected_models(1001), expected_normals(1001);
+    Vulqian::Engine::Math::compute_transform_matrices(transforms.arrays(), expected_models.data(), expected_normals.data(), SimdLevel::Scalar);
+
+    for (SimdLevel level : {SimdLevel::SSE, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > Vulqian::Engine::Math::detect_simd_level()) {
+            continue;
+        }
+
+        std::vector<glm::mat4> models(1001), normals(1001);
+        Vulqian::Engine::Math::compute_transform_matrices(transforms.arrays(), models.data(), normals.data(), level);
+
+        ASSERT_EQ(std::memcmp(models.data(), expected_models.data(), models.size() * sizeof(glm::mat4)), 0)
+            << Vulqian::Engine::Math::simd_level_name(level);
+        ASSERT_EQ(std::memcmp(normals.data(), expected_normals.data(), normals.size() * sizeof(glm::mat4)), 0)
+            << Vulqian::Engine::Math::simd_level_name(level);
+    }
+}
+
+} // namespace
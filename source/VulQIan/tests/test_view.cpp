@@ -0,0 +1,74 @@
+// Vulquian - Custom Vulkan Engine
+// Copyright (C) 60-de-QI - All rights reserved
+// This software is provided 'as is' and without any warranty, express or implied.
+// The author(s) disclaim all liability for damages resulting from the use or misuse of this software.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ECS/Coordinator/Coordinator.hpp"
+
+namespace {
+
+struct Position {
+    float x{};
+};
+
+struct Velocity {
+    float dx{};
+};
+
+struct Frozen {};
+
+class ViewTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        this->coordinator.init();
+        this->coordinator.register_component<Position>();
+        this->coordinator.register_component<Velocity>();
+        this->coordinator.register_component<Frozen>();
+    }
+
+    Vulqian::Engine::ECS::Coordinator coordinator{};
+};
+
+} // namespace
+
+TEST_F(ViewTest, EachVisitsOnlyEntitiesWithAllComponents) {
+    auto moving = this->coordinator.create_entity();
+    auto still = this->coordinator.create_entity();
+
+    this->coordinator.add_component(moving, Position{1.f});
+    this->coordinator.add_component(moving, Velocity{2.f});
+    this->coordinator.add_component(still, Position{5.f});
+
+    int visited{0};
+    this->coordinator.each<Position, const Velocity>([&](Position& position, Velocity const& velocity) {
+        position.x += velocity.dx;
+        ++visited;
+    });
+
+    ASSERT_EQ(visited, 1);
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<Position>(moving).x, 3.f);
+    ASSERT_FLOAT_EQ(this->coordinator.get_component<Position>(still).x, 5.f);
+}
+
+TEST_F(ViewTest, ExcludeSkipsEntities) {
+    std::vector<Vulqian::Engine::ECS::Entity> created{};
+    for (int i = 0; i < 4; ++i) {
+        auto entity = this->coordinator.create_entity();
+        this->coordinator.add_component(entity, Position{static_cast<float>(i)});
+        if (i % 2 == 0) {
+            this->coordinator.add_component(entity, Frozen{});
+        }
+        created.push_back(entity);
+    }
+
+    std::vector<Vulqian::Engine::ECS::Entity> matched{};
+    for (auto entity : this->coordinator.view<Position>(Vulqian::Engine::ECS::exclude<Frozen>)) {
+        matched.push_back(entity);
+    }
+
+    ASSERT_EQ(matched, (std::vector<Vulqian::Engine::ECS::Entity>{created[1], created[3]}));
+}
@@ -23,7 +23,6 @@ App::App() {
                             .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT)
                             .build();
     this->load_entities();
-    this->load_systems();
 }
 
 void App::run() {
@@ -41,7 +40,7 @@ void App::run() {
     }
 
     auto globalSetLayout{Vulqian::Engine::Graphics::Descriptors::DescriptorSetLayout::Builder(this->device)
-                             .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS)
+                             .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT)
                              .build()};
 
     std::vector<VkDescriptorSet> globalDescriptorSets(Vulqian::Engine::Graphics::SwapChain::MAX_FRAMES_IN_FLIGHT);
@@ -56,6 +55,15 @@ void App::run() {
     Vulqian::Engine::ECS::Systems::PointLights point_light_system{this->device, this->renderer.get_SwapChain_RenderPass(), globalSetLayout->getDescriptorSetLayout()};
     Vulqian::Engine::Graphics::Camera          camera{};
 
+    // Software rasterizers: culling in a compute shader costs as much as the draws it saves, the CPU culls alone
+    if (this->device.get_physical_device_properties().deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) {
+        render_system.gpu_driven = false;
+        render_system.cpu_occlusion_culling = true;
+    }
+    bool dump_key_down{false};
+    bool stats_key_down{false};
+    bool print_stats{false};
+
     camera.set_view_target(glm::vec3(-1.f, -2.f, 2.f), glm::vec3(0.f, 0.f, 2.5f));
 
     auto viewer_entity{this->coordinator.create_entity()};
@@ -67,6 +75,23 @@ void App::run() {
     Vulqian::Engine::Input::KeyboardMovementController camera_controller{};
     Vulqian::Engine::Input::MouseCameraController      mouse_controller{};
 
+    // Components touched by the per-frame systems, the scheduler runs disjoint ones concurrently
+    Vulqian::Engine::ECS::SystemAccess point_lights_access{};
+    point_lights_access.reads = this->coordinator.signature_of<Vulqian::Engine::ECS::Components::PointLight>();
+    point_lights_access.writes = this->coordinator.signature_of<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>();
+
+    Vulqian::Engine::ECS::SystemAccess hierarchy_access{};
+    hierarchy_access.reads = this->coordinator.signature_of<Vulqian::Engine::ECS::Components::Transform_TB_YXZ,
+                                                            Vulqian::Engine::ECS::Components::Parent,
+                                                            Vulqian::Engine::ECS::Components::Children>();
+    hierarchy_access.writes = this->coordinator.signature_of<Vulqian::Engine::ECS::Components::WorldTransform>();
+
+    Vulqian::Engine::ECS::SystemAccess extraction_access{};
+    extraction_access.reads = this->coordinator.signature_of<Vulqian::Engine::ECS::Components::Transform_TB_YXZ,
+                                                             Vulqian::Engine::ECS::Components::Mesh,
+                                                             Vulqian::Engine::ECS::Components::Transparency,
+                                                             Vulqian::Engine::ECS::Components::PointLight>();
+
     auto current_time{std::chrono::high_resolution_clock::now()};
 
     while (!this->window.should_close()) {
@@ -80,13 +105,28 @@ void App::run() {
         camera_controller.move_in_plane_xz(this->window.get_window(), frame_time, transform);
         camera.set_view_YXZ(transform.translation, transform.rotation);
 
+        // F2 writes the CPU occlusion buffer of the next frame to the working directory
+        const bool dump_key = glfwGetKey(this->window.get_window(), GLFW_KEY_F2) == GLFW_PRESS;
+        if (dump_key && !dump_key_down) {
+            render_system.occlusion_dump_path = "occlusion.pgm";
+        }
+        dump_key_down = dump_key;
+
+        // F3 toggles printing the system timings and render stats once a second
+        const bool stats_key = glfwGetKey(this->window.get_window(), GLFW_KEY_F3) == GLFW_PRESS;
+        if (stats_key && !stats_key_down) {
+            print_stats = !print_stats;
+        }
+        stats_key_down = stats_key;
+
         float aspect = this->renderer.get_aspect_ratio();
         camera.set_perspective_projection(glm::radians(50.f), aspect, .1f, 1000.f);
+        render_system.viewport_height = static_cast<float>(this->renderer.get_extent().height);
 
         if (auto command_buffer = this->renderer.begin_frame()) {
             int                                     frame_index{this->renderer.get_frame_index()};
             Vulqian::Engine::Graphics::Frames::Info frame_info{
-                0,
+                frame_index,
                 frame_time,
                 nullptr,
                 camera,
@@ -99,42 +139,76 @@ void App::run() {
             ubo.projection = camera.get_projection();
             ubo.view = camera.get_view();
             ubo.inverseView = camera.get_inverse_view();
-            point_light_system.update(frame_info, ubo, this->coordinator, this->entities);
-            ubo_buffers[frame_index]->writeToBuffer(&ubo);
-            ubo_buffers[frame_index]->flush();
 
-            // rendering phase /!\ the order matters
-            this->renderer.begin_SwapChain_RenderPass(command_buffer);
-
-            // 1. Render opaque objects first
-            render_system.render_opaque_entities_only(frame_info, this->entities, this->coordinator);
-
-            // 2. Collect and sort all transparent objects (meshes + lights)
+            // Transparent objects (meshes + lights) sorted by distance to the camera
             std::map<float, std::pair<std::string, Vulqian::Engine::ECS::Entity>> transparent_objects;
             glm::vec3                                                             camera_pos = camera.get_position();
 
-            // Add transparent meshes
-            for (const auto& entity : this->entities) {
-                if (coordinator.has_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity) &&
-                    coordinator.has_component<Vulqian::Engine::ECS::Components::Mesh>(entity) &&
-                    coordinator.has_component<Vulqian::Engine::ECS::Components::Transparency>(entity)) {
-                    auto const& transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-                    auto        offset = camera_pos - transform.translation;
-                    float       depth = glm::dot(offset, offset);
-                    transparent_objects[depth] = {"mesh", entity};
+            // Systems run on the thread pool, ordered by the components they declare
+            this->scheduler.clear();
+            this->scheduler.add("physics", this->physics_system->access, [this, frame_time] { this->physics_system->update(this->coordinator, frame_time); });
+            this->scheduler.add("transform_hierarchy", hierarchy_access, [this] { this->transform_hierarchy->update(this->coordinator); });
+            this->scheduler.add("point_lights", point_lights_access, [&point_light_system, &frame_info, &ubo, this] {
+                point_light_system.update(frame_info, ubo, this->coordinator);
+            });
+            this->scheduler.add("transparent_extraction", extraction_access, [&camera_pos, &transparent_objects, this] {
+                // Add transparent meshes
+                this->coordinator.each<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ,
+                                       const Vulqian::Engine::ECS::Components::Mesh,
+                                       const Vulqian::Engine::ECS::Components::Transparency>(
+                    [&camera_pos, &transparent_objects](Vulqian::Engine::ECS::Entity entity, auto const& transform, auto const&, auto const&) {
+                        auto  offset = camera_pos - transform.translation;
+                        float depth = glm::dot(offset, offset);
+                        transparent_objects[depth] = {"mesh", entity};
+                    });
+
+                // Add lights
+                this->coordinator.each<const Vulqian::Engine::ECS::Components::Transform_TB_YXZ, const Vulqian::Engine::ECS::Components::PointLight>(
+                    [&camera_pos, &transparent_objects](Vulqian::Engine::ECS::Entity entity, auto const& transform, auto const&) {
+                        auto  offset = camera_pos - transform.translation;
+                        float depth = glm::dot(offset, offset);
+                        transparent_objects[depth] = {"light", entity};
+                    });
+            });
+            this->scheduler.run();
+
+            // Change observers see this frame's updates once the systems are done with them
+            this->coordinator.dispatch_changes();
+
+            // Where the update time goes, only printed once asked for and occasionally to reduce spam
+            if (static int frame_counter = 0; print_stats && ++frame_counter % 60 == 0) {
+                for (auto const& timing : this->scheduler.get_timings()) {
+                    std::cout << *timing.name << ": " << timing.milliseconds << " ms, ";
                 }
+                std::cout << "systems total: " << this->scheduler.get_frame_milliseconds() << " ms, opaque draws: " << render_system.get_stats().draw_calls
+                          << " for " << render_system.get_stats().instances << " entities, " << render_system.get_stats().culled << " culled, "
+                          << render_system.get_stats().occluded << " occluded, " << render_system.get_stats().disoccluded << " disoccluded, "
+                          << render_system.get_stats().meshlets << " meshlets drawn, " << render_system.get_stats().culled_meshlets << " culled" << std::endl;
             }
 
-            // Add lights
-            for (const auto& entity : this->entities) {
-                if (coordinator.has_component<Vulqian::Engine::ECS::Components::PointLight>(entity)) {
-                    auto const& transform = coordinator.get_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(entity);
-                    auto        offset = camera_pos - transform.translation;
-                    float       depth = glm::dot(offset, offset);
-                    transparent_objects[depth] = {"light", entity};
-                }
+            ubo_buffers[frame_index]->writeToBuffer(&ubo);
+            ubo_buffers[frame_index]->flush();
+
+            // rendering phase /!\ the order matters
+            // 0. Cull the opaque objects on the GPU, compute passes cannot run inside the render pass
+            render_system.record_culling(frame_info, this->coordinator, this->renderer.get_depth_target());
+
+            this->renderer.begin_SwapChain_RenderPass(command_buffer, render_system.is_occlusion_pending());
+
+            // 1. Render opaque objects first
+            render_system.render_opaque_entities_only(frame_info, this->coordinator);
+
+            // 1b. Occlusion culling: the pass is interrupted to build the depth pyramid from what was just drawn,
+            //     and the opaque objects hidden by the previous frame's depth are tested again against it
+            if (render_system.is_occlusion_pending()) {
+                this->renderer.end_SwapChain_RenderPass(command_buffer);
+                render_system.record_occlusion(frame_info);
+                this->renderer.resume_SwapChain_RenderPass(command_buffer);
+                render_system.render_disoccluded_entities(frame_info);
             }
 
+            // 2. Transparent objects were collected and sorted by the extraction system above
+
             // 3. Render transparent objects back-to-front
             for (auto it = transparent_objects.rbegin(); it != transparent_objects.rend(); ++it) {
                 if (it->second.first == "mesh") {
@@ -159,11 +233,11 @@ void App::load_vase(void) {
     transform.translation = glm::vec3{-.5f, .5f, .0f};
 
     Vulqian::Engine::ECS::Components::Mesh mesh{};
-    mesh.model = Vulqian::Engine::Graphics::Model::create_model_from_file(this->device, Vulqian::Engine::Utils::smooth_vase);
+    mesh.model = this->models.load(Vulqian::Engine::Utils::smooth_vase);
 
     this->coordinator.add_component(smooth_vase, Vulqian::Engine::ECS::Components::Transform_TB_YXZ{transform});
     this->coordinator.add_component(smooth_vase, Vulqian::Engine::ECS::Components::Mesh{mesh});
-    this->entities.push_back(smooth_vase);
+    this->coordinator.add_component(smooth_vase, Vulqian::Engine::ECS::Components::WorldTransform{});
 
     // flat vase
     Vulqian::Engine::ECS::Entity                       flat_vase = this->coordinator.create_entity();
@@ -173,11 +247,11 @@ void App::load_vase(void) {
     transform_flat.translation = {.5f, .5f, .0f};
 
     Vulqian::Engine::ECS::Components::Mesh flat_mesh{};
-    flat_mesh.model = Vulqian::Engine::Graphics::Model::create_model_from_file(this->device, Vulqian::Engine::Utils::flat_vase);
+    flat_mesh.model = this->models.load(Vulqian::Engine::Utils::flat_vase);
 
     this->coordinator.add_component(flat_vase, Vulqian::Engine::ECS::Components::Transform_TB_YXZ{transform_flat});
     this->coordinator.add_component(flat_vase, Vulqian::Engine::ECS::Components::Mesh{flat_mesh});
-    this->entities.push_back(flat_vase);
+    this->coordinator.add_component(flat_vase, Vulqian::Engine::ECS::Components::WorldTransform{});
 
     // flat plane for lights
     Vulqian::Engine::ECS::Entity                       quad{this->coordinator.create_entity()};
@@ -187,22 +261,31 @@ void App::load_vase(void) {
     transform_quad.translation = {0.f, .5f, 0.f};
 
     Vulqian::Engine::ECS::Components::Mesh quad_mesh{};
-    quad_mesh.model = Vulqian::Engine::Graphics::Model::create_model_from_file(this->device, Vulqian::Engine::Utils::quad);
+    quad_mesh.model = this->models.load(Vulqian::Engine::Utils::quad);
+    quad_mesh.occluder = true;
 
     this->coordinator.add_component(quad, Vulqian::Engine::ECS::Components::Transform_TB_YXZ{transform_quad});
     this->coordinator.add_component(quad, Vulqian::Engine::ECS::Components::Mesh{quad_mesh});
-    this->entities.emplace_back(quad);
+    this->coordinator.add_component(quad, Vulqian::Engine::ECS::Components::WorldTransform{});
 }
 
 void App::load_systems(void) {
     this->physics_system = this->coordinator.register_system<Vulqian::Engine::ECS::Systems::Physics>();
 
-    Vulqian::Engine::ECS::Signature physics_signature;
-    physics_signature.set(this->coordinator.get_component_type<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>());
-    physics_signature.set(this->coordinator.get_component_type<Vulqian::Engine::ECS::Components::Mesh>());
-    physics_signature.set(this->coordinator.get_component_type<Vulqian::Engine::ECS::Components::PointLight>());
-
-    this->coordinator.set_system_signature<Vulqian::Engine::ECS::Systems::Physics>(physics_signature);
+    this->coordinator.set_system_signature<Vulqian::Engine::ECS::Systems::Physics>(
+        this->coordinator.signature_of<Vulqian::Engine::ECS::Components::Transform_TB_YXZ,
+                                       Vulqian::Engine::ECS::Components::RigidBody,
+                                       Vulqian::Engine::ECS::Components::Velocity>());
+    this->physics_system->access.writes = this->coordinator.signature_of<Vulqian::Engine::ECS::Components::Transform_TB_YXZ,
+                                                                         Vulqian::Engine::ECS::Components::RigidBody,
+                                                                         Vulqian::Engine::ECS::Components::Velocity>();
+    this->physics_system->access.reads = this->coordinator.signature_of<Vulqian::Engine::ECS::Components::Collider>();
+    this->physics_system->solve_contacts = true;
+
+    this->transform_hierarchy = this->coordinator.register_system<Vulqian::Engine::ECS::Systems::TransformHierarchy>();
+    this->coordinator.set_system_signature<Vulqian::Engine::ECS::Systems::TransformHierarchy>(
+        this->coordinator.signature_of<Vulqian::Engine::ECS::Components::Transform_TB_YXZ, Vulqian::Engine::ECS::Components::WorldTransform>());
+    this->transform_hierarchy->init(this->coordinator);
 }
 
 void App::load_transparent_quad(void) {
@@ -219,7 +302,7 @@ void App::load_transparent_quad(void) {
     transform.rotation = glm::vec3{glm::radians(90.0f), 0.0f, 0.0f};
 
     Vulqian::Engine::ECS::Components::Mesh mesh{};
-    mesh.model = Vulqian::Engine::Graphics::Model::create_model_from_file(this->device, Vulqian::Engine::Utils::quad);
+    mesh.model = this->models.load(Vulqian::Engine::Utils::quad);
 
     Vulqian::Engine::ECS::Components::Transparency transparency{};
     transparency.alpha = 0.4f;                         // 40% opacity for nice transparency effect
@@ -229,47 +312,79 @@ void App::load_transparent_quad(void) {
     this->coordinator.add_component(transparent_quad, transform);
     this->coordinator.add_component(transparent_quad, mesh);
     this->coordinator.add_component(transparent_quad, transparency);
+    this->coordinator.add_component(transparent_quad, Vulqian::Engine::ECS::Components::WorldTransform{});
 
-    this->entities.push_back(transparent_quad);
 }
 
 void App::load_entities(void) {
     // ECS
     this->coordinator.init();
+    this->coordinator.set_thread_pool(&this->thread_pool);
     this->coordinator.register_component<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>();
     this->coordinator.register_component<Vulqian::Engine::ECS::Components::Mesh>();
     this->coordinator.register_component<Vulqian::Engine::ECS::Components::PointLight>();
     this->coordinator.register_component<Vulqian::Engine::ECS::Components::Transparency>();  // Add this line
+    this->coordinator.register_component<Vulqian::Engine::ECS::Components::WorldTransform>();
+    this->coordinator.register_component<Vulqian::Engine::ECS::Components::Parent>();
+    this->coordinator.register_component<Vulqian::Engine::ECS::Components::Children>();
+    this->coordinator.register_component<Vulqian::Engine::ECS::Components::RigidBody>();
+    this->coordinator.register_component<Vulqian::Engine::ECS::Components::Velocity>();
+    this->coordinator.register_component<Vulqian::Engine::ECS::Components::Collider>();
+
+    // Systems pick up entities as they are created, so they are registered first
+    this->load_systems();
 
     std::default_random_engine            generator;
     std::uniform_real_distribution<float> randPosition(-100.0f, 100.0f);
     std::uniform_real_distribution<float> randRotation(.0f, 3.0f);
     std::uniform_real_distribution<float> randScale(0.5f, 3.f);
 
-    this->entities.reserve(Vulqian::Engine::ECS::MAX_ENTITIES + 1);
-
     this->load_vase();
 
     // Create transparent quad in front of the vases
     this->load_transparent_quad();
 
-    // Create regular mesh entities (with Transform + Mesh)
-    for (int i = 0; i != 400; i++) {
-        float scale{randScale(generator)};
+    // Create regular mesh entities (with Transform + Mesh) in one batch, the cubes share a single model
+    Vulqian::Engine::ECS::Components::Mesh mesh{};
+    mesh.model = this->models.load(Vulqian::Engine::Utils::colored_cube);
 
-        Vulqian::Engine::ECS::Entity entity{this->coordinator.create_entity()};
+    std::vector<Vulqian::Engine::ECS::Components::Transform_TB_YXZ> transforms(400);
+    for (auto& transform : transforms) {
+        float scale{randScale(generator)};
 
-        Vulqian::Engine::ECS::Components::Transform_TB_YXZ transform{};
         transform.scale = glm::vec3{scale, scale, scale};
         transform.rotation = glm::vec3{randRotation(generator), randRotation(generator), randRotation(generator)};
         transform.translation = glm::vec3{randPosition(generator), randPosition(generator), randPosition(generator)};
+    }
+
+    auto cubes{this->coordinator.create_entities(transforms.size(), mesh, Vulqian::Engine::ECS::Components::WorldTransform{})};
+    this->coordinator.add_components<Vulqian::Engine::ECS::Components::Transform_TB_YXZ>(cubes, transforms);
+
+    // The cubes float, spin and bounce off each other, moved by the physics system
+    Vulqian::Engine::ECS::Components::RigidBody floating{};
+    floating.gravity_scale = 0.f;
+    floating.angular_damping = 0.f;
+
+    Vulqian::Engine::ECS::Components::Velocity spin{};
+    spin.angular = glm::vec3{.03f, .06f, 0.f};
+
+    // The cube model spans -1 to 1 on each axis
+    Vulqian::Engine::ECS::Components::Collider box{};
+    box.half_extents = glm::vec3{1.f, 1.f, 1.f};
+    box.restitution = .5f;
+
+    this->coordinator.add_components<Vulqian::Engine::ECS::Components::RigidBody>(cubes, std::vector(cubes.size(), floating));
+    this->coordinator.add_components<Vulqian::Engine::ECS::Components::Velocity>(cubes, std::vector(cubes.size(), spin));
+    this->coordinator.add_components<Vulqian::Engine::ECS::Components::Collider>(cubes, std::vector(cubes.size(), box));
 
-        Vulqian::Engine::ECS::Components::Mesh mesh{};
-        mesh.model = Vulqian::Engine::Graphics::Model::create_model_from_file(this->device, Vulqian::Engine::Utils::colored_cube);
+    // A small satellite attached to a few of the cubes, placed relative to its parent
+    Vulqian::Engine::ECS::Components::Transform_TB_YXZ satellite_transform{};
+    satellite_transform.scale = glm::vec3{.3f, .3f, .3f};
+    satellite_transform.translation = glm::vec3{1.5f, 0.f, 0.f};
 
-        this->coordinator.add_component(entity, Vulqian::Engine::ECS::Components::Transform_TB_YXZ{transform});
-        this->coordinator.add_component(entity, Vulqian::Engine::ECS::Components::Mesh{mesh});
-        this->entities.push_back(entity);
+    auto satellites{this->coordinator.create_entities(8, mesh, satellite_transform, Vulqian::Engine::ECS::Components::WorldTransform{})};
+    for (std::size_t i = 0; i < satellites.size(); ++i) {
+        this->transform_hierarchy->set_parent(this->coordinator, satellites[i], cubes[i * cubes.size() / satellites.size()]);
     }
 
     // Create light entities (with Transform + PointLight, but NO Mesh)
@@ -303,6 +418,5 @@ void App::load_entities(void) {
 
         this->coordinator.add_component(light, transform);
         this->coordinator.add_component(light, pointLight);
-        this->entities.push_back(light);
     }
 }
@@ -36,12 +36,20 @@ class App {
     Vulqian::Engine::Graphics::Device   device{this->window};
     Vulqian::Engine::Graphics::Renderer renderer{this->window, this->device};
 
+    // Every model loaded once, meshes share it. Declared after the device, so released before it
+    Vulqian::Engine::Graphics::ModelRegistry models{
+        [this](std::string const& path) { return Vulqian::Engine::Graphics::Model::create_model_from_file(this->device, path); }};
+
     // Descriptor Sets ! order of declaration matters
     std::unique_ptr<Vulqian::Engine::Graphics::Descriptors::DescriptorPool> global_pool;
 
     // ECS
     Vulqian::Engine::ECS::Coordinator coordinator{};
 
-    std::shared_ptr<Vulqian::Engine::ECS::Systems::Physics> physics_system;
-    std::vector<Vulqian::Engine::ECS::Entity>               entities;
+    // Worker threads must outlive the scheduler using them
+    Vulqian::Engine::Jobs::ThreadPool thread_pool{};
+    Vulqian::Engine::ECS::Scheduler   scheduler{this->thread_pool};
+
+    std::shared_ptr<Vulqian::Engine::ECS::Systems::Physics>            physics_system;
+    std::shared_ptr<Vulqian::Engine::ECS::Systems::TransformHierarchy> transform_hierarchy;
 };